@@ -63,9 +63,8 @@ cppSwitchboard::HttpResponse CompressionMiddleware::handle(
         
         // Create new response with compressed body
         auto compressedResponse = response;
-        compressedResponse.setBody(compressedBody);
+        compressedResponse.setBody(std::move(compressedBody));
         compressedResponse.setHeader("Content-Encoding", compressionType);
-        compressedResponse.setHeader("Content-Length", std::to_string(compressedBody.size()));
         compressedResponse.setHeader("Vary", "Accept-Encoding");
         
         // Add compression info to context
@@ -122,8 +121,7 @@ bool CompressionMiddleware::shouldCompress(const cppSwitchboard::HttpResponse& r
     }
     
     // Check response size
-    std::string body = response.getBody();
-    if (body.size() < config_.minSize) {
+    if (response.getContentLength() < config_.minSize) {
         return false;
     }
     
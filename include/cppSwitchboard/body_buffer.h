@@ -0,0 +1,118 @@
+/**
+ * @file body_buffer.h
+ * @brief Reference-counted immutable byte buffer for message bodies
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-22
+ * @version 1.2.0
+ *
+ * Bodies used to be copied at every hop: out of the parser into the
+ * request, out of the handler's string into the response, and once more
+ * into the transport's own buffer. BodyBuffer takes ownership of the bytes
+ * once and is then shared by reference count, so a response cache, a
+ * compression layer and the socket writer can all hold the same body.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cppSwitchboard {
+
+/**
+ * @class BodyBuffer
+ * @brief Shared, immutable view over body bytes
+ *
+ * Copying a BodyBuffer copies a pointer and bumps a reference count; the
+ * bytes themselves are never modified once wrapped. Slices share the same
+ * storage.
+ *
+ * @code{.cpp}
+ * std::string payload = renderPage();
+ * BodyBuffer body(std::move(payload));          // no copy
+ * BodyBuffer cached = body;                      // shared with a cache
+ * response.setBody(body);                        // shared with the response
+ *
+ * static const BodyBuffer notFound = BodyBuffer::fromStatic("Not Found");
+ * @endcode
+ *
+ * @since 1.2.0
+ */
+class BodyBuffer {
+public:
+    /**
+     * @brief Empty body
+     */
+    BodyBuffer() = default;
+
+    /**
+     * @brief Take ownership of a string without copying it
+     */
+    explicit BodyBuffer(std::string&& data);
+
+    /**
+     * @brief Take ownership of a byte vector without copying it
+     */
+    explicit BodyBuffer(std::vector<uint8_t>&& data);
+
+    /**
+     * @brief Copy bytes into a new buffer
+     */
+    static BodyBuffer copyOf(std::string_view data);
+
+    /**
+     * @brief Copy raw bytes into a new buffer
+     */
+    static BodyBuffer copyOf(const void* data, std::size_t size);
+
+    /**
+     * @brief Refer to bytes with static storage duration (no ownership, no copy)
+     * @warning @p data must outlive every copy of the returned buffer
+     */
+    static BodyBuffer fromStatic(std::string_view data) noexcept;
+
+    const char* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    std::string_view view() const noexcept { return std::string_view(data_, size_); }
+
+    /**
+     * @brief Copy the bytes into a std::string
+     */
+    std::string str() const { return std::string(data_, size_); }
+
+    /**
+     * @brief Sub-range sharing the same storage
+     * @param offset Start offset (clamped to size())
+     * @param length Maximum length
+     */
+    BodyBuffer slice(std::size_t offset, std::size_t length = std::string::npos) const noexcept;
+
+    /**
+     * @brief Number of BodyBuffer objects sharing the storage (0 for static or empty buffers)
+     */
+    long useCount() const noexcept { return owner_.use_count(); }
+
+    /**
+     * @brief Convert to a std::string, moving the bytes out when this is the sole owner
+     *
+     * The buffer is left empty. Bytes are only copied when the storage is
+     * shared, static, sliced or not string-backed.
+     */
+    std::string release();
+
+private:
+    std::shared_ptr<const void> owner_;    ///< Keeps the storage alive
+    std::string* ownedString_ = nullptr;   ///< Set when owner_ holds a std::string
+    const char* data_ = "";
+    std::size_t size_ = 0;
+};
+
+inline bool operator==(const BodyBuffer& lhs, std::string_view rhs) noexcept { return lhs.view() == rhs; }
+inline bool operator!=(const BodyBuffer& lhs, std::string_view rhs) noexcept { return lhs.view() != rhs; }
+
+} // namespace cppSwitchboard
@@ -0,0 +1,264 @@
+/**
+ * @file buffer_pool.h
+ * @brief Process-wide pool of size-classed I/O buffers
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-21
+ * @version 1.2.0
+ *
+ * Connections used to allocate their read/write buffers on accept and free
+ * them on close, which under connection churn turns into a steady stream of
+ * large malloc/free calls. BufferPool keeps freed blocks in per-size-class
+ * free lists so they can be handed to the next connection, and
+ * AdaptiveBuffer lets a connection grow its buffer for bulk transfers and
+ * give it back when the connection goes idle.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cppSwitchboard {
+
+/**
+ * @class BufferPool
+ * @brief Singleton slab of reusable memory blocks grouped by size class
+ *
+ * Requests are rounded up to the next size class (256 B .. 64 KB). Larger
+ * requests bypass the pool. Each size class keeps at most
+ * getMaxCachedPerClass() free blocks; anything beyond that is returned to
+ * the system allocator.
+ *
+ * @code{.cpp}
+ * auto buffer = BufferPool::getInstance().acquire(8192);
+ * size_t n = socket.read_some(boost::asio::buffer(buffer.data(), buffer.size()));
+ * // buffer returns to the pool when it goes out of scope
+ * @endcode
+ *
+ * @note All methods are thread-safe.
+ * @since 1.2.0
+ */
+class BufferPool {
+public:
+    /// Block sizes served from the pool
+    static constexpr std::array<std::size_t, 9> SIZE_CLASSES = {
+        256, 512, 1024, 2048, 4096, 8192, 16384, 32768, 65536
+    };
+
+    /// Default number of free blocks retained per size class
+    static constexpr std::size_t DEFAULT_MAX_CACHED_PER_CLASS = 256;
+
+    /**
+     * @class Buffer
+     * @brief Move-only handle to a pooled block
+     *
+     * The block is returned to the pool when the handle is destroyed or
+     * reset.
+     */
+    class Buffer {
+    public:
+        Buffer() = default;
+        Buffer(Buffer&& other) noexcept;
+        Buffer& operator=(Buffer&& other) noexcept;
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+        ~Buffer() { reset(); }
+
+        uint8_t* data() const noexcept { return data_; }
+        std::size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return data_ == nullptr; }
+
+        /**
+         * @brief Return the block to the pool
+         */
+        void reset() noexcept;
+
+    private:
+        friend class BufferPool;
+        Buffer(uint8_t* data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+        uint8_t* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
+    /**
+     * @brief Get the process-wide pool
+     */
+    static BufferPool& getInstance();
+
+    /**
+     * @brief Acquire a buffer of at least @p minSize bytes
+     * @param minSize Requested size
+     * @return Buffer whose size() is the rounded-up size class (or @p minSize when above the largest class)
+     */
+    Buffer acquire(std::size_t minSize);
+
+    /**
+     * @brief Allocate a raw block (used by PoolAllocator)
+     * @param bytes Requested size
+     * @return Block of at least @p bytes bytes, aligned for any fundamental type
+     */
+    void* allocate(std::size_t bytes);
+
+    /**
+     * @brief Return a raw block obtained from allocate()
+     * @param p Block pointer
+     * @param bytes Size that was passed to allocate()
+     */
+    void deallocate(void* p, std::size_t bytes) noexcept;
+
+    /**
+     * @brief Size class a request of @p bytes is rounded up to
+     * @return Size class, or @p bytes itself when above the largest class
+     */
+    static std::size_t roundUp(std::size_t bytes) noexcept;
+
+    /**
+     * @brief Next larger size class, saturating at the largest one
+     */
+    static std::size_t nextClass(std::size_t size) noexcept;
+
+    /**
+     * @brief Next smaller size class, saturating at the smallest one
+     */
+    static std::size_t previousClass(std::size_t size) noexcept;
+
+    void setMaxCachedPerClass(std::size_t maxBlocks);
+    std::size_t getMaxCachedPerClass() const noexcept { return maxCachedPerClass_.load(); }
+
+    /**
+     * @brief Release every cached free block to the system allocator
+     */
+    void trim();
+
+    /**
+     * @brief Pool counters
+     * @return Map with "allocations", "reuses", "releases", "cached_blocks",
+     *         "cached_bytes" and "outstanding_blocks"
+     */
+    std::unordered_map<std::string, std::size_t> getStatistics() const;
+
+private:
+    BufferPool() = default;
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    static int classIndex(std::size_t bytes) noexcept;
+
+    struct SizeClass {
+        mutable std::mutex mutex;
+        std::vector<void*> freeBlocks;
+    };
+
+    std::array<SizeClass, SIZE_CLASSES.size()> classes_;
+    std::atomic<std::size_t> maxCachedPerClass_{DEFAULT_MAX_CACHED_PER_CLASS};
+    std::atomic<std::size_t> allocations_{0};
+    std::atomic<std::size_t> reuses_{0};
+    std::atomic<std::size_t> releases_{0};
+    std::atomic<std::size_t> outstanding_{0};
+};
+
+/**
+ * @class PoolAllocator
+ * @brief Standard allocator drawing from BufferPool
+ *
+ * Suitable for containers and buffers that are created and destroyed with
+ * every connection, e.g. Beast's basic_flat_buffer or std::allocate_shared
+ * for session objects.
+ *
+ * @tparam T Value type
+ */
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                      "PoolAllocator does not support over-aligned types");
+        return static_cast<T*>(BufferPool::getInstance().allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        BufferPool::getInstance().deallocate(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>&) const noexcept { return true; }
+
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>&) const noexcept { return false; }
+};
+
+/**
+ * @class AdaptiveBuffer
+ * @brief Per-connection read buffer that follows the traffic pattern
+ *
+ * The buffer starts at the initial size class. A read that fills the whole
+ * buffer grows it by one class (bulk transfer); a run of reads that use
+ * less than a quarter of it shrinks it by one class. release() hands the
+ * block back to the pool so idle connections hold no buffer at all.
+ *
+ * @code{.cpp}
+ * AdaptiveBuffer buffer;
+ * auto n = socket.read_some(boost::asio::buffer(buffer.prepare(), buffer.capacity()));
+ * buffer.commit(n);
+ * @endcode
+ */
+class AdaptiveBuffer {
+public:
+    static constexpr std::size_t DEFAULT_INITIAL_SIZE = 4096;   ///< Starting size class
+    static constexpr std::size_t DEFAULT_MAX_SIZE = 65536;      ///< Largest size grown to
+    static constexpr int SHRINK_AFTER_SMALL_READS = 8;          ///< Small reads before shrinking
+
+    explicit AdaptiveBuffer(std::size_t initialSize = DEFAULT_INITIAL_SIZE,
+                            std::size_t maxSize = DEFAULT_MAX_SIZE);
+
+    /**
+     * @brief Make sure a block is held and return it
+     * @return Pointer to capacity() writable bytes
+     */
+    uint8_t* prepare();
+
+    /**
+     * @brief Bytes available in the block returned by prepare()
+     */
+    std::size_t capacity() const noexcept { return targetSize_; }
+
+    /**
+     * @brief Record how many bytes the last read produced and adapt the size
+     * @param bytesRead Bytes read into the buffer
+     */
+    void commit(std::size_t bytesRead);
+
+    /**
+     * @brief Give the block back to the pool (e.g. while the connection is idle)
+     */
+    void release() noexcept { buffer_.reset(); }
+
+    /**
+     * @brief Whether a block is currently held
+     */
+    bool holdsBuffer() const noexcept { return !buffer_.empty(); }
+
+private:
+    BufferPool::Buffer buffer_;
+    std::size_t targetSize_;
+    std::size_t minSize_;
+    std::size_t maxSize_;
+    int smallReads_ = 0;
+};
+
+} // namespace cppSwitchboard
@@ -0,0 +1,230 @@
+/**
+ * @file bulkhead.h
+ * @brief Per-route executor pools with bounded queues
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ *
+ * A bulkhead is a WorkerPool of its own with a limit on the requests
+ * waiting for it. Routes bound to it in the middleware configuration run
+ * there instead of on the shared pool, so a slow endpoint fills its own
+ * queue and then sheds load according to its overflow policy, while health
+ * checks and other routes keep their threads.
+ */
+
+#pragma once
+
+#include <cppSwitchboard/middleware_config.h>
+#include <cppSwitchboard/worker_pool.h>
+#include <cppSwitchboard/queue_delay.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cppSwitchboard {
+
+/**
+ * @class Bulkhead
+ * @brief Executor pool of one route group
+ *
+ * Admits a request while fewer than threads + maxQueue are queued or
+ * running. Past that, BulkheadOverflow decides: REJECT refuses it, DEGRADE
+ * leaves it to the caller's shared pool, and QUEUE queues it anyway but
+ * answers it with the rejected callback if no thread picked it up within
+ * queueTimeout. A reaper thread, started on the first such request, runs
+ * the callback at the deadline and frees the slot; the task is then
+ * skipped when its turn comes.
+ *
+ * @code{.cpp}
+ * BulkheadConfig config;
+ * config.name = "reports";
+ * config.threads = 2;
+ * config.maxQueue = 8;
+ * Bulkhead reports(config);
+ * auto unavailable = cannedResponses.error(HttpResponse::SERVICE_UNAVAILABLE);
+ * auto admission = reports.submit([request, done]() { done(generate(*request)); },
+ *                                 [done, unavailable]() { done(unavailable->toResponse()); });
+ * if (admission == Bulkhead::Admission::REJECTED) {
+ *     done(unavailable->toResponse());
+ * }
+ * @endcode
+ *
+ * @since 1.2.0
+ */
+class Bulkhead : public std::enable_shared_from_this<Bulkhead> {
+public:
+    using Task = WorkerPool::Task;
+
+    /**
+     * @brief Outcome of submit()
+     */
+    enum class Admission {
+        ADMITTED,   ///< Queued; the task or the rejected callback will run
+        REJECTED,   ///< Not queued; answer with 503 Service Unavailable
+        DEGRADED    ///< Not queued; run the task on the shared pool
+    };
+
+    /**
+     * @brief Counters of a bulkhead
+     */
+    struct Stats {
+        size_t running = 0;     ///< Tasks on a thread now
+        size_t queued = 0;      ///< Admitted tasks waiting for a thread
+        uint64_t admitted = 0;  ///< Tasks accepted by submit()
+        uint64_t rejected = 0;  ///< Refused with REJECTED
+        uint64_t degraded = 0;  ///< Handed back with DEGRADED
+        uint64_t expired = 0;   ///< Queued past queueTimeout and answered with the rejected callback
+    };
+
+    /**
+     * @param config Name, thread count and limits; assumed valid
+     */
+    explicit Bulkhead(const BulkheadConfig& config);
+
+    /// Runs the tasks still queued, then joins the threads
+    ~Bulkhead();
+
+    Bulkhead(const Bulkhead&) = delete;
+    Bulkhead& operator=(const Bulkhead&) = delete;
+
+    /**
+     * @brief Queue a task if the limits allow it
+     * @param task Work to run on one of the bulkhead's threads
+     * @param rejected Run instead of @p task when a request queued under
+     *        the QUEUE policy waited longer than queueTimeout; on the
+     *        reaper thread, at the deadline
+     * @return Whether the task was queued; REJECTED after shutdown()
+     */
+    Admission submit(Task task, Task rejected = nullptr);
+
+    /**
+     * @brief Take the queue limit, overflow policy and timeout of a new configuration
+     *
+     * The thread count is fixed; BulkheadRegistry replaces a bulkhead whose
+     * thread count changed.
+     */
+    void setLimits(const BulkheadConfig& config);
+
+    /// Stop admitting, run what is queued and join the threads
+    void shutdown();
+
+    /**
+     * @brief Shut down once no admitted task is left
+     *
+     * For a bulkhead dropped from the configuration. Its threads cannot
+     * join themselves, so the last task to finish leaves shutdown() to a
+     * short-lived thread; a bulkhead not owned by a shared_ptr waits for
+     * an explicit shutdown() instead.
+     */
+    void retire();
+
+    const std::string& getName() const { return name_; }
+    size_t getThreadCount() const { return pool_->getThreadCount(); }
+    Stats getStats() const;
+
+    /// Tasks queued or running
+    size_t getOccupancy() const { return occupancy_.load(); }
+
+    /**
+     * @brief Queue-delay controller of this bulkhead's queue
+     *
+     * Switches the bulkhead's queue to LIFO while overloaded. The server
+     * consults it before running each request it queued here.
+     */
+    QueueDelayController& getQueueDelay() { return queueDelay_; }
+
+private:
+    /// Task queued past the limit, answered by a thread or the reaper, whichever claims it first
+    struct QueuedTask {
+        std::atomic<bool> claimed{false};
+        Task rejected;
+    };
+
+    struct Expiry {
+        int64_t deadlineNs;
+        std::shared_ptr<QueuedTask> queued;
+        bool operator>(const Expiry& other) const { return deadlineNs > other.deadlineNs; }
+    };
+
+    void finished();
+    void scheduleExpiry(int64_t deadlineNs, std::shared_ptr<QueuedTask> queued);
+    void reap();
+
+    const std::string name_;
+    std::atomic<int> maxQueue_;
+    std::atomic<BulkheadOverflow> overflow_;
+    std::atomic<int64_t> queueTimeoutNs_;
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> retired_{false};
+
+    std::atomic<size_t> occupancy_{0};         ///< Admitted tasks not yet finished
+    std::atomic<size_t> running_{0};
+    std::atomic<uint64_t> admitted_{0};
+    std::atomic<uint64_t> rejected_{0};
+    std::atomic<uint64_t> degraded_{0};
+    std::atomic<uint64_t> expired_{0};
+    QueueDelayController queueDelay_;
+
+    std::mutex reaperMutex_;
+    std::condition_variable reaperWake_;
+    std::priority_queue<Expiry, std::vector<Expiry>, std::greater<Expiry>> expiries_;  ///< Earliest deadline on top
+    std::thread reaper_;                       ///< Started with the first expiry
+    bool reaperStopping_ = false;
+
+    std::unique_ptr<WorkerPool> pool_;         ///< Declared last: joined before the counters go away
+};
+
+/**
+ * @class BulkheadRegistry
+ * @brief Bulkheads by name, kept in step with the middleware configuration
+ *
+ * configure() keeps a bulkhead whose name and thread count are unchanged,
+ * so its queue survives a reload. Bulkheads that were removed or resized
+ * get no new requests and are shut down once idle, when their last task
+ * finishes or on the next configure(), since requests may still be queued
+ * on them.
+ *
+ * @since 1.2.0
+ */
+class BulkheadRegistry {
+public:
+    BulkheadRegistry() = default;
+    ~BulkheadRegistry();
+
+    BulkheadRegistry(const BulkheadRegistry&) = delete;
+    BulkheadRegistry& operator=(const BulkheadRegistry&) = delete;
+
+    /// Create, update and retire bulkheads to match @p configs
+    void configure(const std::vector<BulkheadConfig>& configs);
+
+    /// Bulkhead named @p name, or nullptr
+    std::shared_ptr<Bulkhead> find(const std::string& name) const;
+
+    /// Names of the current bulkheads
+    std::vector<std::string> getNames() const;
+
+    /// Shut every bulkhead down, including retired ones
+    void shutdown();
+
+    /// Admission control of every bulkhead, current and future
+    void setAdmissionControl(const AdmissionControlConfig& config);
+
+private:
+    /// Shut down retired bulkheads with nothing left to run; caller holds mutex_
+    void pruneRetired();
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<Bulkhead>> bulkheads_;
+    std::vector<std::shared_ptr<Bulkhead>> retired_;  ///< No longer configured, maybe still draining
+    AdmissionControlConfig admission_;
+};
+
+} // namespace cppSwitchboard
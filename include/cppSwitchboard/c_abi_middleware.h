@@ -0,0 +1,96 @@
+/**
+ * @file c_abi_middleware.h
+ * @brief Framework side of the C plugin ABI
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ *
+ * CAbiPlugin presents a cppSwitchboard_c_plugin descriptor as a
+ * MiddlewarePlugin. The plugin manager, the factory and hot reload therefore
+ * treat C plugins like any other plugin. The middleware it creates are
+ * CAbiMiddleware. MiddlewarePipeline recognizes them and calls their hooks
+ * inline. It skips the NextHandler std::function, and the C code only sees
+ * PODs and host callbacks.
+ */
+
+#pragma once
+
+#include <cppSwitchboard/middleware_plugin.h>
+#include <cppSwitchboard/plugin_c_abi.h>
+#include <string>
+#include <vector>
+
+namespace cppSwitchboard {
+
+/**
+ * @class CAbiMiddleware
+ * @brief Middleware implemented by C ABI hooks
+ *
+ * handle() runs the hooks around next() for callers outside a pipeline;
+ * pipelines call before() and after() directly.
+ *
+ * @since 1.2.0
+ */
+class CAbiMiddleware : public Middleware {
+public:
+    /**
+     * @param type Hooks; must outlive the middleware (they live in the plugin library)
+     * @param instance Value returned by type.create, or nullptr
+     * @param priority Execution priority
+     */
+    CAbiMiddleware(const cppSwitchboard_c_middleware& type, void* instance, int priority);
+    ~CAbiMiddleware() override;
+
+    CAbiMiddleware(const CAbiMiddleware&) = delete;
+    CAbiMiddleware& operator=(const CAbiMiddleware&) = delete;
+
+    HttpResponse handle(const HttpRequest& request, Context& context, NextHandler next) override;
+    std::string getName() const override { return name_; }
+    int getPriority() const override { return priority_; }
+
+    /**
+     * @brief Run on_request
+     * @return false if the middleware answered the request with response
+     */
+    bool before(const HttpRequest& request, Context& context, HttpResponse& response) const;
+
+    /// Run on_response on the response of the rest of the chain
+    void after(const HttpRequest& request, Context& context, HttpResponse& response) const;
+
+    /// Callbacks handed to every hook
+    static const cppSwitchboard_host_api& hostApi();
+
+private:
+    const cppSwitchboard_c_middleware& type_;
+    void* instance_;
+    int priority_;
+    std::string name_;
+};
+
+/**
+ * @class CAbiPlugin
+ * @brief MiddlewarePlugin over an exported cppSwitchboard_c_plugin descriptor
+ *
+ * @since 1.2.0
+ */
+class CAbiPlugin : public MiddlewarePlugin {
+public:
+    /// @param descriptor Exported descriptor; must outlive the plugin
+    explicit CAbiPlugin(const cppSwitchboard_c_plugin& descriptor);
+
+    bool initialize(const PluginVersion& frameworkVersion) override;
+    void shutdown() override;
+    std::shared_ptr<Middleware> createMiddleware(const MiddlewareInstanceConfig& config) override;
+    bool validateConfig(const MiddlewareInstanceConfig& config, std::string& errorMessage) const override;
+    std::vector<std::string> getSupportedTypes() const override;
+    const MiddlewarePluginInfo& getInfo() const override { return info_; }
+
+private:
+    const cppSwitchboard_c_middleware* findType(const std::string& type) const;
+
+    const cppSwitchboard_c_plugin& descriptor_;
+    MiddlewarePluginInfo info_;
+    bool initialized_ = false;
+};
+
+} // namespace cppSwitchboard
@@ -0,0 +1,150 @@
+/**
+ * @file cancellation.h
+ * @brief Per-request cancellation and deadlines
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ *
+ * A client that resets its HTTP/2 stream or closes its HTTP/1 connection
+ * no longer reads the response, and a client whose own timeout expired
+ * has given up on it. Handlers that keep running for them only take
+ * workers and database connections from requests that still have a
+ * reader. Each request therefore carries a CancellationToken: the
+ * protocol layer cancels it when the client goes away, and its deadline,
+ * from the client's timeout header or the route's configured timeout,
+ * cancels it once passed. The pipeline checks the token between
+ * middleware, and long-running handlers poll it or register a callback.
+ */
+
+#pragma once
+
+#include <cppSwitchboard/http_response.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+
+namespace cppSwitchboard {
+
+class HttpRequest;
+
+/**
+ * @class CancellationToken
+ * @brief Cancellation state and deadline shared by the copies of one request
+ *
+ * Deadlines and disconnects are noticed when the token is checked, so no
+ * timer or socket watcher runs per request. The first check that finds
+ * the deadline passed, or the probe reporting the client gone, cancels
+ * the token and runs the registered callbacks.
+ *
+ * @code{.cpp}
+ * class SlowQuery : public AsyncHttpHandler {
+ *     void handleAsync(const HttpRequest& request, ResponseCallback callback) override {
+ *         auto query = database.start(request.getQueryParam("q"));
+ *         request.getCancellation()->onCancel([query]() { query->abort(); });
+ *         query->then([callback](Rows rows) { callback(HttpResponse::json(toJson(rows))); });
+ *     }
+ * };
+ * @endcode
+ *
+ * @since 1.2.0
+ */
+class CancellationToken {
+public:
+    using Clock = std::chrono::steady_clock;
+    using CallbackId = uint64_t;
+
+    /// Why a token was cancelled
+    enum class Reason {
+        NONE,           ///< Not cancelled
+        CLIENT_GONE,    ///< Stream reset or connection closed by the client
+        DEADLINE        ///< Deadline passed
+    };
+
+    /// Shortest time between two calls of the disconnect probe
+    static constexpr std::chrono::milliseconds PROBE_INTERVAL{10};
+
+    CancellationToken() = default;
+    explicit CancellationToken(Clock::time_point deadline) : deadline_(deadline.time_since_epoch().count()) {}
+    CancellationToken(const CancellationToken&) = delete;
+    CancellationToken& operator=(const CancellationToken&) = delete;
+
+    /**
+     * @brief Cancel the token and run its callbacks
+     * @return False if it was already cancelled; the first reason is kept
+     */
+    bool cancel(Reason reason = Reason::CLIENT_GONE);
+
+    /**
+     * @brief Whether the work for this request should stop
+     *
+     * Cheap enough to call between steps: an atomic load while neither a
+     * deadline nor a probe is set.
+     */
+    bool isCancelled();
+
+    Reason getReason() const { return reason_.load(std::memory_order_acquire); }
+
+    /// Move the deadline earlier; a later one than the current is ignored
+    void tightenDeadline(Clock::time_point deadline);
+
+    /// Deadline; Clock::time_point::max() when there is none
+    Clock::time_point getDeadline() const { return Clock::time_point(Clock::duration(deadline_.load())); }
+
+    bool hasDeadline() const { return getDeadline() != Clock::time_point::max(); }
+
+    /**
+     * @brief Run a callback once the token is cancelled
+     *
+     * Runs right away, on the calling thread, if the token already is.
+     * Otherwise it runs on the thread that cancels; keep it short.
+     *
+     * @return Id for removeCallback(); 0 if the callback already ran
+     */
+    CallbackId onCancel(std::function<void()> callback);
+
+    /// Unregister a callback that has not run yet
+    void removeCallback(CallbackId id);
+
+    /**
+     * @brief Ask the connection whether the client is still there
+     *
+     * Called by isCancelled(), at most once per PROBE_INTERVAL and under
+     * the token's lock; setProbe(nullptr) therefore returns only once no
+     * call is running, after which the connection may close its socket.
+     *
+     * @param probe Returns true when the client has gone away
+     */
+    void setProbe(std::function<bool()> probe);
+
+    /**
+     * @brief Response for a request stopped by its token
+     * @return 504 for a passed deadline; 499 (client closed request) otherwise,
+     *         which no client reads and the access log records
+     */
+    HttpResponse response() const;
+
+    /**
+     * @brief Deadline requested by the client
+     *
+     * Reads `grpc-timeout` (digits and a unit of H, M, S, m, u or n) and
+     * `X-Request-Timeout` (milliseconds); the earlier one wins.
+     *
+     * @return Clock::time_point::max() when neither header is set or valid
+     */
+    static Clock::time_point deadlineFromHeaders(const HttpRequest& request, Clock::time_point now = Clock::now());
+
+private:
+    std::atomic<Reason> reason_{Reason::NONE};
+    std::atomic<Clock::rep> deadline_{Clock::time_point::max().time_since_epoch().count()};
+    std::atomic<bool> hasProbe_{false};                             ///< Skip the lock while no probe is set
+    std::mutex mutex_;
+    std::map<CallbackId, std::function<void()>> callbacks_;
+    CallbackId nextId_ = 1;
+    std::function<bool()> probe_;
+    Clock::time_point nextProbe_{};                                 ///< Earliest time the probe runs again
+};
+
+} // namespace cppSwitchboard
@@ -0,0 +1,135 @@
+/**
+ * @file canned_response.h
+ * @brief Pre-serialized responses and cached per-response header values
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-24
+ * @version 1.2.0
+ *
+ * Error responses and responses of constant routes are identical on every
+ * request, yet serializing them means building the status line, formatting
+ * every header and Content-Length, and concatenating the Server value each
+ * time. A CannedResponse does that work once: the HTTP/1.1 header block and
+ * the body are kept ready to be written with a single gather write. Only the
+ * Date and Connection lines are added per request, and the Date line comes
+ * from a per-thread cache that is refreshed once a second.
+ */
+
+#pragma once
+
+#include <cppSwitchboard/http_response.h>
+#include <cppSwitchboard/body_buffer.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace cppSwitchboard {
+
+/**
+ * @class HttpDate
+ * @brief IMF-fixdate for the Date header, formatted at most once a second
+ */
+class HttpDate {
+public:
+    /**
+     * @brief Current time as "Sun, 06 Nov 1994 08:49:37 GMT"
+     * @return View into a thread-local buffer, valid until the next call on
+     *         the same thread
+     */
+    static std::string_view now();
+};
+
+/**
+ * @class CannedResponse
+ * @brief Immutable response with its HTTP/1.1 serialization prepared up front
+ *
+ * Handlers return toResponse(), which is an ordinary HttpResponse (HTTP/2
+ * and middleware see no difference) that remembers where it came from. The
+ * HTTP/1.1 writer sends the prepared bytes as long as nothing modified the
+ * response on the way out; any change falls back to regular serialization.
+ *
+ * @code{.cpp}
+ * auto health = CannedResponse::create(HttpResponse::json("{\"status\":\"ok\"}"), "my-service/1.0");
+ * server->get("/health", [health](const HttpRequest&) { return health->toResponse(); });
+ * @endcode
+ *
+ * @since 1.2.0
+ */
+class CannedResponse : public std::enable_shared_from_this<CannedResponse> {
+public:
+    /**
+     * @brief Prepare a response for repeated sending
+     * @param response Response to serialize
+     * @param serverHeader Server header value, used unless @p response sets
+     *        one; when both are empty the writer adds its own server's value
+     */
+    static std::shared_ptr<const CannedResponse> create(HttpResponse response, std::string_view serverHeader);
+
+    /**
+     * @brief Copy of the response, linked to the prepared serialization
+     */
+    HttpResponse toResponse() const;
+
+    int getStatus() const noexcept { return response_.getStatus(); }
+
+    /**
+     * @brief Serialized head following the "HTTP/1.x" version token
+     *
+     * Starts with the space before the status code and ends after the
+     * Content-Length line; Date, Connection and the blank line are added
+     * when writing.
+     */
+    const std::string& getHead() const noexcept { return head_; }
+
+    /// Whether getHead() includes a Server line
+    bool hasServerHeader() const noexcept { return hasServer_; }
+
+    const BodyBuffer& getBody() const noexcept { return response_.getBodyBuffer(); }
+
+private:
+    CannedResponse(HttpResponse response, std::string_view serverHeader);
+
+    HttpResponse response_;
+    std::string head_;
+    bool hasServer_ = false;
+};
+
+/**
+ * @class CannedResponseRegistry
+ * @brief Canned standard error responses plus a factory for constant routes
+ *
+ * The registry carries the Server value of one server, computed once from
+ * the application name and version. The standard JSON error responses
+ * (400, 404, 405, 413, 500, 503 for shed requests and 504 for handlers
+ * that missed their deadline) are canned when the registry is created.
+ *
+ * @note add() is meant for setup time; error() may be called concurrently.
+ * @since 1.2.0
+ */
+class CannedResponseRegistry {
+public:
+    /**
+     * @brief Create a registry
+     * @param serverHeader Server header value ("name/version")
+     */
+    explicit CannedResponseRegistry(std::string serverHeader);
+
+    /**
+     * @brief Canned form of a response, tagged with this registry's Server value
+     */
+    std::shared_ptr<const CannedResponse> add(HttpResponse response) const;
+
+    /**
+     * @brief Standard JSON error response for a status code
+     * @return Canned response, or nullptr for codes without one
+     */
+    std::shared_ptr<const CannedResponse> error(int status) const;
+
+    const std::string& getServerHeader() const noexcept { return serverHeader_; }
+
+private:
+    std::string serverHeader_;
+    std::map<int, std::shared_ptr<const CannedResponse>> errors_;
+};
+
+} // namespace cppSwitchboard
@@ -0,0 +1,202 @@
+/**
+ * @file compiled_middleware_config.h
+ * @brief Route-to-pipeline table compiled from a middleware configuration
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-25
+ * @version 1.2.0
+ *
+ * ComprehensiveMiddlewareConfig::getMiddlewareForRoute() is convenient for
+ * inspection but expensive on a request path: it tests every rule, compiles
+ * regex rules on each call, copies the MiddlewareInstanceConfig objects and
+ * sorts them again. CompiledMiddlewareConfig does that work once when the
+ * configuration is loaded. Each rule gets a prepared matcher, each distinct
+ * middleware configuration is instantiated once, and each distinct
+ * middleware stack becomes one MiddlewarePipeline shared by every route it
+ * applies to.
+ *
+ * With MiddlewareInstantiation::LAZY only the global stack is instantiated
+ * up front. Route stacks are validated at compile time but created on the
+ * first request they serve, or by warmUp() once the server is accepting
+ * requests, so startup does not wait for key loading and regex compilation
+ * of routes that are not hit yet.
+ */
+
+#pragma once
+
+#include <cppSwitchboard/middleware_config.h>
+#include <cppSwitchboard/middleware_pipeline.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cppSwitchboard {
+
+class MiddlewareFactory;
+
+/**
+ * @brief When CompiledMiddlewareConfig creates middleware instances
+ */
+enum class MiddlewareInstantiation {
+    EAGER,  ///< Every stack at compile time; a creation failure fails compile()
+    LAZY    ///< Global stack at compile time, route stacks on first use
+};
+
+/**
+ * @class CompiledMiddlewareConfig
+ * @brief Immutable path-to-pipeline table for a ComprehensiveMiddlewareConfig
+ *
+ * Lookups follow getMiddlewareForRoute(): the first matching rule wins and
+ * its middleware run together with the global middleware in priority order.
+ * Paths matching no rule get the pipeline of the global middleware alone.
+ *
+ * @code{.cpp}
+ * std::string error;
+ * auto compiled = CompiledMiddlewareConfig::compile(loader.getConfiguration(),
+ *                                                   MiddlewareFactory::getInstance(), error);
+ * if (!compiled) {
+ *     throw std::runtime_error(error);
+ * }
+ * server->registerHandler("/api/users", HttpMethod::GET, compiled->wrap("/api/users", usersHandler));
+ * @endcode
+ *
+ * @note The table is read-only once compiled and safe to share between threads.
+ * @since 1.2.0
+ */
+class CompiledMiddlewareConfig : public std::enable_shared_from_this<CompiledMiddlewareConfig> {
+public:
+    /// Returned by findRule() when no route rule matches
+    static constexpr int NO_RULE = -1;
+
+    /**
+     * @brief Compile a configuration and instantiate its middleware
+     * @param config Configuration to compile
+     * @param factory Factory creating the middleware instances
+     * @param errorMessage Set when compilation fails
+     * @param instantiation When route stacks are instantiated. A lazily
+     *        created middleware that fails answers 500 in place of the route.
+     * @return Compiled table, or nullptr if a regex rule is invalid, a
+     *         middleware cannot be created or fails validation, or a route
+     *         names an undeclared executor
+     */
+    static std::shared_ptr<const CompiledMiddlewareConfig> compile(
+        const ComprehensiveMiddlewareConfig& config, MiddlewareFactory& factory, std::string& errorMessage,
+        MiddlewareInstantiation instantiation = MiddlewareInstantiation::EAGER);
+
+    /**
+     * @brief Index into ComprehensiveMiddlewareConfig::routes of the first
+     *        rule matching a path
+     * @return Rule index or NO_RULE
+     */
+    int findRule(std::string_view path) const;
+
+    /**
+     * @brief Shared pipeline for a request path
+     * @return Pipeline without a final handler; run it with
+     *         MiddlewarePipeline::execute(request, context, handler)
+     */
+    const std::shared_ptr<MiddlewarePipeline>& getPipeline(std::string_view path) const;
+
+    /**
+     * @brief Bulkhead bound to the first rule matching a path
+     * @return Executor name; empty when the path runs on the shared pool
+     */
+    const std::string& getExecutor(std::string_view path) const;
+
+    /**
+     * @brief Deadline of the first rule matching a path
+     * @return RouteMiddlewareConfig::timeout; 0 when the path has none
+     */
+    std::chrono::milliseconds getTimeout(std::string_view path) const;
+
+    /**
+     * @name Lookups by rule
+     * The path lookups above each call findRule(); a caller needing several
+     * of them for one request finds the rule once and passes it here.
+     * @param rule Result of findRule(), NO_RULE included
+     * @{
+     */
+    const std::shared_ptr<MiddlewarePipeline>& getRulePipeline(int rule) const;
+    const std::string& getRuleExecutor(int rule) const;
+    std::chrono::milliseconds getRuleTimeout(int rule) const;
+    /** @} */
+
+    /// Bulkheads declared by the configuration
+    const std::vector<BulkheadConfig>& getExecutors() const noexcept { return executors_; }
+
+    /**
+     * @brief Wrap a route handler in the configured middleware
+     *
+     * Literal route paths resolve their pipeline here, once. Routes with
+     * parameters or wildcards resolve it from the request path on each call,
+     * since rules may tell apart paths the route pattern does not.
+     *
+     * @param routePattern Path the handler is registered under
+     * @param handler Route handler
+     * @return Handler to register in place of @p handler; @p handler itself
+     *         when no middleware applies
+     */
+    std::shared_ptr<HttpHandler> wrap(const std::string& routePattern, std::shared_ptr<HttpHandler> handler) const;
+
+    /// Number of distinct pipelines, including the global-only one
+    size_t getPipelineCount() const noexcept { return pipelines_.size(); }
+
+    /// Number of middleware instances created by the factory so far
+    size_t getMiddlewareInstanceCount() const noexcept { return instanceCount_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Create the pipelines of every route stack not used yet
+     * @return Number of pipelines that were pending; 0 for eager tables
+     */
+    size_t warmUp() const;
+
+    /// Pipelines still waiting for their first use
+    size_t getPendingPipelineCount() const noexcept { return pendingPipelines_.load(std::memory_order_acquire); }
+
+private:
+    struct Rule {
+        std::string pattern;
+        bool isRegex = false;
+        std::string literalPrefix;      ///< Leading characters every match starts with (globs only)
+        std::regex regex;
+        size_t pipeline = 0;
+        std::string executor;           ///< RouteMiddlewareConfig::executor
+        std::chrono::milliseconds timeout{0}; ///< RouteMiddlewareConfig::timeout
+    };
+
+    /// Route stack instantiated on first use
+    struct LazyPipeline {
+        std::vector<MiddlewareInstanceConfig> stack;
+        std::once_flag built;
+    };
+
+    CompiledMiddlewareConfig() = default;
+
+    /// Pipeline index serving a path
+    size_t pipelineIndexFor(std::string_view path) const;
+    const std::shared_ptr<MiddlewarePipeline>& pipelineAt(size_t index) const;
+    bool isEmptyPipeline(size_t index) const;
+
+    /// Shared instance for a configuration; caller holds instancesMutex_
+    std::shared_ptr<Middleware> instantiate(const MiddlewareInstanceConfig& config) const;
+
+    /// Runs a pipeline in front of one route handler
+    class PipelineHandler;
+
+    std::vector<Rule> rules_;
+    std::vector<BulkheadConfig> executors_;
+    mutable std::vector<std::shared_ptr<MiddlewarePipeline>> pipelines_;   ///< [0] holds the global middleware only; lazy slots are set once
+    std::vector<std::unique_ptr<LazyPipeline>> lazyPipelines_;             ///< Parallel to pipelines_; null for pipelines built at compile time
+    MiddlewareFactory* factory_ = nullptr;
+    mutable std::mutex instancesMutex_;                                    ///< Guards instances_
+    mutable std::unordered_map<std::string, std::shared_ptr<Middleware>> instances_;  ///< Shared instances by configuration signature
+    mutable std::atomic<size_t> instanceCount_{0};
+    mutable std::atomic<size_t> pendingPipelines_{0};
+};
+
+} // namespace cppSwitchboard
@@ -71,6 +71,7 @@ struct Http1Config {
     bool enabled = true;                      ///< Enable HTTP/1.1 support
     int port = 8080;                         ///< HTTP/1.1 listening port
     std::string bindAddress = "0.0.0.0";    ///< IP address to bind to (0.0.0.0 for all interfaces)
+    std::string parser = "beast";           ///< Request parser engine: "beast" or "simd" (see Http1Parser)
 };
 
 /**
@@ -85,6 +86,30 @@ struct Http2Config {
     std::string bindAddress = "0.0.0.0";    ///< IP address to bind to (0.0.0.0 for all interfaces)
 };
 
+/**
+ * @brief Queue-delay admission control (CoDel)
+ * 
+ * Requests that waited in a worker queue longer than `target` for a whole
+ * `interval` put the queue into overload. While overloaded, requests that
+ * waited longer than `target` are answered with a fast 503 instead of
+ * running, and the queue serves the newest requests first. The queue
+ * leaves overload once every request for an interval started within
+ * `target`.
+ * 
+ * @code{.yaml}
+ * general:
+ *   admission:
+ *     enabled: true
+ *     target_ms: 5
+ *     interval_ms: 100
+ * @endcode
+ */
+struct AdmissionControlConfig {
+    bool enabled = false;                         ///< Shed requests on sustained queueing delay
+    std::chrono::milliseconds target{5};          ///< Acceptable queueing delay
+    std::chrono::milliseconds interval{100};      ///< How long the delay must stay above target
+};
+
 /**
  * @brief General server configuration settings
  * 
@@ -96,7 +121,8 @@ struct GeneralConfig {
     std::chrono::seconds requestTimeout{30};  ///< Request timeout in seconds
     bool enableLogging = true;                ///< Enable request/response logging
     std::string logLevel = "info";           ///< Log level: debug, info, warn, error
-    int workerThreads = 4;                   ///< Number of worker threads for request processing
+    int workerThreads = 4;                   ///< Handler worker threads; 0 ("auto") for one per hardware thread
+    AdmissionControlConfig admission;        ///< Queue-delay admission control
 };
 
 /**
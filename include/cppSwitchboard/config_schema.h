@@ -0,0 +1,126 @@
+/**
+ * @file config_schema.h
+ * @brief Typed schemas for middleware configuration
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ *
+ * A ConfigSchema lists the keys a middleware type reads from its `config`
+ * block, with the type of each, whether it is required and its limits.
+ * Built-in creators declare theirs in code. Plugins return a JSON Schema
+ * from MiddlewarePlugin::getConfigSchema(), which is converted once when
+ * the plugin is registered. MiddlewareConfigCompiler converts YAML values
+ * to the declared types while compiling. Creators therefore receive values
+ * whose std::any holds exactly the declared C++ type.
+ *
+ * | ConfigValueType | C++ type                   | JSON Schema type         |
+ * |-----------------|----------------------------|--------------------------|
+ * | STRING          | std::string                | string                   |
+ * | INTEGER         | int                        | integer                  |
+ * | NUMBER          | double                     | number                   |
+ * | BOOLEAN         | bool                       | boolean                  |
+ * | STRING_ARRAY    | std::vector<std::string>   | array of string          |
+ */
+
+#pragma once
+
+#include <any>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cppSwitchboard {
+
+/**
+ * @brief Type of a configuration value
+ */
+enum class ConfigValueType {
+    STRING,
+    INTEGER,
+    NUMBER,
+    BOOLEAN,
+    STRING_ARRAY
+};
+
+/**
+ * @brief One key of a middleware configuration
+ */
+struct ConfigField {
+    std::string name;
+    ConfigValueType type = ConfigValueType::STRING;
+    bool required = false;
+    std::any defaultValue;                   ///< Set when the key is absent; empty for none
+    std::optional<double> minimum;           ///< Lower bound of numbers
+    std::optional<double> maximum;           ///< Upper bound of numbers
+    std::vector<std::string> allowedValues;  ///< Accepted strings; empty for any
+};
+
+/**
+ * @class ConfigSchema
+ * @brief Keys and types accepted by a middleware type
+ *
+ * @code{.cpp}
+ * auto schema = std::make_shared<ConfigSchema>();
+ * schema->field("format", ConfigValueType::STRING).oneOf({"json", "combined"})
+ *        .field("max_age", ConfigValueType::INTEGER).range(0, 86400)
+ *        .field("jwt_secret", ConfigValueType::STRING).required();
+ * @endcode
+ *
+ * @since 1.2.0
+ */
+class ConfigSchema {
+public:
+    /// Add a key; the modifiers below apply to the key added last
+    ConfigSchema& field(std::string name, ConfigValueType type);
+    ConfigSchema& required();
+    ConfigSchema& defaultValue(std::any value);
+    ConfigSchema& range(double minimum, double maximum);
+    ConfigSchema& minimum(double minimum);
+    ConfigSchema& oneOf(std::vector<std::string> values);
+
+    /// Reject keys that are not declared (JSON Schema additionalProperties: false)
+    ConfigSchema& strict(bool strict = true);
+
+    const std::vector<ConfigField>& getFields() const { return fields_; }
+    const ConfigField* findField(const std::string& name) const;
+    bool isStrict() const { return strict_; }
+
+    /**
+     * @brief Check a value against its field's type and limits
+     * @param field Field of this schema
+     * @param value Value converted to the field's type
+     * @param errorMessage Reason on failure
+     */
+    static bool checkValue(const ConfigField& field, const std::any& value, std::string& errorMessage);
+
+    /**
+     * @brief Check a configuration built in code
+     * @param config Values by key
+     * @param errors Receives one message per problem
+     * @return bool True if there was no problem
+     */
+    bool validate(const std::unordered_map<std::string, std::any>& config, std::vector<std::string>& errors) const;
+
+    /**
+     * @brief Convert a JSON Schema object
+     *
+     * Understands properties with type, default, minimum, maximum and enum,
+     * required, and additionalProperties: false.
+     *
+     * @param jsonSchema Schema text
+     * @param errorMessage Reason on failure
+     * @return Schema, or nullptr if the text is not a usable schema
+     */
+    static std::shared_ptr<ConfigSchema> fromJsonSchema(const std::string& jsonSchema, std::string& errorMessage);
+
+    /// Name of a type in diagnostics, e.g. "integer"
+    static const char* typeName(ConfigValueType type);
+
+private:
+    std::vector<ConfigField> fields_;
+    bool strict_ = false;
+};
+
+} // namespace cppSwitchboard
@@ -47,6 +47,7 @@
 #include <chrono>
 #include <sstream>
 #include <iomanip>
+#include <string_view>
 
 namespace cppSwitchboard {
 
@@ -315,7 +316,7 @@ private:
      * @param payload The payload string to potentially truncate
      * @return Truncated payload string with indicator if truncated
      */
-    std::string truncatePayload(const std::string& payload) const;
+    std::string truncatePayload(std::string_view payload) const;
     
     /**
      * @brief Format URL information for log output
@@ -0,0 +1,131 @@
+/**
+ * @file file_watcher.h
+ * @brief Change notification for configuration files
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-26
+ * @version 1.2.0
+ *
+ * Configuration files are usually replaced rather than rewritten: editors
+ * and deployment tools write a temporary file and rename it over the old
+ * one. FileWatcher therefore watches the directories holding the files with
+ * inotify and filters events by file name, so a replaced file keeps being
+ * watched. A burst of events (write, close, rename) is folded into one
+ * notification once the directory has been quiet for the debounce period.
+ * Where inotify is unavailable the files' modification times are polled.
+ *
+ * A watcher can also cover whole directories, optionally restricted to some
+ * file extensions. It then reports the paths of files that were written or
+ * moved in, which lets plugin directories pick up new libraries.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cppSwitchboard {
+
+/**
+ * @class FileWatcher
+ * @brief Calls back on a background thread when any of a set of files changes
+ *
+ * @code{.cpp}
+ * FileWatcher watcher({"/etc/app/middleware.yaml"}, [] { reloadConfiguration(); });
+ * watcher.start();
+ * @endcode
+ *
+ * @since 1.2.0
+ */
+class FileWatcher {
+public:
+    using ChangeCallback = std::function<void()>;
+    using PathsCallback = std::function<void(const std::vector<std::string>& changedPaths)>;
+
+    /**
+     * @brief Create a watcher; nothing is watched until start()
+     * @param files Files to watch; they need not exist yet
+     * @param onChange Invoked on the watcher thread after changes settle
+     */
+    FileWatcher(std::vector<std::string> files, ChangeCallback onChange);
+
+    /**
+     * @brief Create a watcher for every matching file in some directories
+     *
+     * Subdirectories are not watched; list them explicitly.
+     *
+     * @param directories Directories to watch; they must exist at start()
+     * @param extensions File extensions to report (".so"); empty reports all files
+     * @param onChange Invoked on the watcher thread with the changed paths, sorted
+     */
+    FileWatcher(std::vector<std::string> directories, std::vector<std::string> extensions,
+                PathsCallback onChange);
+
+    /**
+     * @brief Stops the watcher thread
+     */
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /**
+     * @brief Start watching
+     * @param pollInterval Check interval used when inotify is unavailable
+     * @return false if already running or nothing to watch
+     */
+    bool start(std::chrono::milliseconds pollInterval = std::chrono::seconds(5));
+
+    /**
+     * @brief Stop watching and join the watcher thread
+     *
+     * Must not be called from the change callback.
+     */
+    void stop();
+
+    bool isRunning() const noexcept { return running_; }
+
+    /// True when changes are reported by inotify rather than by polling
+    bool isUsingInotify() const noexcept { return inotifyFd_ >= 0; }
+
+    /**
+     * @brief Quiet period that ends a burst of events (default 50 ms)
+     */
+    void setDebounce(std::chrono::milliseconds debounce) { debounce_ = debounce; }
+
+private:
+    /// Files watched in one directory; no names means any file with a matching extension
+    struct WatchedDirectory {
+        std::string path;
+        std::vector<std::string> names;
+    };
+
+    bool matches(const WatchedDirectory& directory, const std::string& name) const;
+    void runInotify();
+    void runPolling();
+    std::map<std::string, std::chrono::nanoseconds> modificationTimes() const;
+
+    std::vector<WatchedDirectory> directories_;
+    std::vector<std::string> extensions_;
+    PathsCallback onChange_;
+    std::chrono::milliseconds debounce_{50};
+    std::chrono::milliseconds pollInterval_{5000};
+
+    int inotifyFd_ = -1;
+    int wakePipe_[2] = {-1, -1};                                ///< Written by stop() to end poll()
+    std::unordered_map<int, size_t> watched_;                   ///< Watch descriptor to index in directories_
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::mutex stopMutex_;
+    std::condition_variable stopCondition_;
+};
+
+} // namespace cppSwitchboard
@@ -0,0 +1,148 @@
+/**
+ * @file http1_parser.h
+ * @brief In-place HTTP/1.1 request head parser
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-22
+ * @version 1.2.0
+ *
+ * Beast's parser copies every field of the request head into its own
+ * container before the server copies it again into HttpRequest. For the
+ * small requests that dominate API traffic that is most of the parsing cost.
+ * Http1Parser works in the style of picohttpparser instead: it scans the
+ * connection buffer with SSE4.2/AVX2 (selected at runtime, scalar fallback
+ * elsewhere) and returns string_views into that buffer, so parsing the
+ * request head performs no allocation at all.
+ *
+ * The engine is selected with `http1.parser: simd` in the server
+ * configuration; Beast remains the default.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace cppSwitchboard {
+
+/**
+ * @struct Http1Header
+ * @brief One header field as views into the parsed buffer
+ */
+struct Http1Header {
+    std::string_view name;   ///< Field name as received
+    std::string_view value;  ///< Field value without surrounding whitespace
+};
+
+/**
+ * @struct Http1RequestHead
+ * @brief Result of parsing a request line and header block
+ *
+ * All views point into the buffer handed to Http1Parser::parse() and are
+ * only valid while that buffer is unchanged.
+ */
+struct Http1RequestHead {
+    static constexpr std::size_t MAX_HEADERS = 64;   ///< Header fields accepted per request
+
+    std::string_view method;
+    std::string_view target;
+    unsigned version = 11;                           ///< 10 * major + minor, as in Beast
+
+    std::array<Http1Header, MAX_HEADERS> headers;
+    std::size_t headerCount = 0;
+
+    bool hasContentLength = false;
+    std::uint64_t contentLength = 0;
+    bool chunked = false;                            ///< Transfer-Encoding ends in "chunked"
+    bool keepAlive = true;                           ///< Derived from version and Connection
+
+    /**
+     * @brief Case-insensitive header lookup
+     * @return Value of the first matching field, empty when absent
+     */
+    std::string_view findHeader(std::string_view name) const noexcept;
+};
+
+/**
+ * @class Http1Parser
+ * @brief Stateless, allocation-free parser for HTTP/1.x request heads
+ *
+ * parse() may be called again with the same (grown) buffer after it
+ * returned NEED_MORE; the scan simply restarts, which is cheaper than
+ * keeping state for the small heads this parser is meant for.
+ *
+ * The grammar follows RFC 9112 as strictly as Beast does: lines end in
+ * CRLF, obsolete line folding is rejected, field names must be tokens and
+ * Content-Length and Transfer-Encoding are validated the same way.
+ *
+ * @code{.cpp}
+ * Http1RequestHead head;
+ * int consumed = Http1Parser::parse(data, size, head);
+ * if (consumed > 0) {
+ *     // head.method, head.target, head.headers[0..headerCount) are ready;
+ *     // the body starts at data + consumed
+ * }
+ * @endcode
+ *
+ * @since 1.2.0
+ */
+class Http1Parser {
+public:
+    static constexpr int BAD_REQUEST = -1;             ///< Malformed request head
+    static constexpr int NEED_MORE = -2;               ///< Head is not complete yet
+    static constexpr std::size_t HEADER_LIMIT = 8192;  ///< Largest accepted head (Beast's default)
+
+    /**
+     * @brief Parse a request line and header block
+     * @param data Start of the request
+     * @param length Bytes available
+     * @param head Receives the parsed request head
+     * @return Size of the head including the terminating empty line,
+     *         NEED_MORE or BAD_REQUEST
+     */
+    static int parse(const char* data, std::size_t length, Http1RequestHead& head) noexcept;
+
+    /**
+     * @brief Instruction set used for scanning ("avx2", "sse4.2" or "scalar")
+     */
+    static const char* simdLevel() noexcept;
+};
+
+/**
+ * @class Http1ChunkedDecoder
+ * @brief Incremental decoder for chunked transfer coding
+ *
+ * Chunk extensions are ignored and trailer fields are discarded.
+ *
+ * @code{.cpp}
+ * Http1ChunkedDecoder decoder;
+ * std::string body;
+ * long used = decoder.decode(data, size, body);   // call again with more data until isComplete()
+ * @endcode
+ */
+class Http1ChunkedDecoder {
+public:
+    /**
+     * @brief Consume encoded bytes and append the payload to @p body
+     * @param data Encoded input
+     * @param length Bytes available
+     * @param body Receives decoded payload
+     * @return Bytes consumed (input after the final chunk is left alone),
+     *         or -1 on malformed input
+     */
+    long decode(const char* data, std::size_t length, std::string& body);
+
+    bool isComplete() const noexcept { return state_ == State::DONE; }
+
+private:
+    enum class State { SIZE, EXTENSION, SIZE_LF, DATA, DATA_CR, DATA_LF, TRAILER, TRAILER_LF, DONE };
+
+    State state_ = State::SIZE;
+    std::uint64_t remaining_ = 0;
+    std::size_t sizeDigits_ = 0;
+    std::size_t trailerLineLength_ = 0;
+};
+
+} // namespace cppSwitchboard
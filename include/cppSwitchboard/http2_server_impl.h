@@ -52,9 +52,16 @@
 #include <boost/asio/ssl.hpp>
 #include <boost/beast/core.hpp>
 #include <cppSwitchboard/http_request.h>
+#include <cppSwitchboard/cancellation.h>
 #include <cppSwitchboard/http_response.h>
 #include <cppSwitchboard/config.h>
 #include <cppSwitchboard/debug_logger.h>
+#include <cppSwitchboard/request_arena.h>
+#include <cppSwitchboard/buffer_pool.h>
+#include <cppSwitchboard/session_memory_pool.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 
 namespace cppSwitchboard {
 
@@ -62,6 +69,41 @@ namespace asio = boost::asio;
 namespace ssl = asio::ssl;
 using tcp = asio::ip::tcp;
 
+/**
+ * @brief Hands HTTP/2 request processing to an asynchronous processor
+ * 
+ * Shared by an Http2Server and its sessions. The processor picks the pool
+ * a request runs on, after routing. The dispatch counts the requests whose
+ * response is still outstanding, so the server can wait for them before
+ * its io_context, which their responses are posted to, goes away.
+ */
+class Http2WorkDispatch : public std::enable_shared_from_this<Http2WorkDispatch> {
+public:
+    using Done = std::function<void(HttpResponse)>;
+    
+    /// Calls done exactly once, from any thread
+    using Processor = std::function<void(std::shared_ptr<const HttpRequest>, Done)>;
+    
+    explicit Http2WorkDispatch(Processor processor) : processor_(std::move(processor)) {}
+    
+    /**
+     * @brief Start processing a request
+     * @param done Receives the response; 500 if the processor threw before answering
+     */
+    void submit(std::shared_ptr<const HttpRequest> request, Done done);
+    
+    /// Wait until every submitted request has been answered
+    void drain();
+
+private:
+    void finished();
+    
+    Processor processor_;
+    std::mutex mutex_;
+    std::condition_variable idle_;
+    size_t inFlight_ = 0;
+};
+
 /**
  * @brief HTTP/2 session handler for individual client connections
  * 
@@ -108,6 +150,8 @@ public:
      * @param ssl_ctx SSL context for TLS encryption (must not be null)
      * @param request_processor Function to process HTTP requests
      * @param debugLogger Optional debug logger for detailed logging
+     * @param dispatch Processes requests off the I/O thread; nullptr to
+     *                 run request_processor on it
      * 
      * @throws std::runtime_error if nghttp2 session creation fails
      * 
@@ -122,7 +166,8 @@ public:
      */
     Http2Session(tcp::socket socket, ssl::context* ssl_ctx, 
                  std::function<HttpResponse(const HttpRequest&)> request_processor,
-                 std::shared_ptr<DebugLogger> debugLogger = nullptr);
+                 std::shared_ptr<DebugLogger> debugLogger = nullptr,
+                 std::shared_ptr<Http2WorkDispatch> dispatch = nullptr);
     
     /**
      * @brief Destructor - cleans up HTTP/2 session resources
@@ -164,8 +209,9 @@ private:
     /**
      * @brief Write HTTP/2 frames to the client
      * 
-     * Asynchronously writes buffered HTTP/2 frames to the SSL stream.
-     * This is triggered by nghttp2 when frames need to be sent.
+     * Collects all frames nghttp2 has queued and writes them with a single
+     * asynchronous write. Only one write is in flight at a time; frames
+     * queued meanwhile are sent from the completion handler.
      */
     void do_write();
     
@@ -180,12 +226,59 @@ private:
      */
     void send_response(int32_t stream_id, const HttpResponse& response);
     
+    /**
+     * @brief Build the request for a completed stream and dispatch it
+     * 
+     * Called once the client has closed its side of the stream (END_STREAM
+     * on HEADERS or on the last DATA frame).
+     * 
+     * @param stream_id HTTP/2 stream identifier
+     */
+    void process_request(int32_t stream_id);
+    
+    /**
+     * @brief Build the HttpRequest of a completed stream, moving its body
+     * @param resource Allocator of the request's fields
+     */
+    HttpRequest make_request(int32_t stream_id, std::pmr::memory_resource* resource);
+    
+    /**
+     * @brief Run the request processor
+     * @return Response, or 500 if the processor threw
+     */
+    HttpResponse respond(const HttpRequest& request);
+    
+    /**
+     * @brief Complete, log and send a response on the I/O thread
+     * 
+     * Sets a missing status and content type. Drops the response if the
+     * client reset the stream meanwhile.
+     */
+    void finish_request(int32_t stream_id, const HttpRequest& request, HttpResponse response);
+    
+    /**
+     * @brief Cancel the requests still waiting for a response
+     * 
+     * Called when the connection is gone; their handlers can stop.
+     */
+    void cancel_streams();
+    
+    /**
+     * @brief Queue frame bytes for the next write (copied)
+     */
+    void queue_bytes(const uint8_t* data, size_t length);
+    
+    /**
+     * @brief Queue a body slice for the next write (referenced, not copied)
+     */
+    void queue_body(BodyBuffer body);
+    
     // nghttp2 callback functions - these interface with the nghttp2 library
     /**
      * @brief nghttp2 callback for sending data
      * 
      * Called by nghttp2 when data needs to be sent to the client.
-     * Buffers the data for asynchronous transmission.
+     * Queues the frame bytes for the next asynchronous write.
      * 
      * @param session nghttp2 session handle
      * @param data Data to send
@@ -211,6 +304,20 @@ private:
     static int on_frame_recv_callback(nghttp2_session* session,
                                     const nghttp2_frame* frame, void* user_data);
     
+    /**
+     * @brief nghttp2 callback for frame transmission
+     * 
+     * Called once a frame has been serialized for the socket. Fires the
+     * response_written probe when the frame ends a response's stream.
+     * 
+     * @param session nghttp2 session handle
+     * @param frame Sent frame
+     * @param user_data Pointer to Http2Session instance
+     * @return 0 on success, negative on error
+     */
+    static int on_frame_send_callback(nghttp2_session* session,
+                                    const nghttp2_frame* frame, void* user_data);
+    
     /**
      * @brief nghttp2 callback for header field reception
      * 
@@ -251,7 +358,9 @@ private:
     /**
      * @brief nghttp2 callback for stream closure
      * 
-     * Called when an HTTP/2 stream is closed. Cleans up stream resources.
+     * Called when an HTTP/2 stream is closed. Cleans up stream resources
+     * and cancels the request if it was closed (RST_STREAM) before its
+     * response was ready.
      * 
      * @param session nghttp2 session handle
      * @param stream_id Stream identifier
@@ -265,7 +374,8 @@ private:
     /**
      * @brief nghttp2 callback for reading response data
      * 
-     * Called by nghttp2 to read response body data for transmission.
+     * Called by nghttp2 to schedule the next DATA frame. Only the length
+     * is decided here; the bytes are queued by send_data_callback.
      * 
      * @param session nghttp2 session handle
      * @param stream_id Stream identifier
@@ -279,12 +389,38 @@ private:
     static ssize_t data_source_read_callback(nghttp2_session* session, int32_t stream_id,
                                            uint8_t* buf, size_t length, uint32_t* data_flags,
                                            nghttp2_data_source* source, void* user_data);
+    
+    /**
+     * @brief nghttp2 callback for sending a DATA frame without copying
+     * 
+     * Called for DATA frames whose payload was scheduled with
+     * NGHTTP2_DATA_FLAG_NO_COPY. Queues the frame header and a slice of
+     * the shared response body.
+     * 
+     * @return 0 on success
+     */
+    static int send_data_callback(nghttp2_session* session, nghttp2_frame* frame,
+                                  const uint8_t* framehd, size_t length,
+                                  nghttp2_data_source* source, void* user_data);
+    
+    /**
+     * @brief nghttp2 callback for request body chunks
+     * 
+     * Appends DATA payload to the stream's request body.
+     * 
+     * @return 0 on success
+     */
+    static int on_data_chunk_recv_callback(nghttp2_session* session, uint8_t flags,
+                                           int32_t stream_id, const uint8_t* data,
+                                           size_t len, void* user_data);
 
     tcp::socket socket_;                                    ///< TCP socket for client connection
     std::unique_ptr<ssl::stream<tcp::socket&>> ssl_stream_; ///< SSL stream wrapper
+    SessionMemoryPool nghttp2_pool_;                        ///< Allocator for nghttp2 internals; freed after session_
     nghttp2_session* session_;                              ///< nghttp2 session handle
     std::function<HttpResponse(const HttpRequest&)> request_processor_; ///< Request processing function
     std::shared_ptr<DebugLogger> debugLogger_;              ///< Optional debug logger
+    std::shared_ptr<Http2WorkDispatch> dispatch_;           ///< Off-thread processing; null to process inline
     
     /**
      * @brief Stream-specific data storage
@@ -299,13 +435,34 @@ private:
         std::map<std::string, std::string> headers;    ///< Request headers
         std::string body;                              ///< Request body
         bool headers_complete = false;                 ///< Headers completion flag
+        bool processed = false;                        ///< Request handed to the processor
+        bool responded = false;                        ///< Response handed to nghttp2
+        std::shared_ptr<CancellationToken> cancellation; ///< Cancelled if the stream closes before the response
+        BodyBuffer response_body;                      ///< Shared response body being sent
+        size_t response_scheduled = 0;                 ///< Bytes handed to nghttp2 as DATA
+        size_t response_sent = 0;                      ///< Bytes queued for the socket
+        int response_status = 0;                       ///< Status of the submitted response, until its last frame is sent
+        size_t response_length = 0;                    ///< Content length of the submitted response
+    };
+    
+    /**
+     * @brief Piece of the pending write: either a range of write_buffer_ or a body slice
+     */
+    struct WriteSegment {
+        size_t offset;                                 ///< Start in write_buffer_ (when body is empty)
+        size_t length;                                 ///< Length in write_buffer_ (when body is empty)
+        BodyBuffer body;                               ///< Referenced body bytes
     };
     
     std::map<int32_t, StreamData> streams_;                              ///< Active streams data
     std::map<int32_t, std::vector<std::string>> header_strings_;        ///< Header string storage
     std::map<int32_t, std::vector<nghttp2_nv>> header_nvs_;             ///< nghttp2 header structures
-    std::vector<uint8_t> read_buffer_;                                  ///< Input buffer
-    std::vector<uint8_t> write_buffer_;                                 ///< Output buffer
+    RequestArena arena_;                                                ///< Request-scoped allocations
+    AdaptiveBuffer read_buffer_;                                        ///< Pooled input buffer
+    std::vector<uint8_t, PoolAllocator<uint8_t>> write_buffer_;         ///< Frame headers and control frames
+    std::vector<WriteSegment> write_segments_;                          ///< Write order of buffer ranges and bodies
+    std::vector<asio::const_buffer> write_sequence_;                    ///< Scatter list for the write in flight
+    bool writing_ = false;                                              ///< An async_write is in flight
 };
 
 /**
@@ -359,6 +516,9 @@ public:
      * @param ioc Boost.Asio I/O context for asynchronous operations
      * @param config Server configuration including HTTP/2 and SSL settings
      * @param request_processor Function to process incoming HTTP requests
+     * @param async_processor Processes requests off the I/O thread and
+     *                        calls back with the response; nullptr to run
+     *                        request_processor on the I/O thread
      * 
      * @throws std::runtime_error if SSL setup fails or port binding fails
      * 
@@ -368,7 +528,13 @@ public:
      * @endcode
      */
     Http2Server(asio::io_context& ioc, const ServerConfig& config,
-                std::function<HttpResponse(const HttpRequest&)> request_processor);
+                std::function<HttpResponse(const HttpRequest&)> request_processor,
+                Http2WorkDispatch::Processor async_processor = nullptr);
+    
+    /**
+     * @brief Waits for requests still being processed off the I/O thread
+     */
+    ~Http2Server();
     
     /**
      * @brief Start accepting HTTP/2 connections
@@ -391,6 +557,7 @@ public:
      * 
      * Gracefully stops the server by closing the acceptor and stopping
      * new connection acceptance. Existing connections are allowed to complete.
+     * Waits for requests running on the worker pool.
      * 
      * @note Existing sessions will continue until they complete naturally
      * 
@@ -425,6 +592,7 @@ private:
     std::function<HttpResponse(const HttpRequest&)> request_processor_; ///< Request processor function
     const ServerConfig& config_;                               ///< Server configuration reference
     std::shared_ptr<DebugLogger> debugLogger_;                 ///< Optional debug logger
+    std::shared_ptr<Http2WorkDispatch> dispatch_;              ///< Off-thread processing, if any
     bool running_;                                             ///< Server running state
 };
 
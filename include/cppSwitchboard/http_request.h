@@ -13,13 +13,24 @@
 
 #pragma once
 
+#include <cppSwitchboard/body_buffer.h>
+#include <cppSwitchboard/lazy_json.h>
+#include <nlohmann/json_fwd.hpp>
+#include <atomic>
+#include <chrono>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <map>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 #include <cstdint>
 
 namespace cppSwitchboard {
 
+class CancellationToken;
+
 /**
  * @enum HttpMethod
  * @brief HTTP request methods enumeration
@@ -100,6 +111,52 @@ public:
      * @endcode
      */
     HttpRequest(const std::string& method, const std::string& path, const std::string& protocol);
+    
+    /**
+     * @brief Constructor with request line components and a memory resource
+     * @param method HTTP method string (e.g., "GET", "POST")
+     * @param path Request path (e.g., "/api/users")
+     * @param protocol HTTP protocol version (e.g., "HTTP/1.1")
+     * @param resource Memory resource for headers and parameters
+     * 
+     * Headers, query parameters and path parameters are allocated from
+     * @p resource, typically a connection's RequestArena. The resource must
+     * outlive the request. Copies of the request use the default resource.
+     * 
+     * @code{.cpp}
+     * RequestArena arena;
+     * HttpRequest request("GET", "/api/users", "HTTP/1.1", arena.resource());
+     * @endcode
+     * 
+     * @see RequestArena
+     */
+    HttpRequest(const std::string& method, const std::string& path, const std::string& protocol,
+                std::pmr::memory_resource* resource);
+    
+    /**
+     * @brief Copy constructor
+     * 
+     * The copy owns its storage on the default memory resource, so it may
+     * safely outlive the arena of the request it was copied from.
+     */
+    HttpRequest(const HttpRequest& other) = default;
+    
+    /**
+     * @brief Allocator-extended copy constructor
+     * @param other Request to copy
+     * @param resource Memory resource for the copy's headers and parameters
+     */
+    HttpRequest(const HttpRequest& other, std::pmr::memory_resource* resource);
+    
+    HttpRequest(HttpRequest&& other) = default;
+    HttpRequest& operator=(const HttpRequest& other) = default;
+    HttpRequest& operator=(HttpRequest&& other) = default;
+    
+    /**
+     * @brief Memory resource backing headers and parameters
+     * @return The resource passed at construction, or the default resource
+     */
+    std::pmr::memory_resource* getMemoryResource() const { return headers_.get_allocator().resource(); }
 
     // Basic request information
     
@@ -110,7 +167,7 @@ public:
      * Returns the HTTP method as a string representation.
      * This is the original method string provided during construction.
      */
-    std::string getMethod() const { return method_; }
+    const std::string& getMethod() const { return method_; }
     
     /**
      * @brief Get the HTTP method as enum
@@ -135,7 +192,7 @@ public:
      * query parameters. For example, "/api/users/123" from
      * "/api/users/123?sort=name".
      */
-    std::string getPath() const { return path_; }
+    const std::string& getPath() const { return path_; }
     
     /**
      * @brief Get the HTTP protocol version
@@ -143,7 +200,7 @@ public:
      * 
      * Returns the HTTP protocol version used for this request.
      */
-    std::string getProtocol() const { return protocol_; }
+    const std::string& getProtocol() const { return protocol_; }
     
     // Headers
     
@@ -177,7 +234,32 @@ public:
      * }
      * @endcode
      */
-    std::map<std::string, std::string> getHeaders() const { return headers_; }
+    std::map<std::string, std::string> getHeaders() const;
+    
+    /**
+     * @brief Visit all headers without copying them
+     * @param visit Called as visit(std::string_view name, std::string_view value)
+     *              in name order; returning false stops the iteration
+     */
+    template <typename Visitor>
+    void forEachHeader(Visitor&& visit) const {
+        for (const auto& [name, value] : headers_) {
+            if (!visit(std::string_view(name), std::string_view(value))) {
+                return;
+            }
+        }
+    }
+    
+    /// Number of headers
+    size_t getHeaderCount() const noexcept { return headers_.size(); }
+    
+    /**
+     * @brief Look up a header without copying it
+     * @param name Header name, matched case-insensitively
+     * @param value Set to the value, valid until the header is changed
+     * @return True if the header is present
+     */
+    bool findHeader(std::string_view name, std::string_view& value) const;
     
     /**
      * @brief Set a header value
@@ -192,7 +274,7 @@ public:
      * request.setHeader("Content-Type", "application/json");
      * @endcode
      */
-    void setHeader(const std::string& name, const std::string& value);
+    void setHeader(std::string_view name, std::string_view value);
     
     // Body
     
@@ -200,11 +282,26 @@ public:
      * @brief Get the request body
      * @return Request body as string
      * 
-     * Returns the HTTP request body content as a string.
+     * Returns a copy of the HTTP request body content as a string.
      * For binary content, consider the raw bytes may not be
-     * properly represented as a string.
+     * properly represented as a string. Prefer getBodyView() when
+     * the body is only inspected.
      */
-    std::string getBody() const { return body_; }
+    std::string getBody() const { return body_.str(); }
+    
+    /**
+     * @brief Get a read-only view of the request body
+     * @return View valid until the body is next modified
+     */
+    std::string_view getBodyView() const noexcept { return body_.view(); }
+    
+    /**
+     * @brief Get the shared body buffer
+     * 
+     * Copies of the request (and anything that keeps the returned buffer)
+     * share the same bytes.
+     */
+    const BodyBuffer& getBodyBuffer() const noexcept { return body_; }
     
     /**
      * @brief Set the request body from string
@@ -217,7 +314,35 @@ public:
      * request.setBody("{\"name\": \"John\", \"age\": 30}");
      * @endcode
      */
-    void setBody(const std::string& body) { body_ = body; }
+    void setBody(const std::string& body) { resetBody(BodyBuffer::copyOf(body)); }
+    
+    /**
+     * @brief Set the request body, taking ownership of the string
+     * @param body Request body content; no bytes are copied
+     */
+    void setBody(std::string&& body) { resetBody(BodyBuffer(std::move(body))); }
+    
+    /**
+     * @brief Set the request body from a string view (copies the bytes)
+     */
+    void setBody(std::string_view body) { resetBody(BodyBuffer::copyOf(body)); }
+    
+    /**
+     * @brief Set the request body from a string literal (copies the bytes)
+     */
+    void setBody(const char* body) { setBody(std::string_view(body)); }
+    
+    /**
+     * @brief Set the request body from raw bytes (copies the bytes)
+     * @param data Pointer to the first byte
+     * @param size Number of bytes
+     */
+    void setBody(const void* data, size_t size) { resetBody(BodyBuffer::copyOf(data, size)); }
+    
+    /**
+     * @brief Set the request body to a shared buffer (no copy)
+     */
+    void setBody(BodyBuffer body) { resetBody(std::move(body)); }
     
     /**
      * @brief Set the request body from binary data
@@ -233,7 +358,50 @@ public:
      */
     void setBody(const std::vector<uint8_t>& body);
     
+    /**
+     * @brief Set the request body from binary data, taking ownership of the vector
+     */
+    void setBody(std::vector<uint8_t>&& body) { resetBody(BodyBuffer(std::move(body))); }
+    
+    /**
+     * @brief Get the body parsed as JSON
+     * @return Parsed document, cached until the body is next modified
+     * @throws nlohmann::json::parse_error if the body is not valid JSON
+     * 
+     * The body is parsed on the first call only; middleware and the handler
+     * can all call json() without parsing the same body again. Copies of
+     * the request share the parsed document.
+     * 
+     * @code{.cpp}
+     * const auto& doc = request.json();
+     * std::string name = doc.value("name", "");
+     * @endcode
+     * 
+     * @note Include <nlohmann/json.hpp> to use the returned value.
+     */
+    const nlohmann::json& json() const;
+    
+    /**
+     * @brief Get an on-demand view of the JSON body
+     * @return Tape index of the body, cached until the body is next modified
+     * 
+     * Cheaper than json() for large bodies of which only a few fields are
+     * read: the body is indexed once and values are converted when accessed.
+     * Check LazyJson::isValid() before use.
+     * 
+     * @code{.cpp}
+     * auto userId = request.lazyJson()["user"]["id"].getInt();
+     * @endcode
+     */
+    const LazyJson& lazyJson() const;
+    
     // Query parameters
+    //
+    // Query parameters are parsed on first access, not when the request is
+    // constructed. Names and values are percent-decoded ('+' is a space);
+    // a value is only copied for decoding when it actually contains escapes.
+    // Like json() and lazyJson(), the getters may be called from several
+    // threads sharing one const request.
     
     /**
      * @brief Get all query parameters
@@ -241,6 +409,8 @@ public:
      * 
      * Returns all query parameters parsed from the request URL.
      * Query parameters are the key-value pairs after the '?' in the URL.
+     * When a name is repeated the last value is returned; use
+     * getQueryParamValues() to see all of them.
      * 
      * @code{.cpp}
      * // For URL: /api/users?sort=name&limit=10
@@ -248,15 +418,16 @@ public:
      * // params["sort"] = "name", params["limit"] = "10"
      * @endcode
      */
-    std::map<std::string, std::string> getQueryParams() const { return queryParams_; }
+    std::map<std::string, std::string> getQueryParams() const;
     
     /**
      * @brief Get a specific query parameter value
      * @param name Parameter name
      * @return Parameter value string, empty if not found
      * 
-     * Retrieves the value of a specific query parameter.
-     * Returns empty string if the parameter is not present.
+     * Retrieves the decoded value of a specific query parameter.
+     * Returns empty string if the parameter is not present; if it is
+     * repeated, the last occurrence wins.
      * 
      * @code{.cpp}
      * std::string sortBy = request.getQueryParam("sort");
@@ -265,13 +436,33 @@ public:
      */
     std::string getQueryParam(const std::string& name) const;
     
+    /**
+     * @brief Get every value of a repeated query parameter
+     * @param name Parameter name
+     * @return Decoded values in the order they appear in the URL
+     * 
+     * @code{.cpp}
+     * // For URL: /api/items?tag=red&tag=blue
+     * auto tags = request.getQueryParamValues("tag"); // {"red", "blue"}
+     * @endcode
+     */
+    std::vector<std::string> getQueryParamValues(const std::string& name) const;
+    
+    /**
+     * @brief Check whether a query parameter is present
+     * @param name Parameter name
+     * @return true if the parameter appears at least once (even without a value)
+     */
+    bool hasQueryParam(const std::string& name) const;
+    
     /**
      * @brief Set a query parameter value
      * @param name Parameter name
      * @param value Parameter value
      * 
-     * Sets the value of a query parameter. This can be used to
-     * programmatically add or modify query parameters.
+     * Sets the value of a query parameter, replacing every existing
+     * occurrence. This can be used to programmatically add or modify
+     * query parameters. The value is stored as given (not decoded).
      * 
      * @code{.cpp}
      * request.setQueryParam("page", "2");
@@ -297,7 +488,7 @@ public:
      * // params["id"] = "123", params["postId"] = "456"
      * @endcode
      */
-    std::map<std::string, std::string> getPathParams() const { return pathParams_; }
+    std::map<std::string, std::string> getPathParams() const;
     
     /**
      * @brief Get a specific path parameter value
@@ -350,6 +541,43 @@ public:
      */
     void setStreamId(int streamId) { streamId_ = streamId; }
     
+    /**
+     * @brief When the request was fully parsed
+     * @return steady_clock time set by the protocol layer; the epoch if unset
+     * 
+     * The time a request then waits before its handler starts is its
+     * queueing delay, which QueueDelayController acts on.
+     */
+    std::chrono::steady_clock::time_point getReceivedAt() const { return receivedAt_; }
+    
+    /**
+     * @brief Set when the request was fully parsed
+     * @param receivedAt steady_clock time of parse completion
+     */
+    void setReceivedAt(std::chrono::steady_clock::time_point receivedAt) { receivedAt_ = receivedAt; }
+    
+    /**
+     * @brief Cancellation token of the request
+     * @return Token shared by every copy of the request; null outside a server
+     * 
+     * Cancelled when the client resets the stream or closes the connection,
+     * or when the request's deadline passes. Long-running handlers poll it
+     * or register a callback with CancellationToken::onCancel().
+     */
+    const std::shared_ptr<CancellationToken>& getCancellation() const { return cancellation_; }
+    
+    /**
+     * @brief Attach a cancellation token
+     * @param cancellation Token set by the protocol layer
+     */
+    void setCancellation(std::shared_ptr<CancellationToken> cancellation) { cancellation_ = std::move(cancellation); }
+    
+    /**
+     * @brief Whether the client is gone or the deadline has passed
+     * @return False for requests without a token
+     */
+    bool isCancelled() const;
+    
     // Content type helpers
     
     /**
@@ -390,10 +618,11 @@ public:
      * Convenience method to check if the request contains form data.
      * This checks for both URL-encoded and multipart form data.
      * 
+     * @see MultipartParser
      * @code{.cpp}
      * if (request.isFormData()) {
-     *     // Parse form data
-     *     auto formData = parseFormData(request.getBody());
+     *     // multipart/form-data bodies are split into parts by MultipartParser
+     *     auto parts = MultipartParser::parse(request);
      * }
      * @endcode
      */
@@ -405,8 +634,10 @@ public:
      * @brief Parse query string into parameters
      * @param queryString Query string to parse (without leading '?')
      * 
-     * Parses a query string and populates the internal query parameters map.
+     * Parses a query string and adds its parameters to the request.
      * The query string should not include the leading '?' character.
+     * Names and values are percent-decoded; a name without '=' gets an
+     * empty value.
      * 
      * @code{.cpp}
      * request.parseQueryString("sort=name&limit=10&active=true");
@@ -447,15 +678,106 @@ public:
     static std::string methodToString(HttpMethod method);
 
 private:
+    /// Header/parameter storage; allocates from the request's memory resource
+    using StringMap = std::pmr::map<std::pmr::string, std::pmr::string, std::less<>>;
+    
     std::string method_;                                    ///< HTTP method string
     HttpMethod httpMethod_ = HttpMethod::GET;              ///< HTTP method enum
     std::string path_;                                     ///< Request path
     std::string protocol_;                                 ///< HTTP protocol version
-    std::map<std::string, std::string> headers_;          ///< HTTP headers
-    std::string body_;                                     ///< Request body content
-    std::map<std::string, std::string> queryParams_;      ///< Query parameters
-    std::map<std::string, std::string> pathParams_;       ///< Path parameters from routing
+    StringMap headers_;                                    ///< HTTP headers
+    BodyBuffer body_;                                      ///< Request body content (shared between copies)
+    /**
+     * @brief One query parameter, stored as offsets into queryString_
+     * 
+     * Offsets rather than string_views keep entries valid when the request
+     * (and therefore its query string) is copied or moved.
+     */
+    struct QueryEntry {
+        size_t keyOffset;
+        size_t keyLength;
+        size_t valueOffset;
+        size_t valueLength;
+        bool keyEncoded;                                   ///< Key contains '%' or '+'
+        bool valueEncoded;                                 ///< Value contains '%' or '+'
+    };
+    
+    /**
+     * @brief Query entries, parsed by the first reader after each change
+     * 
+     * Const accessors of a request shared between threads may run at the
+     * same time, so parsing is done under a lock and published through the
+     * parsed length.
+     */
+    class QueryIndex {
+    public:
+        explicit QueryIndex(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : entries_(resource) {}
+        QueryIndex(const QueryIndex& other, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+        QueryIndex& operator=(const QueryIndex& other);
+        
+        /// Entries of @p query, parsing it on the first call
+        const std::pmr::vector<QueryEntry>& get(std::string_view query);
+        
+        /// Entries of @p query for a non-const caller to modify
+        std::pmr::vector<QueryEntry>& modify(std::string_view query);
+        
+        /// Add an entry the caller appended to the end of the query string
+        void add(const QueryEntry& entry, size_t queryLength);
+        
+    private:
+        std::pmr::vector<QueryEntry> entries_;
+        std::atomic<size_t> parsedUpTo_{0};                ///< Bytes of the query string already parsed
+        mutable std::mutex mutex_;
+    };
+    
+    /**
+     * @brief Value derived from the body by a const accessor
+     * 
+     * Read and published atomically, so concurrent readers of a shared
+     * request agree on one instance and copying the request is not a race.
+     */
+    template <typename T>
+    class SharedCache {
+    public:
+        SharedCache() = default;
+        SharedCache(const SharedCache& other) : value_(other.load()) {}
+        SharedCache& operator=(const SharedCache& other) {
+            std::atomic_store(&value_, other.load());
+            return *this;
+        }
+        
+        std::shared_ptr<const T> load() const { return std::atomic_load(&value_); }
+        
+        /// Keep @p value unless another reader published first; returns the one kept
+        std::shared_ptr<const T> publish(std::shared_ptr<const T> value) {
+            std::shared_ptr<const T> current;
+            return std::atomic_compare_exchange_strong(&value_, &current, value) ? value : current;
+        }
+        
+        void reset() { std::atomic_store(&value_, std::shared_ptr<const T>()); }
+        
+    private:
+        std::shared_ptr<const T> value_;
+    };
+    
+    std::pmr::string queryString_;                         ///< Raw query string (without '?')
+    mutable QueryIndex queryIndex_;                        ///< Parsed parameters, in URL order
+    StringMap pathParams_;                                 ///< Path parameters from routing
     int streamId_ = 0;                                     ///< HTTP/2 stream ID (0 for HTTP/1.1)
+    std::chrono::steady_clock::time_point receivedAt_{};   ///< Parse completion; epoch if unset
+    std::shared_ptr<CancellationToken> cancellation_;      ///< Shared with the protocol layer; null if unset
+    mutable SharedCache<nlohmann::json> jsonCache_;        ///< Body parsed by json()
+    mutable SharedCache<LazyJson> lazyJsonCache_;          ///< Body indexed by lazyJson()
+    
+    /**
+     * @brief Replace the body and drop anything derived from it
+     */
+    void resetBody(BodyBuffer body) {
+        body_ = std::move(body);
+        jsonCache_.reset();
+        lazyJsonCache_.reset();
+    }
     
     /**
      * @brief Update HttpMethod enum from method string
@@ -464,6 +786,21 @@ private:
      * the method string when the method is changed.
      */
     void updateHttpMethod();
+    
+    /**
+     * @brief Parsed query parameters, parsing queryString_ on first use
+     */
+    const std::pmr::vector<QueryEntry>& queryEntries() const { return queryIndex_.get(queryString_); }
+    
+    /**
+     * @brief Decoded key or value of a query entry
+     */
+    std::string decodeQueryPart(size_t offset, size_t length, bool encoded) const;
+    
+    /**
+     * @brief Whether a query entry's key equals @p name after decoding
+     */
+    bool queryKeyEquals(const QueryEntry& entry, std::string_view name) const;
 };
 
 } // namespace cppSwitchboard 
\ No newline at end of file
@@ -13,13 +13,20 @@
 
 #pragma once
 
+#include <cppSwitchboard/body_buffer.h>
+#include <cppSwitchboard/json_writer.h>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <map>
+#include <memory>
 #include <vector>
 #include <cstdint>
 
 namespace cppSwitchboard {
 
+class CannedResponse;
+
 /**
  * @class HttpResponse
  * @brief HTTP response representation and generation
@@ -104,7 +111,7 @@ public:
      * response.setStatus(500);
      * @endcode
      */
-    void setStatus(int status) { status_ = status; }
+    void setStatus(int status) { status_ = status; canned_.reset(); }
     
     // Headers
     
@@ -129,7 +136,8 @@ public:
      * @return Map of all header name-value pairs
      * 
      * Returns a copy of all HTTP headers as a map. Header names
-     * are stored in their original case.
+     * are stored in their original case. Content-Length is derived
+     * from the body and included when the body is not empty.
      * 
      * @code{.cpp}
      * auto headers = response.getHeaders();
@@ -138,7 +146,25 @@ public:
      * }
      * @endcode
      */
-    std::map<std::string, std::string> getHeaders() const { return headers_; }
+    std::map<std::string, std::string> getHeaders() const;
+    
+    /**
+     * @brief Get the headers as set, without derived fields
+     * @return Reference to the header map (no Content-Length unless set explicitly)
+     * 
+     * Used by the protocol serializers, which compute Content-Length once
+     * when the response is written.
+     */
+    const std::map<std::string, std::string>& getHeaderFields() const noexcept { return headers_; }
+    
+    /**
+     * @brief Get the pre-serialized form of this response
+     * @return Canned response this was created from, or nullptr once the
+     *         response has been modified (or was never canned)
+     * 
+     * @see CannedResponse
+     */
+    const std::shared_ptr<const CannedResponse>& getCanned() const noexcept { return canned_; }
     
     /**
      * @brief Set a header value
@@ -147,7 +173,7 @@ public:
      * 
      * Sets the value of an HTTP header. If the header already exists,
      * it will be replaced with the new value. Content-Length is
-     * automatically managed when the body is modified.
+     * derived from the body when the response is serialized.
      * 
      * @code{.cpp}
      * response.setHeader("Content-Type", "application/json");
@@ -208,11 +234,35 @@ public:
      * @brief Get the response body
      * @return Response body as string
      * 
-     * Returns the HTTP response body content as a string.
+     * Returns a copy of the HTTP response body content as a string.
      * For binary content, consider that raw bytes may not be
-     * properly represented as a string.
+     * properly represented as a string. Prefer getBodyView() when
+     * the body is only inspected.
      */
-    std::string getBody() const { return body_; }
+    std::string getBody() const { return body_.str(); }
+    
+    /**
+     * @brief Get a read-only view of the response body
+     * @return View valid until the body is next modified
+     */
+    std::string_view getBodyView() const noexcept { return body_.view(); }
+    
+    /**
+     * @brief Get the shared body buffer
+     * @return Buffer that can be copied cheaply and outlives the response
+     * 
+     * Transports and caches keep a copy of this buffer instead of copying
+     * the bytes.
+     */
+    const BodyBuffer& getBodyBuffer() const noexcept { return body_; }
+    
+    /**
+     * @brief Move the body out of the response
+     * @return Body content; the response body is left empty
+     * 
+     * No bytes are copied when the response is the only owner of the body.
+     */
+    std::string takeBody();
     
     /**
      * @brief Set the response body from string
@@ -230,6 +280,45 @@ public:
      */
     void setBody(const std::string& body);
     
+    /**
+     * @brief Set the response body, taking ownership of the string
+     * @param body Response body content; no bytes are copied
+     * 
+     * @code{.cpp}
+     * std::string page = renderTemplate(data);
+     * response.setBody(std::move(page));
+     * @endcode
+     */
+    void setBody(std::string&& body);
+    
+    /**
+     * @brief Set the response body from a string view (copies the bytes)
+     */
+    void setBody(std::string_view body);
+    
+    /**
+     * @brief Set the response body from a string literal (copies the bytes)
+     */
+    void setBody(const char* body) { setBody(std::string_view(body)); }
+    
+    /**
+     * @brief Set the response body from raw bytes (copies the bytes)
+     * @param data Pointer to the first byte
+     * @param size Number of bytes
+     */
+    void setBody(const void* data, size_t size);
+    
+    /**
+     * @brief Set the response body to a shared buffer
+     * @param body Buffer shared with the caller; no bytes are copied
+     * 
+     * @code{.cpp}
+     * static const BodyBuffer banner = BodyBuffer::fromStatic("Service ready");
+     * response.setBody(banner);
+     * @endcode
+     */
+    void setBody(BodyBuffer body);
+    
     /**
      * @brief Set the response body from binary data
      * @param body Response body as vector of bytes
@@ -246,6 +335,11 @@ public:
      */
     void setBody(const std::vector<uint8_t>& body);
     
+    /**
+     * @brief Set the response body from binary data, taking ownership of the vector
+     */
+    void setBody(std::vector<uint8_t>&& body);
+    
     /**
      * @brief Append data to the response body
      * @param data Data to append to the body
@@ -253,6 +347,7 @@ public:
      * Appends the specified data to the existing response body.
      * This automatically updates the Content-Length header.
      * Useful for streaming responses or building responses incrementally.
+     * The body is only copied first if it is shared with another owner.
      * 
      * @code{.cpp}
      * response.setBody("Initial content\\n");
@@ -260,7 +355,7 @@ public:
      * response.appendBody("Additional line 2\\n");
      * @endcode
      */
-    void appendBody(const std::string& data);
+    void appendBody(std::string_view data);
     
     // Content length (automatically calculated)
     
@@ -277,7 +372,7 @@ public:
      * size_t length = response.getContentLength(); // Returns 13
      * @endcode
      */
-    size_t getContentLength() const { return body_.length(); }
+    size_t getContentLength() const { return body_.size(); }
     
     // Convenience methods for common responses
     
@@ -296,7 +391,7 @@ public:
      * auto response3 = HttpResponse::ok(); // Empty OK response
      * @endcode
      */
-    static HttpResponse ok(const std::string& body = "", const std::string& contentType = "text/plain");
+    static HttpResponse ok(std::string body = "", const std::string& contentType = "text/plain");
     
     /**
      * @brief Create a JSON response
@@ -311,7 +406,30 @@ public:
      * auto errorResponse = HttpResponse::json("{\"error\": \"Invalid input\"}");
      * @endcode
      */
-    static HttpResponse json(const std::string& jsonBody);
+    static HttpResponse json(std::string jsonBody);
+    
+    /**
+     * @brief Create a JSON response produced by a JsonWriter
+     * @param writerFn Callback that writes the document
+     * @return HttpResponse with status 200 and application/json content type
+     * 
+     * The document is serialized straight into the response body in one
+     * pass, without building an intermediate DOM.
+     * 
+     * @code{.cpp}
+     * auto response = HttpResponse::json([&](JsonWriter& out) {
+     *     out.beginObject().member("status", "success").member("id", 123).endObject();
+     * });
+     * @endcode
+     */
+    static HttpResponse json(const std::function<void(JsonWriter&)>& writerFn);
+    
+    /**
+     * @brief Create a JSON response produced by a JsonWriter
+     * @param writerFn Callback that writes the document
+     * @param sizeHint Expected body size in bytes, reserved before writing
+     */
+    static HttpResponse json(const std::function<void(JsonWriter&)>& writerFn, size_t sizeHint);
     
     /**
      * @brief Create an HTML response
@@ -326,7 +444,7 @@ public:
      * auto response = HttpResponse::html(html);
      * @endcode
      */
-    static HttpResponse html(const std::string& htmlBody);
+    static HttpResponse html(std::string htmlBody);
     
     /**
      * @brief Create a Not Found (404) response
@@ -392,6 +510,43 @@ public:
      */
     static HttpResponse methodNotAllowed(const std::string& message = "Method Not Allowed");
     
+    /**
+     * @brief Create a Payload Too Large (413) response
+     * @param message Error message (default: "Payload Too Large")
+     * @return HttpResponse with status 413
+     * 
+     * Answer for requests whose body exceeds the server's limit; servers
+     * serve the canned form from CannedResponseRegistry::error().
+     */
+    static HttpResponse payloadTooLarge(const std::string& message = "Payload Too Large");
+    
+    /**
+     * @brief Create a Service Unavailable (503) response
+     * @param message Error message (default: "Service Unavailable")
+     * @param retryAfterSeconds Retry-After value sent to the client
+     * @return HttpResponse with status 503
+     * 
+     * Answer for requests shed under overload; servers serve the canned
+     * form from CannedResponseRegistry::error().
+     * 
+     * @code{.cpp}
+     * auto response = HttpResponse::serviceUnavailable("Maintenance", 60);
+     * @endcode
+     */
+    static HttpResponse serviceUnavailable(const std::string& message = "Service Unavailable",
+                                           int64_t retryAfterSeconds = 1);
+    
+    /**
+     * @brief Create a Gateway Timeout (504) response
+     * @param message Error message (default: "Gateway Timeout")
+     * @return HttpResponse with status 504
+     * 
+     * Answer for requests whose handler did not respond before their
+     * deadline; servers serve the canned form from
+     * CannedResponseRegistry::error().
+     */
+    static HttpResponse gatewayTimeout(const std::string& message = "Gateway Timeout");
+    
     // Status code helpers
     
     /**
@@ -484,6 +639,9 @@ public:
     /** @brief HTTP 405 Method Not Allowed - Request method not supported for resource */
     static constexpr int METHOD_NOT_ALLOWED = 405;
     
+    /** @brief HTTP 413 Payload Too Large - Request body exceeds what the server accepts */
+    static constexpr int PAYLOAD_TOO_LARGE = 413;
+    
     /** @brief HTTP 500 Internal Server Error - Generic server error message */
     static constexpr int INTERNAL_SERVER_ERROR = 500;
     
@@ -492,20 +650,25 @@ public:
     
     /** @brief HTTP 503 Service Unavailable - Server is currently unavailable */
     static constexpr int SERVICE_UNAVAILABLE = 503;
+    
+    /** @brief HTTP 504 Gateway Timeout - Request deadline passed before a response was ready */
+    static constexpr int GATEWAY_TIMEOUT = 504;
 
 private:
+    friend class CannedResponse;
+    
     int status_ = 200;                                     ///< HTTP status code
     std::map<std::string, std::string> headers_;          ///< HTTP headers
-    std::string body_;                                     ///< Response body content
+    BodyBuffer body_;                                      ///< Response body content (shared, immutable)
+    std::shared_ptr<const CannedResponse> canned_;         ///< Pre-serialized form, while unmodified
     
     /**
-     * @brief Update Content-Length header based on body size
+     * @brief Drop state derived from the body
      * 
-     * Internal method to automatically update the Content-Length header
-     * when the response body is modified. This ensures the header
-     * always reflects the actual body size.
+     * Removes an explicitly set Content-Length (the serializers derive it
+     * from the body) and detaches the response from its canned form.
      */
-    void updateContentLength();
+    void bodyChanged();
 };
 
 } // namespace cppSwitchboard 
\ No newline at end of file
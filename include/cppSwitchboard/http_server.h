@@ -16,12 +16,18 @@
 #include <cppSwitchboard/http_request.h>
 #include <cppSwitchboard/http_response.h>
 #include <cppSwitchboard/route_registry.h>
+#include <cppSwitchboard/canned_response.h>
+#include <cppSwitchboard/virtual_host.h>
+#include <cppSwitchboard/middleware_reloader.h>
 #include <cppSwitchboard/config.h>
 #include <cppSwitchboard/middleware.h>
+#include <cppSwitchboard/worker_pool.h>
+#include <cppSwitchboard/bulkhead.h>
 #include <memory>
 #include <thread>
 #include <atomic>
 #include <chrono>
+#include <optional>
 
 namespace cppSwitchboard {
 
@@ -154,6 +160,29 @@ public:
      */
     void registerRouteWithMiddleware(const std::string& path, HttpMethod method, std::shared_ptr<MiddlewarePipeline> pipeline);
     
+    /**
+     * @brief Register a route that always returns the same response
+     * @param path URL path pattern
+     * @param method HTTP method
+     * @param response Response to send; serialized once, at registration
+     * 
+     * Suited to health checks, fixed redirects and similar constant
+     * endpoints: HTTP/1.1 connections write the prepared bytes directly.
+     * 
+     * @code{.cpp}
+     * server->registerCannedResponse("/health", HttpMethod::GET, HttpResponse::json("{\"status\":\"ok\"}"));
+     * @endcode
+     * 
+     * @see CannedResponse
+     */
+    void registerCannedResponse(const std::string& path, HttpMethod method, HttpResponse response);
+    
+    /**
+     * @brief Get the canned responses of this server
+     * @return Registry with the standard error responses and this server's Server value
+     */
+    const CannedResponseRegistry& getCannedResponses() const { return *cannedResponses_; }
+    
     // Convenience methods for common HTTP methods
     
     /**
@@ -247,8 +276,9 @@ public:
      * @param middleware Shared pointer to Middleware implementation
      * @throws std::invalid_argument if middleware is null
      * 
-     * Registers middleware that will be executed for all requests in the order
-     * they were registered. Middleware can modify requests/responses, implement
+     * Registers middleware that will be executed for all requests served by the
+     * default host, in priority order (registration order among equal
+     * priorities). Middleware can modify requests/responses, implement
      * authentication, logging, CORS, etc.
      * 
      * @code{.cpp}
@@ -260,6 +290,58 @@ public:
      */
     void registerMiddleware(std::shared_ptr<Middleware> middleware);
     
+    /**
+     * @brief Apply a YAML middleware configuration to every request
+     * @param filename Path to the middleware configuration file
+     * @return Result of loading, validating and compiling the file
+     * 
+     * The global and route middleware of the file run around route dispatch,
+     * inside middleware registered with registerMiddleware(). When the file
+     * enables hot_reload with reload_on_change, edits are picked up while the
+     * server runs: a new generation is built off the request path and swapped
+     * in atomically, and requests already running finish on the old one.
+     * Call during setup, before start(). Route middleware are instantiated
+     * in the background once the server is listening, or by the first
+     * request that needs them, whichever comes first.
+     * 
+     * @code{.cpp}
+     * auto result = server->loadMiddlewareConfig("/etc/app/middleware.yaml");
+     * if (!result.isSuccess()) {
+     *     throw std::runtime_error(result.message);
+     * }
+     * @endcode
+     * 
+     * @see MiddlewareReloader
+     */
+    MiddlewareConfigResult loadMiddlewareConfig(const std::string& filename);
+    
+    /**
+     * @brief Reloader of the configuration loaded by loadMiddlewareConfig()
+     * @return Reloader for stats and manual reloads, or nullptr
+     */
+    std::shared_ptr<MiddlewareReloader> getMiddlewareReloader() const { return middlewareReloader_; }
+    
+    // Virtual hosts
+    
+    /**
+     * @brief Route table for a host name, created on first use
+     * @param hostPattern Exact host ("api.example.com") or wildcard ("*.example.com")
+     * @return Host to register routes and middleware on
+     * @throws std::invalid_argument if the pattern is malformed
+     * 
+     * Requests are matched on the Host header (HTTP/1.1) or :authority
+     * (HTTP/2) before path routing. Requests for hosts without a table are
+     * served by the routes and middleware registered on the server itself.
+     * 
+     * @code{.cpp}
+     * server->virtualHost("api.example.com")->get("/status", statusHandler);
+     * server->virtualHost("*.tenants.example.com")->registerMiddleware(tenantResolver);
+     * @endcode
+     * 
+     * @see VirtualHost
+     */
+    std::shared_ptr<VirtualHost> virtualHost(const std::string& hostPattern);
+    
     // Error handler
     
     /**
@@ -335,6 +417,61 @@ public:
      */
     bool isRunning() const { return running_; }
     
+    /**
+     * @brief Time from start() until the first response was produced
+     * @return Duration, or std::nullopt until a request has been served
+     * 
+     * Includes instantiating the middleware the first request needed. Also
+     * logged once when logging is enabled.
+     */
+    std::optional<std::chrono::microseconds> getTimeToFirstRequest() const;
+    
+    /**
+     * @brief Pool that runs handler work
+     * @return Pool, or nullptr before the first start()
+     * 
+     * Sized by GeneralConfig::workerThreads. HTTP/2 requests and
+     * asynchronous handlers run on it; handlers can queue continuations
+     * with submit(). Its per-worker counters show queue depth and steals.
+     * 
+     * @code{.cpp}
+     * void handleAsync(const HttpRequest& request, ResponseCallback callback) override {
+     *     WorkerPool::current()->submit([callback]() { callback(HttpResponse::ok("done")); });
+     * }
+     * @endcode
+     */
+    std::shared_ptr<WorkerPool> getWorkerPool() const { return workerPool_; }
+    
+    /**
+     * @brief Executor pool declared under middleware.executors
+     * @param name Executor name
+     * @return Bulkhead, or nullptr if the loaded configuration has none by that name
+     * 
+     * Routes bound to an executor run on its threads instead of the shared
+     * pool; its counters show how many requests it queued, rejected or
+     * handed back. The executors follow reloads of the configuration.
+     * 
+     * @code{.yaml}
+     * middleware:
+     *   executors:
+     *     reports: {threads: 2, max_queue: 8, overflow: reject}
+     *   routes:
+     *     "/reports*":
+     *       executor: reports
+     *       middleware: []
+     * @endcode
+     */
+    std::shared_ptr<Bulkhead> getBulkhead(const std::string& name) const { return bulkheads_->find(name); }
+    
+    /**
+     * @brief Queue-delay controller state of the shared worker pool
+     * @return Overload state, shed and admitted counts and observed delays
+     * 
+     * Configured by GeneralConfig::admission. Each bulkhead has its own,
+     * see Bulkhead::getQueueDelay().
+     */
+    QueueDelayController::Stats getQueueDelayStats() const { return queueDelay_->getStats(); }
+    
     // Configuration
     
     /**
@@ -355,11 +492,13 @@ public:
      * @throws std::runtime_error if server is currently running
      * 
      * Updates the server configuration. The server must be stopped
-     * before changing configuration.
+     * before changing configuration. The standard canned responses are
+     * rebuilt with the new Server value; routes registered with
+     * registerCannedResponse() keep the value they were created with.
      * 
      * @see ServerConfig
      */
-    void setConfig(const ServerConfig& config) { config_ = config; }
+    void setConfig(const ServerConfig& config);
     
     // SSL/TLS support
     
@@ -403,28 +542,54 @@ protected:
      * Protected constructor to prevent direct instantiation.
      * Use create() static methods instead.
      */
-    HttpServer() = default;
+    HttpServer();
     
     /**
      * @brief Constructor with configuration for derived classes
      * @param config Server configuration object
      * 
-     * Protected constructor with configuration for derived classes.
+     * Protected constructor with configuration for derived classes. Both
+     * constructors leave the server ready to route: empty route tables,
+     * the default error handler and canned responses for config.application.
      */
-    HttpServer(const ServerConfig& config) : config_(config) {}
+    HttpServer(const ServerConfig& config);
 
 protected:
     ServerConfig config_;                                      ///< Server configuration
     std::unique_ptr<RouteRegistry> routes_;                   ///< Route registry for URL matching
     std::vector<std::shared_ptr<Middleware>> middleware_;     ///< Registered middleware chain
     std::shared_ptr<ErrorHandler> errorHandler_;             ///< Custom error handler
+    std::shared_ptr<CannedResponseRegistry> cannedResponses_; ///< Pre-serialized standard responses
+    std::unique_ptr<VirtualHostRouter> virtualHosts_;        ///< Per-host route tables
+    std::shared_ptr<MiddlewareReloader> middlewareReloader_; ///< YAML middleware configuration, if loaded
     
     std::atomic<bool> running_{false};                       ///< Server running state
     std::thread http1Thread_;                                ///< HTTP/1.1 server thread
     std::thread http2Thread_;                                ///< HTTP/2 server thread
+    std::thread warmUpThread_;                               ///< Instantiates deferred middleware after start()
+    std::atomic<int64_t> startedAtNs_{0};                    ///< steady_clock time of start(), 0 before
+    std::atomic<int64_t> timeToFirstRequestUs_{-1};          ///< -1 until the first response
+    std::shared_ptr<QueueDelayController> queueDelay_ = std::make_shared<QueueDelayController>(); ///< Admission control of workerPool_
+    std::shared_ptr<WorkerPool> workerPool_;                 ///< Handler workers; joined on destruction, after the bulkheads
+    std::shared_ptr<BulkheadRegistry> bulkheads_ = std::make_shared<BulkheadRegistry>(); ///< Per-route executors; destroyed first
     
     // Internal request processing
     
+    /**
+     * @brief YAML configuration generation and its rule for one request
+     * 
+     * Found once per request, so the rule scan does not repeat for the
+     * pipeline, executor and timeout, and all three come from the same
+     * generation even if a reload lands meanwhile.
+     */
+    struct ConfiguredRoute {
+        std::shared_ptr<const CompiledMiddlewareConfig> config;   ///< Null without loadMiddlewareConfig()
+        int rule = CompiledMiddlewareConfig::NO_RULE;             ///< config->findRule() of the request path
+    };
+    
+    /// Current configuration and the rule matching the request's path
+    ConfiguredRoute resolveConfiguredRoute(const HttpRequest& request) const;
+    
     /**
      * @brief Process an HTTP request through the middleware chain
      * @param request HTTP request to process
@@ -436,6 +601,56 @@ protected:
      */
     HttpResponse processRequest(const HttpRequest& request);
     
+    /**
+     * @brief Process a request whose configured route was already resolved
+     * @param route resolveConfiguredRoute() of @p request
+     */
+    HttpResponse processRequest(const HttpRequest& request, const ConfiguredRoute& route);
+    
+    /**
+     * @brief Process a request on the connection's thread, or on its route's bulkhead
+     * @param request HTTP request to process
+     * @return Response; the canned 503 if the bulkhead refused the request
+     * 
+     * Waits while a bulkhead runs the request. A DEGRADED admission runs it
+     * on the calling thread.
+     */
+    HttpResponse executeRequest(const HttpRequest& request);
+    
+    /**
+     * @brief Process a request on its route's bulkhead, or on the shared pool
+     * @param request HTTP request to process
+     * @param done Called exactly once with the response, from any thread
+     * 
+     * The route is looked up on the calling I/O thread; the handler never
+     * runs there unless no pool accepts it.
+     */
+    void scheduleRequest(std::shared_ptr<const HttpRequest> request, std::function<void(HttpResponse)> done);
+    
+    /**
+     * @brief Process a request that waited in a worker queue
+     * @param request HTTP request to process
+     * @param queueDelay Controller of the queue it waited in
+     * @param route resolveConfiguredRoute() of @p request
+     * @return Response, or the canned 503 if it was shed
+     */
+    HttpResponse runQueuedRequest(const HttpRequest& request, QueueDelayController& queueDelay,
+                                  const ConfiguredRoute& route);
+    
+    /**
+     * @brief Bring a request's deadline forward to its route's configured timeout
+     * 
+     * The timeout counts from HttpRequest::getReceivedAt(). Requests without
+     * a cancellation token are left alone.
+     */
+    void applyRouteDeadline(const HttpRequest& request, const ConfiguredRoute& route) const;
+    
+    /**
+     * @brief Bulkhead bound to a request's route by the middleware configuration
+     * @return Bulkhead, or nullptr for the shared pool
+     */
+    std::shared_ptr<Bulkhead> findBulkhead(const ConfiguredRoute& route) const;
+    
     /**
      * @brief Process an HTTP request asynchronously
      * @param request HTTP request to process
@@ -445,6 +660,33 @@ protected:
      */
     void processAsyncRequest(const HttpRequest& request, std::function<void(const HttpResponse&)> callback);
     
+    /**
+     * @brief Dispatch a request to a route of one route table
+     * @param routes Route table of the host serving the request
+     * @param request HTTP request to dispatch
+     * @return Handler response, or the unmatched-route response
+     */
+    HttpResponse routeRequest(const RouteRegistry& routes, const HttpRequest& request);
+    
+    /**
+     * @brief Run an asynchronous handler on the worker pool and wait for its response
+     * @param handler Matched handler
+     * @param request Request with path parameters set
+     * @return Response passed to the callback, or 503 if none arrived
+     *         within GeneralConfig::requestTimeout
+     * @throws Whatever handleAsync() threw
+     */
+    HttpResponse runAsyncHandler(const std::shared_ptr<AsyncHttpHandler>& handler, const HttpRequest& request);
+    
+    /**
+     * @brief Response for a request no route accepted
+     * @param request Unmatched request
+     * @param match Result of the route lookup
+     * @return 404 when the path is unknown, 204 with Allow for OPTIONS,
+     *         otherwise 405 with Allow
+     */
+    HttpResponse unmatchedResponse(const HttpRequest& request, const RouteMatch& match) const;
+    
     // Protocol-specific server implementations
     
     /**
@@ -0,0 +1,135 @@
+/**
+ * @file json_writer.h
+ * @brief Streaming JSON serializer that writes straight into a body string
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-23
+ * @version 1.2.0
+ *
+ * Building an nlohmann::json object only to dump() it allocates a node per
+ * value and then copies everything again into the output string. JsonWriter
+ * skips the DOM: values are appended to a single pre-reserved string as they
+ * are produced, strings are escaped with a vectorized scan for the bytes
+ * that need it, and the finished string is moved into the response body.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace cppSwitchboard {
+
+/**
+ * @class JsonWriter
+ * @brief Zero-DOM JSON writer
+ *
+ * Commas and member separators are inserted automatically; the caller only
+ * opens and closes containers and emits keys and values in order. Keys and
+ * string values are escaped as required by RFC 8259 (bytes outside ASCII are
+ * passed through unchanged, so they must already be UTF-8).
+ *
+ * @code{.cpp}
+ * return HttpResponse::json([&](JsonWriter& out) {
+ *     out.beginObject();
+ *     out.member("count", items.size());
+ *     out.key("items").beginArray();
+ *     for (const auto& item : items) {
+ *         out.beginObject().member("id", item.id).member("name", item.name).endObject();
+ *     }
+ *     out.endArray();
+ *     out.endObject();
+ * }, items.size() * 48);
+ * @endcode
+ *
+ * @note The writer does not check that the calls form a well-nested
+ *       document; mismatched begin/end calls produce invalid JSON.
+ * @since 1.2.0
+ */
+class JsonWriter {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 256;   ///< Bytes reserved when no estimate is given
+
+    /// Separator layout
+    enum class Spacing {
+        COMPACT,   ///< {"a":1,"b":2}
+        SPACED     ///< {"a": 1, "b": 2}
+    };
+
+    /**
+     * @brief Create a writer
+     * @param expectedSize Estimated output size in bytes, reserved up front
+     * @param spacing Separator layout
+     */
+    explicit JsonWriter(std::size_t expectedSize = DEFAULT_CAPACITY, Spacing spacing = Spacing::COMPACT);
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+
+    /**
+     * @brief Emit an object member name; the next call writes its value
+     */
+    JsonWriter& key(std::string_view name);
+
+    JsonWriter& value(std::string_view text);
+    JsonWriter& value(const char* text) { return value(std::string_view(text)); }
+    JsonWriter& value(const std::string& text) { return value(std::string_view(text)); }
+    JsonWriter& value(bool flag);
+    JsonWriter& value(double number);   ///< Non-finite numbers are written as null
+
+    template <typename T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, int>::type = 0>
+    JsonWriter& value(T number) {
+        if constexpr (std::is_signed<T>::value) {
+            return writeInteger(static_cast<int64_t>(number));
+        } else {
+            return writeUnsigned(static_cast<uint64_t>(number));
+        }
+    }
+
+    JsonWriter& nullValue();
+
+    /**
+     * @brief Emit already serialized JSON as a value (not validated)
+     */
+    JsonWriter& rawValue(std::string_view json);
+
+    /**
+     * @brief Shorthand for key(name).value(v)
+     */
+    template <typename T>
+    JsonWriter& member(std::string_view name, const T& v) {
+        key(name);
+        return value(v);
+    }
+
+    /// Output produced so far
+    std::string_view view() const noexcept { return out_; }
+    std::size_t size() const noexcept { return out_.size(); }
+
+    /**
+     * @brief Take the output, leaving the writer empty
+     */
+    std::string take();
+
+    /**
+     * @brief Append @p text to @p out as a quoted, escaped JSON string
+     */
+    static void appendString(std::string& out, std::string_view text);
+
+private:
+    void separate();
+    JsonWriter& writeInteger(int64_t number);
+    JsonWriter& writeUnsigned(uint64_t number);
+
+    std::string out_;
+    std::vector<bool> hasElements_;   ///< Per open container: a value was written
+    bool afterKey_ = false;
+    Spacing spacing_;
+};
+
+} // namespace cppSwitchboard
@@ -0,0 +1,162 @@
+/**
+ * @file lazy_json.h
+ * @brief On-demand access to fields of a JSON document
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-23
+ * @version 1.2.0
+ *
+ * Building a full DOM for a large request body costs an allocation per
+ * value, even when the handler only reads a handful of fields. LazyJson
+ * makes a single pass over the text and records the structure on a flat
+ * tape (one entry per value with its byte range and the index of the next
+ * sibling), in the spirit of simdjson. Navigating the tape skips whole
+ * subtrees, and only the values that are actually read are converted.
+ */
+
+#pragma once
+
+#include <cppSwitchboard/body_buffer.h>
+#include <nlohmann/json_fwd.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cppSwitchboard {
+
+class LazyJson;
+
+/**
+ * @class JsonCursor
+ * @brief Position of one value inside a LazyJson document
+ *
+ * Cursors are cheap to copy and stay valid as long as the document they
+ * came from. Looking up a missing member or an out-of-range element yields
+ * a cursor for which exists() is false; every accessor on such a cursor
+ * returns an empty result, so lookups can be chained safely.
+ *
+ * @code{.cpp}
+ * const LazyJson& body = request.lazyJson();
+ * auto id = body["user"]["id"].getInt();          // std::optional<int64_t>
+ * auto tags = body["tags"].materialize();         // nlohmann::json of this subtree only
+ * @endcode
+ */
+class JsonCursor {
+public:
+    enum class Type : uint8_t { INVALID, NULL_VALUE, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+    JsonCursor() = default;
+
+    bool exists() const noexcept { return doc_ != nullptr; }
+    explicit operator bool() const noexcept { return exists(); }
+
+    Type type() const noexcept;
+    bool isObject() const noexcept { return type() == Type::OBJECT; }
+    bool isArray() const noexcept { return type() == Type::ARRAY; }
+    bool isString() const noexcept { return type() == Type::STRING; }
+    bool isNumber() const noexcept { return type() == Type::NUMBER; }
+    bool isBool() const noexcept { return type() == Type::BOOLEAN; }
+    bool isNull() const noexcept { return type() == Type::NULL_VALUE; }
+
+    /**
+     * @brief Member of an object (first occurrence of @p key)
+     */
+    JsonCursor operator[](std::string_view key) const;
+
+    /**
+     * @brief Element of an array
+     */
+    JsonCursor operator[](std::size_t index) const;
+
+    /**
+     * @brief Number of members or elements (0 for scalars)
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Member names of an object, in document order
+     */
+    std::vector<std::string> keys() const;
+
+    /**
+     * @brief Exact source text of the value
+     */
+    std::string_view raw() const noexcept;
+
+    std::optional<std::string> getString() const;
+    std::optional<int64_t> getInt() const;
+    std::optional<double> getDouble() const;
+    std::optional<bool> getBool() const;
+
+    /**
+     * @brief Build a DOM for this value and its children only
+     * @return Parsed value, or a discarded value when the cursor does not exist
+     */
+    nlohmann::json materialize() const;
+
+private:
+    friend class LazyJson;
+    JsonCursor(const LazyJson* doc, uint32_t index) noexcept : doc_(doc), index_(index) {}
+
+    const LazyJson* doc_ = nullptr;
+    uint32_t index_ = 0;
+};
+
+/**
+ * @class LazyJson
+ * @brief Tape index over a JSON text with on-demand value conversion
+ *
+ * The constructor validates the document structure (brackets, separators,
+ * string and literal tokens). Number formats, escape sequences and UTF-8
+ * are checked when a value is read or materialized.
+ *
+ * @note A LazyJson is immutable after construction and may be shared
+ *       between threads.
+ * @since 1.2.0
+ */
+class LazyJson {
+public:
+    static constexpr std::size_t MAX_DEPTH = 1024;   ///< Deepest accepted nesting
+
+    /**
+     * @brief Index a JSON document
+     * @param text Document; the buffer is shared, not copied
+     */
+    explicit LazyJson(BodyBuffer text);
+
+    bool isValid() const noexcept { return error_.empty(); }
+    const std::string& getError() const noexcept { return error_; }
+
+    /**
+     * @brief Top-level value, non-existent when the document is invalid
+     */
+    JsonCursor root() const noexcept;
+
+    JsonCursor operator[](std::string_view key) const { return root()[key]; }
+    JsonCursor operator[](std::size_t index) const { return root()[index]; }
+
+    /// Number of entries on the tape (values and member names)
+    std::size_t getTapeSize() const noexcept { return tape_.size(); }
+
+private:
+    friend class JsonCursor;
+
+    struct TapeEntry {
+        uint32_t start;        ///< Offset of the first byte of the value
+        uint32_t length;       ///< Length of the value's source text
+        uint32_t next;         ///< Tape index following this value's subtree
+        JsonCursor::Type type;
+        bool escaped;          ///< String contains escape sequences
+    };
+
+    bool build();
+    bool fail(std::string message, std::size_t offset);
+
+    BodyBuffer text_;
+    std::vector<TapeEntry> tape_;
+    std::string error_;
+};
+
+} // namespace cppSwitchboard
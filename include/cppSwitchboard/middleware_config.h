@@ -67,9 +67,6 @@ namespace cppSwitchboard {
 class Middleware;
 class MiddlewarePipeline;
 
-// YAML parsing node structure (defined in implementation)
-struct YamlNode;
-
 /**
  * @brief Individual middleware configuration
  * 
@@ -165,6 +162,8 @@ struct RouteMiddlewareConfig {
     std::string pattern;                                      ///< Route pattern (glob or regex)
     bool isRegex = false;                                     ///< Whether pattern is a regular expression
     std::vector<MiddlewareInstanceConfig> middlewares;        ///< Middleware stack for this route
+    std::string executor;                                     ///< Bulkhead running the route's requests; empty for the shared pool
+    std::chrono::milliseconds timeout{0};                     ///< Deadline of the route's requests; 0 for none
     
     /**
      * @brief Validate this route middleware configuration
@@ -211,6 +210,57 @@ struct GlobalMiddlewareConfig {
     bool validate(std::string& errorMessage) const;
 };
 
+/**
+ * @brief What a bulkhead does with a request when its queue is full
+ */
+enum class BulkheadOverflow {
+    REJECT,   ///< Answer 503 with Retry-After
+    QUEUE,    ///< Wait up to queueTimeout for a queue slot, then 503
+    DEGRADE   ///< Run the request on the shared worker pool instead
+};
+
+/**
+ * @brief Named executor pool isolating the routes bound to it
+ * 
+ * Requests of a route group with `executor: <name>` run on the bulkhead's
+ * own threads, so a backlog there cannot hold up other routes.
+ * 
+ * @code{.yaml}
+ * middleware:
+ *   executors:
+ *     reports:
+ *       threads: 2
+ *       max_queue: 8
+ *       overflow: reject      # reject, queue or degrade
+ *   routes:
+ *     "/reports*":
+ *       executor: reports
+ *       middleware:
+ *         - name: auth
+ * @endcode
+ */
+struct BulkheadConfig {
+    std::string name;                                         ///< Referenced by RouteMiddlewareConfig::executor
+    int threads = 1;                                          ///< Worker threads of the bulkhead
+    int maxQueue = 64;                                        ///< Requests waiting for a thread before overflow applies
+    BulkheadOverflow overflow = BulkheadOverflow::REJECT;     ///< Policy when the queue is full
+    std::chrono::milliseconds queueTimeout{1000};             ///< Longest wait for a queue slot (QUEUE)
+    
+    /**
+     * @brief Validate the bulkhead configuration
+     * 
+     * @param errorMessage Output parameter for validation error details
+     * @return bool True if configuration is valid
+     */
+    bool validate(std::string& errorMessage) const;
+    
+    /**
+     * @brief Parse "reject", "queue" or "degrade"
+     * @return bool False for any other text
+     */
+    static bool parseOverflow(const std::string& text, BulkheadOverflow& overflow);
+};
+
 /**
  * @brief Hot-reload configuration settings
  * 
@@ -263,6 +313,7 @@ struct HotReloadConfig {
 struct ComprehensiveMiddlewareConfig {
     GlobalMiddlewareConfig global;                            ///< Global middleware configuration
     std::vector<RouteMiddlewareConfig> routes;                ///< Route-specific middleware configurations
+    std::vector<BulkheadConfig> executors;                    ///< Bulkheads routes can be bound to
     HotReloadConfig hotReload;                               ///< Hot-reload settings
     
     /**
@@ -301,6 +352,17 @@ struct ComprehensiveMiddlewareConfig {
      * @return bool True if middleware is configured somewhere
      */
     bool hasMiddleware(const std::string& middlewareName) const;
+    
+    /**
+     * @brief Merge another configuration on top of this one
+     * 
+     * Global middleware is appended, routes and executors with the same
+     * pattern or name are replaced, and an enabled hot-reload section takes
+     * precedence.
+     * 
+     * @param overlay Configuration to overlay on top
+     */
+    void merge(const ComprehensiveMiddlewareConfig& overlay);
 };
 
 /**
@@ -450,64 +512,12 @@ private:
     mutable std::mutex configMutex_;                         ///< Thread safety for configuration access
     
     /**
-     * @brief Parse YAML node into middleware instance configuration
-     * 
-     * @param yamlNode YAML node containing middleware configuration
-     * @param config Output middleware instance configuration
-     * @return MiddlewareConfigResult Parse result
-     */
-    MiddlewareConfigResult parseMiddlewareInstance(const YamlNode& yamlNode, MiddlewareInstanceConfig& config);
-    
-    /**
-     * @brief Parse global middleware configuration from YAML
-     * 
-     * @param yamlNode YAML node containing global middleware
-     * @param config Output global middleware configuration
-     * @return MiddlewareConfigResult Parse result
-     */
-    MiddlewareConfigResult parseGlobalMiddleware(const YamlNode& yamlNode, GlobalMiddlewareConfig& config);
-    
-    /**
-     * @brief Parse route middleware configuration from YAML
-     * 
-     * @param yamlNode YAML node containing route middleware
-     * @param routes Output route middleware configurations
-     * @return MiddlewareConfigResult Parse result
-     */
-    MiddlewareConfigResult parseRouteMiddleware(const YamlNode& yamlNode, std::vector<RouteMiddlewareConfig>& routes);
-    
-    /**
-     * @brief Parse hot-reload configuration from YAML
-     * 
-     * @param yamlNode YAML node containing hot-reload settings
-     * @param config Output hot-reload configuration
-     * @return MiddlewareConfigResult Parse result
-     */
-    MiddlewareConfigResult parseHotReloadConfig(const YamlNode& yamlNode, HotReloadConfig& config);
-    
-    /**
-     * @brief Parse YAML configuration node into std::any map
-     * 
-     * @param node YAML node to parse
-     * @param config Output configuration map
-     */
-    void parseConfigNode(const YamlNode& node, std::unordered_map<std::string, std::any>& config);
-    
-    /**
-     * @brief Substitute environment variables in configuration values
-     * 
-     * @param value Configuration value that may contain ${VAR} patterns
-     * @return std::string Value with environment variables substituted
-     */
-    std::string substituteEnvironmentVariables(const std::string& value) const;
-    
-    /**
-     * @brief Merge two middleware configurations
-     * 
-     * @param base Base configuration to merge into
-     * @param overlay Configuration to overlay on top
+     * @brief Parse, validate and store a YAML configuration
+     * @param yamlContent YAML configuration content
+     * @param sourceFile File the content was read from, empty for strings
+     * @return MiddlewareConfigResult Operation result
      */
-    void mergeConfigurations(ComprehensiveMiddlewareConfig& base, const ComprehensiveMiddlewareConfig& overlay);
+    MiddlewareConfigResult loadFromContent(const std::string& yamlContent, const std::string& sourceFile);
 };
 
 // Forward declarations for middleware factory - full definitions in middleware_factory.h
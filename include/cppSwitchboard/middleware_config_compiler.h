@@ -0,0 +1,121 @@
+/**
+ * @file middleware_config_compiler.h
+ * @brief YAML middleware configuration compiler with schema validation
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ *
+ * MiddlewareConfigCompiler turns middleware YAML into a
+ * ComprehensiveMiddlewareConfig in one pass over a yaml-cpp document.
+ * Given a factory, it also checks every middleware name against the
+ * registered creators and every `config` block against the creator's
+ * ConfigSchema. Values are converted to the declared types. The compiler
+ * does not stop at the first problem. It reports every error as a
+ * ConfigDiagnostic with its line and column.
+ *
+ * compileFile() caches its results by file. A file is compiled again only
+ * when its content or the factory's set of creators has changed. Reloading
+ * several files where one changed therefore parses only that one.
+ */
+
+#pragma once
+
+#include <cppSwitchboard/middleware_config.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cppSwitchboard {
+
+class MiddlewareFactory;
+
+/**
+ * @brief One problem found while compiling a configuration
+ */
+struct ConfigDiagnostic {
+    MiddlewareConfigError error = MiddlewareConfigError::INVALID_YAML;
+    std::string source;   ///< File name, empty for strings
+    int line = 0;         ///< 1-based; 0 if the problem has no position
+    int column = 0;       ///< 1-based
+    std::string path;     ///< Position in the document, e.g. "middleware.global[1].config.max_age"
+    std::string message;
+
+    /// "file:line:column: path: message"
+    std::string toString() const;
+};
+
+/**
+ * @class MiddlewareConfigCompiler
+ * @brief Parses, type-checks and caches middleware configuration
+ *
+ * @code{.cpp}
+ * MiddlewareConfigCompiler compiler(&MiddlewareFactory::getInstance());
+ * std::vector<ConfigDiagnostic> diagnostics;
+ * auto config = compiler.compileFile("/etc/app/middleware.yaml", diagnostics);
+ * if (!config) {
+ *     for (const auto& diagnostic : diagnostics) {
+ *         std::cerr << diagnostic.toString() << std::endl;
+ *     }
+ * }
+ * @endcode
+ *
+ * @since 1.2.0
+ */
+class MiddlewareConfigCompiler {
+public:
+    /**
+     * @param factory Factory whose creators and schemas are checked; nullptr
+     *                to check only the structure of the document
+     */
+    explicit MiddlewareConfigCompiler(MiddlewareFactory* factory = nullptr);
+
+    /**
+     * @brief Compile YAML text
+     * @param yamlContent YAML document
+     * @param sourceFile File the text came from, added to the hot-reload watch list; empty for strings
+     * @param diagnostics Receives every problem found
+     * @return Configuration, or nullptr if there was an error
+     */
+    std::shared_ptr<const ComprehensiveMiddlewareConfig> compile(const std::string& yamlContent,
+                                                                 const std::string& sourceFile,
+                                                                 std::vector<ConfigDiagnostic>& diagnostics) const;
+
+    /**
+     * @brief Compile a file, reusing the previous result if neither the file
+     *        nor the factory's creators have changed
+     */
+    std::shared_ptr<const ComprehensiveMiddlewareConfig> compileFile(const std::string& filename,
+                                                                     std::vector<ConfigDiagnostic>& diagnostics);
+
+    /// Replace ${VAR} in string values with the environment (default: on)
+    void setEnvironmentSubstitution(bool enabled) { environmentSubstitution_ = enabled; }
+
+    void clearCache();
+
+    /// Compilations answered from the cache by compileFile()
+    uint64_t getCacheHits() const;
+
+    /**
+     * @brief Summarize diagnostics as a result
+     * @return Success if empty, otherwise the first error's code with all messages
+     */
+    static MiddlewareConfigResult toResult(const std::vector<ConfigDiagnostic>& diagnostics);
+
+private:
+    struct CacheEntry {
+        size_t contentHash = 0;
+        uint64_t factoryGeneration = 0;
+        std::shared_ptr<const ComprehensiveMiddlewareConfig> config;
+    };
+
+    MiddlewareFactory* factory_;
+    bool environmentSubstitution_ = true;
+    mutable std::mutex cacheMutex_;
+    std::map<std::string, CacheEntry> cache_;
+    uint64_t cacheHits_ = 0;
+};
+
+} // namespace cppSwitchboard
@@ -11,14 +11,17 @@
  */
 #pragma once
 
+#include <functional>
+#include <map>
 #include <string>
 #include <vector>
 #include <memory>
 #include <unordered_map>
 #include <mutex>
 #include <atomic>
-#include <thread>
 #include <cppSwitchboard/plugin_manager.h>
+#include <cppSwitchboard/plugin_accounting.h>
+#include <cppSwitchboard/config_schema.h>
 
 namespace cppSwitchboard {
 
@@ -26,6 +29,9 @@ namespace cppSwitchboard {
 class Middleware;
 class MiddlewarePipeline;
 struct MiddlewareInstanceConfig;
+struct ComprehensiveMiddlewareConfig;
+class CompiledMiddlewareConfig;
+class FileWatcher;
 
 /**
  * @brief Middleware factory interface for configuration-driven instantiation
@@ -60,6 +66,16 @@ public:
      * @return bool True if configuration is valid for this middleware
      */
     virtual bool validateConfig(const MiddlewareInstanceConfig& config, std::string& errorMessage) const = 0;
+    
+    /**
+     * @brief Keys and types of the `config` block
+     * 
+     * MiddlewareConfigCompiler converts values to these types and reports
+     * keys that do not match, before create() is called.
+     * 
+     * @return Schema, or nullptr to accept any keys
+     */
+    virtual std::shared_ptr<const ConfigSchema> getConfigSchema() const { return nullptr; }
 };
 
 /**
@@ -121,6 +137,20 @@ public:
      */
     std::shared_ptr<MiddlewarePipeline> createPipeline(const std::vector<MiddlewareInstanceConfig>& middlewares);
     
+    /**
+     * @brief Create the pipelines of a complete configuration, once
+     * 
+     * Every distinct middleware configuration is instantiated a single time
+     * and every distinct middleware stack becomes one shared pipeline.
+     * 
+     * @param config Global and route middleware configuration
+     * @param errorMessage Output parameter for compilation errors
+     * @return std::shared_ptr<const CompiledMiddlewareConfig> Route-to-pipeline table or nullptr if failed
+     * @see CompiledMiddlewareConfig
+     */
+    std::shared_ptr<const CompiledMiddlewareConfig> createPipelines(const ComprehensiveMiddlewareConfig& config,
+                                                                    std::string& errorMessage);
+    
     /**
      * @brief Get list of registered middleware names
      * 
@@ -145,6 +175,22 @@ public:
      */
     bool validateMiddlewareConfig(const MiddlewareInstanceConfig& config, std::string& errorMessage) const;
     
+    /**
+     * @brief Configuration schema of a middleware type
+     * 
+     * @param middlewareName Name of middleware
+     * @return Schema, or nullptr if the type is unknown or declares none
+     */
+    std::shared_ptr<const ConfigSchema> getConfigSchema(const std::string& middlewareName) const;
+    
+    /**
+     * @brief Counter bumped whenever a creator is registered, replaced or removed
+     * 
+     * Configuration compiled against one generation stays valid while the
+     * generation is unchanged.
+     */
+    uint64_t getCreatorGeneration() const { return creatorGeneration_.load(std::memory_order_acquire); }
+    
     /**
      * @brief Load plugins from directory and register their creators
      * 
@@ -164,11 +210,15 @@ public:
     /**
      * @brief Enable hot-reload for plugins
      * 
-     * When enabled, the factory will periodically check for plugin changes
-     * and reload them automatically.
+     * When enabled, the plugin directories are watched with inotify. Plugins
+     * loaded through the factory are reloaded when their file is rewritten
+     * or replaced, and new plugin files are loaded, once the directory has
+     * been quiet for a few milliseconds. Nothing runs while no file changes.
+     * Plugins loaded while enabled are hot-reloadable.
      * 
      * @param enabled Whether to enable hot-reload
-     * @param intervalSeconds Check interval in seconds (default: 30)
+     * @param intervalSeconds Poll interval in seconds when inotify is unavailable
+     *                        and plugin health check interval (default: 30)
      */
     void setPluginHotReloadEnabled(bool enabled, int intervalSeconds = 30);
     
@@ -178,6 +228,50 @@ public:
      * @return std::vector<std::string> List of loaded plugin names
      */
     std::vector<std::string> getLoadedPlugins() const;
+    
+    using PluginReloadListener = std::function<void(const std::vector<std::string>& pluginNames)>;
+    
+    /**
+     * @brief Be told when hot-reload has loaded new plugin generations
+     * 
+     * Called on the watcher thread after the plugins' creators have been
+     * replaced, e.g. to rebuild pipelines so they bind to the new code.
+     * 
+     * @param listener Receives the names of the reloaded or newly loaded plugins
+     * @return size_t Id for removePluginReloadListener()
+     */
+    size_t addPluginReloadListener(PluginReloadListener listener);
+    
+    /**
+     * @brief Remove a listener; once this returns it is no longer running or called
+     */
+    void removePluginReloadListener(size_t listenerId);
+    
+    /**
+     * @brief Set the latency and error budget of a plugin
+     * 
+     * Applies to middleware already created from the plugin as well. May be
+     * set before the plugin is loaded.
+     * 
+     * @param pluginName Name of the plugin
+     * @param budget Budget; the default budget never trips
+     */
+    void setPluginBudget(const std::string& pluginName, const PluginBudget& budget);
+    
+    /**
+     * @brief Resources used by a plugin's middleware and its circuit state
+     * 
+     * Kept across hot reloads of the plugin.
+     * 
+     * @param pluginName Name of the plugin
+     * @return PluginUsage Usage, all zero for plugins that never ran
+     */
+    PluginUsage getPluginUsage(const std::string& pluginName) const;
+    
+    /**
+     * @brief Usage of every plugin with an account, by plugin name
+     */
+    std::map<std::string, PluginUsage> getPluginUsage() const;
 
 private:
     MiddlewareFactory() = default;
@@ -191,6 +285,7 @@ private:
     
     std::unordered_map<std::string, std::unique_ptr<MiddlewareCreator>> creators_;  ///< Registered middleware creators
     mutable std::mutex creatorsMutex_;                                             ///< Thread safety for creator access
+    std::atomic<uint64_t> creatorGeneration_{0};                                   ///< Bumped on every change to creators_
     
     /**
      * @brief Initialize built-in middleware creators
@@ -207,36 +302,62 @@ private:
      */
     class PluginMiddlewareCreator : public MiddlewareCreator {
     public:
-        PluginMiddlewareCreator(std::shared_ptr<MiddlewarePlugin> plugin, const std::string& middlewareType);
+        PluginMiddlewareCreator(std::shared_ptr<MiddlewarePlugin> plugin, const std::string& middlewareType,
+                                std::shared_ptr<PluginAccount> account);
         
         std::shared_ptr<Middleware> create(const MiddlewareInstanceConfig& config) override;
         std::string getMiddlewareName() const override;
         bool validateConfig(const MiddlewareInstanceConfig& config, std::string& errorMessage) const override;
+        std::shared_ptr<const ConfigSchema> getConfigSchema() const override { return schema_; }
         
     private:
+        /// Members are destroyed in reverse order: the middleware before its plugin
+        struct PluginMiddlewareHolder {
+            std::shared_ptr<MiddlewarePlugin> plugin;
+            std::shared_ptr<Middleware> middleware;
+        };
+        
         std::shared_ptr<MiddlewarePlugin> plugin_;
         std::string middlewareType_;
+        std::shared_ptr<PluginAccount> account_;
+        std::shared_ptr<const ConfigSchema> schema_;  ///< Converted from the plugin's JSON Schema
     };
     
     // Plugin management
     std::unordered_map<std::string, std::string> pluginCreators_;  ///< Maps creator name to plugin name
-    std::unique_ptr<std::thread> hotReloadThread_;                 ///< Hot-reload monitoring thread
+    std::map<std::string, std::shared_ptr<PluginAccount>> pluginAccounts_; ///< Accounts by plugin name; guarded by creatorsMutex_
+    std::unique_ptr<FileWatcher> pluginWatcher_;                   ///< Watches plugin directories while hot-reload is enabled
+    std::mutex pluginWatcherMutex_;                                ///< Guards pluginWatcher_
     std::atomic<bool> hotReloadEnabled_{false};                   ///< Whether hot-reload is enabled  
-    std::atomic<int> hotReloadInterval_{30};                      ///< Hot-reload check interval
-    std::atomic<bool> shutdownRequested_{false};                  ///< Shutdown flag for hot-reload thread
+    std::atomic<int> hotReloadInterval_{30};                      ///< Poll interval without inotify
+    std::map<size_t, PluginReloadListener> pluginReloadListeners_; ///< Listeners by id
+    size_t nextPluginReloadListenerId_ = 1;                        ///< Id of the next listener
+    std::mutex pluginReloadListenersMutex_;                        ///< Held while listeners run
+    
+    /**
+     * @brief (Re)start the plugin watcher on the current plugin directories
+     */
+    void startPluginWatcher();
+    
+    void stopPluginWatcher();
     
     /**
-     * @brief Hot-reload monitoring thread function
+     * @brief Reload changed plugins and re-register their creators; runs on the watcher thread
      */
-    void hotReloadLoop();
+    void onPluginFilesChanged(const std::vector<std::string>& changedPaths);
     
     /**
-     * @brief Register creators from a plugin
+     * @brief Register creators from a plugin, replacing those of an earlier load
      * 
      * @param plugin Plugin to register creators from
      * @param pluginName Name of the plugin
      */
     void registerPluginCreators(std::shared_ptr<MiddlewarePlugin> plugin, const std::string& pluginName);
+    
+    /**
+     * @brief Account of a plugin, created on first use; caller holds creatorsMutex_
+     */
+    std::shared_ptr<PluginAccount> pluginAccount(const std::string& pluginName);
 };
 
 } // namespace cppSwitchboard 
\ No newline at end of file
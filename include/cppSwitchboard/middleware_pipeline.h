@@ -44,6 +44,9 @@
 
 namespace cppSwitchboard {
 
+class CAbiMiddleware;
+class PluginAccount;
+
 /**
  * @brief Exception thrown when pipeline execution fails
  * 
@@ -215,6 +218,26 @@ public:
      */
     HttpResponse execute(const HttpRequest& request, Context& context);
     
+    /**
+     * @brief Execute the middleware with a caller-supplied final handler
+     * 
+     * Lets one pipeline instance serve many routes: the middleware are
+     * shared and each route passes its own handler. The pipeline's own
+     * final handler, if any, is not used.
+     * 
+     * @param request The HTTP request to process
+     * @param context Request context
+     * @param finalHandler Handler invoked after the last middleware
+     * @return HttpResponse The final response after pipeline execution
+     * @throws PipelineException if execution fails
+     * 
+     * @code{.cpp}
+     * Context context;
+     * HttpResponse response = sharedPipeline->execute(request, context, *usersHandler);
+     * @endcode
+     */
+    HttpResponse execute(const HttpRequest& request, Context& context, HttpHandler& finalHandler);
+    
     /**
      * @brief Get the number of middleware in the pipeline
      * 
@@ -279,15 +302,27 @@ private:
                                    Context& context, 
                                    NextHandler next);
     
+    /**
+     * @brief Execute a C ABI middleware and the rest of the chain after it
+     * 
+     * Calls the middleware's hooks directly instead of going through
+     * Middleware::handle() and a NextHandler. When the middleware comes from
+     * a plugin, the hooks are charged to the plugin's account.
+     */
+    HttpResponse executeNativeMiddleware(const CAbiMiddleware& middleware, PluginAccount* account,
+                                         const HttpRequest& request, Context& context, size_t index,
+                                         HttpHandler* handler);
+    
     /**
      * @brief Execute the final handler
      * 
      * @param request The HTTP request
      * @param context The request context (may contain data from middleware)
+     * @param handler Handler supplied to execute(), or nullptr for the pipeline's own
      * @return HttpResponse The response from the final handler
      * @throws std::runtime_error if no final handler is set
      */
-    HttpResponse executeFinalHandler(const HttpRequest& request, Context& context);
+    HttpResponse executeFinalHandler(const HttpRequest& request, Context& context, HttpHandler* handler);
     
     /**
      * @brief Execute middleware chain starting from a specific index
@@ -295,9 +330,11 @@ private:
      * @param request The HTTP request
      * @param context The request context
      * @param index Starting index in the middleware vector
+     * @param handler Handler supplied to execute(), or nullptr for the pipeline's own
      * @return HttpResponse The response after executing the chain
      */
-    HttpResponse executeMiddlewareChain(const HttpRequest& request, Context& context, size_t index);
+    HttpResponse executeMiddlewareChain(const HttpRequest& request, Context& context, size_t index,
+                                        HttpHandler* handler);
     
     /**
      * @brief Log performance metrics
@@ -309,7 +346,14 @@ private:
                        std::chrono::milliseconds duration);
 
 private:
+    /// C ABI form of a middleware, found once by sortMiddleware()
+    struct NativeMiddleware {
+        const CAbiMiddleware* middleware = nullptr;          ///< nullptr if not a C ABI middleware
+        PluginAccount* account = nullptr;                    ///< Account of the plugin it came from, if any
+    };
+    
     std::vector<std::shared_ptr<Middleware>> middlewares_;    ///< List of middleware components
+    std::vector<NativeMiddleware> nativeMiddlewares_;         ///< Per middleware; built by sortMiddleware()
     std::shared_ptr<HttpHandler> finalHandler_;              ///< Final synchronous handler
     std::shared_ptr<AsyncHttpHandler> finalAsyncHandler_;    ///< Final asynchronous handler
     bool middlewareSorted_ = false;                          ///< Whether middleware are sorted by priority
@@ -0,0 +1,160 @@
+/**
+ * @file middleware_reloader.h
+ * @brief Hot reload of the YAML middleware configuration
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-26
+ * @version 1.2.0
+ *
+ * A running MiddlewarePipeline must not be modified: adding middleware and
+ * its lazy sort would race with requests going through it. Reloading
+ * therefore never touches live pipelines. Each reload parses and validates
+ * the files, compiles them into a new CompiledMiddlewareConfig generation
+ * and publishes it with an atomic pointer swap. All of this happens on the
+ * watcher thread. Requests take a reference to the generation that is
+ * current when they start and finish on it. The old generation is freed
+ * when its last request drops that reference. A failed reload leaves the
+ * current generation in place.
+ */
+
+#pragma once
+
+#include <cppSwitchboard/compiled_middleware_config.h>
+#include <cppSwitchboard/middleware_config_compiler.h>
+#include <cppSwitchboard/file_watcher.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cppSwitchboard {
+
+class MiddlewareFactory;
+
+/**
+ * @brief Counters and timings of configuration reloads
+ */
+struct MiddlewareReloadStats {
+    uint64_t generation = 0;                            ///< Published generations, the initial load included
+    uint64_t reloads = 0;                               ///< Successful reloads after the initial load
+    uint64_t failures = 0;                              ///< Rejected reloads
+    std::chrono::microseconds lastLatency{0};           ///< Parse, validate, compile and publish time of the last attempt
+    std::chrono::microseconds maxLatency{0};            ///< Slowest attempt so far
+    std::string lastError;                              ///< Message of the last failure, empty if none
+    std::chrono::system_clock::time_point lastAttempt;  ///< Time of the last attempt
+};
+
+/**
+ * @class MiddlewareReloader
+ * @brief Owns the current middleware configuration generation and reloads it
+ *
+ * @code{.cpp}
+ * auto reloader = std::make_shared<MiddlewareReloader>(MiddlewareFactory::getInstance());
+ * auto result = reloader->load("/etc/app/middleware.yaml");
+ * reloader->setReloadListener([](const MiddlewareConfigResult& result, std::chrono::microseconds latency) {
+ *     std::cerr << "middleware reload " << (result.isSuccess() ? "ok" : result.message)
+ *               << " in " << latency.count() << "us" << std::endl;
+ * });
+ * reloader->startWatching();
+ *
+ * // On the request path
+ * auto generation = reloader->getCurrent();
+ * @endcode
+ *
+ * @since 1.2.0
+ */
+class MiddlewareReloader {
+public:
+    using ReloadListener = std::function<void(const MiddlewareConfigResult& result, std::chrono::microseconds latency)>;
+
+    /**
+     * @brief Create a reloader
+     * @param factory Factory creating middleware for each generation
+     */
+    explicit MiddlewareReloader(MiddlewareFactory& factory);
+
+    /**
+     * @brief Stops watching
+     */
+    ~MiddlewareReloader();
+
+    MiddlewareReloader(const MiddlewareReloader&) = delete;
+    MiddlewareReloader& operator=(const MiddlewareReloader&) = delete;
+
+    /**
+     * @brief Load the initial configuration
+     * @param files Configuration files; later files are merged over earlier ones
+     * @return Result of parsing, validation and compilation
+     */
+    MiddlewareConfigResult load(const std::vector<std::string>& files);
+    MiddlewareConfigResult load(const std::string& filename);
+
+    /**
+     * @brief Instantiate route middleware of the initial load on first use
+     *
+     * Shortens startup; see MiddlewareInstantiation::LAZY. Reloads always
+     * instantiate before the swap, so a failing creator keeps the previous
+     * generation. Set before load().
+     */
+    void setLazyInstantiation(bool lazy) { lazyInstantiation_ = lazy; }
+
+    /**
+     * @brief Read the files again and publish a new generation if they are valid
+     */
+    MiddlewareConfigResult reload();
+
+    /**
+     * @brief Generation to use for a request; nullptr before the first load
+     *
+     * Lock-free for readers and safe to call from any thread. The returned
+     * pointer keeps its generation alive while the request runs.
+     */
+    std::shared_ptr<const CompiledMiddlewareConfig> getCurrent() const;
+
+    /**
+     * @brief Start reloading when a configuration file changes
+     *
+     * Watches the loaded files and the configuration's hot_reload
+     * watched_files. Falls back to polling every hot_reload check_interval
+     * if inotify is unavailable. Also recompiles when the factory hot-reloads
+     * plugins, so pipelines move to the new plugin generations.
+     *
+     * @return false if nothing has been loaded or already watching
+     */
+    bool startWatching();
+
+    void stopWatching();
+
+    bool isWatching() const;
+
+    /// Hot-reload settings of the current configuration
+    HotReloadConfig getHotReloadConfig() const;
+
+    /**
+     * @brief Called after every reload attempt, on the thread that made it
+     */
+    void setReloadListener(ReloadListener listener);
+
+    MiddlewareReloadStats getStats() const;
+
+private:
+    MiddlewareConfigResult loadFiles(const std::vector<std::string>& files, bool initial);
+
+    MiddlewareFactory& factory_;
+    MiddlewareConfigCompiler compiler_;                         ///< Recompiles only files that changed
+    std::shared_ptr<const CompiledMiddlewareConfig> current_;   ///< Accessed with std::atomic_load/atomic_store only
+
+    mutable std::mutex mutex_;                                  ///< Serializes reloads; guards the members below
+    std::vector<std::string> files_;
+    HotReloadConfig hotReload_;
+    MiddlewareReloadStats stats_;
+    ReloadListener listener_;
+    std::unique_ptr<FileWatcher> watcher_;
+    size_t pluginListenerId_ = 0;                               ///< Factory plugin reload listener, 0 if none
+    bool lazyInstantiation_ = false;
+};
+
+} // namespace cppSwitchboard
@@ -0,0 +1,262 @@
+/**
+ * @file multipart_parser.h
+ * @brief Incremental multipart/form-data parser with spill-to-disk
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-23
+ * @version 1.2.0
+ *
+ * MultipartParser consumes a multipart body in arbitrary chunks and emits
+ * one MultipartPart per form field. Boundaries are located with a
+ * Boyer-Moore-Horspool search, so the body is scanned in strides of up to
+ * the delimiter length. Small parts are handed out as BodyBuffer slices
+ * that share the caller's buffer; parts that grow beyond a threshold are
+ * streamed to an anonymous temporary file (O_TMPFILE) instead of memory.
+ */
+
+#pragma once
+
+#include <cppSwitchboard/body_buffer.h>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cppSwitchboard {
+
+class HttpRequest;
+
+/**
+ * @class MultipartPart
+ * @brief One part of a multipart body, held in memory or in a temporary file
+ *
+ * Copies share the underlying buffer or file. A spilled file is closed (and,
+ * being anonymous, removed) when the last copy goes away unless it has been
+ * kept with saveAs().
+ */
+class MultipartPart {
+public:
+    /// Form field name from Content-Disposition
+    const std::string& getName() const noexcept { return name_; }
+
+    /// File name from Content-Disposition, empty for plain fields
+    const std::string& getFilename() const noexcept { return filename_; }
+
+    /// Content-Type of the part ("text/plain" when absent)
+    const std::string& getContentType() const noexcept { return contentType_; }
+
+    /// All part headers as received
+    const std::map<std::string, std::string>& getHeaders() const noexcept { return headers_; }
+
+    /**
+     * @brief Case-insensitive part header lookup
+     * @return Header value, empty if not present
+     */
+    std::string getHeader(const std::string& name) const;
+
+    /// Size of the part content in bytes
+    std::size_t size() const noexcept { return size_; }
+
+    /// Whether the content was written to a temporary file
+    bool isSpilled() const noexcept { return static_cast<bool>(file_); }
+
+    /**
+     * @brief In-memory content
+     * @return Buffer with the content, empty when the part is spilled
+     */
+    const BodyBuffer& getData() const noexcept { return data_; }
+
+    /// View of the in-memory content, empty when the part is spilled
+    std::string_view view() const noexcept { return data_.view(); }
+
+    /**
+     * @brief Descriptor of the temporary file
+     * @return Readable descriptor, or -1 for in-memory parts
+     */
+    int getFileDescriptor() const noexcept;
+
+    /**
+     * @brief Content as a string, read back from disk if necessary
+     */
+    std::string readAll() const;
+
+    /**
+     * @brief Store the content under @p path
+     *
+     * Anonymous temporary files are linked into place without copying where
+     * the file system allows it; otherwise the content is copied.
+     *
+     * @return true on success
+     */
+    bool saveAs(const std::string& path) const;
+
+private:
+    friend class MultipartParser;
+
+    /**
+     * @brief Owned descriptor of a spill file
+     */
+    struct SpillFile {
+        explicit SpillFile(int descriptor) : fd(descriptor) {}
+        ~SpillFile();
+        SpillFile(const SpillFile&) = delete;
+        SpillFile& operator=(const SpillFile&) = delete;
+
+        int fd;
+        bool anonymous = true;   ///< Created with O_TMPFILE (linkable via /proc)
+    };
+
+    std::string name_;
+    std::string filename_;
+    std::string contentType_ = "text/plain";
+    std::map<std::string, std::string> headers_;
+    BodyBuffer data_;
+    std::shared_ptr<SpillFile> file_;
+    std::size_t size_ = 0;
+};
+
+/**
+ * @class MultipartParser
+ * @brief Streaming multipart/form-data parser (RFC 7578 / RFC 2046)
+ *
+ * Feed the body in chunks as it arrives. Each completed part is passed to
+ * the part handler, or collected for getParts() when no handler is set.
+ * Feeding a BodyBuffer lets in-memory parts share that buffer; raw pointers
+ * are copied.
+ *
+ * @code{.cpp}
+ * auto boundary = MultipartParser::boundaryFromContentType(request.getContentType());
+ * MultipartParser parser(*boundary);
+ * parser.setPartHandler([](MultipartPart part) {
+ *     if (!part.getFilename().empty()) {
+ *         part.saveAs("/var/uploads/" + part.getFilename());
+ *     }
+ * });
+ * if (!parser.feed(request.getBodyBuffer()) || !parser.finish()) {
+ *     return HttpResponse::badRequest(parser.getError());
+ * }
+ * @endcode
+ *
+ * @note Not thread-safe; use one parser per body.
+ * @since 1.2.0
+ */
+class MultipartParser {
+public:
+    static constexpr std::size_t DEFAULT_SPILL_THRESHOLD = 1024 * 1024;   ///< Bytes kept in memory per part
+    static constexpr std::size_t DEFAULT_MAX_HEADER_SIZE = 8192;          ///< Largest part header block
+    static constexpr std::size_t MAX_BOUNDARY_LENGTH = 70;                ///< RFC 2046 limit
+
+    /**
+     * @brief Parser limits and spill location
+     */
+    struct Options {
+        std::size_t spillThreshold = DEFAULT_SPILL_THRESHOLD;
+        std::size_t maxHeaderSize = DEFAULT_MAX_HEADER_SIZE;
+        std::string tempDirectory = "/tmp";
+    };
+
+    using PartHandler = std::function<void(MultipartPart)>;
+
+    /**
+     * @brief Create a parser for the given boundary with default options
+     * @param boundary Boundary parameter from the Content-Type header
+     */
+    explicit MultipartParser(std::string boundary);
+
+    /**
+     * @brief Create a parser for the given boundary
+     * @param boundary Boundary parameter from the Content-Type header
+     * @param options Spill threshold, header limit and temp directory
+     */
+    MultipartParser(std::string boundary, Options options);
+
+    /**
+     * @brief Extract the boundary parameter from a Content-Type value
+     * @return Boundary (unquoted), or nullopt if @p contentType is not a
+     *         multipart type with a valid boundary
+     */
+    static std::optional<std::string> boundaryFromContentType(std::string_view contentType);
+
+    /**
+     * @brief Parse a complete multipart request body
+     * @return Parts of the body, or nullopt if the request is not multipart
+     *         or the body is malformed
+     */
+    static std::optional<std::vector<MultipartPart>> parse(const HttpRequest& request);
+    static std::optional<std::vector<MultipartPart>> parse(const HttpRequest& request, Options options);
+
+    void setPartHandler(PartHandler handler) { partHandler_ = std::move(handler); }
+
+    /**
+     * @brief Consume the next chunk of the body, sharing its storage
+     * @return false on malformed input (see getError())
+     */
+    bool feed(const BodyBuffer& chunk);
+
+    /**
+     * @brief Consume the next chunk of the body, copying what is retained
+     * @return false on malformed input (see getError())
+     */
+    bool feed(const char* data, std::size_t size);
+
+    /**
+     * @brief Signal the end of the body
+     * @return true if the closing boundary was seen
+     */
+    bool finish();
+
+    bool isComplete() const noexcept { return state_ == State::EPILOGUE; }
+    const std::string& getError() const noexcept { return error_; }
+
+    /// Parts collected when no part handler is set
+    const std::vector<MultipartPart>& getParts() const noexcept { return parts_; }
+    std::vector<MultipartPart> takeParts() { return std::move(parts_); }
+
+private:
+    enum class State { PREAMBLE, AFTER_DELIMITER, HEADERS, BODY, EPILOGUE, FAILED };
+
+    /**
+     * @brief Boyer-Moore-Horspool matcher for the delimiter
+     */
+    class DelimiterSearch {
+    public:
+        explicit DelimiterSearch(std::string delimiter);
+        std::size_t find(const char* data, std::size_t size, std::size_t from) const noexcept;
+        std::size_t length() const noexcept { return delimiter_.size(); }
+        const std::string& delimiter() const noexcept { return delimiter_; }
+
+    private:
+        std::string delimiter_;
+        std::array<std::size_t, 256> shift_;
+    };
+
+    bool consume(const char* data, std::size_t size, const BodyBuffer* owner);
+    bool scanForDelimiter(const char*& p, const char* end, const BodyBuffer* owner);
+    bool emitData(const char* data, std::size_t size, const BodyBuffer* owner);
+    bool parseHeaders();
+    bool finishPart();
+    bool spill();
+    bool fail(std::string message);
+
+    DelimiterSearch search_;
+    Options options_;
+    PartHandler partHandler_;
+    std::vector<MultipartPart> parts_;
+
+    State state_ = State::PREAMBLE;
+    std::string error_;
+    std::string tail_;           ///< Bytes that may start a delimiter split across chunks
+    std::string window_;         ///< tail_ joined with the head of the next chunk
+    std::string lineBuffer_;     ///< Transport padding / part headers being collected
+
+    MultipartPart current_;
+    BodyBuffer currentSlice_;    ///< Content so far, while it is one contiguous slice
+    std::string currentCopy_;    ///< Content so far, once it had to be copied
+    bool copying_ = false;
+};
+
+} // namespace cppSwitchboard
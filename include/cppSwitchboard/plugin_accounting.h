@@ -0,0 +1,229 @@
+/**
+ * @file plugin_accounting.h
+ * @brief Per-plugin resource accounting and circuit breaking
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ *
+ * Every middleware created from a plugin runs behind the plugin's
+ * PluginAccount. Each call charges the account with the time the
+ * middleware itself spent. That covers wall time, thread CPU time and, in
+ * builds with -DENABLE_ALLOCATION_ACCOUNTING=ON, heap allocations. Time
+ * spent in the rest of the chain is excluded. Exceptions thrown by the
+ * middleware are counted too.
+ *
+ * An account with a PluginBudget is also a circuit breaker. A call fails if
+ * it throws or runs longer than maxLatency. Once the share of failed calls
+ * in the current window exceeds maxFailureRate, the circuit opens. While it
+ * is open the plugin's middleware is skipped (FAIL_OPEN) or requests are
+ * answered with 503 (FAIL_CLOSED). After openDuration one trial call is let
+ * through; it closes the circuit again if it succeeds.
+ */
+
+#pragma once
+
+#include <cppSwitchboard/middleware.h>
+#include <cppSwitchboard/canned_response.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace cppSwitchboard {
+
+/**
+ * @brief What a tripped circuit does with the requests it would have handled
+ */
+enum class PluginFailureMode {
+    FAIL_OPEN,    ///< Skip the plugin's middleware and continue the chain
+    FAIL_CLOSED   ///< Answer 503 Service Unavailable
+};
+
+/**
+ * @brief Latency and error budget of a plugin
+ *
+ * The default budget never trips, so accounts only collect usage.
+ */
+struct PluginBudget {
+    std::chrono::microseconds maxLatency{0};         ///< Slowest acceptable call, 0 for no limit
+    double maxFailureRate = 1.0;                     ///< Tolerated share of failed calls per window
+    uint32_t minCalls = 20;                          ///< Calls in a window before the rate is judged
+    uint32_t windowSize = 100;                       ///< Calls per window
+    std::chrono::milliseconds openDuration{5000};    ///< Time before a trial call after tripping
+    PluginFailureMode failureMode = PluginFailureMode::FAIL_OPEN;
+};
+
+/**
+ * @brief Circuit breaker state of a plugin
+ */
+enum class PluginCircuitState {
+    CLOSED,     ///< Middleware runs
+    OPEN,       ///< Budget exceeded; middleware is bypassed or requests rejected
+    HALF_OPEN   ///< One trial call is running
+};
+
+/**
+ * @brief Resources consumed by one middleware call, excluding the rest of the chain
+ */
+struct PluginCost {
+    std::chrono::nanoseconds wallTime{0};
+    std::chrono::nanoseconds cpuTime{0};
+    uint64_t allocations = 0;
+};
+
+/**
+ * @brief Snapshot of a plugin's account
+ */
+struct PluginUsage {
+    uint64_t calls = 0;                       ///< Calls that ran the middleware
+    uint64_t exceptions = 0;                  ///< Calls that threw
+    uint64_t slowCalls = 0;                   ///< Calls over maxLatency
+    uint64_t bypassed = 0;                    ///< Calls skipped by an open circuit (FAIL_OPEN)
+    uint64_t rejected = 0;                    ///< Requests answered 503 by an open circuit (FAIL_CLOSED)
+    uint64_t trips = 0;                       ///< Times the circuit opened
+    std::chrono::nanoseconds wallTime{0};     ///< Total wall time
+    std::chrono::nanoseconds cpuTime{0};      ///< Total thread CPU time
+    std::chrono::nanoseconds maxWallTime{0};  ///< Slowest call
+    uint64_t allocations = 0;                 ///< Heap allocations; 0 unless built with allocation accounting
+    PluginCircuitState state = PluginCircuitState::CLOSED;
+};
+
+/**
+ * @class PluginCostMeter
+ * @brief Measures the cost of one call on the calling thread
+ *
+ * pause() and resume() bracket the part of the call that is not charged,
+ * i.e. the rest of the chain.
+ *
+ * @since 1.2.0
+ */
+class PluginCostMeter {
+public:
+    void start();
+    void pause();
+    void resume();
+    PluginCost stop();
+
+    /// Heap allocations made by this thread so far; always 0 without allocation accounting
+    static uint64_t threadAllocations() noexcept;
+
+private:
+    std::chrono::steady_clock::time_point wallStart_;
+    std::chrono::nanoseconds cpuStart_{0};
+    uint64_t allocationsStart_ = 0;
+    PluginCost cost_;
+    bool paused_ = false;
+};
+
+/**
+ * @class PluginAccount
+ * @brief Usage counters and circuit breaker of one plugin
+ *
+ * Shared by all middleware created from the plugin, across hot reloads.
+ * admit() and record() are lock-free and called concurrently by requests.
+ *
+ * @code{.cpp}
+ * PluginBudget budget;
+ * budget.maxLatency = std::chrono::milliseconds(5);
+ * budget.maxFailureRate = 0.2;
+ * budget.failureMode = PluginFailureMode::FAIL_CLOSED;
+ * MiddlewareFactory::getInstance().setPluginBudget("GeoIpPlugin", budget);
+ *
+ * PluginUsage usage = MiddlewareFactory::getInstance().getPluginUsage("GeoIpPlugin");
+ * @endcode
+ *
+ * @since 1.2.0
+ */
+class PluginAccount {
+public:
+    enum class Admission {
+        RUN,     ///< Run the middleware and record() the call
+        BYPASS,  ///< Skip the middleware
+        REJECT   ///< Answer with rejection()
+    };
+
+    explicit PluginAccount(std::string pluginName);
+
+    const std::string& getPluginName() const { return pluginName_; }
+
+    void setBudget(const PluginBudget& budget);
+    PluginBudget getBudget() const;
+
+    /// Decide whether a call may run; opens the trial call when the open period is over
+    Admission admit();
+
+    /**
+     * @brief Charge a call admitted with RUN
+     * @param cost Cost of the call
+     * @param threw Whether the middleware threw
+     */
+    void record(const PluginCost& cost, bool threw);
+
+    /// Close the circuit and start a new window, e.g. for a new plugin generation
+    void reset();
+
+    PluginCircuitState getState() const;
+    PluginUsage getUsage() const;
+
+    /// 503 response sent by a FAIL_CLOSED circuit; canned once per budget
+    HttpResponse rejection() const;
+
+private:
+    void trip();
+
+    std::string pluginName_;
+
+    std::atomic<int64_t> maxLatencyNs_{0};
+    std::atomic<double> maxFailureRate_{1.0};
+    std::atomic<uint32_t> minCalls_{20};
+    std::atomic<uint32_t> windowSize_{100};
+    std::atomic<int64_t> openDurationNs_{5000000000};
+    std::atomic<bool> failClosed_{false};
+    std::shared_ptr<const CannedResponse> rejection_;  ///< Read and replaced atomically
+
+    std::atomic<int> state_{static_cast<int>(PluginCircuitState::CLOSED)};
+    std::atomic<int64_t> openedAt_{0};              ///< steady_clock nanoseconds
+    std::atomic<uint32_t> windowCalls_{0};
+    std::atomic<uint32_t> windowFailures_{0};
+
+    std::atomic<uint64_t> calls_{0};
+    std::atomic<uint64_t> exceptions_{0};
+    std::atomic<uint64_t> slowCalls_{0};
+    std::atomic<uint64_t> bypassed_{0};
+    std::atomic<uint64_t> rejected_{0};
+    std::atomic<uint64_t> trips_{0};
+    std::atomic<int64_t> wallTimeNs_{0};
+    std::atomic<int64_t> cpuTimeNs_{0};
+    std::atomic<int64_t> maxWallTimeNs_{0};
+    std::atomic<uint64_t> allocations_{0};
+};
+
+/**
+ * @class AccountedMiddleware
+ * @brief Runs a plugin's middleware behind its account
+ *
+ * Created by the factory for every plugin middleware. Pipelines call the
+ * C ABI hooks of a wrapped CAbiMiddleware directly and charge the account
+ * themselves.
+ *
+ * @since 1.2.0
+ */
+class AccountedMiddleware : public Middleware {
+public:
+    AccountedMiddleware(std::shared_ptr<Middleware> middleware, std::shared_ptr<PluginAccount> account);
+
+    HttpResponse handle(const HttpRequest& request, Context& context, NextHandler next) override;
+    std::string getName() const override { return middleware_->getName(); }
+    int getPriority() const override { return middleware_->getPriority(); }
+    bool isEnabled() const override { return middleware_->isEnabled(); }
+
+    const std::shared_ptr<Middleware>& getMiddleware() const { return middleware_; }
+    PluginAccount& getAccount() const { return *account_; }
+
+private:
+    std::shared_ptr<Middleware> middleware_;
+    std::shared_ptr<PluginAccount> account_;
+};
+
+} // namespace cppSwitchboard
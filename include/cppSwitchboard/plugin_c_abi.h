@@ -0,0 +1,178 @@
+/**
+ * @file plugin_c_abi.h
+ * @brief Versioned C ABI for plugin middleware
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ *
+ * The C++ plugin interface hands std::shared_ptr, std::function and std::any
+ * across the shared library boundary. A plugin must therefore be built with
+ * the framework's compiler and standard library, and every hop goes through
+ * type-erased calls. This header is the alternative: plain C structs and
+ * function pointers. A plugin written in C, or in C++ against another
+ * standard library, exports one cppSwitchboard_c_plugin descriptor.
+ * MiddlewarePipeline calls its hooks directly with a POD view of the
+ * request; the response and context are changed through host callbacks.
+ *
+ * A C middleware does not call the rest of the chain itself. on_request
+ * runs before it and either continues or answers the request. on_response
+ * runs after it on the way out.
+ *
+ * All strings are passed as pointer and length and are not NUL-terminated.
+ * Views handed to a hook are valid until the hook returns.
+ *
+ * @section c_abi_example C Plugin Example
+ * @code{.c}
+ * #include <cppSwitchboard/plugin_c_abi.h>
+ *
+ * static int on_request(void* instance, const cppSwitchboard_host_api* host,
+ *                       const cppSwitchboard_request_view* request,
+ *                       cppSwitchboard_context* context, cppSwitchboard_response* response) {
+ *     cppSwitchboard_str key = {"X-Api-Key", 9}, value;
+ *     if (!host->request_header(request->request, key, &value)) {
+ *         cppSwitchboard_str body = {"{\"error\":\"missing key\"}", 23};
+ *         host->response_set_status(response, 401);
+ *         host->response_set_body(response, body);
+ *         return CPPSWITCH_C_RESPOND;
+ *     }
+ *     return CPPSWITCH_C_CONTINUE;
+ * }
+ *
+ * static const cppSwitchboard_c_middleware middleware[] = {
+ *     {"api_key", 100, NULL, NULL, on_request, NULL}
+ * };
+ *
+ * CPPSWITCH_PLUGIN_EXPORT const cppSwitchboard_c_plugin cppSwitchboard_c_plugin_info = {
+ *     CPPSWITCH_C_ABI_VERSION, "ApiKey", "API key check", "Developer Name",
+ *     {1, 0, 0}, {1, 2, 0}, middleware, 1, NULL, NULL
+ * };
+ * @endcode
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** C ABI version; increment when a struct below changes layout */
+#define CPPSWITCH_C_ABI_VERSION 1
+
+#ifndef CPPSWITCH_PLUGIN_EXPORT
+    #ifdef _WIN32
+        #define CPPSWITCH_PLUGIN_EXPORT __declspec(dllexport)
+    #else
+        #define CPPSWITCH_PLUGIN_EXPORT __attribute__((visibility("default")))
+    #endif
+#endif
+
+/** Hook results of on_request */
+#define CPPSWITCH_C_CONTINUE 0  /**< Run the rest of the chain */
+#define CPPSWITCH_C_RESPOND 1   /**< Send the response built so far; the rest of the chain is skipped */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief String slice; not NUL-terminated */
+typedef struct cppSwitchboard_str {
+    const char* data;
+    size_t size;
+} cppSwitchboard_str;
+
+/** @brief Semantic version; same layout as PluginVersion */
+typedef struct cppSwitchboard_c_version {
+    uint16_t major;
+    uint16_t minor;
+    uint16_t patch;
+} cppSwitchboard_c_version;
+
+/* Framework objects, only reachable through host callbacks */
+typedef struct cppSwitchboard_request cppSwitchboard_request;
+typedef struct cppSwitchboard_response cppSwitchboard_response;
+typedef struct cppSwitchboard_context cppSwitchboard_context;
+
+/** @brief Read-only view of the request being processed */
+typedef struct cppSwitchboard_request_view {
+    cppSwitchboard_str method;
+    cppSwitchboard_str path;
+    cppSwitchboard_str protocol;
+    cppSwitchboard_str body;
+    size_t header_count;
+    const cppSwitchboard_request* request;  /**< Handle for the request_* callbacks */
+} cppSwitchboard_request_view;
+
+/**
+ * @brief Header visitor for request_headers()
+ * @return Nonzero to continue, 0 to stop
+ */
+typedef int (*cppSwitchboard_header_visitor)(void* user, cppSwitchboard_str name, cppSwitchboard_str value);
+
+/** @brief Callbacks into the framework, passed to every hook */
+typedef struct cppSwitchboard_host_api {
+    uint32_t abi_version;  /**< CPPSWITCH_C_ABI_VERSION of the framework */
+
+    /** Calls visit for each request header, in name order */
+    void (*request_headers)(const cppSwitchboard_request* request, cppSwitchboard_header_visitor visit, void* user);
+    /** Case-insensitive header lookup; returns 0 if absent */
+    int (*request_header)(const cppSwitchboard_request* request, cppSwitchboard_str name, cppSwitchboard_str* value);
+
+    int (*response_status)(const cppSwitchboard_response* response);
+    void (*response_set_status)(cppSwitchboard_response* response, int status);
+    /** Case-insensitive header lookup; returns 0 if absent */
+    int (*response_header)(const cppSwitchboard_response* response, cppSwitchboard_str name, cppSwitchboard_str* value);
+    void (*response_set_header)(cppSwitchboard_response* response, cppSwitchboard_str name, cppSwitchboard_str value);
+    cppSwitchboard_str (*response_body)(const cppSwitchboard_response* response);
+    void (*response_set_body)(cppSwitchboard_response* response, cppSwitchboard_str body);
+    void (*response_append_body)(cppSwitchboard_response* response, cppSwitchboard_str data);
+
+    /** String context values; returns 0 if absent or not a string */
+    int (*context_get)(const cppSwitchboard_context* context, cppSwitchboard_str key, cppSwitchboard_str* value);
+    void (*context_set)(cppSwitchboard_context* context, cppSwitchboard_str key, cppSwitchboard_str value);
+} cppSwitchboard_host_api;
+
+/** @brief One middleware configuration value, rendered as text */
+typedef struct cppSwitchboard_config_entry {
+    cppSwitchboard_str key;
+    cppSwitchboard_str value;
+} cppSwitchboard_config_entry;
+
+/** @brief A middleware type provided by a C plugin */
+typedef struct cppSwitchboard_c_middleware {
+    const char* type;   /**< Type name used in middleware configuration */
+    int priority;       /**< Priority used when the configuration leaves it at 0 */
+
+    /**
+     * Create an instance from its configuration (string, number and boolean
+     * values). May be NULL for stateless middleware; returning NULL from a
+     * non-NULL create fails the creation.
+     */
+    void* (*create)(const cppSwitchboard_config_entry* entries, size_t count);
+    /** Destroy an instance; may be NULL */
+    void (*destroy)(void* instance);
+
+    /** Before the rest of the chain; returns CPPSWITCH_C_CONTINUE or CPPSWITCH_C_RESPOND. May be NULL */
+    int (*on_request)(void* instance, const cppSwitchboard_host_api* host, const cppSwitchboard_request_view* request,
+                      cppSwitchboard_context* context, cppSwitchboard_response* response);
+    /** After the rest of the chain, with its response. May be NULL */
+    void (*on_response)(void* instance, const cppSwitchboard_host_api* host, const cppSwitchboard_request_view* request,
+                        cppSwitchboard_context* context, cppSwitchboard_response* response);
+} cppSwitchboard_c_middleware;
+
+/**
+ * @brief Plugin descriptor, exported as cppSwitchboard_c_plugin_info
+ */
+typedef struct cppSwitchboard_c_plugin {
+    uint32_t abi_version;                           /**< Must be CPPSWITCH_C_ABI_VERSION */
+    const char* name;                               /**< Plugin name (must be unique) */
+    const char* description;
+    const char* author;
+    cppSwitchboard_c_version plugin_version;
+    cppSwitchboard_c_version min_framework_version;
+    const cppSwitchboard_c_middleware* middleware;  /**< Middleware types */
+    size_t middleware_count;
+    int (*initialize)(void);                        /**< Nonzero on success; may be NULL */
+    void (*shutdown)(void);                         /**< May be NULL */
+} cppSwitchboard_c_plugin;
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
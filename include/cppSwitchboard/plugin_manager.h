@@ -55,7 +55,7 @@ struct LoadedPluginInfo {
     std::string filePath;                     ///< Path to plugin file
     std::string name;                         ///< Plugin name
     PluginVersion version;                    ///< Plugin version
-    std::shared_ptr<MiddlewarePlugin> plugin; ///< Plugin instance
+    std::shared_ptr<MiddlewarePlugin> plugin; ///< Plugin instance; owns the library, which stays loaded while it is referenced
     void* handle;                             ///< Platform-specific handle (dlopen/LoadLibrary)
     std::atomic<int> refCount{0};            ///< Reference count for safe unloading
     std::chrono::steady_clock::time_point loadTime; ///< When plugin was loaded
@@ -72,6 +72,7 @@ struct PluginDiscoveryConfig {
     bool recursive = true;                       ///< Whether to search recursively
     bool followSymlinks = false;                 ///< Whether to follow symbolic links
     size_t maxDepth = 10;                       ///< Maximum search depth for recursive search
+    size_t loadConcurrency = 0;                 ///< Plugins opened and initialized at once; 0 for one per hardware thread
 };
 
 /**
@@ -168,7 +169,9 @@ public:
     /**
      * @brief Unload a plugin by name
      * 
-     * Plugin will only be unloaded if reference count is zero.
+     * Plugin will only be unloaded if reference count is zero. The plugin is
+     * removed at once; it is shut down and its library closed when the last
+     * middleware created from it is released.
      * 
      * @param pluginName Name of plugin to unload
      * @return bool True if plugin was unloaded
@@ -195,10 +198,16 @@ public:
     /**
      * @brief Discover and load all plugins
      * 
+     * Libraries are opened and plugins initialized on up to
+     * PluginDiscoveryConfig::loadConcurrency threads. A plugin is initialized
+     * only after the plugins it requires in MiddlewarePluginInfo::dependencies
+     * that are part of the same discovery.
+     * 
+     * @param hotReload Whether to enable hot-reload for the loaded plugins
      * @return std::unordered_map<std::string, std::pair<PluginLoadResult, std::string>> 
      *         Map of file paths to load results
      */
-    std::unordered_map<std::string, std::pair<PluginLoadResult, std::string>> discoverAndLoadPlugins();
+    std::unordered_map<std::string, std::pair<PluginLoadResult, std::string>> discoverAndLoadPlugins(bool hotReload = false);
     
     /**
      * @brief Get a loaded plugin by name
@@ -262,12 +271,40 @@ public:
     /**
      * @brief Check for plugin file changes and reload if needed
      * 
-     * Only affects plugins loaded with hot-reload enabled.
+     * Only affects plugins loaded with hot-reload enabled. Stats every such
+     * plugin file; prefer reloadChangedPlugins() driven by a FileWatcher.
      * 
      * @return std::vector<std::string> List of plugins that were reloaded
      */
     std::vector<std::string> checkAndReloadPlugins();
     
+    /**
+     * @brief Reload or load the plugins at the given paths
+     * 
+     * A path belonging to a hot-reload plugin loads a new generation of it
+     * from a private copy of the library. The new generation replaces the
+     * old one for lookups and new middleware; middleware already created
+     * keeps the old generation loaded until it is released. If loading
+     * fails the old generation stays registered.
+     * A path with a plugin file extension that is not loaded yet loads it
+     * with hot-reload enabled. Other paths are ignored. The manager lock is
+     * not held while libraries are closed, opened or initialized.
+     * 
+     * @param changedPaths Paths reported by a file watcher
+     * @return std::vector<std::string> Names of plugins that were reloaded or newly loaded
+     */
+    std::vector<std::string> reloadChangedPlugins(const std::vector<std::string>& changedPaths);
+    
+    /**
+     * @brief Directories to watch for plugin changes
+     * 
+     * The search directories (and their subdirectories when discovery is
+     * recursive) plus the directories of loaded hot-reload plugins.
+     * 
+     * @return std::vector<std::string> Existing directories, without duplicates
+     */
+    std::vector<std::string> getWatchDirectories() const;
+    
     /**
      * @brief Validate plugin dependencies
      * 
@@ -332,16 +369,45 @@ private:
     PluginManager(PluginManager&&) = delete;
     PluginManager& operator=(PluginManager&&) = delete;
     
+    /**
+     * @brief Open a plugin library and load it, optionally as a new generation
+     * 
+     * @param filePath Path to plugin file
+     * @param hotReload Whether hot-reload is enabled
+     * @param replacing Loaded generation the new one replaces under the same name, or nullptr
+     * @return std::pair<PluginLoadResult, std::string> Result and plugin name (if successful)
+     */
+    std::pair<PluginLoadResult, std::string> loadPluginFile(
+        const std::string& filePath, bool hotReload, const std::shared_ptr<LoadedPluginInfo>& replacing);
+    
+    /**
+     * @brief Open a plugin library without creating the plugin
+     * 
+     * @param filePath Path to plugin file
+     * @param hotReload Whether to open a private copy
+     * @param library Set to the opened library on success
+     */
+    PluginLoadResult openPluginLibrary(const std::string& filePath, bool hotReload, std::shared_ptr<void>& library);
+    
+    /**
+     * @brief Load the plugin of an opened library and report the outcome
+     */
+    std::pair<PluginLoadResult, std::string> completePluginLoad(
+        std::shared_ptr<void> library, const std::string& filePath, bool hotReload,
+        const std::shared_ptr<LoadedPluginInfo>& replacing);
+    
     /**
      * @brief Load plugin from handle and validate
      * 
-     * @param handle Platform-specific library handle
+     * @param library Platform-specific library handle, closed when the last owner releases it
      * @param filePath Path to plugin file
      * @param hotReload Whether hot-reload is enabled
+     * @param replacing Loaded generation the new one replaces, or nullptr
      * @return std::pair<PluginLoadResult, std::shared_ptr<LoadedPluginInfo>> Result and plugin info
      */
     std::pair<PluginLoadResult, std::shared_ptr<LoadedPluginInfo>> loadPluginFromHandle(
-        void* handle, const std::string& filePath, bool hotReload);
+        std::shared_ptr<void> library, const std::string& filePath, bool hotReload,
+        const std::shared_ptr<LoadedPluginInfo>& replacing);
     
     /**
      * @brief Validate plugin version compatibility
@@ -366,6 +432,11 @@ private:
      */
     static std::string getLibraryExtension();
     
+    /**
+     * @brief Names of plugins depending on a plugin; caller holds mutex_
+     */
+    std::vector<std::string> dependentsOf(const std::string& pluginName) const;
+    
     /**
      * @brief Fire plugin event
      * 
@@ -384,6 +455,7 @@ private:
     std::unordered_map<std::string, std::shared_ptr<LoadedPluginInfo>> loadedPlugins_; ///< Loaded plugins map
     PluginDiscoveryConfig discoveryConfig_;                             ///< Discovery configuration
     PluginEventCallback eventCallback_;                                 ///< Event callback function
+    std::recursive_mutex eventMutex_;                                   ///< Serializes event callbacks; callbacks may load plugins
     
     // Statistics
     std::atomic<size_t> totalLoadAttempts_{0};      ///< Total plugin load attempts
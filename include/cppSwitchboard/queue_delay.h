@@ -0,0 +1,108 @@
+/**
+ * @file queue_delay.h
+ * @brief Queue-delay admission control for worker queues
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ *
+ * A request's queueing delay is the time from parse completion to the
+ * start of its handler. Under a burst, requests can wait longer than their
+ * client is willing to, and the server then spends CPU on responses nobody
+ * reads. QueueDelayController follows CoDel (Nichols and Jacobson,
+ * "Controlling Queue Delay", 2012): a delay that stays above a target for
+ * a whole interval marks the queue as overloaded, not a single slow
+ * request. While overloaded, requests that waited past the target get a
+ * fast 503, and the queue switches to LIFO so that newly arrived requests
+ * are served while their clients still wait.
+ */
+
+#pragma once
+
+#include <cppSwitchboard/config.h>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace cppSwitchboard {
+
+/**
+ * @class QueueDelayController
+ * @brief CoDel-style shedding for one worker queue
+ *
+ * Call admit() when a queued request is about to run; it records the delay
+ * even when admission control is disabled.
+ *
+ * @code{.cpp}
+ * QueueDelayController queueDelay(config.general.admission);
+ * queueDelay.setOverloadListener([&pool](bool overloaded) { pool.setLifo(overloaded); });
+ * pool.submit([&queueDelay, request, done]() {
+ *     if (!queueDelay.admit(request->getReceivedAt())) {
+ *         done(cannedResponses.error(HttpResponse::SERVICE_UNAVAILABLE)->toResponse());
+ *         return;
+ *     }
+ *     done(handle(*request));
+ * });
+ * @endcode
+ *
+ * @since 1.2.0
+ */
+class QueueDelayController {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Controller state and counters
+     */
+    struct Stats {
+        bool enabled = false;                   ///< Shedding is configured
+        bool overloaded = false;                ///< Shedding and serving newest first
+        uint64_t admitted = 0;                  ///< Requests let through
+        uint64_t dropped = 0;                   ///< Requests answered with 503
+        uint64_t overloads = 0;                 ///< Times the queue entered overload
+        std::chrono::microseconds lastDelay{0}; ///< Queueing delay of the latest request
+        std::chrono::microseconds maxDelay{0};  ///< Largest queueing delay seen
+    };
+
+    QueueDelayController() = default;
+    explicit QueueDelayController(const AdmissionControlConfig& config) { configure(config); }
+
+    /// Apply new settings; disabling leaves overload at once
+    void configure(const AdmissionControlConfig& config);
+
+    /**
+     * @brief Decide whether a queued request runs
+     * @param receivedAt HttpRequest::getReceivedAt(); requests without it are admitted unmeasured
+     * @param now Time the handler would start
+     * @return False if the request should be answered with 503 Service Unavailable
+     */
+    bool admit(Clock::time_point receivedAt, Clock::time_point now = Clock::now());
+
+    bool isOverloaded() const;
+    Stats getStats() const;
+
+    /**
+     * @brief Called with the new state when the queue enters or leaves overload
+     *
+     * Runs under the controller's lock, so calls arrive in order; keep it
+     * short. Typically WorkerPool::setLifo().
+     */
+    void setOverloadListener(std::function<void(bool overloaded)> listener);
+
+private:
+    void setOverloaded(bool overloaded);
+
+    mutable std::mutex mutex_;
+    AdmissionControlConfig config_;
+    Clock::time_point firstAbove_{};            ///< Start of the current run above target; epoch if none
+    Clock::time_point firstBelow_{};            ///< Start of the current run within target while overloaded
+    bool overloaded_ = false;
+    uint64_t admitted_ = 0;
+    uint64_t dropped_ = 0;
+    uint64_t overloads_ = 0;
+    std::chrono::microseconds lastDelay_{0};
+    std::chrono::microseconds maxDelay_{0};
+    std::function<void(bool)> listener_;
+};
+
+} // namespace cppSwitchboard
@@ -0,0 +1,169 @@
+/**
+ * @file request_arena.h
+ * @brief Per-connection monotonic arena for request-scoped allocations
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-20
+ * @version 1.2.0
+ *
+ * A request creates dozens of short-lived strings and map nodes (headers,
+ * query parameters, path parameters, parser fields) that all die together
+ * once the response has been written. RequestArena hands those allocations
+ * out of a monotonic buffer owned by the connection and reclaims them in one
+ * step between requests, so a keep-alive connection reuses the same memory
+ * instead of going through malloc/free for every node.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+namespace cppSwitchboard {
+
+/**
+ * @class RequestArena
+ * @brief Resettable monotonic memory resource for one connection
+ *
+ * The arena owns an initial buffer that is carved up by a
+ * std::pmr::monotonic_buffer_resource. Allocations beyond the buffer fall
+ * through to the upstream resource and are counted as overflow. On reset()
+ * everything is released at once; if the previous request overflowed, the
+ * initial buffer grows (up to MAX_INITIAL_SIZE) so that steady-state requests
+ * are served entirely from the buffer.
+ *
+ * Objects allocated from the arena must be destroyed before reset() is
+ * called. Copies of arena-backed HttpRequest objects use the default heap
+ * resource, so copying is the safe way to let data outlive the request.
+ *
+ * @note Not thread-safe; each connection (or HTTP/2 session) owns its arena.
+ *
+ * @code{.cpp}
+ * RequestArena arena;
+ * while (connection.keepAlive()) {
+ *     arena.reset();
+ *     HttpRequest request("GET", "/api/users?page=1", "HTTP/1.1", arena.resource());
+ *     request.setHeader("Accept", "application/json");
+ *     // ... handle request, write response ...
+ * }
+ * @endcode
+ *
+ * @see HttpRequest
+ * @since 1.2.0
+ */
+class RequestArena {
+public:
+    static constexpr std::size_t DEFAULT_INITIAL_SIZE = 8 * 1024;   ///< Initial buffer size in bytes
+    static constexpr std::size_t MAX_INITIAL_SIZE = 256 * 1024;     ///< Upper bound for adaptive growth
+
+    /**
+     * @brief Construct an arena
+     * @param initialSize Size of the owned buffer in bytes
+     * @param upstream Resource used when the buffer is exhausted
+     */
+    explicit RequestArena(std::size_t initialSize = DEFAULT_INITIAL_SIZE,
+                          std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+
+    /**
+     * @brief Memory resource to construct request-scoped containers with
+     * @return Pointer valid for the lifetime of the arena
+     */
+    std::pmr::memory_resource* resource() noexcept { return &*monotonic_; }
+
+    /**
+     * @brief Release every allocation made since the previous reset
+     *
+     * The owned buffer is kept for the next request. When the last request
+     * overflowed into the upstream resource the buffer is enlarged first.
+     */
+    void reset();
+
+    /**
+     * @brief Current size of the owned buffer in bytes
+     */
+    std::size_t getInitialSize() const noexcept { return bufferSize_; }
+
+    /**
+     * @brief Number of times reset() has been called
+     */
+    std::size_t getResetCount() const noexcept { return resetCount_; }
+
+    /**
+     * @brief Total number of allocations that fell through to the upstream resource
+     */
+    std::size_t getOverflowCount() const noexcept { return counter_.allocations; }
+
+private:
+    /**
+     * @brief Upstream adaptor that records how much spilled past the buffer
+     */
+    class OverflowCounter : public std::pmr::memory_resource {
+    public:
+        explicit OverflowCounter(std::pmr::memory_resource* upstream) : upstream_(upstream) {}
+
+        std::size_t allocations = 0;   ///< Lifetime count of upstream allocations
+        std::size_t cycleBytes = 0;    ///< Bytes requested from upstream since the last reset
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+        std::pmr::memory_resource* upstream_;
+    };
+
+    void rebuild();
+
+    OverflowCounter counter_;
+    std::unique_ptr<std::byte[]> buffer_;
+    std::size_t bufferSize_;
+    std::size_t resetCount_ = 0;
+    std::optional<std::pmr::monotonic_buffer_resource> monotonic_;
+};
+
+/**
+ * @class ArenaAllocator
+ * @brief Assignable allocator over a std::pmr::memory_resource
+ *
+ * std::pmr::polymorphic_allocator is not assignable, which some containers
+ * (e.g. Beast's basic_fields) require. ArenaAllocator carries the same
+ * resource pointer but can be copied and assigned freely.
+ *
+ * @tparam T Value type
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator() noexcept = default;
+    explicit ArenaAllocator(std::pmr::memory_resource* resource) noexcept : resource_(resource) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : resource_(other.resource()) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        resource_->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    std::pmr::memory_resource* resource() const noexcept { return resource_; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return resource_ == other.resource(); }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return resource_ != other.resource(); }
+
+private:
+    std::pmr::memory_resource* resource_ = std::pmr::get_default_resource();
+};
+
+} // namespace cppSwitchboard
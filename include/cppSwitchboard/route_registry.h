@@ -17,6 +17,7 @@
 #include <cppSwitchboard/http_request.h>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <memory>
 #include <vector>
 #include <regex>
@@ -133,12 +134,20 @@ private:
  */
 struct RouteMatch {
     bool matched = false;                                       ///< Whether a matching route was found
+    std::string pattern;                                      ///< Pattern of the matched route (e.g., "/users/{id}")
     std::map<std::string, std::string> pathParams;            ///< Extracted path parameters
     std::shared_ptr<HttpHandler> handler;                     ///< Matched synchronous handler (if not async)
     std::shared_ptr<AsyncHttpHandler> asyncHandler;           ///< Matched asynchronous handler (if async)
     std::shared_ptr<MiddlewarePipeline> middlewarePipeline;   ///< Matched middleware pipeline (if middleware enabled)
     bool isAsync = false;                                      ///< Whether the matched route is async
     bool hasMiddleware = false;                               ///< Whether the matched route has middleware
+    bool pathMatched = false;                                  ///< Whether any route exists for the path
+    std::vector<HttpMethod> allowedMethods;                   ///< Methods served for the path, including implicit HEAD and OPTIONS
+    
+    /**
+     * @brief Value for the Allow header (e.g. "GET, HEAD, OPTIONS")
+     */
+    std::string allowHeader() const;
 };
 
 /**
@@ -154,7 +163,11 @@ struct RouteMatch {
  * - RESTful URL patterns with parameter extraction (e.g., "/users/{id}")
  * - Support for all HTTP methods (GET, POST, PUT, DELETE, etc.)
  * - Both synchronous and asynchronous handler registration
- * - Efficient regex-based pattern matching
+ * - Efficient regex-based pattern matching; literal paths are found with a
+ *   single hash lookup and take precedence over patterns
+ * - One lookup per request yields both the handler and the methods the
+ *   path supports, for 405 responses with an Allow header
+ * - GET routes also answer HEAD unless a HEAD route is registered
  * - Route introspection and management
  * - Parameter extraction and validation
  * 
@@ -268,7 +281,10 @@ public:
      * 
      * Searches for a registered route that matches the given path and HTTP method.
      * If a match is found, path parameters are extracted and returned in the
-     * RouteMatch structure along with the associated handler.
+     * RouteMatch structure along with the associated handler. A HEAD request
+     * falls back to the GET route of the path. When the path exists but not
+     * for this method, matched is false, pathMatched is true and
+     * allowedMethods lists what the path does support.
      * 
      * @code{.cpp}
      * auto match = registry.findRoute("/api/users/123", HttpMethod::GET);
@@ -338,7 +354,7 @@ public:
      * 
      * @see RouteInfo
      */
-    std::vector<RouteInfo> getAllRoutes() const { return routes_; }
+    std::vector<RouteInfo> getAllRoutes() const;
     
     /**
      * @brief Remove a registered route
@@ -367,7 +383,22 @@ public:
     void clear();
 
 private:
-    std::vector<RouteInfo> routes_;                    ///< List of registered routes
+    /**
+     * @brief All routes registered under one URL pattern, one per method
+     */
+    struct PathEntry {
+        std::string pattern;                           ///< URL pattern shared by the routes
+        bool literal = false;                          ///< Pattern has no parameters or wildcard
+        std::vector<RouteInfo> routes;                 ///< Routes in registration order
+        
+        const RouteInfo* find(HttpMethod method) const;
+    };
+    
+    std::vector<PathEntry> paths_;                     ///< Registered patterns in registration order
+    std::unordered_map<std::string, size_t> literalPaths_;  ///< Literal pattern -> index into paths_
+    
+    void addRoute(RouteInfo route);
+    void rebuildLiteralIndex();
     
     // Helper methods
     
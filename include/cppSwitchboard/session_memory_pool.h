@@ -0,0 +1,125 @@
+/**
+ * @file session_memory_pool.h
+ * @brief Single-owner memory pool for HTTP/2 session state
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-21
+ * @version 1.2.0
+ *
+ * nghttp2 allocates HPACK table entries, frames and stream structures for
+ * every stream it processes. Routing those through the global allocator
+ * means many small malloc/free pairs that contend with every other
+ * connection thread. SessionMemoryPool serves them from chunks owned by one
+ * session and releases everything in bulk when the session closes.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cppSwitchboard {
+
+/**
+ * @class SessionMemoryPool
+ * @brief malloc/free/realloc-compatible pool owned by a single session
+ *
+ * Small requests (up to MAX_SMALL_SIZE) are carved from fixed-size chunks
+ * and recycled through per-size-class free lists. Larger requests go to
+ * the system allocator but are tracked so that they are released together
+ * with the chunks when the pool is destroyed. Chunks themselves come from
+ * BufferPool, so they are reused across sessions.
+ *
+ * Every block carries a small header recording its capacity, which is what
+ * allows free() and realloc() without a size argument.
+ *
+ * @code{.cpp}
+ * SessionMemoryPool pool;
+ * void* frame = pool.allocate(96);
+ * frame = pool.reallocate(frame, 512);
+ * pool.deallocate(frame);
+ * // anything still allocated is released when pool goes out of scope
+ * @endcode
+ *
+ * @note Not thread-safe; an HTTP/2 session is only driven by one handler at a time.
+ * @see BufferPool
+ * @since 1.2.0
+ */
+class SessionMemoryPool {
+public:
+    static constexpr std::size_t CHUNK_SIZE = 16 * 1024;    ///< Bytes requested from BufferPool per chunk
+    static constexpr std::size_t MAX_SMALL_SIZE = 2048;     ///< Largest request served from chunks
+
+    SessionMemoryPool() = default;
+    ~SessionMemoryPool();
+
+    SessionMemoryPool(const SessionMemoryPool&) = delete;
+    SessionMemoryPool& operator=(const SessionMemoryPool&) = delete;
+
+    /**
+     * @brief Allocate @p size bytes aligned for any fundamental type
+     * @return Block pointer, or nullptr if the system allocator fails
+     */
+    void* allocate(std::size_t size) noexcept;
+
+    /**
+     * @brief Allocate a zero-filled array of @p count elements of @p size bytes
+     */
+    void* callocate(std::size_t count, std::size_t size) noexcept;
+
+    /**
+     * @brief Resize a block with realloc() semantics
+     * @param p Block from this pool, or nullptr
+     * @param size New size; 0 frees the block and returns nullptr
+     */
+    void* reallocate(void* p, std::size_t size) noexcept;
+
+    /**
+     * @brief Return a block to the pool (nullptr is ignored)
+     */
+    void deallocate(void* p) noexcept;
+
+    /**
+     * @brief Pool counters
+     * @return Map with "chunks", "reserved_bytes", "live_blocks",
+     *         "large_blocks" and "reused_blocks"
+     */
+    std::unordered_map<std::string, std::size_t> getStatistics() const;
+
+private:
+    /// Payload sizes of the small size classes
+    static constexpr std::array<std::size_t, 7> SIZE_CLASSES = {32, 64, 128, 256, 512, 1024, 2048};
+
+    struct alignas(std::max_align_t) BlockHeader {
+        std::size_t capacity;   ///< Usable bytes after the header
+    };
+
+    struct alignas(std::max_align_t) LargeLink {
+        LargeLink* prev;
+        LargeLink* next;
+    };
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static int classIndex(std::size_t size) noexcept;
+    void* allocateSmall(int index) noexcept;
+    void* allocateLarge(std::size_t size) noexcept;
+
+    std::array<FreeBlock*, SIZE_CLASSES.size()> freeLists_{};
+    std::vector<uint8_t*> chunks_;
+    uint8_t* cursor_ = nullptr;
+    uint8_t* chunkEnd_ = nullptr;
+    LargeLink* largeBlocks_ = nullptr;
+
+    std::size_t liveBlocks_ = 0;
+    std::size_t largeCount_ = 0;
+    std::size_t largeBytes_ = 0;
+    std::size_t reusedBlocks_ = 0;
+};
+
+} // namespace cppSwitchboard
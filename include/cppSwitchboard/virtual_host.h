@@ -0,0 +1,127 @@
+/**
+ * @file virtual_host.h
+ * @brief Host/authority based selection of route tables
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-25
+ * @version 1.2.0
+ *
+ * Several tenants can share one server process by giving each host name its
+ * own route table and global middleware. The host is taken from the Host
+ * header on HTTP/1.1 and from :authority on HTTP/2 and resolved before path
+ * routing: exact names with one hash lookup, wildcard names ("*.example.com")
+ * by probing one suffix per label, most specific first. Requests for hosts
+ * without a table fall through to the server's own routes, the default host.
+ */
+
+#pragma once
+
+#include <cppSwitchboard/route_registry.h>
+#include <cppSwitchboard/middleware.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cppSwitchboard {
+
+/**
+ * @class VirtualHost
+ * @brief Route table and global middleware of one host name
+ *
+ * @code{.cpp}
+ * auto api = server->virtualHost("api.example.com");
+ * api->get("/users", [](const HttpRequest&) { return HttpResponse::json("[]"); });
+ * api->registerMiddleware(std::make_shared<AuthMiddleware>(secret));
+ *
+ * auto tenants = server->virtualHost("*.tenants.example.com");
+ * tenants->get("/", handleTenantHome);
+ * @endcode
+ *
+ * @note Routes and middleware are registered during setup, before the server
+ *       starts; lookups afterwards are read-only.
+ * @since 1.2.0
+ */
+class VirtualHost {
+public:
+    /**
+     * @brief Create a host
+     * @param pattern Normalized host name, or "*." followed by a domain
+     */
+    explicit VirtualHost(std::string pattern);
+
+    const std::string& getPattern() const noexcept { return pattern_; }
+
+    RouteRegistry& getRoutes() noexcept { return *routes_; }
+    const RouteRegistry& getRoutes() const noexcept { return *routes_; }
+
+    void registerHandler(const std::string& path, HttpMethod method, std::shared_ptr<HttpHandler> handler);
+    void registerAsyncHandler(const std::string& path, HttpMethod method, std::shared_ptr<AsyncHttpHandler> handler);
+    void registerRouteWithMiddleware(const std::string& path, HttpMethod method, std::shared_ptr<MiddlewarePipeline> pipeline);
+
+    void get(const std::string& path, std::function<HttpResponse(const HttpRequest&)> handler);
+    void post(const std::string& path, std::function<HttpResponse(const HttpRequest&)> handler);
+    void put(const std::string& path, std::function<HttpResponse(const HttpRequest&)> handler);
+    void del(const std::string& path, std::function<HttpResponse(const HttpRequest&)> handler);
+
+    /**
+     * @brief Add middleware run for every request routed to this host
+     *
+     * Middleware runs in priority order (highest first) around route
+     * dispatch, so it also sees 404 and 405 responses.
+     */
+    void registerMiddleware(std::shared_ptr<Middleware> middleware);
+
+    const std::vector<std::shared_ptr<Middleware>>& getMiddleware() const noexcept { return middleware_; }
+
+private:
+    std::string pattern_;
+    std::unique_ptr<RouteRegistry> routes_;
+    std::vector<std::shared_ptr<Middleware>> middleware_;
+};
+
+/**
+ * @class VirtualHostRouter
+ * @brief Resolves a Host/:authority value to a VirtualHost
+ *
+ * Host names are compared case-insensitively without port and trailing dot.
+ * An exact name wins over wildcards; among wildcards the longest suffix wins,
+ * so "*.eu.example.com" is preferred to "*.example.com" for
+ * "shop.eu.example.com". A wildcard matches subdomains at any depth but not
+ * the domain itself.
+ *
+ * @since 1.2.0
+ */
+class VirtualHostRouter {
+public:
+    /**
+     * @brief Host for a pattern, created on first use
+     * @param pattern Host name ("api.example.com") or wildcard ("*.example.com")
+     * @throws std::invalid_argument if the pattern is empty or has a wildcard
+     *         anywhere but in a leading "*." label
+     */
+    std::shared_ptr<VirtualHost> addHost(const std::string& pattern);
+
+    /**
+     * @brief Host serving a request
+     * @param host Host header or :authority value, port included or not
+     * @return Matching host, or nullptr when the default host applies
+     */
+    std::shared_ptr<VirtualHost> findHost(std::string_view host) const;
+
+    bool empty() const noexcept { return exact_.empty() && wildcards_.empty(); }
+
+    /**
+     * @brief Lowercase host name without port, IPv6 brackets kept
+     */
+    static std::string normalize(std::string_view host);
+
+private:
+    std::unordered_map<std::string, std::shared_ptr<VirtualHost>> exact_;
+    /// Keyed by the suffix including its leading dot (".example.com")
+    std::map<std::string, std::shared_ptr<VirtualHost>, std::less<>> wildcards_;
+};
+
+} // namespace cppSwitchboard
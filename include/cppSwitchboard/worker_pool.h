@@ -0,0 +1,168 @@
+/**
+ * @file worker_pool.h
+ * @brief Work-stealing thread pool for handler execution
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ *
+ * Each worker owns a Chase-Lev deque. Tasks submitted from a worker go to
+ * the bottom of its own deque and it takes them back LIFO, while its cache
+ * still holds what they touch. Tasks submitted from any other thread go to
+ * a shared injection queue. An idle worker first drains the injection queue,
+ * then steals from the top of another worker's deque. Only the owner
+ * touches the bottom of a deque, so the common push and pop take no lock.
+ *
+ * HttpServer runs request handling on one pool sized by
+ * GeneralConfig::workerThreads. Handlers can queue continuations on it with
+ * WorkerPool::current() or HttpServer::getWorkerPool().
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace cppSwitchboard {
+
+/**
+ * @class WorkerPool
+ * @brief Fixed set of worker threads with per-worker deques and stealing
+ *
+ * @code{.cpp}
+ * WorkerPool pool(WorkerPool::resolveThreadCount(0));  // One per hardware thread
+ * pool.submit([&pool]() {
+ *     auto partial = std::make_shared<int>(compute());
+ *     // Continuation: stays on this worker unless another one is idle
+ *     WorkerPool::current()->submit([partial]() { publish(*partial); });
+ * });
+ * @endcode
+ *
+ * @since 1.2.0
+ */
+class WorkerPool {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Counters of one worker
+     */
+    struct WorkerStats {
+        size_t queueDepth = 0;  ///< Tasks waiting in the worker's deque
+        uint64_t executed = 0;  ///< Tasks the worker has run
+        uint64_t steals = 0;    ///< Tasks it took from other workers' deques
+    };
+
+    /**
+     * @param threadCount Number of workers; 0 for one per hardware thread
+     */
+    explicit WorkerPool(size_t threadCount = 0);
+
+    /// Runs the tasks still queued, then joins the workers
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Queue a task
+     *
+     * From one of this pool's workers the task goes to that worker's deque,
+     * otherwise to the injection queue. A task that throws is dropped; the
+     * exception does not reach the worker.
+     *
+     * @return False if the task is empty, or after shutdown() when called
+     *         from outside the pool; the task was not queued
+     */
+    bool submit(Task task);
+
+    /**
+     * @brief Run one queued task on the calling thread
+     *
+     * For a thread that waits on work it has queued, so the wait cannot
+     * starve the pool. A worker checks its own deque first.
+     *
+     * @return True if a task was run
+     */
+    bool tryRunOne();
+
+    /**
+     * @brief Run the newest task of the calling worker's own deque
+     *
+     * For a worker waiting on continuations it queued itself: with @p floor
+     * taken from getLocalDepth() before they were queued, only tasks queued
+     * since are run, never older work or other workers' tasks.
+     *
+     * @param floor Tasks at the bottom of the deque to leave alone
+     * @return True if a task was run; false off the pool's workers
+     */
+    bool tryRunLocal(size_t floor);
+
+    /// Tasks in the calling worker's deque; 0 off the pool's workers
+    size_t getLocalDepth() const;
+
+    /**
+     * @brief Stop accepting tasks, run those already queued and join the workers
+     *
+     * Workers may still queue continuations while the pool drains.
+     *
+     * @throws std::logic_error if called from one of the pool's workers
+     */
+    void shutdown();
+
+    size_t getThreadCount() const { return workers_.size(); }
+
+    /// Counters of every worker, in worker order
+    std::vector<WorkerStats> getWorkerStats() const;
+
+    /// Tasks waiting in the injection queue
+    size_t getInjectionQueueDepth() const;
+
+    /**
+     * @brief Take the newest task from the injection queue instead of the oldest
+     *
+     * Under sustained overload the oldest requests have likely outlived
+     * their client's timeout; serving the newest first keeps some of them
+     * fresh. QueueDelayController switches this on and off.
+     */
+    void setLifo(bool lifo) { lifo_.store(lifo, std::memory_order_relaxed); }
+
+    bool isLifo() const { return lifo_.load(std::memory_order_relaxed); }
+
+    /// Pool of the calling worker thread; nullptr on other threads
+    static WorkerPool* current();
+
+    /**
+     * @brief Number of workers for a GeneralConfig::workerThreads value
+     * @return configured if positive, otherwise the hardware concurrency (at least 1)
+     */
+    static size_t resolveThreadCount(int configured);
+
+private:
+    struct Worker;
+
+    void workerLoop(size_t index);
+    Task* findTask(Worker* self);
+    Task* popInjected();
+    Task* steal(Worker* thief);
+    void run(Task* task, Worker* self);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    mutable std::mutex injectionMutex_;
+    std::deque<Task*> injected_;                ///< Tasks from threads outside the pool
+    std::atomic<size_t> pending_{0};            ///< Queued tasks not yet taken by a worker
+    std::atomic<size_t> sleepers_{0};           ///< Workers parked on parkCondition_
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> lifo_{false};             ///< Injection queue order; see setLifo()
+    std::mutex parkMutex_;
+    std::condition_variable parkCondition_;
+    std::mutex shutdownMutex_;                  ///< Serializes shutdown() callers
+};
+
+} // namespace cppSwitchboard
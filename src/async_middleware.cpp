@@ -7,6 +7,7 @@
  */
 
 #include <cppSwitchboard/async_middleware.h>
+#include <cppSwitchboard/cancellation.h>
 #include <algorithm>
 #include <future>
 #include <iostream>
@@ -212,6 +213,12 @@ void AsyncMiddlewarePipeline::executeFinalHandler(const HttpRequest& request, Co
 
 void AsyncMiddlewarePipeline::executeMiddlewareChain(const HttpRequest& request, Context& context,
                                                    size_t index, AsyncResponseCallback callback) {
+    // Stop between hops once the client is gone or the deadline passed
+    if (request.isCancelled()) {
+        callback(request.getCancellation()->response());
+        return;
+    }
+    
     std::shared_ptr<AsyncMiddleware> middleware;
     bool shouldExecuteFinalHandler = false;
     
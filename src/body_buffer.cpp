@@ -0,0 +1,75 @@
+/**
+ * @file body_buffer.cpp
+ * @brief Implementation of the shared body buffer
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-22
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/body_buffer.h>
+#include <algorithm>
+
+namespace cppSwitchboard {
+
+BodyBuffer::BodyBuffer(std::string&& data) {
+    if (data.empty()) {
+        return;
+    }
+    auto owned = std::make_shared<std::string>(std::move(data));
+    ownedString_ = owned.get();
+    data_ = owned->data();
+    size_ = owned->size();
+    owner_ = std::move(owned);
+}
+
+BodyBuffer::BodyBuffer(std::vector<uint8_t>&& data) {
+    if (data.empty()) {
+        return;
+    }
+    auto owned = std::make_shared<std::vector<uint8_t>>(std::move(data));
+    data_ = reinterpret_cast<const char*>(owned->data());
+    size_ = owned->size();
+    owner_ = std::move(owned);
+}
+
+BodyBuffer BodyBuffer::copyOf(std::string_view data) {
+    return BodyBuffer(std::string(data));
+}
+
+BodyBuffer BodyBuffer::copyOf(const void* data, std::size_t size) {
+    return BodyBuffer(std::string(static_cast<const char*>(data), size));
+}
+
+BodyBuffer BodyBuffer::fromStatic(std::string_view data) noexcept {
+    BodyBuffer buffer;
+    if (!data.empty()) {
+        buffer.data_ = data.data();
+        buffer.size_ = data.size();
+    }
+    return buffer;
+}
+
+BodyBuffer BodyBuffer::slice(std::size_t offset, std::size_t length) const noexcept {
+    BodyBuffer result(*this);
+    offset = std::min(offset, size_);
+    result.data_ = data_ + offset;
+    result.size_ = std::min(length, size_ - offset);
+    if (result.data_ != data_ || result.size_ != size_) {
+        // A partial view cannot hand its storage out as a whole string
+        result.ownedString_ = nullptr;
+    }
+    return result;
+}
+
+std::string BodyBuffer::release() {
+    std::string result;
+    if (ownedString_ && owner_.use_count() == 1) {
+        result = std::move(*ownedString_);
+    } else {
+        result.assign(data_, size_);
+    }
+    *this = BodyBuffer();
+    return result;
+}
+
+} // namespace cppSwitchboard
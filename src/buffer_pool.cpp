@@ -0,0 +1,213 @@
+/**
+ * @file buffer_pool.cpp
+ * @brief Implementation of the size-classed I/O buffer pool
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-21
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/buffer_pool.h>
+#include <algorithm>
+#include <new>
+
+namespace cppSwitchboard {
+
+// ---------------------------------------------------------------------------
+// BufferPool::Buffer
+// ---------------------------------------------------------------------------
+
+BufferPool::Buffer::Buffer(Buffer&& other) noexcept
+    : data_(other.data_), size_(other.size_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+BufferPool::Buffer& BufferPool::Buffer::operator=(Buffer&& other) noexcept {
+    if (this != &other) {
+        reset();
+        data_ = other.data_;
+        size_ = other.size_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+void BufferPool::Buffer::reset() noexcept {
+    if (data_) {
+        BufferPool::getInstance().deallocate(data_, size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// BufferPool
+// ---------------------------------------------------------------------------
+
+BufferPool& BufferPool::getInstance() {
+    // Intentionally never destroyed: detached connection threads may still
+    // return buffers while static destructors run at process exit.
+    static BufferPool* instance = new BufferPool();
+    return *instance;
+}
+
+int BufferPool::classIndex(std::size_t bytes) noexcept {
+    for (std::size_t i = 0; i < SIZE_CLASSES.size(); ++i) {
+        if (bytes <= SIZE_CLASSES[i]) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+std::size_t BufferPool::roundUp(std::size_t bytes) noexcept {
+    int index = classIndex(bytes);
+    return index < 0 ? bytes : SIZE_CLASSES[static_cast<std::size_t>(index)];
+}
+
+std::size_t BufferPool::nextClass(std::size_t size) noexcept {
+    int index = classIndex(size);
+    if (index < 0 || static_cast<std::size_t>(index) + 1 >= SIZE_CLASSES.size()) {
+        return SIZE_CLASSES.back();
+    }
+    if (SIZE_CLASSES[static_cast<std::size_t>(index)] > size) {
+        return SIZE_CLASSES[static_cast<std::size_t>(index)];
+    }
+    return SIZE_CLASSES[static_cast<std::size_t>(index) + 1];
+}
+
+std::size_t BufferPool::previousClass(std::size_t size) noexcept {
+    int index = classIndex(size);
+    if (index < 0) {
+        return SIZE_CLASSES.back();
+    }
+    return index == 0 ? SIZE_CLASSES.front() : SIZE_CLASSES[static_cast<std::size_t>(index) - 1];
+}
+
+BufferPool::Buffer BufferPool::acquire(std::size_t minSize) {
+    std::size_t size = roundUp(std::max<std::size_t>(minSize, 1));
+    return Buffer(static_cast<uint8_t*>(allocate(size)), size);
+}
+
+void* BufferPool::allocate(std::size_t bytes) {
+    int index = classIndex(bytes);
+    outstanding_++;
+
+    if (index >= 0) {
+        SizeClass& sizeClass = classes_[static_cast<std::size_t>(index)];
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        if (!sizeClass.freeBlocks.empty()) {
+            void* block = sizeClass.freeBlocks.back();
+            sizeClass.freeBlocks.pop_back();
+            reuses_++;
+            return block;
+        }
+    }
+
+    allocations_++;
+    return ::operator new(index >= 0 ? SIZE_CLASSES[static_cast<std::size_t>(index)] : bytes);
+}
+
+void BufferPool::deallocate(void* p, std::size_t bytes) noexcept {
+    if (!p) {
+        return;
+    }
+    outstanding_--;
+
+    int index = classIndex(bytes);
+    if (index >= 0) {
+        SizeClass& sizeClass = classes_[static_cast<std::size_t>(index)];
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        if (sizeClass.freeBlocks.size() < maxCachedPerClass_.load(std::memory_order_relaxed)) {
+            try {
+                sizeClass.freeBlocks.push_back(p);
+                return;
+            } catch (const std::bad_alloc&) {
+                // Fall through and release the block
+            }
+        }
+    }
+
+    releases_++;
+    ::operator delete(p);
+}
+
+void BufferPool::setMaxCachedPerClass(std::size_t maxBlocks) {
+    maxCachedPerClass_ = maxBlocks;
+
+    for (auto& sizeClass : classes_) {
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        while (sizeClass.freeBlocks.size() > maxBlocks) {
+            ::operator delete(sizeClass.freeBlocks.back());
+            sizeClass.freeBlocks.pop_back();
+            releases_++;
+        }
+    }
+}
+
+void BufferPool::trim() {
+    for (auto& sizeClass : classes_) {
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        for (void* block : sizeClass.freeBlocks) {
+            ::operator delete(block);
+            releases_++;
+        }
+        sizeClass.freeBlocks.clear();
+        sizeClass.freeBlocks.shrink_to_fit();
+    }
+}
+
+std::unordered_map<std::string, std::size_t> BufferPool::getStatistics() const {
+    std::size_t cachedBlocks = 0;
+    std::size_t cachedBytes = 0;
+
+    for (std::size_t i = 0; i < classes_.size(); ++i) {
+        std::lock_guard<std::mutex> lock(classes_[i].mutex);
+        cachedBlocks += classes_[i].freeBlocks.size();
+        cachedBytes += classes_[i].freeBlocks.size() * SIZE_CLASSES[i];
+    }
+
+    return {
+        {"allocations", allocations_.load()},
+        {"reuses", reuses_.load()},
+        {"releases", releases_.load()},
+        {"cached_blocks", cachedBlocks},
+        {"cached_bytes", cachedBytes},
+        {"outstanding_blocks", outstanding_.load()}
+    };
+}
+
+// ---------------------------------------------------------------------------
+// AdaptiveBuffer
+// ---------------------------------------------------------------------------
+
+AdaptiveBuffer::AdaptiveBuffer(std::size_t initialSize, std::size_t maxSize)
+    : targetSize_(BufferPool::roundUp(initialSize)),
+      minSize_(targetSize_),
+      maxSize_(std::max(BufferPool::roundUp(maxSize), targetSize_)) {
+}
+
+uint8_t* AdaptiveBuffer::prepare() {
+    if (buffer_.size() != targetSize_) {
+        buffer_ = BufferPool::getInstance().acquire(targetSize_);
+    }
+    return buffer_.data();
+}
+
+void AdaptiveBuffer::commit(std::size_t bytesRead) {
+    if (bytesRead >= targetSize_ && targetSize_ < maxSize_) {
+        // Filled the whole buffer: the peer is streaming, read bigger chunks
+        targetSize_ = std::min(BufferPool::nextClass(targetSize_), maxSize_);
+        smallReads_ = 0;
+    } else if (bytesRead < targetSize_ / 4 && targetSize_ > minSize_) {
+        if (++smallReads_ >= SHRINK_AFTER_SMALL_READS) {
+            targetSize_ = std::max(BufferPool::previousClass(targetSize_), minSize_);
+            smallReads_ = 0;
+        }
+    } else {
+        smallReads_ = 0;
+    }
+}
+
+} // namespace cppSwitchboard
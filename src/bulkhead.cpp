@@ -0,0 +1,295 @@
+/**
+ * @file bulkhead.cpp
+ * @brief Implementation of per-route executor pools
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/bulkhead.h>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace cppSwitchboard {
+
+namespace {
+    int64_t steadyNowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    size_t threadCount(const BulkheadConfig& config) {
+        return static_cast<size_t>(std::max(1, config.threads));
+    }
+}
+
+Bulkhead::Bulkhead(const BulkheadConfig& config)
+    : name_(config.name), maxQueue_(config.maxQueue), overflow_(config.overflow),
+      queueTimeoutNs_(std::chrono::duration_cast<std::chrono::nanoseconds>(config.queueTimeout).count()),
+      pool_(std::make_unique<WorkerPool>(threadCount(config))) {
+    queueDelay_.setOverloadListener([this](bool overloaded) { pool_->setLifo(overloaded); });
+}
+
+Bulkhead::~Bulkhead() {
+    shutdown();
+}
+
+Bulkhead::Admission Bulkhead::submit(Task task, Task rejected) {
+    if (!task || stopping_.load()) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return Admission::REJECTED;
+    }
+
+    // Reserve a slot first, so concurrent callers cannot overshoot the limit
+    const size_t capacity = pool_->getThreadCount() + static_cast<size_t>(std::max(0, maxQueue_.load()));
+    int64_t deadlineNs = 0;
+    if (occupancy_.fetch_add(1) >= capacity) {
+        const BulkheadOverflow overflow = overflow_.load();
+        if (overflow != BulkheadOverflow::QUEUE) {
+            occupancy_.fetch_sub(1);
+            if (overflow == BulkheadOverflow::DEGRADE) {
+                degraded_.fetch_add(1, std::memory_order_relaxed);
+                return Admission::DEGRADED;
+            }
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            return Admission::REJECTED;
+        }
+        deadlineNs = steadyNowNs() + queueTimeoutNs_.load();
+    }
+
+    // Past the limit, whichever comes first answers the request: a thread
+    // picking it up, or the reaper once queueTimeout has passed
+    std::shared_ptr<QueuedTask> queued;
+    if (deadlineNs != 0) {
+        queued = std::make_shared<QueuedTask>();
+        queued->rejected = std::move(rejected);
+    }
+
+    bool submitted = pool_->submit([this, task = std::move(task), queued, deadlineNs]() {
+        if (queued && queued->claimed.exchange(true)) {
+            // Expired by the reaper, which released the slot
+            return;
+        }
+        try {
+            if (queued && steadyNowNs() > deadlineNs) {
+                expired_.fetch_add(1, std::memory_order_relaxed);
+                if (queued->rejected) {
+                    queued->rejected();
+                }
+            } else {
+                running_.fetch_add(1);
+                struct RunningGuard {
+                    std::atomic<size_t>& running;
+                    ~RunningGuard() { running.fetch_sub(1); }
+                } guard{running_};
+                task();
+            }
+        } catch (...) {
+            // Counted as finished either way
+        }
+        finished();
+    });
+    if (!submitted) {
+        occupancy_.fetch_sub(1);
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return Admission::REJECTED;
+    }
+    if (queued) {
+        scheduleExpiry(deadlineNs, std::move(queued));
+    }
+    admitted_.fetch_add(1, std::memory_order_relaxed);
+    return Admission::ADMITTED;
+}
+
+void Bulkhead::scheduleExpiry(int64_t deadlineNs, std::shared_ptr<QueuedTask> queued) {
+    std::lock_guard<std::mutex> lock(reaperMutex_);
+    if (reaperStopping_) {
+        // Shutting down: the pool runs what is queued
+        return;
+    }
+    expiries_.push({deadlineNs, std::move(queued)});
+    if (!reaper_.joinable()) {
+        reaper_ = std::thread([this]() { reap(); });
+    }
+    reaperWake_.notify_one();
+}
+
+void Bulkhead::reap() {
+    std::unique_lock<std::mutex> lock(reaperMutex_);
+    while (!reaperStopping_) {
+        if (expiries_.empty()) {
+            reaperWake_.wait_for(lock, std::chrono::milliseconds(100));
+            continue;
+        }
+        const int64_t deadlineNs = expiries_.top().deadlineNs;
+        const int64_t nowNs = steadyNowNs();
+        if (nowNs <= deadlineNs) {
+            reaperWake_.wait_for(lock, std::chrono::nanoseconds(deadlineNs - nowNs + 1));
+            continue;
+        }
+        auto queued = expiries_.top().queued;
+        expiries_.pop();
+        if (queued->claimed.exchange(true)) {
+            // Already picked up by a thread
+            continue;
+        }
+
+        // Free the slot before answering, so the caller sees it released
+        lock.unlock();
+        expired_.fetch_add(1, std::memory_order_relaxed);
+        finished();
+        try {
+            if (queued->rejected) {
+                queued->rejected();
+            }
+        } catch (...) {
+            // The slot is released either way
+        }
+        queued->rejected = nullptr;
+        lock.lock();
+    }
+}
+
+void Bulkhead::setLimits(const BulkheadConfig& config) {
+    maxQueue_ = config.maxQueue;
+    overflow_ = config.overflow;
+    queueTimeoutNs_ = std::chrono::duration_cast<std::chrono::nanoseconds>(config.queueTimeout).count();
+}
+
+void Bulkhead::shutdown() {
+    stopping_ = true;
+    pool_->shutdown();
+
+    // Every queued task ran or expired, so nothing is left for the reaper
+    std::thread reaper;
+    {
+        std::lock_guard<std::mutex> lock(reaperMutex_);
+        reaperStopping_ = true;
+        reaper = std::move(reaper_);
+        reaperWake_.notify_one();
+    }
+    if (reaper.joinable()) {
+        if (reaper.get_id() == std::this_thread::get_id()) {
+            reaper.detach();
+        } else {
+            reaper.join();
+        }
+    }
+}
+
+Bulkhead::Stats Bulkhead::getStats() const {
+    Stats stats;
+    stats.running = running_.load();
+    const size_t occupancy = occupancy_.load();
+    stats.queued = occupancy > stats.running ? occupancy - stats.running : 0;
+    stats.admitted = admitted_.load(std::memory_order_relaxed);
+    stats.rejected = rejected_.load(std::memory_order_relaxed);
+    stats.degraded = degraded_.load(std::memory_order_relaxed);
+    stats.expired = expired_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void Bulkhead::retire() {
+    retired_ = true;
+}
+
+void Bulkhead::finished() {
+    if (occupancy_.fetch_sub(1) != 1 || !retired_.load()) {
+        return;
+    }
+    if (auto self = weak_from_this().lock()) {
+        std::thread([self]() { self->shutdown(); }).detach();
+    }
+}
+
+// BulkheadRegistry implementation
+BulkheadRegistry::~BulkheadRegistry() {
+    shutdown();
+}
+
+void BulkheadRegistry::configure(const std::vector<BulkheadConfig>& configs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pruneRetired();
+
+    std::unordered_map<std::string, std::shared_ptr<Bulkhead>> next;
+    for (const auto& config : configs) {
+        auto existing = bulkheads_.find(config.name);
+        if (existing != bulkheads_.end() &&
+            existing->second->getThreadCount() == threadCount(config)) {
+            existing->second->setLimits(config);
+            next[config.name] = std::move(existing->second);
+            bulkheads_.erase(existing);
+        } else {
+            next[config.name] = std::make_shared<Bulkhead>(config);
+            next[config.name]->getQueueDelay().configure(admission_);
+        }
+    }
+    for (auto& entry : bulkheads_) {
+        entry.second->retire();
+        retired_.push_back(std::move(entry.second));
+    }
+    bulkheads_ = std::move(next);
+    pruneRetired();
+}
+
+std::shared_ptr<Bulkhead> BulkheadRegistry::find(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = bulkheads_.find(name);
+    return it == bulkheads_.end() ? nullptr : it->second;
+}
+
+std::vector<std::string> BulkheadRegistry::getNames() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> names;
+    names.reserve(bulkheads_.size());
+    for (const auto& entry : bulkheads_) {
+        names.push_back(entry.first);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+void BulkheadRegistry::shutdown() {
+    std::unordered_map<std::string, std::shared_ptr<Bulkhead>> bulkheads;
+    std::vector<std::shared_ptr<Bulkhead>> retired;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        bulkheads.swap(bulkheads_);
+        retired.swap(retired_);
+    }
+    for (auto& entry : bulkheads) {
+        entry.second->shutdown();
+    }
+    for (auto& bulkhead : retired) {
+        bulkhead->shutdown();
+    }
+}
+
+void BulkheadRegistry::setAdmissionControl(const AdmissionControlConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    admission_ = config;
+    for (auto& entry : bulkheads_) {
+        entry.second->getQueueDelay().configure(config);
+    }
+}
+
+void BulkheadRegistry::pruneRetired() {
+    for (auto it = retired_.begin(); it != retired_.end();) {
+        if ((*it)->getOccupancy() > 0) {
+            ++it;
+            continue;
+        }
+        try {
+            (*it)->shutdown();
+        } catch (const std::logic_error&) {
+            // Called from one of its threads; try again on the next configure()
+            ++it;
+            continue;
+        }
+        it = retired_.erase(it);
+    }
+}
+
+} // namespace cppSwitchboard
@@ -0,0 +1,266 @@
+/**
+ * @file c_abi_middleware.cpp
+ * @brief Implementation of the framework side of the C plugin ABI
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/c_abi_middleware.h>
+#include <cstring>
+#include <string_view>
+#include <strings.h>
+
+namespace cppSwitchboard {
+
+namespace {
+    std::string_view view(cppSwitchboard_str str) {
+        return std::string_view(str.data, str.size);
+    }
+
+    cppSwitchboard_str slice(std::string_view text) {
+        return {text.data(), text.size()};
+    }
+
+    const HttpRequest& requestOf(const cppSwitchboard_request* request) {
+        return *reinterpret_cast<const HttpRequest*>(request);
+    }
+
+    HttpResponse& responseOf(cppSwitchboard_response* response) {
+        return *reinterpret_cast<HttpResponse*>(response);
+    }
+
+    const HttpResponse& responseOf(const cppSwitchboard_response* response) {
+        return *reinterpret_cast<const HttpResponse*>(response);
+    }
+
+    cppSwitchboard_request_view viewOf(const HttpRequest& request) {
+        cppSwitchboard_request_view requestView;
+        requestView.method = slice(request.getMethod());
+        requestView.path = slice(request.getPath());
+        requestView.protocol = slice(request.getProtocol());
+        requestView.body = slice(request.getBodyView());
+        requestView.header_count = request.getHeaderCount();
+        requestView.request = reinterpret_cast<const cppSwitchboard_request*>(&request);
+        return requestView;
+    }
+
+    /// Renders scalar configuration values; other types are not passed to C
+    bool renderValue(const std::any& value, std::string& out) {
+        if (const auto* text = std::any_cast<std::string>(&value)) {
+            out = *text;
+        } else if (const auto* number = std::any_cast<int>(&value)) {
+            out = std::to_string(*number);
+        } else if (const auto* real = std::any_cast<double>(&value)) {
+            out = std::to_string(*real);
+        } else if (const auto* flag = std::any_cast<bool>(&value)) {
+            out = *flag ? "true" : "false";
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    const cppSwitchboard_host_api HOST_API = {
+        CPPSWITCH_C_ABI_VERSION,
+
+        // request_headers
+        [](const cppSwitchboard_request* request, cppSwitchboard_header_visitor visit, void* user) {
+            requestOf(request).forEachHeader([visit, user](std::string_view name, std::string_view value) {
+                return visit(user, slice(name), slice(value)) != 0;
+            });
+        },
+        // request_header
+        [](const cppSwitchboard_request* request, cppSwitchboard_str name, cppSwitchboard_str* value) -> int {
+            std::string_view found;
+            if (!requestOf(request).findHeader(view(name), found)) {
+                return 0;
+            }
+            *value = slice(found);
+            return 1;
+        },
+
+        // response_status
+        [](const cppSwitchboard_response* response) -> int {
+            return responseOf(response).getStatus();
+        },
+        // response_set_status
+        [](cppSwitchboard_response* response, int status) {
+            responseOf(response).setStatus(status);
+        },
+        // response_header
+        [](const cppSwitchboard_response* response, cppSwitchboard_str name, cppSwitchboard_str* value) -> int {
+            for (const auto& [fieldName, fieldValue] : responseOf(response).getHeaderFields()) {
+                if (fieldName.size() == name.size && strncasecmp(fieldName.data(), name.data, name.size) == 0) {
+                    *value = slice(fieldValue);
+                    return 1;
+                }
+            }
+            return 0;
+        },
+        // response_set_header
+        [](cppSwitchboard_response* response, cppSwitchboard_str name, cppSwitchboard_str value) {
+            responseOf(response).setHeader(std::string(view(name)), std::string(view(value)));
+        },
+        // response_body
+        [](const cppSwitchboard_response* response) -> cppSwitchboard_str {
+            return slice(responseOf(response).getBodyView());
+        },
+        // response_set_body
+        [](cppSwitchboard_response* response, cppSwitchboard_str body) {
+            responseOf(response).setBody(view(body));
+        },
+        // response_append_body
+        [](cppSwitchboard_response* response, cppSwitchboard_str data) {
+            responseOf(response).appendBody(view(data));
+        },
+
+        // context_get
+        [](const cppSwitchboard_context* context, cppSwitchboard_str key, cppSwitchboard_str* value) -> int {
+            const auto& map = *reinterpret_cast<const Context*>(context);
+            auto it = map.find(std::string(view(key)));
+            const std::string* text = it == map.end() ? nullptr : std::any_cast<std::string>(&it->second);
+            if (!text) {
+                return 0;
+            }
+            *value = slice(*text);
+            return 1;
+        },
+        // context_set
+        [](cppSwitchboard_context* context, cppSwitchboard_str key, cppSwitchboard_str value) {
+            (*reinterpret_cast<Context*>(context))[std::string(view(key))] = std::string(view(value));
+        },
+    };
+}
+
+CAbiMiddleware::CAbiMiddleware(const cppSwitchboard_c_middleware& type, void* instance, int priority)
+    : type_(type), instance_(instance), priority_(priority), name_(type.type ? type.type : "") {}
+
+CAbiMiddleware::~CAbiMiddleware() {
+    if (type_.destroy) {
+        type_.destroy(instance_);
+    }
+}
+
+const cppSwitchboard_host_api& CAbiMiddleware::hostApi() {
+    return HOST_API;
+}
+
+bool CAbiMiddleware::before(const HttpRequest& request, Context& context, HttpResponse& response) const {
+    if (!type_.on_request) {
+        return true;
+    }
+    cppSwitchboard_request_view requestView = viewOf(request);
+    int result = type_.on_request(instance_, &HOST_API, &requestView,
+                                  reinterpret_cast<cppSwitchboard_context*>(&context),
+                                  reinterpret_cast<cppSwitchboard_response*>(&response));
+    return result != CPPSWITCH_C_RESPOND;
+}
+
+void CAbiMiddleware::after(const HttpRequest& request, Context& context, HttpResponse& response) const {
+    if (!type_.on_response) {
+        return;
+    }
+    cppSwitchboard_request_view requestView = viewOf(request);
+    type_.on_response(instance_, &HOST_API, &requestView,
+                      reinterpret_cast<cppSwitchboard_context*>(&context),
+                      reinterpret_cast<cppSwitchboard_response*>(&response));
+}
+
+HttpResponse CAbiMiddleware::handle(const HttpRequest& request, Context& context, NextHandler next) {
+    HttpResponse response;
+    if (!before(request, context, response)) {
+        return response;
+    }
+    response = next(request, context);
+    after(request, context, response);
+    return response;
+}
+
+CAbiPlugin::CAbiPlugin(const cppSwitchboard_c_plugin& descriptor) : descriptor_(descriptor) {
+    info_.version = CPPSWITCH_PLUGIN_VERSION;
+    info_.name = descriptor.name;
+    info_.description = descriptor.description;
+    info_.author = descriptor.author;
+    info_.plugin_version = {descriptor.plugin_version.major, descriptor.plugin_version.minor,
+                            descriptor.plugin_version.patch};
+    info_.min_framework_version = {descriptor.min_framework_version.major, descriptor.min_framework_version.minor,
+                                   descriptor.min_framework_version.patch};
+    info_.dependencies = nullptr;
+    info_.dependency_count = 0;
+}
+
+bool CAbiPlugin::initialize(const PluginVersion& frameworkVersion) {
+    if (!frameworkVersion.isCompatible(info_.min_framework_version)) {
+        return false;
+    }
+    initialized_ = !descriptor_.initialize || descriptor_.initialize() != 0;
+    return initialized_;
+}
+
+void CAbiPlugin::shutdown() {
+    if (initialized_ && descriptor_.shutdown) {
+        descriptor_.shutdown();
+    }
+    initialized_ = false;
+}
+
+std::shared_ptr<Middleware> CAbiPlugin::createMiddleware(const MiddlewareInstanceConfig& config) {
+    const cppSwitchboard_c_middleware* type = findType(config.name);
+    if (!type || !initialized_) {
+        return nullptr;
+    }
+
+    void* instance = nullptr;
+    if (type->create) {
+        // Rendered values must stay alive for the duration of create()
+        std::vector<std::pair<std::string, std::string>> rendered;
+        rendered.reserve(config.config.size());
+        for (const auto& [key, value] : config.config) {
+            std::string text;
+            if (renderValue(value, text)) {
+                rendered.emplace_back(key, std::move(text));
+            }
+        }
+        std::vector<cppSwitchboard_config_entry> entries;
+        entries.reserve(rendered.size());
+        for (const auto& [key, text] : rendered) {
+            entries.push_back({slice(key), slice(text)});
+        }
+
+        instance = type->create(entries.data(), entries.size());
+        if (!instance) {
+            return nullptr;
+        }
+    }
+    return std::make_shared<CAbiMiddleware>(*type, instance, config.priority != 0 ? config.priority : type->priority);
+}
+
+bool CAbiPlugin::validateConfig(const MiddlewareInstanceConfig& config, std::string& errorMessage) const {
+    if (!findType(config.name)) {
+        errorMessage = "Middleware type not provided by plugin " + std::string(info_.name) + ": " + config.name;
+        return false;
+    }
+    return true;
+}
+
+std::vector<std::string> CAbiPlugin::getSupportedTypes() const {
+    std::vector<std::string> types;
+    for (size_t i = 0; i < descriptor_.middleware_count; ++i) {
+        if (descriptor_.middleware[i].type) {
+            types.emplace_back(descriptor_.middleware[i].type);
+        }
+    }
+    return types;
+}
+
+const cppSwitchboard_c_middleware* CAbiPlugin::findType(const std::string& type) const {
+    for (size_t i = 0; i < descriptor_.middleware_count; ++i) {
+        if (descriptor_.middleware[i].type && type == descriptor_.middleware[i].type) {
+            return &descriptor_.middleware[i];
+        }
+    }
+    return nullptr;
+}
+
+} // namespace cppSwitchboard
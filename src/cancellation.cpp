@@ -0,0 +1,176 @@
+/**
+ * @file cancellation.cpp
+ * @brief Implementation of per-request cancellation and deadlines
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/cancellation.h>
+#include <cppSwitchboard/http_request.h>
+#include "usdt_probes.h"
+#include <algorithm>
+#include <string_view>
+
+namespace cppSwitchboard {
+
+namespace {
+    // Timeouts beyond this are treated as no deadline, so the arithmetic
+    // on steady_clock cannot overflow
+    constexpr double MAX_TIMEOUT_SECONDS = 365.0 * 24 * 3600;
+
+    /// Parse a non-empty run of at most @p maxDigits decimal digits
+    bool parseDigits(std::string_view text, size_t maxDigits, uint64_t& value) {
+        if (text.empty() || text.size() > maxDigits) {
+            return false;
+        }
+        value = 0;
+        for (char c : text) {
+            if (c < '0' || c > '9') {
+                return false;
+            }
+            value = value * 10 + static_cast<uint64_t>(c - '0');
+        }
+        return true;
+    }
+
+    CancellationToken::Clock::time_point after(CancellationToken::Clock::time_point now, double seconds) {
+        if (seconds > MAX_TIMEOUT_SECONDS) {
+            return CancellationToken::Clock::time_point::max();
+        }
+        return now + std::chrono::duration_cast<CancellationToken::Clock::duration>(
+            std::chrono::duration<double>(seconds));
+    }
+}
+
+bool CancellationToken::cancel(Reason reason) {
+    if (reason == Reason::NONE) {
+        return false;
+    }
+    Reason expected = Reason::NONE;
+    if (!reason_.compare_exchange_strong(expected, reason, std::memory_order_acq_rel)) {
+        return false;
+    }
+    CPPSWITCHBOARD_PROBE1(request_cancelled, static_cast<int>(reason));
+
+    // Callbacks registered from here on run at once in onCancel()
+    std::map<CallbackId, std::function<void()>> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callbacks.swap(callbacks_);
+    }
+    for (auto& entry : callbacks) {
+        try {
+            entry.second();
+        } catch (...) {
+            // A failing callback must not keep the others from running
+        }
+    }
+    return true;
+}
+
+bool CancellationToken::isCancelled() {
+    if (reason_.load(std::memory_order_acquire) != Reason::NONE) {
+        return true;
+    }
+    const Clock::rep deadline = deadline_.load(std::memory_order_relaxed);
+    const bool bounded = deadline != Clock::time_point::max().time_since_epoch().count();
+    if (!bounded && !hasProbe_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    const auto now = Clock::now();
+    if (bounded && now.time_since_epoch().count() >= deadline) {
+        cancel(Reason::DEADLINE);
+        return true;
+    }
+
+    bool gone = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (probe_ && now >= nextProbe_) {
+            nextProbe_ = now + PROBE_INTERVAL;
+            gone = probe_();
+        }
+    }
+    if (gone) {
+        cancel(Reason::CLIENT_GONE);
+    }
+    return reason_.load(std::memory_order_acquire) != Reason::NONE;
+}
+
+void CancellationToken::tightenDeadline(Clock::time_point deadline) {
+    const Clock::rep requested = deadline.time_since_epoch().count();
+    Clock::rep current = deadline_.load();
+    while (requested < current && !deadline_.compare_exchange_weak(current, requested)) {
+        // current was reloaded; retry while the new deadline is still earlier
+    }
+}
+
+CancellationToken::CallbackId CancellationToken::onCancel(std::function<void()> callback) {
+    if (!callback) {
+        return 0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (reason_.load(std::memory_order_acquire) == Reason::NONE) {
+            CallbackId id = nextId_++;
+            callbacks_.emplace(id, std::move(callback));
+            return id;
+        }
+    }
+    callback();
+    return 0;
+}
+
+void CancellationToken::removeCallback(CallbackId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    callbacks_.erase(id);
+}
+
+void CancellationToken::setProbe(std::function<bool()> probe) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    probe_ = std::move(probe);
+    nextProbe_ = Clock::time_point{};
+    hasProbe_.store(static_cast<bool>(probe_), std::memory_order_relaxed);
+}
+
+HttpResponse CancellationToken::response() const {
+    if (getReason() == Reason::DEADLINE) {
+        return HttpResponse::gatewayTimeout();
+    }
+    return HttpResponse(499); // Client Closed Request
+}
+
+CancellationToken::Clock::time_point CancellationToken::deadlineFromHeaders(const HttpRequest& request,
+                                                                            Clock::time_point now) {
+    auto deadline = Clock::time_point::max();
+    uint64_t value = 0;
+
+    // gRPC: TimeoutValue of up to 8 digits followed by a TimeoutUnit
+    const std::string grpcTimeout = request.getHeader("grpc-timeout");
+    if (grpcTimeout.size() >= 2 &&
+        parseDigits(std::string_view(grpcTimeout).substr(0, grpcTimeout.size() - 1), 8, value)) {
+        double unit = 0;
+        switch (grpcTimeout.back()) {
+            case 'H': unit = 3600; break;
+            case 'M': unit = 60; break;
+            case 'S': unit = 1; break;
+            case 'm': unit = 1e-3; break;
+            case 'u': unit = 1e-6; break;
+            case 'n': unit = 1e-9; break;
+            default: break;
+        }
+        if (unit > 0) {
+            deadline = std::min(deadline, after(now, static_cast<double>(value) * unit));
+        }
+    }
+
+    const std::string requestTimeout = request.getHeader("X-Request-Timeout");
+    if (parseDigits(requestTimeout, 12, value)) {
+        deadline = std::min(deadline, after(now, static_cast<double>(value) * 1e-3));
+    }
+    return deadline;
+}
+
+} // namespace cppSwitchboard
@@ -0,0 +1,141 @@
+/**
+ * @file canned_response.cpp
+ * @brief Implementation of pre-serialized responses and the Date cache
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-24
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/canned_response.h>
+#include <ostream>
+#include <boost/beast/http/status.hpp>
+#include <cctype>
+#include <ctime>
+
+namespace cppSwitchboard {
+
+namespace {
+    bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (std::tolower(static_cast<unsigned char>(a[i])) !=
+                std::tolower(static_cast<unsigned char>(b[i]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Statuses whose responses never carry a body (RFC 9110 section 8.6)
+    bool statusAllowsBody(int status) {
+        return status >= 200 && status != 204 && status != 304;
+    }
+
+    void appendTwoDigits(std::string& out, int value) {
+        out.push_back(static_cast<char>('0' + value / 10));
+        out.push_back(static_cast<char>('0' + value % 10));
+    }
+}
+
+// HttpDate implementation
+
+std::string_view HttpDate::now() {
+    static const char* const DAYS[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    static const char* const MONTHS[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                         "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+    thread_local std::time_t cachedSecond = -1;
+    thread_local std::string cached;
+
+    std::time_t second = std::time(nullptr);
+    if (second != cachedSecond) {
+        std::tm tm{};
+        gmtime_r(&second, &tm);
+        // Formatted by hand: strftime's %a and %b follow the C locale setting
+        cached.clear();
+        cached.append(DAYS[tm.tm_wday]).append(", ");
+        appendTwoDigits(cached, tm.tm_mday);
+        cached.push_back(' ');
+        cached.append(MONTHS[tm.tm_mon]).push_back(' ');
+        cached.append(std::to_string(tm.tm_year + 1900)).push_back(' ');
+        appendTwoDigits(cached, tm.tm_hour);
+        cached.push_back(':');
+        appendTwoDigits(cached, tm.tm_min);
+        cached.push_back(':');
+        appendTwoDigits(cached, tm.tm_sec);
+        cached.append(" GMT");
+        cachedSecond = second;
+    }
+    return cached;
+}
+
+// CannedResponse implementation
+
+std::shared_ptr<const CannedResponse> CannedResponse::create(HttpResponse response, std::string_view serverHeader) {
+    return std::shared_ptr<const CannedResponse>(new CannedResponse(std::move(response), serverHeader));
+}
+
+CannedResponse::CannedResponse(HttpResponse response, std::string_view serverHeader)
+    : response_(std::move(response)) {
+    const int status = response_.getStatus();
+    const auto& headers = response_.getHeaderFields();
+    const bool withBody = statusAllowsBody(status);
+    if (!withBody) {
+        response_.setBody(BodyBuffer());
+    }
+    response_.canned_.reset();
+
+    auto reason = boost::beast::http::obsolete_reason(static_cast<boost::beast::http::status>(status));
+    head_.reserve(128);
+    head_.push_back(' ');
+    head_.append(std::to_string(status)).push_back(' ');
+    head_.append(reason.data(), reason.size()).append("\r\n");
+
+    bool hasServer = false;
+    for (const auto& header : headers) {
+        if (equalsIgnoreCase(header.first, "Content-Length")) {
+            continue;
+        }
+        hasServer = hasServer || equalsIgnoreCase(header.first, "Server");
+        head_.append(header.first).append(": ").append(header.second).append("\r\n");
+    }
+    if (!hasServer && !serverHeader.empty()) {
+        head_.append("Server: ").append(serverHeader.data(), serverHeader.size()).append("\r\n");
+        hasServer = true;
+    }
+    hasServer_ = hasServer;
+    if (withBody) {
+        head_.append("Content-Length: ").append(std::to_string(response_.getBodyBuffer().size())).append("\r\n");
+    }
+}
+
+HttpResponse CannedResponse::toResponse() const {
+    HttpResponse response = response_;
+    response.canned_ = shared_from_this();
+    return response;
+}
+
+// CannedResponseRegistry implementation
+
+CannedResponseRegistry::CannedResponseRegistry(std::string serverHeader)
+    : serverHeader_(std::move(serverHeader)) {
+    errors_[HttpResponse::BAD_REQUEST] = add(HttpResponse::badRequest());
+    errors_[HttpResponse::NOT_FOUND] = add(HttpResponse::notFound());
+    errors_[HttpResponse::METHOD_NOT_ALLOWED] = add(HttpResponse::methodNotAllowed());
+    errors_[HttpResponse::PAYLOAD_TOO_LARGE] = add(HttpResponse::payloadTooLarge());
+    errors_[HttpResponse::INTERNAL_SERVER_ERROR] = add(HttpResponse::internalServerError());
+    errors_[HttpResponse::SERVICE_UNAVAILABLE] = add(HttpResponse::serviceUnavailable());
+    errors_[HttpResponse::GATEWAY_TIMEOUT] = add(HttpResponse::gatewayTimeout());
+}
+
+std::shared_ptr<const CannedResponse> CannedResponseRegistry::add(HttpResponse response) const {
+    return CannedResponse::create(std::move(response), serverHeader_);
+}
+
+std::shared_ptr<const CannedResponse> CannedResponseRegistry::error(int status) const {
+    auto it = errors_.find(status);
+    return it != errors_.end() ? it->second : nullptr;
+}
+
+} // namespace cppSwitchboard
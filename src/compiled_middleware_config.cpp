@@ -0,0 +1,395 @@
+/**
+ * @file compiled_middleware_config.cpp
+ * @brief Implementation of the compiled route-to-pipeline table
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-25
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/compiled_middleware_config.h>
+#include <cppSwitchboard/middleware_factory.h>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+
+namespace cppSwitchboard {
+
+namespace {
+    /// Same semantics as RouteMiddlewareConfig's glob: '*' spans any run, '?' one character
+    bool globMatch(std::string_view text, std::string_view pattern) {
+        size_t textPos = 0, patternPos = 0;
+        size_t starIdx = std::string_view::npos, match = 0;
+
+        while (textPos < text.length()) {
+            if (patternPos < pattern.length() &&
+                (pattern[patternPos] == '?' || pattern[patternPos] == text[textPos])) {
+                textPos++;
+                patternPos++;
+            } else if (patternPos < pattern.length() && pattern[patternPos] == '*') {
+                starIdx = patternPos;
+                match = textPos;
+                patternPos++;
+            } else if (starIdx != std::string_view::npos) {
+                patternPos = starIdx + 1;
+                match++;
+                textPos = match;
+            } else {
+                return false;
+            }
+        }
+
+        while (patternPos < pattern.length() && pattern[patternPos] == '*') {
+            patternPos++;
+        }
+        return patternPos == pattern.length();
+    }
+
+    /**
+     * @brief Append a canonical rendering of a configuration value
+     * @return false for value types that cannot be compared, which keeps
+     *         the owning middleware from being shared
+     */
+    bool appendValue(std::string& out, const std::any& value) {
+        if (const auto* text = std::any_cast<std::string>(&value)) {
+            out.append("s:").append(*text);
+        } else if (const auto* number = std::any_cast<int>(&value)) {
+            out.append("i:").append(std::to_string(*number));
+        } else if (const auto* real = std::any_cast<double>(&value)) {
+            out.append("d:").append(std::to_string(*real));
+        } else if (const auto* flag = std::any_cast<bool>(&value)) {
+            out.append(*flag ? "b:1" : "b:0");
+        } else if (const auto* list = std::any_cast<std::vector<std::string>>(&value)) {
+            out.append("a:").append(std::to_string(list->size()));
+            for (const auto& item : *list) {
+                out.append(1, '\0').append(item);
+            }
+        } else if (const auto* nested = std::any_cast<std::unordered_map<std::string, std::any>>(&value)) {
+            // Keys in sorted order so equal maps render equally
+            std::map<std::string_view, const std::any*> sorted;
+            for (const auto& [key, child] : *nested) {
+                sorted.emplace(key, &child);
+            }
+            out.append("m:").append(std::to_string(sorted.size()));
+            for (const auto& [key, child] : sorted) {
+                out.append(1, '\0').append(key).append(1, '=');
+                if (!appendValue(out, *child)) {
+                    return false;
+                }
+            }
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    /// Identity of a middleware configuration; empty when it cannot be shared
+    std::string signatureOf(const MiddlewareInstanceConfig& config) {
+        std::string signature = config.name;
+        signature.append(1, '\0').append(std::to_string(config.priority));
+        std::map<std::string_view, const std::any*> sorted;
+        for (const auto& [key, value] : config.config) {
+            sorted.emplace(key, &value);
+        }
+        for (const auto& [key, value] : sorted) {
+            signature.append(1, '\0').append(key).append(1, '=');
+            if (!appendValue(signature, *value)) {
+                return std::string();
+            }
+        }
+        return signature;
+    }
+
+    /// Stands in for a lazily created middleware whose creation failed
+    class UnavailableMiddleware : public Middleware {
+    public:
+        UnavailableMiddleware(std::string middlewareName, int priority)
+            : middlewareName_(std::move(middlewareName)), priority_(priority) {}
+
+        HttpResponse handle(const HttpRequest&, Context&, NextHandler) override {
+            return HttpResponse::internalServerError("Middleware unavailable: " + middlewareName_);
+        }
+
+        std::string getName() const override { return "UnavailableMiddleware"; }
+        int getPriority() const override { return priority_; }
+
+    private:
+        std::string middlewareName_;
+        int priority_;
+    };
+
+    constexpr size_t PIPELINE_FROM_PATH = SIZE_MAX;
+}
+
+class CompiledMiddlewareConfig::PipelineHandler : public HttpHandler {
+public:
+    PipelineHandler(std::shared_ptr<const CompiledMiddlewareConfig> table, size_t pipeline,
+                    std::shared_ptr<HttpHandler> handler)
+        : table_(std::move(table)), pipeline_(pipeline), handler_(std::move(handler)) {}
+
+    HttpResponse handle(const HttpRequest& request) override {
+        // A fixed pipeline was resolved at registration; otherwise look it up
+        size_t index = pipeline_ != PIPELINE_FROM_PATH ? pipeline_ : table_->pipelineIndexFor(request.getPath());
+        Context context;
+        return table_->pipelineAt(index)->execute(request, context, *handler_);
+    }
+
+private:
+    std::shared_ptr<const CompiledMiddlewareConfig> table_;
+    size_t pipeline_;
+    std::shared_ptr<HttpHandler> handler_;
+};
+
+std::shared_ptr<const CompiledMiddlewareConfig> CompiledMiddlewareConfig::compile(
+    const ComprehensiveMiddlewareConfig& config, MiddlewareFactory& factory, std::string& errorMessage,
+    MiddlewareInstantiation instantiation) {
+    std::shared_ptr<CompiledMiddlewareConfig> compiled(new CompiledMiddlewareConfig());
+    compiled->factory_ = &factory;
+    std::lock_guard<std::mutex> lock(compiled->instancesMutex_);
+
+    // Each distinct stack becomes one pipeline, keyed by its instances or,
+    // before they exist, by their configurations
+    std::map<std::vector<Middleware*>, size_t> pipelineIndex;
+    std::map<std::vector<std::string>, size_t> lazyPipelineIndex;
+    auto pipelineFor = [&](const std::vector<const MiddlewareInstanceConfig*>& stack, bool lazy) -> size_t {
+        if (lazy) {
+            std::vector<std::string> key;
+            bool shareable = true;
+            for (const auto* instanceConfig : stack) {
+                if (!factory.validateMiddlewareConfig(*instanceConfig, errorMessage)) {
+                    errorMessage = "Failed to create middleware: " + instanceConfig->name + ": " + errorMessage;
+                    return SIZE_MAX;
+                }
+                key.push_back(signatureOf(*instanceConfig));
+                shareable = shareable && !key.back().empty();
+            }
+            if (shareable) {
+                auto it = lazyPipelineIndex.find(key);
+                if (it != lazyPipelineIndex.end()) {
+                    return it->second;
+                }
+            }
+            auto pending = std::make_unique<LazyPipeline>();
+            for (const auto* instanceConfig : stack) {
+                pending->stack.push_back(*instanceConfig);
+            }
+            compiled->pipelines_.emplace_back();
+            compiled->lazyPipelines_.push_back(std::move(pending));
+            compiled->pendingPipelines_++;
+            if (shareable) {
+                lazyPipelineIndex.emplace(std::move(key), compiled->pipelines_.size() - 1);
+            }
+            return compiled->pipelines_.size() - 1;
+        }
+
+        std::vector<std::shared_ptr<Middleware>> middleware;
+        std::vector<Middleware*> key;
+        for (const auto* instanceConfig : stack) {
+            auto instance = compiled->instantiate(*instanceConfig);
+            if (!instance) {
+                errorMessage = "Failed to create middleware: " + instanceConfig->name;
+                return SIZE_MAX;
+            }
+            key.push_back(instance.get());
+            middleware.push_back(std::move(instance));
+        }
+
+        auto it = pipelineIndex.find(key);
+        if (it != pipelineIndex.end()) {
+            return it->second;
+        }
+        auto pipeline = std::make_shared<MiddlewarePipeline>();
+        for (auto& instance : middleware) {
+            pipeline->addMiddleware(std::move(instance));
+        }
+        // Sorts once up front so concurrent executions only read
+        pipeline->getMiddlewareNames();
+        compiled->pipelines_.push_back(std::move(pipeline));
+        compiled->lazyPipelines_.emplace_back();
+        pipelineIndex.emplace(std::move(key), compiled->pipelines_.size() - 1);
+        return compiled->pipelines_.size() - 1;
+    };
+
+    auto byPriority = [](const MiddlewareInstanceConfig* a, const MiddlewareInstanceConfig* b) {
+        return a->priority > b->priority;
+    };
+
+    // Every request runs the global stack, so it is never deferred
+    std::vector<const MiddlewareInstanceConfig*> globalStack;
+    for (const auto& middleware : config.global.middlewares) {
+        if (middleware.enabled) {
+            globalStack.push_back(&middleware);
+        }
+    }
+    std::stable_sort(globalStack.begin(), globalStack.end(), byPriority);
+    if (pipelineFor(globalStack, false) == SIZE_MAX) {
+        return nullptr;
+    }
+
+    compiled->executors_ = config.executors;
+    for (const auto& route : config.routes) {
+        Rule rule;
+        rule.pattern = route.pattern;
+        rule.isRegex = route.isRegex;
+        rule.executor = route.executor;
+        rule.timeout = route.timeout;
+        if (!route.executor.empty() &&
+            std::none_of(config.executors.begin(), config.executors.end(),
+                         [&route](const BulkheadConfig& executor) { return executor.name == route.executor; })) {
+            errorMessage = "Route '" + route.pattern + "' uses undeclared executor '" + route.executor + "'";
+            return nullptr;
+        }
+        if (route.isRegex) {
+            try {
+                rule.regex = std::regex(route.pattern, std::regex::ECMAScript | std::regex::optimize);
+            } catch (const std::regex_error& e) {
+                errorMessage = "Invalid regex pattern '" + route.pattern + "': " + e.what();
+                return nullptr;
+            }
+        } else {
+            rule.literalPrefix = route.pattern.substr(0, route.pattern.find_first_of("*?"));
+        }
+
+        std::vector<const MiddlewareInstanceConfig*> stack = globalStack;
+        for (const auto& middleware : route.middlewares) {
+            if (middleware.enabled) {
+                stack.push_back(&middleware);
+            }
+        }
+        std::stable_sort(stack.begin(), stack.end(), byPriority);
+
+        rule.pipeline = pipelineFor(stack, instantiation == MiddlewareInstantiation::LAZY);
+        if (rule.pipeline == SIZE_MAX) {
+            return nullptr;
+        }
+        compiled->rules_.push_back(std::move(rule));
+    }
+
+    return compiled;
+}
+
+std::shared_ptr<Middleware> CompiledMiddlewareConfig::instantiate(const MiddlewareInstanceConfig& config) const {
+    // Each distinct middleware configuration is created once
+    std::string signature = signatureOf(config);
+    if (!signature.empty()) {
+        auto it = instances_.find(signature);
+        if (it != instances_.end()) {
+            return it->second;
+        }
+    }
+    auto middleware = factory_->createMiddleware(config);
+    if (middleware) {
+        instanceCount_++;
+        if (!signature.empty()) {
+            instances_.emplace(std::move(signature), middleware);
+        }
+    }
+    return middleware;
+}
+
+int CompiledMiddlewareConfig::findRule(std::string_view path) const {
+    for (size_t i = 0; i < rules_.size(); ++i) {
+        const Rule& rule = rules_[i];
+        if (rule.isRegex) {
+            if (std::regex_match(path.begin(), path.end(), rule.regex)) {
+                return static_cast<int>(i);
+            }
+        } else if (path.compare(0, rule.literalPrefix.size(), rule.literalPrefix) == 0 &&
+                   globMatch(path, rule.pattern)) {
+            return static_cast<int>(i);
+        }
+    }
+    return NO_RULE;
+}
+
+const std::string& CompiledMiddlewareConfig::getExecutor(std::string_view path) const {
+    return getRuleExecutor(findRule(path));
+}
+
+std::chrono::milliseconds CompiledMiddlewareConfig::getTimeout(std::string_view path) const {
+    return getRuleTimeout(findRule(path));
+}
+
+const std::shared_ptr<MiddlewarePipeline>& CompiledMiddlewareConfig::getRulePipeline(int rule) const {
+    return pipelineAt(rule == NO_RULE ? 0 : rules_[static_cast<size_t>(rule)].pipeline);
+}
+
+const std::string& CompiledMiddlewareConfig::getRuleExecutor(int rule) const {
+    static const std::string sharedPool;
+    return rule == NO_RULE ? sharedPool : rules_[static_cast<size_t>(rule)].executor;
+}
+
+std::chrono::milliseconds CompiledMiddlewareConfig::getRuleTimeout(int rule) const {
+    return rule == NO_RULE ? std::chrono::milliseconds(0) : rules_[static_cast<size_t>(rule)].timeout;
+}
+
+size_t CompiledMiddlewareConfig::pipelineIndexFor(std::string_view path) const {
+    int rule = findRule(path);
+    return rule == NO_RULE ? 0 : rules_[static_cast<size_t>(rule)].pipeline;
+}
+
+const std::shared_ptr<MiddlewarePipeline>& CompiledMiddlewareConfig::pipelineAt(size_t index) const {
+    if (const auto& lazy = lazyPipelines_[index]) {
+        std::call_once(lazy->built, [this, index, &lazy]() {
+            auto pipeline = std::make_shared<MiddlewarePipeline>();
+            {
+                std::lock_guard<std::mutex> lock(instancesMutex_);
+                for (const auto& instanceConfig : lazy->stack) {
+                    auto instance = instantiate(instanceConfig);
+                    pipeline->addMiddleware(instance ? std::move(instance)
+                        : std::make_shared<UnavailableMiddleware>(instanceConfig.name, instanceConfig.priority));
+                }
+            }
+            pipeline->getMiddlewareNames();
+            pipelines_[index] = std::move(pipeline);
+            pendingPipelines_--;
+        });
+    }
+    return pipelines_[index];
+}
+
+bool CompiledMiddlewareConfig::isEmptyPipeline(size_t index) const {
+    const auto& lazy = lazyPipelines_[index];
+    return lazy ? lazy->stack.empty() : pipelines_[index]->getMiddlewareCount() == 0;
+}
+
+const std::shared_ptr<MiddlewarePipeline>& CompiledMiddlewareConfig::getPipeline(std::string_view path) const {
+    return pipelineAt(pipelineIndexFor(path));
+}
+
+size_t CompiledMiddlewareConfig::warmUp() const {
+    size_t pending = getPendingPipelineCount();
+    for (size_t i = 0; i < lazyPipelines_.size() && getPendingPipelineCount() > 0; ++i) {
+        if (lazyPipelines_[i]) {
+            pipelineAt(i);
+        }
+    }
+    return pending;
+}
+
+std::shared_ptr<HttpHandler> CompiledMiddlewareConfig::wrap(const std::string& routePattern,
+                                                            std::shared_ptr<HttpHandler> handler) const {
+    if (!handler) {
+        throw std::invalid_argument("Handler cannot be null");
+    }
+
+    const bool literal = routePattern.find_first_of("{*") == std::string::npos;
+    if (literal) {
+        size_t index = pipelineIndexFor(routePattern);
+        if (isEmptyPipeline(index)) {
+            return handler;
+        }
+        return std::make_shared<PipelineHandler>(shared_from_this(), index, std::move(handler));
+    }
+
+    bool anyMiddleware = false;
+    for (size_t i = 0; i < pipelines_.size() && !anyMiddleware; ++i) {
+        anyMiddleware = !isEmptyPipeline(i);
+    }
+    if (!anyMiddleware) {
+        return handler;
+    }
+    return std::make_shared<PipelineHandler>(shared_from_this(), PIPELINE_FROM_PATH, std::move(handler));
+}
+
+} // namespace cppSwitchboard
@@ -1,4 +1,5 @@
 #include <cppSwitchboard/config.h>
+#include <yaml-cpp/yaml.h>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -9,7 +10,8 @@
 
 namespace cppSwitchboard {
 
-// Simple YAML parser for our configuration needs
+// Configuration tree read with yaml-cpp; the accessors fall back to their
+// default when a key is missing or its value does not convert
 class SimpleYamlParser {
 public:
     struct Node {
@@ -60,97 +62,31 @@ public:
         }
     };
     
+    /**
+     * @throws YAML::Exception on malformed YAML
+     */
     static Node parse(const std::string& content) {
         Node root;
-        std::istringstream stream(content);
-        std::string line;
-        std::vector<std::pair<int, std::string>> lines;
-        
-        // Read all lines with indentation level
-        while (std::getline(stream, line)) {
-            if (line.empty() || line[0] == '#') continue;
-            
-            size_t indent = 0;
-            while (indent < line.length() && (line[indent] == ' ' || line[indent] == '\t')) {
-                indent++;
-            }
-            
-            if (indent < line.length()) {
-                lines.push_back({static_cast<int>(indent), line.substr(indent)});
-            }
-        }
-        
-        parseLines(lines, 0, lines.size(), 0, root);
+        convert(YAML::Load(content), root);
         return root;
     }
 
 private:
-    static void parseLines(const std::vector<std::pair<int, std::string>>& lines, 
-                          size_t start, size_t end, int baseIndent, Node& node) {
-        for (size_t i = start; i < end; ++i) {
-            int indent = lines[i].first;
-            const std::string& line = lines[i].second;
-            
-            if (indent < baseIndent) break;
-            if (indent > baseIndent) continue;
-            
-            // Parse key-value pair
-            size_t colonPos = line.find(':');
-            if (colonPos != std::string::npos) {
-                std::string key = trim(line.substr(0, colonPos));
-                std::string value = trim(line.substr(colonPos + 1));
-                
-                Node& child = node.children[key];
-                
-                if (!value.empty() && value != "[]") {
-                    // Handle array notation [item1, item2]
-                    if (value.front() == '[' && value.back() == ']') {
-                        child.isArray = true;
-                        std::string arrayContent = value.substr(1, value.length() - 2);
-                        std::istringstream arrayStream(arrayContent);
-                        std::string item;
-                        while (std::getline(arrayStream, item, ',')) {
-                            Node arrayItem;
-                            arrayItem.value = trim(item);
-                            // Remove quotes if present
-                            if (arrayItem.value.front() == '"' && arrayItem.value.back() == '"') {
-                                arrayItem.value = arrayItem.value.substr(1, arrayItem.value.length() - 2);
-                            }
-                            child.array.push_back(arrayItem);
-                        }
-                    } else {
-                        // Remove quotes if present
-                        if (value.front() == '"' && value.back() == '"') {
-                            value = value.substr(1, value.length() - 2);
-                        }
-                        child.value = value;
-                    }
-                }
-                
-                // Find child lines
-                size_t childStart = i + 1;
-                size_t childEnd = childStart;
-                int childIndent = indent + 2; // Assuming 2-space indentation
-                
-                while (childEnd < end && 
-                       (childEnd < lines.size() && lines[childEnd].first >= childIndent)) {
-                    childEnd++;
-                }
-                
-                if (childStart < childEnd) {
-                    parseLines(lines, childStart, childEnd, childIndent, child);
-                    i = childEnd - 1; // Skip processed lines
-                }
+    static void convert(const YAML::Node& yaml, Node& node) {
+        if (yaml.IsScalar()) {
+            node.value = yaml.Scalar();
+        } else if (yaml.IsSequence()) {
+            node.isArray = true;
+            for (const auto& item : yaml) {
+                node.array.emplace_back();
+                convert(item, node.array.back());
+            }
+        } else if (yaml.IsMap()) {
+            for (const auto& entry : yaml) {
+                convert(entry.second, node.children[entry.first.Scalar()]);
             }
         }
     }
-    
-    static std::string trim(const std::string& str) {
-        size_t start = str.find_first_not_of(" \t\r\n");
-        if (start == std::string::npos) return "";
-        size_t end = str.find_last_not_of(" \t\r\n");
-        return str.substr(start, end - start + 1);
-    }
 };
 
 std::unique_ptr<ServerConfig> ConfigLoader::loadFromFile(const std::string& filename) {
@@ -183,6 +119,7 @@ std::unique_ptr<ServerConfig> ConfigLoader::loadFromString(const std::string& ya
             config->http1.port = http1Node.getChild("port").getInt(8080);
             config->http1.bindAddress = http1Node.getChild("bindAddress").getString(
                 http1Node.getChild("bind_address").getString("0.0.0.0"));
+            config->http1.parser = http1Node.getChild("parser").getString("beast");
         }
         
         // HTTP/2 configuration
@@ -223,8 +160,18 @@ std::unique_ptr<ServerConfig> ConfigLoader::loadFromString(const std::string& ya
                 generalNode.getChild("enable_logging").getBool(true));
             config->general.logLevel = generalNode.getChild("logLevel").getString(
                 generalNode.getChild("log_level").getString("info"));
-            config->general.workerThreads = generalNode.getChild("workerThreads").getInt(
-                generalNode.getChild("worker_threads").getInt(4));
+            // "auto" becomes 0: one worker per hardware thread
+            const auto& workerThreads = generalNode.hasChild("workerThreads")
+                ? generalNode.getChild("workerThreads") : generalNode.getChild("worker_threads");
+            config->general.workerThreads = workerThreads.getString() == "auto" ? 0 : workerThreads.getInt(4);
+            
+            if (generalNode.hasChild("admission")) {
+                const auto& admissionNode = generalNode.getChild("admission");
+                auto& admission = config->general.admission;
+                admission.enabled = admissionNode.getChild("enabled").getBool(false);
+                admission.target = std::chrono::milliseconds(admissionNode.getChild("target_ms").getInt(5));
+                admission.interval = std::chrono::milliseconds(admissionNode.getChild("interval_ms").getInt(100));
+            }
         }
             
         // Security configuration
@@ -378,6 +325,11 @@ bool ConfigLoader::validateConfig(const ServerConfig& config, std::string& error
         return false;
     }
     
+    if (config.http1.parser != "beast" && config.http1.parser != "simd") {
+        errorMessage = "Invalid HTTP/1.1 parser: " + config.http1.parser + " (expected 'beast' or 'simd')";
+        return false;
+    }
+    
     if (config.http1.enabled && config.http2.enabled && config.http1.port == config.http2.port) {
         errorMessage = "HTTP/1.1 and HTTP/2 cannot use the same port";
         return false;
@@ -401,8 +353,14 @@ bool ConfigLoader::validateConfig(const ServerConfig& config, std::string& error
         return false;
     }
     
-    if (config.general.workerThreads < 1) {
-        errorMessage = "Worker threads must be at least 1";
+    if (config.general.workerThreads < 0) {
+        errorMessage = "Worker threads must be at least 1, or auto";
+        return false;
+    }
+    
+    const auto& admission = config.general.admission;
+    if (admission.enabled && (admission.target.count() < 1 || admission.interval < admission.target)) {
+        errorMessage = "Admission target must be at least 1 ms and no longer than the interval";
         return false;
     }
     
@@ -461,8 +419,14 @@ bool ConfigValidator::validateGeneralConfig(const GeneralConfig& general, std::s
         return false;
     }
     
-    if (general.workerThreads < 1) {
-        errorMessage = "Worker threads must be at least 1";
+    if (general.workerThreads < 0) {
+        errorMessage = "Worker threads must be at least 1, or auto";
+        return false;
+    }
+    
+    const auto& admission = general.admission;
+    if (admission.enabled && (admission.target.count() < 1 || admission.interval < admission.target)) {
+        errorMessage = "Admission target must be at least 1 ms and no longer than the interval";
         return false;
     }
     
@@ -0,0 +1,267 @@
+/**
+ * @file config_schema.cpp
+ * @brief Implementation of typed middleware configuration schemas
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/config_schema.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace cppSwitchboard {
+
+namespace {
+    bool holdsType(const std::any& value, ConfigValueType type) {
+        switch (type) {
+            case ConfigValueType::STRING:       return value.type() == typeid(std::string);
+            case ConfigValueType::INTEGER:      return value.type() == typeid(int);
+            case ConfigValueType::NUMBER:       return value.type() == typeid(double) || value.type() == typeid(int);
+            case ConfigValueType::BOOLEAN:      return value.type() == typeid(bool);
+            case ConfigValueType::STRING_ARRAY: return value.type() == typeid(std::vector<std::string>);
+        }
+        return false;
+    }
+
+    std::string formatNumber(double value) {
+        std::string text = std::to_string(value);
+        text.erase(text.find_last_not_of('0') + 1);
+        if (!text.empty() && text.back() == '.') {
+            text.pop_back();
+        }
+        return text;
+    }
+
+    bool jsonType(const std::string& name, const nlohmann::json& property, ConfigValueType& type) {
+        if (name == "string") {
+            type = ConfigValueType::STRING;
+        } else if (name == "integer") {
+            type = ConfigValueType::INTEGER;
+        } else if (name == "number") {
+            type = ConfigValueType::NUMBER;
+        } else if (name == "boolean") {
+            type = ConfigValueType::BOOLEAN;
+        } else if (name == "array") {
+            auto items = property.find("items");
+            if (items != property.end() && items->is_object() && items->value("type", "string") != "string") {
+                return false;
+            }
+            type = ConfigValueType::STRING_ARRAY;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    std::any jsonValue(const nlohmann::json& value, ConfigValueType type) {
+        switch (type) {
+            case ConfigValueType::STRING:       return value.get<std::string>();
+            case ConfigValueType::INTEGER:      return value.get<int>();
+            case ConfigValueType::NUMBER:       return value.get<double>();
+            case ConfigValueType::BOOLEAN:      return value.get<bool>();
+            case ConfigValueType::STRING_ARRAY: return value.get<std::vector<std::string>>();
+        }
+        return {};
+    }
+}
+
+ConfigSchema& ConfigSchema::field(std::string name, ConfigValueType type) {
+    ConfigField field;
+    field.name = std::move(name);
+    field.type = type;
+    fields_.push_back(std::move(field));
+    return *this;
+}
+
+ConfigSchema& ConfigSchema::required() {
+    if (!fields_.empty()) {
+        fields_.back().required = true;
+    }
+    return *this;
+}
+
+ConfigSchema& ConfigSchema::defaultValue(std::any value) {
+    if (!fields_.empty()) {
+        fields_.back().defaultValue = std::move(value);
+    }
+    return *this;
+}
+
+ConfigSchema& ConfigSchema::range(double minimum, double maximum) {
+    if (!fields_.empty()) {
+        fields_.back().minimum = minimum;
+        fields_.back().maximum = maximum;
+    }
+    return *this;
+}
+
+ConfigSchema& ConfigSchema::minimum(double minimum) {
+    if (!fields_.empty()) {
+        fields_.back().minimum = minimum;
+    }
+    return *this;
+}
+
+ConfigSchema& ConfigSchema::oneOf(std::vector<std::string> values) {
+    if (!fields_.empty()) {
+        fields_.back().allowedValues = std::move(values);
+    }
+    return *this;
+}
+
+ConfigSchema& ConfigSchema::strict(bool strict) {
+    strict_ = strict;
+    return *this;
+}
+
+const ConfigField* ConfigSchema::findField(const std::string& name) const {
+    auto it = std::find_if(fields_.begin(), fields_.end(),
+                           [&name](const ConfigField& field) { return field.name == name; });
+    return it != fields_.end() ? &*it : nullptr;
+}
+
+bool ConfigSchema::checkValue(const ConfigField& field, const std::any& value, std::string& errorMessage) {
+    if (!holdsType(value, field.type)) {
+        errorMessage = std::string("expected ") + (field.type == ConfigValueType::INTEGER ? "an " : "a ") +
+                       typeName(field.type);
+        return false;
+    }
+
+    if (field.type == ConfigValueType::INTEGER || field.type == ConfigValueType::NUMBER) {
+        double number = value.type() == typeid(int) ? std::any_cast<int>(value) : std::any_cast<double>(value);
+        if ((field.minimum && number < *field.minimum) || (field.maximum && number > *field.maximum)) {
+            errorMessage = "must be ";
+            if (field.minimum && field.maximum) {
+                errorMessage += "between " + formatNumber(*field.minimum) + " and " + formatNumber(*field.maximum);
+            } else if (field.minimum) {
+                errorMessage += "at least " + formatNumber(*field.minimum);
+            } else {
+                errorMessage += "at most " + formatNumber(*field.maximum);
+            }
+            return false;
+        }
+    }
+
+    if (!field.allowedValues.empty()) {
+        auto allowed = [&field](const std::string& text) {
+            return std::find(field.allowedValues.begin(), field.allowedValues.end(), text) != field.allowedValues.end();
+        };
+        bool valid = true;
+        if (field.type == ConfigValueType::STRING) {
+            valid = allowed(std::any_cast<const std::string&>(value));
+        } else if (field.type == ConfigValueType::STRING_ARRAY) {
+            const auto& items = std::any_cast<const std::vector<std::string>&>(value);
+            valid = std::all_of(items.begin(), items.end(), allowed);
+        }
+        if (!valid) {
+            errorMessage = "must be one of:";
+            for (size_t i = 0; i < field.allowedValues.size(); ++i) {
+                errorMessage += (i == 0 ? " " : ", ") + field.allowedValues[i];
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ConfigSchema::validate(const std::unordered_map<std::string, std::any>& config,
+                            std::vector<std::string>& errors) const {
+    const size_t before = errors.size();
+    for (const auto& field : fields_) {
+        auto it = config.find(field.name);
+        std::string errorMessage;
+        if (it == config.end()) {
+            if (field.required) {
+                errors.push_back("'" + field.name + "' is required");
+            }
+        } else if (!checkValue(field, it->second, errorMessage)) {
+            errors.push_back("'" + field.name + "' " + errorMessage);
+        }
+    }
+    if (strict_) {
+        for (const auto& [key, value] : config) {
+            if (!findField(key)) {
+                errors.push_back("unknown key '" + key + "'");
+            }
+        }
+    }
+    return errors.size() == before;
+}
+
+std::shared_ptr<ConfigSchema> ConfigSchema::fromJsonSchema(const std::string& jsonSchema, std::string& errorMessage) {
+    nlohmann::json root = nlohmann::json::parse(jsonSchema, nullptr, false);
+    if (root.is_discarded() || !root.is_object()) {
+        errorMessage = "configuration schema is not a JSON object";
+        return nullptr;
+    }
+
+    auto schema = std::make_shared<ConfigSchema>();
+    auto properties = root.find("properties");
+    if (properties != root.end() && properties->is_object()) {
+        for (const auto& [name, property] : properties->items()) {
+            ConfigValueType type = ConfigValueType::STRING;
+            if (!property.is_object() || !jsonType(property.value("type", "string"), property, type)) {
+                errorMessage = "unsupported type of property '" + name + "'";
+                return nullptr;
+            }
+            schema->field(name, type);
+            try {
+                if (property.contains("default")) {
+                    schema->defaultValue(jsonValue(property["default"], type));
+                }
+            } catch (const nlohmann::json::exception&) {
+                errorMessage = "default of property '" + name + "' does not match its type";
+                return nullptr;
+            }
+            ConfigField& field = schema->fields_.back();
+            if (property.contains("minimum") && property["minimum"].is_number()) {
+                field.minimum = property["minimum"].get<double>();
+            }
+            if (property.contains("maximum") && property["maximum"].is_number()) {
+                field.maximum = property["maximum"].get<double>();
+            }
+            const nlohmann::json& values = type == ConfigValueType::STRING_ARRAY && property.contains("items")
+                                               ? property["items"] : property;
+            if (values.is_object() && values.contains("enum") && values["enum"].is_array()) {
+                for (const auto& value : values["enum"]) {
+                    if (value.is_string()) {
+                        field.allowedValues.push_back(value.get<std::string>());
+                    }
+                }
+            }
+        }
+    }
+
+    auto required = root.find("required");
+    if (required != root.end() && required->is_array()) {
+        for (const auto& name : *required) {
+            auto field = std::find_if(schema->fields_.begin(), schema->fields_.end(), [&name](const ConfigField& field) {
+                return name.is_string() && field.name == name.get<std::string>();
+            });
+            if (field == schema->fields_.end()) {
+                errorMessage = "required property " + name.dump() + " is not declared";
+                return nullptr;
+            }
+            field->required = true;
+        }
+    }
+
+    auto additional = root.find("additionalProperties");
+    schema->strict(additional != root.end() && additional->is_boolean() && !additional->get<bool>());
+    return schema;
+}
+
+const char* ConfigSchema::typeName(ConfigValueType type) {
+    switch (type) {
+        case ConfigValueType::STRING:       return "string";
+        case ConfigValueType::INTEGER:      return "integer";
+        case ConfigValueType::NUMBER:       return "number";
+        case ConfigValueType::BOOLEAN:      return "boolean";
+        case ConfigValueType::STRING_ARRAY: return "string array";
+    }
+    return "value";
+}
+
+} // namespace cppSwitchboard
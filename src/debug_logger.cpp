@@ -85,7 +85,7 @@ void DebugLogger::logRequestPayload(const HttpRequest& request) {
         return;
     }
     
-    const std::string& body = request.getBody();
+    std::string_view body = request.getBodyView();
     if (body.empty()) {
         return; // Don't log empty payloads
     }
@@ -119,7 +119,7 @@ void DebugLogger::logResponsePayload(const HttpResponse& response, const std::st
         return;
     }
     
-    const std::string& body = response.getBody();
+    std::string_view body = response.getBodyView();
     if (body.empty()) {
         return; // Don't log empty payloads
     }
@@ -206,12 +206,12 @@ bool DebugLogger::shouldExcludeContentType(const std::string& contentType) const
     return false;
 }
 
-std::string DebugLogger::truncatePayload(const std::string& payload) const {
+std::string DebugLogger::truncatePayload(std::string_view payload) const {
     if (static_cast<int>(payload.size()) <= config_.payload.maxPayloadSizeBytes) {
-        return payload;
+        return std::string(payload);
     }
     
-    std::string truncated = payload.substr(0, config_.payload.maxPayloadSizeBytes);
+    std::string truncated(payload.substr(0, config_.payload.maxPayloadSizeBytes));
     truncated += "\n... [TRUNCATED - showing first " + std::to_string(config_.payload.maxPayloadSizeBytes) + 
                  " bytes of " + std::to_string(payload.size()) + " total bytes]";
     return truncated;
@@ -0,0 +1,258 @@
+/**
+ * @file file_watcher.cpp
+ * @brief Implementation of inotify based file change notification
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-26
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/file_watcher.h>
+#include <algorithm>
+#include <cerrno>
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <set>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cppSwitchboard {
+
+namespace {
+    constexpr uint32_t FILE_EVENTS = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_ATTRIB;
+    // Whole directories only report files once they are complete
+    constexpr uint32_t DIRECTORY_EVENTS = IN_CLOSE_WRITE | IN_MOVED_TO;
+
+    void splitPath(const std::string& path, std::string& directory, std::string& name) {
+        size_t slash = path.find_last_of('/');
+        if (slash == std::string::npos) {
+            directory = ".";
+            name = path;
+        } else {
+            directory = slash == 0 ? "/" : path.substr(0, slash);
+            name = path.substr(slash + 1);
+        }
+    }
+
+    void closeDescriptor(int& fd) {
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+}
+
+FileWatcher::FileWatcher(std::vector<std::string> files, ChangeCallback onChange)
+    : onChange_([onChange = std::move(onChange)](const std::vector<std::string>&) { onChange(); }) {
+    // One entry per directory, holding the names of the files watched in it
+    for (const auto& file : files) {
+        std::string directory, name;
+        splitPath(file, directory, name);
+        auto it = std::find_if(directories_.begin(), directories_.end(),
+                               [&directory](const WatchedDirectory& watched) { return watched.path == directory; });
+        if (it == directories_.end()) {
+            directories_.push_back({directory, {}});
+            it = directories_.end() - 1;
+        }
+        it->names.push_back(std::move(name));
+    }
+}
+
+FileWatcher::FileWatcher(std::vector<std::string> directories, std::vector<std::string> extensions,
+                         PathsCallback onChange)
+    : extensions_(std::move(extensions)), onChange_(std::move(onChange)) {
+    for (auto& directory : directories) {
+        while (directory.size() > 1 && directory.back() == '/') {
+            directory.pop_back();
+        }
+        directories_.push_back({std::move(directory), {}});
+    }
+}
+
+FileWatcher::~FileWatcher() {
+    stop();
+}
+
+bool FileWatcher::start(std::chrono::milliseconds pollInterval) {
+    if (running_ || directories_.empty()) {
+        return false;
+    }
+    pollInterval_ = pollInterval;
+
+    inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd_ >= 0) {
+        const uint32_t events = directories_.front().names.empty() ? DIRECTORY_EVENTS : FILE_EVENTS;
+        for (size_t i = 0; i < directories_.size(); ++i) {
+            int wd = inotify_add_watch(inotifyFd_, directories_[i].path.c_str(), events);
+            if (wd >= 0) {
+                watched_[wd] = i;
+            }
+        }
+        if (watched_.empty() || pipe2(wakePipe_, O_CLOEXEC | O_NONBLOCK) != 0) {
+            // No directory could be watched: fall back to polling
+            closeDescriptor(inotifyFd_);
+            watched_.clear();
+        }
+    }
+
+    running_ = true;
+    if (inotifyFd_ >= 0) {
+        thread_ = std::thread(&FileWatcher::runInotify, this);
+    } else {
+        thread_ = std::thread(&FileWatcher::runPolling, this);
+    }
+    return true;
+}
+
+void FileWatcher::stop() {
+    {
+        std::lock_guard<std::mutex> lock(stopMutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    stopCondition_.notify_all();
+    if (wakePipe_[1] >= 0) {
+        char byte = 0;
+        (void)!write(wakePipe_[1], &byte, 1);
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    closeDescriptor(inotifyFd_);
+    closeDescriptor(wakePipe_[0]);
+    closeDescriptor(wakePipe_[1]);
+    watched_.clear();
+}
+
+bool FileWatcher::matches(const WatchedDirectory& directory, const std::string& name) const {
+    if (!directory.names.empty()) {
+        return std::find(directory.names.begin(), directory.names.end(), name) != directory.names.end();
+    }
+    if (extensions_.empty()) {
+        return true;
+    }
+    return std::any_of(extensions_.begin(), extensions_.end(), [&name](const std::string& extension) {
+        return name.size() > extension.size() &&
+               name.compare(name.size() - extension.size(), extension.size(), extension) == 0;
+    });
+}
+
+void FileWatcher::runInotify() {
+    alignas(inotify_event) char buffer[4096];
+    std::set<std::string> pending;
+
+    while (running_) {
+        pollfd fds[2] = {{inotifyFd_, POLLIN, 0}, {wakePipe_[0], POLLIN, 0}};
+        // While changes are pending, wait only for the quiet period to pass
+        int timeout = pending.empty() ? -1 : static_cast<int>(debounce_.count());
+        int ready = poll(fds, 2, timeout);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (!running_ || (fds[1].revents & POLLIN)) {
+            break;
+        }
+        if (ready == 0) {
+            std::vector<std::string> changed(pending.begin(), pending.end());
+            pending.clear();
+            onChange_(changed);
+            continue;
+        }
+
+        ssize_t length;
+        while ((length = read(inotifyFd_, buffer, sizeof(buffer))) > 0) {
+            for (char* p = buffer; p < buffer + length;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(p);
+                p += sizeof(inotify_event) + event->len;
+                auto it = watched_.find(event->wd);
+                if (it == watched_.end() || event->len == 0 || (event->mask & IN_ISDIR)) {
+                    continue;
+                }
+                const WatchedDirectory& directory = directories_[it->second];
+                std::string name(event->name);
+                if (matches(directory, name)) {
+                    pending.insert(directory.path == "/" ? "/" + name : directory.path + "/" + name);
+                }
+            }
+        }
+    }
+}
+
+void FileWatcher::runPolling() {
+    auto lastTimes = modificationTimes();
+    std::unique_lock<std::mutex> lock(stopMutex_);
+    while (running_) {
+        stopCondition_.wait_for(lock, pollInterval_, [this] { return !running_; });
+        if (!running_) {
+            break;
+        }
+        auto times = modificationTimes();
+        if (times == lastTimes) {
+            continue;
+        }
+
+        // Added, modified and removed files, in path order
+        std::vector<std::string> changed;
+        auto current = times.begin();
+        auto last = lastTimes.begin();
+        while (current != times.end() || last != lastTimes.end()) {
+            if (last == lastTimes.end() || (current != times.end() && current->first < last->first)) {
+                changed.push_back((current++)->first);
+            } else if (current == times.end() || last->first < current->first) {
+                changed.push_back((last++)->first);
+            } else {
+                if (current->second != last->second) {
+                    changed.push_back(current->first);
+                }
+                ++current;
+                ++last;
+            }
+        }
+        lastTimes = std::move(times);
+
+        lock.unlock();
+        onChange_(changed);
+        lock.lock();
+    }
+}
+
+std::map<std::string, std::chrono::nanoseconds> FileWatcher::modificationTimes() const {
+    std::map<std::string, std::chrono::nanoseconds> times;
+    auto record = [&times](const std::string& path) {
+        struct stat info{};
+        if (::stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode)) {
+            times[path] = std::chrono::seconds(info.st_mtim.tv_sec) + std::chrono::nanoseconds(info.st_mtim.tv_nsec);
+        }
+    };
+
+    for (const auto& directory : directories_) {
+        const std::string prefix = directory.path == "/" ? "/" : directory.path + "/";
+        if (!directory.names.empty()) {
+            for (const auto& name : directory.names) {
+                record(prefix + name);
+            }
+            continue;
+        }
+        DIR* dir = opendir(directory.path.c_str());
+        if (!dir) {
+            continue;
+        }
+        while (const dirent* entry = readdir(dir)) {
+            std::string name(entry->d_name);
+            if (name != "." && name != ".." && matches(directory, name)) {
+                record(prefix + name);
+            }
+        }
+        closedir(dir);
+    }
+    return times;
+}
+
+} // namespace cppSwitchboard
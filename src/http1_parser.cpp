@@ -0,0 +1,558 @@
+/**
+ * @file http1_parser.cpp
+ * @brief Implementation of the in-place HTTP/1.1 request head parser
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-22
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/http1_parser.h>
+#include <algorithm>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define CPPSWITCHBOARD_X86_DISPATCH 1
+#endif
+
+namespace cppSwitchboard {
+
+namespace {
+    /// tchar from RFC 9110 section 5.6.2
+    constexpr bool TOKEN_CHARS[256] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 1, 0, 1, 1, 1, 1, 1, 0, 0, 1, 1, 0, 1, 1, 0,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0,
+        0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1, 0,
+    };
+
+    inline bool isToken(char c) noexcept {
+        return TOKEN_CHARS[static_cast<unsigned char>(c)];
+    }
+
+    /// Bytes that end a request target: CTLs, SP and DEL
+    inline bool endsTarget(char c) noexcept {
+        auto u = static_cast<unsigned char>(c);
+        return u <= 0x20 || u == 0x7f;
+    }
+
+    /// Bytes that end a field value: CTLs except HTAB, and DEL
+    inline bool endsValue(char c) noexcept {
+        auto u = static_cast<unsigned char>(c);
+        return (u < 0x20 && u != '\t') || u == 0x7f;
+    }
+
+    inline bool isWhitespace(char c) noexcept {
+        return c == ' ' || c == '\t';
+    }
+
+    const char* scanNameScalar(const char* p, const char* end) noexcept {
+        while (p < end && isToken(*p)) {
+            ++p;
+        }
+        return p;
+    }
+
+    const char* scanTargetScalar(const char* p, const char* end) noexcept {
+        while (p < end && !endsTarget(*p)) {
+            ++p;
+        }
+        return p;
+    }
+
+    const char* scanValueScalar(const char* p, const char* end) noexcept {
+        while (p < end && !endsValue(*p)) {
+            ++p;
+        }
+        return p;
+    }
+
+#if defined(CPPSWITCHBOARD_X86_DISPATCH)
+    // Byte ranges for PCMPESTRI; the arrays are padded to 16 bytes so the
+    // whole register can be loaded.
+    alignas(16) constexpr char NAME_STOP_RANGES[16] = {
+        '\x00', ' ', '"', '"', '(', ')', ',', ',', '/', '/', ':', '@', '[', ']', '{', '\xff'
+    };
+    alignas(16) constexpr char TARGET_STOP_RANGES[16] = { '\x00', ' ', '\x7f', '\x7f' };
+    alignas(16) constexpr char VALUE_STOP_RANGES[16] = { '\x00', '\x08', '\x0a', '\x1f', '\x7f', '\x7f' };
+
+    __attribute__((target("sse4.2")))
+    inline const char* scanRangesSse42(const char* p, const char* end,
+                                       const char* ranges, int rangeBytes) noexcept {
+        const __m128i set = _mm_load_si128(reinterpret_cast<const __m128i*>(ranges));
+        while (end - p >= 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            int index = _mm_cmpestri(set, rangeBytes, chunk, 16,
+                                     _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_LEAST_SIGNIFICANT);
+            if (index != 16) {
+                return p + index;
+            }
+            p += 16;
+        }
+        return p;
+    }
+
+    __attribute__((target("sse4.2")))
+    const char* scanNameSse42(const char* p, const char* end) noexcept {
+        // The ranges also stop at '|' and '~', which are token characters;
+        // the scalar loop carries on past them.
+        p = scanRangesSse42(p, end, NAME_STOP_RANGES, 16);
+        return scanNameScalar(p, end);
+    }
+
+    __attribute__((target("sse4.2")))
+    const char* scanTargetSse42(const char* p, const char* end) noexcept {
+        return scanTargetScalar(scanRangesSse42(p, end, TARGET_STOP_RANGES, 4), end);
+    }
+
+    __attribute__((target("sse4.2")))
+    const char* scanValueSse42(const char* p, const char* end) noexcept {
+        return scanValueScalar(scanRangesSse42(p, end, VALUE_STOP_RANGES, 6), end);
+    }
+
+    /**
+     * @brief Bitmask of bytes in [0, limit) or equal to DEL, optionally sparing HTAB
+     *
+     * Bytes >= 0x80 are negative as signed chars, so the lower bound keeps
+     * obs-text out of the match.
+     */
+    __attribute__((target("avx2")))
+    inline unsigned controlMaskAvx2(__m256i chunk, char limit, bool allowTab) noexcept {
+        __m256i below = _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(limit), chunk),
+                                         _mm256_cmpgt_epi8(chunk, _mm256_set1_epi8(-1)));
+        if (allowTab) {
+            below = _mm256_andnot_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\t')), below);
+        }
+        __m256i stop = _mm256_or_si256(below, _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(0x7f)));
+        return static_cast<unsigned>(_mm256_movemask_epi8(stop));
+    }
+
+    __attribute__((target("avx2")))
+    const char* scanTargetAvx2(const char* p, const char* end) noexcept {
+        while (end - p >= 32) {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            unsigned mask = controlMaskAvx2(chunk, 0x21, false);
+            if (mask != 0) {
+                return p + __builtin_ctz(mask);
+            }
+            p += 32;
+        }
+        return scanTargetSse42(p, end);
+    }
+
+    __attribute__((target("avx2")))
+    const char* scanValueAvx2(const char* p, const char* end) noexcept {
+        while (end - p >= 32) {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            unsigned mask = controlMaskAvx2(chunk, 0x20, true);
+            if (mask != 0) {
+                return p + __builtin_ctz(mask);
+            }
+            p += 32;
+        }
+        return scanValueSse42(p, end);
+    }
+#endif
+
+    using ScanFunction = const char* (*)(const char*, const char*) noexcept;
+
+    struct Scanners {
+        ScanFunction name;
+        ScanFunction target;
+        ScanFunction value;
+        const char* level;
+    };
+
+    Scanners selectScanners() noexcept {
+#if defined(CPPSWITCHBOARD_X86_DISPATCH)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("sse4.2")) {
+            return {scanNameSse42, scanTargetAvx2, scanValueAvx2, "avx2"};
+        }
+        if (__builtin_cpu_supports("sse4.2")) {
+            return {scanNameSse42, scanTargetSse42, scanValueSse42, "sse4.2"};
+        }
+#endif
+        return {scanNameScalar, scanTargetScalar, scanValueScalar, "scalar"};
+    }
+
+    const Scanners& scanners() noexcept {
+        static const Scanners selected = selectScanners();
+        return selected;
+    }
+
+    bool equalsIgnoreCase(std::string_view a, std::string_view b) noexcept {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i) {
+            char x = a[i];
+            char y = b[i];
+            if (x >= 'A' && x <= 'Z') x = static_cast<char>(x - 'A' + 'a');
+            if (y >= 'A' && y <= 'Z') y = static_cast<char>(y - 'A' + 'a');
+            if (x != y) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::string_view trimWhitespace(std::string_view s) noexcept {
+        while (!s.empty() && isWhitespace(s.front())) s.remove_prefix(1);
+        while (!s.empty() && isWhitespace(s.back())) s.remove_suffix(1);
+        return s;
+    }
+
+    /**
+     * @brief Call @p visit for every comma-separated element (trimmed)
+     * @return false as soon as @p visit does
+     */
+    template <typename Visitor>
+    bool forEachListElement(std::string_view list, Visitor&& visit) {
+        while (true) {
+            size_t comma = list.find(',');
+            if (!visit(trimWhitespace(list.substr(0, comma)))) {
+                return false;
+            }
+            if (comma == std::string_view::npos) {
+                return true;
+            }
+            list.remove_prefix(comma + 1);
+        }
+    }
+
+    bool parseDecimal(std::string_view digits, std::uint64_t& value) noexcept {
+        if (digits.empty()) {
+            return false;
+        }
+        value = 0;
+        for (char c : digits) {
+            if (c < '0' || c > '9') {
+                return false;
+            }
+            std::uint64_t digit = static_cast<std::uint64_t>(c - '0');
+            if (value > (std::numeric_limits<std::uint64_t>::max() - digit) / 10) {
+                return false;
+            }
+            value = value * 10 + digit;
+        }
+        return true;
+    }
+
+    enum ConnectionFlags : unsigned {
+        CONNECTION_CLOSE = 1,
+        CONNECTION_KEEP_ALIVE = 2
+    };
+
+    /**
+     * @brief Apply the fields that frame the message or control the connection
+     *
+     * Mirrors the checks Beast performs so that both engines accept the same
+     * requests: Content-Length may be a list of identical values, it may not
+     * be combined with chunked Transfer-Encoding, and Connection must be a
+     * valid token list.
+     */
+    bool applyField(Http1RequestHead& head, const Http1Header& field, unsigned& connection) {
+        if (equalsIgnoreCase(field.name, "content-length")) {
+            if (head.chunked) {
+                return false;
+            }
+            bool valid = forEachListElement(field.value, [&](std::string_view element) {
+                std::uint64_t length = 0;
+                if (!parseDecimal(element, length)) {
+                    return false;
+                }
+                if (head.hasContentLength && head.contentLength != length) {
+                    return false;
+                }
+                head.hasContentLength = true;
+                head.contentLength = length;
+                return true;
+            });
+            return valid;
+        }
+
+        if (equalsIgnoreCase(field.name, "transfer-encoding")) {
+            if (head.chunked || head.hasContentLength) {
+                return false;
+            }
+            // Beast silently ignores a malformed coding list, which would
+            // leave the body length up to interpretation; reject it instead.
+            std::string_view last;
+            bool valid = forEachListElement(field.value, [&](std::string_view element) {
+                std::string_view coding = trimWhitespace(element.substr(0, element.find(';')));
+                if (scanNameScalar(coding.data(), coding.data() + coding.size()) != coding.data() + coding.size()) {
+                    return false;
+                }
+                if (!coding.empty()) {
+                    last = coding;
+                }
+                return true;
+            });
+            head.chunked = equalsIgnoreCase(last, "chunked");
+            return valid;
+        }
+
+        if (equalsIgnoreCase(field.name, "connection") || equalsIgnoreCase(field.name, "proxy-connection")) {
+            return forEachListElement(field.value, [&](std::string_view element) {
+                if (scanNameScalar(element.data(), element.data() + element.size()) !=
+                    element.data() + element.size()) {
+                    return false;
+                }
+                if (equalsIgnoreCase(element, "close")) {
+                    connection |= CONNECTION_CLOSE;
+                } else if (equalsIgnoreCase(element, "keep-alive")) {
+                    connection |= CONNECTION_KEEP_ALIVE;
+                }
+                return true;
+            });
+        }
+
+        return true;
+    }
+
+    int parseHead(const char* data, const char* end, Http1RequestHead& head) {
+        const Scanners& scan = scanners();
+        const char* p = data;
+
+        // Method
+        const char* methodEnd = scanNameScalar(p, end);
+        if (methodEnd == end) {
+            return Http1Parser::NEED_MORE;
+        }
+        if (*methodEnd != ' ' || methodEnd == p) {
+            return Http1Parser::BAD_REQUEST;
+        }
+        head.method = std::string_view(p, static_cast<size_t>(methodEnd - p));
+        p = methodEnd + 1;
+
+        // Target
+        const char* targetEnd = scan.target(p, end);
+        if (targetEnd == end) {
+            return Http1Parser::NEED_MORE;
+        }
+        if (*targetEnd != ' ' || targetEnd == p) {
+            return Http1Parser::BAD_REQUEST;
+        }
+        head.target = std::string_view(p, static_cast<size_t>(targetEnd - p));
+        p = targetEnd + 1;
+
+        // HTTP-version CRLF
+        if (end - p < 10) {
+            return Http1Parser::NEED_MORE;
+        }
+        if (p[0] != 'H' || p[1] != 'T' || p[2] != 'T' || p[3] != 'P' || p[4] != '/' ||
+            p[5] < '0' || p[5] > '9' || p[6] != '.' || p[7] < '0' || p[7] > '9' ||
+            p[8] != '\r' || p[9] != '\n') {
+            return Http1Parser::BAD_REQUEST;
+        }
+        head.version = static_cast<unsigned>((p[5] - '0') * 10 + (p[7] - '0'));
+        p += 10;
+
+        // Header fields
+        unsigned connection = 0;
+        while (true) {
+            if (p >= end) {
+                return Http1Parser::NEED_MORE;
+            }
+            if (*p == '\r') {
+                if (end - p < 2) {
+                    return Http1Parser::NEED_MORE;
+                }
+                if (p[1] != '\n') {
+                    return Http1Parser::BAD_REQUEST;
+                }
+                p += 2;
+                break;
+            }
+
+            const char* nameEnd = scan.name(p, end);
+            if (nameEnd == end) {
+                return Http1Parser::NEED_MORE;
+            }
+            if (*nameEnd != ':' || nameEnd == p) {
+                return Http1Parser::BAD_REQUEST;
+            }
+            std::string_view name(p, static_cast<size_t>(nameEnd - p));
+
+            p = nameEnd + 1;
+            while (p < end && isWhitespace(*p)) {
+                ++p;
+            }
+            const char* valueEnd = scan.value(p, end);
+            // Look one byte past the CRLF so that obsolete line folding is
+            // detected before the field is accepted.
+            if (end - valueEnd < 3) {
+                return Http1Parser::NEED_MORE;
+            }
+            if (valueEnd[0] != '\r' || valueEnd[1] != '\n' || isWhitespace(valueEnd[2])) {
+                return Http1Parser::BAD_REQUEST;
+            }
+            const char* valueLast = valueEnd;
+            while (valueLast > p && isWhitespace(valueLast[-1])) {
+                --valueLast;
+            }
+
+            if (head.headerCount == Http1RequestHead::MAX_HEADERS) {
+                return Http1Parser::BAD_REQUEST;
+            }
+            Http1Header& field = head.headers[head.headerCount++];
+            field.name = name;
+            field.value = std::string_view(p, static_cast<size_t>(valueLast - p));
+            if (!applyField(head, field, connection)) {
+                return Http1Parser::BAD_REQUEST;
+            }
+            p = valueEnd + 2;
+        }
+
+        if (head.version >= 11) {
+            head.keepAlive = (connection & CONNECTION_CLOSE) == 0;
+        } else {
+            head.keepAlive = (connection & CONNECTION_KEEP_ALIVE) != 0 && (connection & CONNECTION_CLOSE) == 0;
+        }
+        return static_cast<int>(p - data);
+    }
+}
+
+std::string_view Http1RequestHead::findHeader(std::string_view name) const noexcept {
+    for (size_t i = 0; i < headerCount; ++i) {
+        if (equalsIgnoreCase(headers[i].name, name)) {
+            return headers[i].value;
+        }
+    }
+    return {};
+}
+
+int Http1Parser::parse(const char* data, std::size_t length, Http1RequestHead& head) noexcept {
+    head.headerCount = 0;
+    head.hasContentLength = false;
+    head.contentLength = 0;
+    head.chunked = false;
+    head.keepAlive = true;
+
+    std::size_t window = std::min(length, HEADER_LIMIT);
+    int result = parseHead(data, data + window, head);
+    if (result == NEED_MORE && length >= HEADER_LIMIT) {
+        return BAD_REQUEST;
+    }
+    return result;
+}
+
+const char* Http1Parser::simdLevel() noexcept {
+    return scanners().level;
+}
+
+long Http1ChunkedDecoder::decode(const char* data, std::size_t length, std::string& body) {
+    const char* p = data;
+    const char* end = data + length;
+
+    while (p < end && state_ != State::DONE) {
+        char c = *p;
+        switch (state_) {
+            case State::SIZE: {
+                int digit = -1;
+                if (c >= '0' && c <= '9') digit = c - '0';
+                else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+                else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+
+                if (digit >= 0) {
+                    if (++sizeDigits_ > 16) {
+                        return -1;
+                    }
+                    remaining_ = remaining_ * 16 + static_cast<std::uint64_t>(digit);
+                    ++p;
+                    break;
+                }
+                if (sizeDigits_ == 0) {
+                    return -1;
+                }
+                if (c == ';' || isWhitespace(c)) {
+                    state_ = State::EXTENSION;
+                } else if (c == '\r') {
+                    state_ = State::SIZE_LF;
+                } else {
+                    return -1;
+                }
+                ++p;
+                break;
+            }
+            case State::EXTENSION:
+                if (c == '\r') {
+                    state_ = State::SIZE_LF;
+                } else if (c == '\n') {
+                    return -1;
+                }
+                ++p;
+                break;
+            case State::SIZE_LF:
+                if (c != '\n') {
+                    return -1;
+                }
+                ++p;
+                sizeDigits_ = 0;
+                if (remaining_ == 0) {
+                    trailerLineLength_ = 0;
+                    state_ = State::TRAILER;
+                } else {
+                    state_ = State::DATA;
+                }
+                break;
+            case State::DATA: {
+                std::size_t take = static_cast<std::size_t>(
+                    std::min<std::uint64_t>(remaining_, static_cast<std::uint64_t>(end - p)));
+                body.append(p, take);
+                p += take;
+                remaining_ -= take;
+                if (remaining_ == 0) {
+                    state_ = State::DATA_CR;
+                }
+                break;
+            }
+            case State::DATA_CR:
+                if (c != '\r') {
+                    return -1;
+                }
+                ++p;
+                state_ = State::DATA_LF;
+                break;
+            case State::DATA_LF:
+                if (c != '\n') {
+                    return -1;
+                }
+                ++p;
+                state_ = State::SIZE;
+                break;
+            case State::TRAILER:
+                if (c == '\r') {
+                    state_ = State::TRAILER_LF;
+                } else if (c == '\n') {
+                    return -1;
+                } else {
+                    ++trailerLineLength_;
+                }
+                ++p;
+                break;
+            case State::TRAILER_LF:
+                if (c != '\n') {
+                    return -1;
+                }
+                ++p;
+                if (trailerLineLength_ == 0) {
+                    state_ = State::DONE;
+                } else {
+                    trailerLineLength_ = 0;
+                    state_ = State::TRAILER;
+                }
+                break;
+            case State::DONE:
+                break;
+        }
+    }
+    return static_cast<long>(p - data);
+}
+
+} // namespace cppSwitchboard
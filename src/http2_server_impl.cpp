@@ -1,16 +1,38 @@
 #include <cppSwitchboard/http2_server_impl.h>
+#include "usdt_probes.h"
 #include <iostream>
 #include <fstream>
+#include <chrono>
 #include <boost/asio/ssl/error.hpp>
 
 namespace cppSwitchboard {
 
+namespace {
+    // nghttp2_mem adaptors forwarding to the owning session's pool
+    void* pool_malloc(size_t size, void* mem_user_data) {
+        return static_cast<SessionMemoryPool*>(mem_user_data)->allocate(size);
+    }
+    
+    void pool_free(void* ptr, void* mem_user_data) {
+        static_cast<SessionMemoryPool*>(mem_user_data)->deallocate(ptr);
+    }
+    
+    void* pool_calloc(size_t nmemb, size_t size, void* mem_user_data) {
+        return static_cast<SessionMemoryPool*>(mem_user_data)->callocate(nmemb, size);
+    }
+    
+    void* pool_realloc(void* ptr, size_t size, void* mem_user_data) {
+        return static_cast<SessionMemoryPool*>(mem_user_data)->reallocate(ptr, size);
+    }
+}
+
 // Http2Session implementation
 Http2Session::Http2Session(tcp::socket socket, ssl::context* ssl_ctx,
                           std::function<HttpResponse(const HttpRequest&)> request_processor,
-                          std::shared_ptr<DebugLogger> debugLogger)
+                          std::shared_ptr<DebugLogger> debugLogger,
+                          std::shared_ptr<Http2WorkDispatch> dispatch)
     : socket_(std::move(socket)), request_processor_(request_processor), debugLogger_(debugLogger),
-      read_buffer_(8192), write_buffer_(8192) {
+      dispatch_(std::move(dispatch)) {
     
     if (ssl_ctx) {
         ssl_stream_ = std::make_unique<ssl::stream<tcp::socket&>>(socket_, *ssl_ctx);
@@ -22,11 +44,17 @@ Http2Session::Http2Session(tcp::socket socket, ssl::context* ssl_ctx,
     
     nghttp2_session_callbacks_set_send_callback(callbacks, send_callback);
     nghttp2_session_callbacks_set_on_frame_recv_callback(callbacks, on_frame_recv_callback);
+    nghttp2_session_callbacks_set_on_frame_send_callback(callbacks, on_frame_send_callback);
     nghttp2_session_callbacks_set_on_header_callback(callbacks, on_header_callback);
     nghttp2_session_callbacks_set_on_begin_headers_callback(callbacks, on_begin_headers_callback);
     nghttp2_session_callbacks_set_on_stream_close_callback(callbacks, on_stream_close_callback);
+    nghttp2_session_callbacks_set_on_data_chunk_recv_callback(callbacks, on_data_chunk_recv_callback);
+    nghttp2_session_callbacks_set_send_data_callback(callbacks, send_data_callback);
     
-    nghttp2_session_server_new(&session_, callbacks, this);
+    // HPACK tables, frames and stream state come from the session pool and
+    // are released in bulk when the session is destroyed
+    nghttp2_mem mem = {&nghttp2_pool_, pool_malloc, pool_free, pool_calloc, pool_realloc};
+    nghttp2_session_server_new3(&session_, callbacks, this, nullptr, &mem);
     nghttp2_session_callbacks_del(callbacks);
     
     // Send initial settings
@@ -38,6 +66,7 @@ Http2Session::Http2Session(tcp::socket socket, ssl::context* ssl_ctx,
 }
 
 Http2Session::~Http2Session() {
+    CPPSWITCHBOARD_PROBE2(connection_close, static_cast<int>(socket_.native_handle()), 2);
     if (session_) {
         nghttp2_session_del(session_);
     }
@@ -84,68 +113,141 @@ void Http2Session::do_handshake() {
 void Http2Session::do_read() {
     auto self = shared_from_this();
     
-    auto read_handler = [this, self](boost::system::error_code ec, std::size_t bytes_transferred) {
-        if (!ec) {
-            ssize_t readlen = nghttp2_session_mem_recv(session_, 
-                read_buffer_.data(), bytes_transferred);
-            if (readlen < 0) {
-                std::cerr << "nghttp2_session_mem_recv failed: " << nghttp2_strerror(readlen) << std::endl;
-                return;
-            }
-            
-            if (nghttp2_session_want_write(session_)) {
-                do_write();
-            } else {
-                do_read();
-            }
-        } else if (ec != asio::error::eof) {
-            std::cerr << "Read error: " << ec.message() << std::endl;
+    auto consume = [this](std::size_t bytes_transferred) {
+        ssize_t readlen = nghttp2_session_mem_recv(session_, 
+            read_buffer_.prepare(), bytes_transferred);
+        read_buffer_.commit(bytes_transferred);
+        if (readlen < 0) {
+            std::cerr << "nghttp2_session_mem_recv failed: " << nghttp2_strerror(readlen) << std::endl;
+            cancel_streams();
+            return false;
         }
+        
+        do_write();
+        if (nghttp2_session_want_read(session_)) {
+            do_read();
+        }
+        return true;
     };
     
     if (ssl_stream_) {
-        ssl_stream_->async_read_some(asio::buffer(read_buffer_), read_handler);
-    } else {
-        socket_.async_read_some(asio::buffer(read_buffer_), read_handler);
+        // The TLS layer may already hold decrypted bytes, so read directly
+        ssl_stream_->async_read_some(asio::buffer(read_buffer_.prepare(), read_buffer_.capacity()),
+            [this, self, consume](boost::system::error_code ec, std::size_t bytes_transferred) {
+                if (!ec) {
+                    consume(bytes_transferred);
+                    return;
+                }
+                if (ec != asio::error::eof) {
+                    std::cerr << "Read error: " << ec.message() << std::endl;
+                }
+                cancel_streams();
+            });
+        return;
     }
+    
+    // Plain TCP: wait for readability without holding a buffer, then borrow
+    // one from the pool only for the duration of the read.
+    socket_.async_wait(tcp::socket::wait_read,
+        [this, self, consume](boost::system::error_code ec) {
+            if (ec) {
+                if (ec != asio::error::operation_aborted) {
+                    std::cerr << "Read error: " << ec.message() << std::endl;
+                }
+                cancel_streams();
+                return;
+            }
+            
+            socket_.non_blocking(true, ec);
+            std::size_t bytes_transferred = socket_.read_some(
+                asio::buffer(read_buffer_.prepare(), read_buffer_.capacity()), ec);
+            if (ec == asio::error::would_block || ec == asio::error::try_again) {
+                read_buffer_.release();
+                do_read();
+                return;
+            }
+            if (ec) {
+                if (ec != asio::error::eof) {
+                    std::cerr << "Read error: " << ec.message() << std::endl;
+                }
+                cancel_streams();
+                return;
+            }
+            
+            bool ok = consume(bytes_transferred);
+            if (ok) {
+                // nghttp2 copies what it keeps; the block can go back to the pool
+                read_buffer_.release();
+            }
+        });
 }
 
 void Http2Session::do_write() {
-    const uint8_t* data;
-    ssize_t datalen = nghttp2_session_mem_send(session_, &data);
-    std::cout << "DEBUG: do_write() called, nghttp2_session_mem_send returned: " << datalen << " bytes" << std::endl;
+    if (writing_) {
+        // The completion handler picks up whatever was queued meanwhile
+        return;
+    }
     
-    if (datalen > 0) {
-        auto self = shared_from_this();
-        
-        std::cout << "DEBUG: Sending " << datalen << " bytes via async_write" << std::endl;
+    // nghttp2 hands every frame to send_callback/send_data_callback, which
+    // queue frame bytes in write_buffer_ and response bodies by reference
+    int rv = nghttp2_session_send(session_);
+    if (rv != 0) {
+        std::cerr << "ERROR: nghttp2_session_send failed: " << nghttp2_strerror(rv) << std::endl;
+        return;
+    }
+    if (write_segments_.empty()) {
+        return;
+    }
+    
+    write_sequence_.clear();
+    for (const auto& segment : write_segments_) {
+        if (segment.body.empty()) {
+            write_sequence_.emplace_back(write_buffer_.data() + segment.offset, segment.length);
+        } else {
+            write_sequence_.emplace_back(segment.body.data(), segment.body.size());
+        }
+    }
+    
+    auto self = shared_from_this();
+    writing_ = true;
+    
+    auto write_handler = [this, self](boost::system::error_code ec, std::size_t) {
+        writing_ = false;
+        write_buffer_.clear();
+        write_segments_.clear();
+        write_sequence_.clear();
         
-        auto write_handler = [this, self](boost::system::error_code ec, std::size_t bytes_written) {
-            std::cout << "DEBUG: Write completed, bytes written: " << bytes_written << ", error: " << ec.message() << std::endl;
-            if (!ec) {
-                if (nghttp2_session_want_read(session_)) {
-                    std::cout << "DEBUG: Session wants to read, calling do_read()" << std::endl;
-                    do_read();
-                } else if (nghttp2_session_want_write(session_)) {
-                    std::cout << "DEBUG: Session wants to write more, calling do_write()" << std::endl;
-                    do_write();
-                } else {
-                    std::cout << "DEBUG: Session doesn't want to read or write, operation complete" << std::endl;
-                }
-            } else {
-                std::cerr << "Write error: " << ec.message() << std::endl;
-            }
-        };
+        if (ec) {
+            std::cerr << "Write error: " << ec.message() << std::endl;
+            return;
+        }
         
-        if (ssl_stream_) {
-            asio::async_write(*ssl_stream_, asio::buffer(data, datalen), write_handler);
+        if (nghttp2_session_want_write(session_)) {
+            do_write();
         } else {
-            asio::async_write(socket_, asio::buffer(data, datalen), write_handler);
+            // Nothing queued: hand the block back to the pool while idle
+            write_buffer_.shrink_to_fit();
         }
-    } else if (datalen == 0) {
-        std::cout << "DEBUG: No data to send" << std::endl;
+    };
+    
+    if (ssl_stream_) {
+        asio::async_write(*ssl_stream_, write_sequence_, write_handler);
     } else {
-        std::cerr << "ERROR: nghttp2_session_mem_send failed: " << nghttp2_strerror(datalen) << std::endl;
+        asio::async_write(socket_, write_sequence_, write_handler);
+    }
+}
+
+void Http2Session::queue_bytes(const uint8_t* data, size_t length) {
+    if (write_segments_.empty() || !write_segments_.back().body.empty()) {
+        write_segments_.push_back({write_buffer_.size(), 0, BodyBuffer()});
+    }
+    write_buffer_.insert(write_buffer_.end(), data, data + length);
+    write_segments_.back().length += length;
+}
+
+void Http2Session::queue_body(BodyBuffer body) {
+    if (!body.empty()) {
+        write_segments_.push_back({0, 0, std::move(body)});
     }
 }
 
@@ -155,40 +257,31 @@ void Http2Session::send_response(int32_t stream_id, const HttpResponse& response
     header_storage.clear();
     
     // Reserve space to prevent reallocation and pointer invalidation
-    // We need: 2 for :status (name + value) + 2 * response.getHeaders().size() for other headers
-    header_storage.reserve(2 + 2 * response.getHeaders().size());
+    // We need: 2 for :status (name + value) + 2 per header + 2 for content-length
+    const auto& fields = response.getHeaderFields();
+    header_storage.reserve(4 + 2 * fields.size());
     
     // Also store nghttp2_nv structures persistently
     std::vector<nghttp2_nv>& headers = header_nvs_[stream_id];
     headers.clear();
-    headers.reserve(1 + response.getHeaders().size()); // 1 for :status + other headers
+    headers.reserve(2 + fields.size()); // :status + other headers + content-length
     
     // Add status - ensure it's valid
     int status = response.getStatus();
-    std::cout << "DEBUG: Original status from response: " << status << std::endl;
     
     if (status == 0) {
         status = 200; // Default to 200 OK if status is unset
-        std::cout << "DEBUG: Status was 0, setting to 200" << std::endl;
     }
     
     // Store both status header name and value persistently
     header_storage.push_back(":status");          // index 0: header name
     header_storage.push_back(std::to_string(status)); // index 1: header value
     
-    std::cout << "DEBUG: Status string stored: '" << header_storage[1] << "'" << std::endl;
-    std::cout << "DEBUG: Status string length: " << header_storage[1].length() << std::endl;
-    
     headers.push_back({(uint8_t*)header_storage[0].c_str(), (uint8_t*)header_storage[1].c_str(), 
                       header_storage[0].length(), header_storage[1].length(), NGHTTP2_NV_FLAG_NONE});
     
-    std::cout << "DEBUG: :status header name pointer: " << (void*)header_storage[0].c_str() << std::endl;
-    std::cout << "DEBUG: :status header value pointer: " << (void*)header_storage[1].c_str() << std::endl;
-    std::cout << "DEBUG: :status header name: '" << std::string((char*)headers[0].name, headers[0].namelen) << "'" << std::endl;
-    std::cout << "DEBUG: :status header value: '" << std::string((char*)headers[0].value, headers[0].valuelen) << "'" << std::endl;
-    
     // Add response headers
-    for (const auto& header : response.getHeaders()) {
+    for (const auto& header : fields) {
         size_t name_idx = header_storage.size();
         size_t value_idx = header_storage.size() + 1;
         
@@ -201,41 +294,50 @@ void Http2Session::send_response(int32_t stream_id, const HttpResponse& response
                           header_storage[value_idx].length(), 
                           NGHTTP2_NV_FLAG_NONE});
         
-        std::cout << "DEBUG: Added header: " << header_storage[name_idx] << ": " << header_storage[value_idx] << std::endl;
     }
     
-    std::cout << "DEBUG: Total headers count: " << headers.size() << std::endl;
-    
-    // Double-check that our pointers are still valid after all the push_backs
-    std::cout << "DEBUG: Final :status header name: '" << std::string((char*)headers[0].name, headers[0].namelen) << "'" << std::endl;
-    std::cout << "DEBUG: Final :status header value: '" << std::string((char*)headers[0].value, headers[0].valuelen) << "'" << std::endl;
+    // Content-Length is derived from the body here, once, unless the
+    // handler set one explicitly (e.g. for HEAD)
+    if (!response.getBodyBuffer().empty() && fields.find("Content-Length") == fields.end()) {
+        size_t name_idx = header_storage.size();
+        header_storage.push_back("content-length");
+        header_storage.push_back(std::to_string(response.getBodyBuffer().size()));
+        headers.push_back({(uint8_t*)header_storage[name_idx].c_str(),
+                          (uint8_t*)header_storage[name_idx + 1].c_str(),
+                          header_storage[name_idx].length(),
+                          header_storage[name_idx + 1].length(),
+                          NGHTTP2_NV_FLAG_NONE});
+    }
     
-    std::string* response_body = new std::string(response.getBody());
-    std::cout << "DEBUG: Response body length: " << response_body->length() << std::endl;
+    // The stream keeps a reference to the shared body until it is fully sent;
+    // HEAD responses carry the GET handler's content-length but no DATA
+    auto& stream = streams_[stream_id];
+    if (stream.method != "HEAD") {
+        stream.response_body = response.getBodyBuffer();
+    }
+    stream.response_scheduled = 0;
+    stream.response_sent = 0;
     
-    if (!response_body->empty()) {
+    int rv = 0;
+    if (!stream.response_body.empty()) {
         nghttp2_data_provider data_prd;
-        data_prd.source.ptr = response_body;
+        data_prd.source.ptr = &stream;
         data_prd.read_callback = data_source_read_callback;
         
-        int rv = nghttp2_submit_response(session_, stream_id, headers.data(), headers.size(), &data_prd);
-        std::cout << "DEBUG: nghttp2_submit_response (with body) returned: " << rv << std::endl;
-        if (rv != 0) {
-            std::cerr << "nghttp2_submit_response failed: " << nghttp2_strerror(rv) << std::endl;
-            delete response_body;
-        }
+        rv = nghttp2_submit_response(session_, stream_id, headers.data(), headers.size(), &data_prd);
     } else {
-        int rv = nghttp2_submit_response(session_, stream_id, headers.data(), headers.size(), nullptr);
-        std::cout << "DEBUG: nghttp2_submit_response (no body) returned: " << rv << std::endl;
-        if (rv != 0) {
-            std::cerr << "nghttp2_submit_response failed: " << nghttp2_strerror(rv) << std::endl;
-        }
-        delete response_body;
+        rv = nghttp2_submit_response(session_, stream_id, headers.data(), headers.size(), nullptr);
+    }
+    if (rv != 0) {
+        std::cerr << "nghttp2_submit_response failed: " << nghttp2_strerror(rv) << std::endl;
+    } else {
+        // response_written fires from on_frame_send_callback once the last frame is out
+        stream.response_status = status;
+        stream.response_length = response.getContentLength();
     }
     
     // CRITICAL: After submitting the response, we need to trigger the write operation
     // to actually send the queued HTTP/2 frames to the client
-    std::cout << "DEBUG: Triggering do_write() to send HTTP/2 frames" << std::endl;
     do_write();
 }
 
@@ -243,12 +345,10 @@ void Http2Session::send_response(int32_t stream_id, const HttpResponse& response
 ssize_t Http2Session::send_callback(nghttp2_session* session, const uint8_t* data,
                                    size_t length, int flags, void* user_data) {
     (void)session;
-    (void)data;
-    (void)length;
     (void)flags;
-    (void)user_data;
-    // Not used with mem_send
-    return NGHTTP2_ERR_WOULDBLOCK;
+    auto* sess = static_cast<Http2Session*>(user_data);
+    sess->queue_bytes(data, length);
+    return static_cast<ssize_t>(length);
 }
 
 int Http2Session::on_begin_headers_callback(nghttp2_session* session,
@@ -291,6 +391,120 @@ int Http2Session::on_header_callback(nghttp2_session* session,
     return 0;
 }
 
+void Http2Session::process_request(int32_t stream_id) {
+    auto it = streams_.find(stream_id);
+    if (it == streams_.end() || it->second.processed) {
+        return;
+    }
+    it->second.processed = true;
+    
+    if (!dispatch_) {
+        {
+            HttpRequest request = make_request(stream_id, arena_.resource());
+            finish_request(stream_id, request, respond(request));
+        }
+        
+        // Requests are processed synchronously and the request is destroyed
+        // above, so nothing allocated from the arena survives past this point
+        arena_.reset();
+        return;
+    }
+    
+    // The handler runs off the I/O thread while this session reads other
+    // streams; the request outlives this call, so it is not on the arena
+    auto request = std::make_shared<HttpRequest>(make_request(stream_id, std::pmr::new_delete_resource()));
+    auto self = shared_from_this();
+    auto executor = socket_.get_executor();
+    dispatch_->submit(request, [self, request, stream_id, executor](HttpResponse response) {
+        asio::post(executor, [self, request, stream_id, response = std::move(response)]() {
+            self->finish_request(stream_id, *request, response);
+        });
+    });
+}
+
+HttpRequest Http2Session::make_request(int32_t stream_id, std::pmr::memory_resource* resource) {
+    auto& stream = streams_[stream_id];
+    
+    HttpRequest request(stream.method, stream.path, "HTTP/2", resource);
+    request.setStreamId(stream_id);
+    request.setReceivedAt(std::chrono::steady_clock::now());
+    
+    for (const auto& header : stream.headers) {
+        request.setHeader(header.first, header.second);
+    }
+    
+    // Shared with every copy of the request; cancelled on RST_STREAM
+    stream.cancellation = std::make_shared<CancellationToken>(
+        CancellationToken::deadlineFromHeaders(request, request.getReceivedAt()));
+    request.setCancellation(stream.cancellation);
+    // :authority takes the place of Host (RFC 9113 section 8.3.1)
+    if (!stream.authority.empty()) {
+        request.setHeader("Host", stream.authority);
+    }
+    
+    if (!stream.body.empty()) {
+        request.setBody(std::move(stream.body));
+    }
+    
+    CPPSWITCHBOARD_PROBE3(request_parsed, stream.method.c_str(), stream.path.c_str(),
+                          stream_id);
+    
+    // Debug log request headers and payload
+    if (debugLogger_) {
+        debugLogger_->logRequestHeaders(request);
+        debugLogger_->logRequestPayload(request);
+    }
+    return request;
+}
+
+HttpResponse Http2Session::respond(const HttpRequest& request) {
+    HttpResponse response;
+    try {
+        response = request_processor_(request);
+    } catch (const std::exception& e) {
+        std::cerr << "Error processing request: " << e.what() << std::endl;
+        response.setStatus(500);
+        response.setHeader("content-type", "text/plain");
+        response.setBody("Internal Server Error");
+    }
+    return response;
+}
+
+void Http2Session::finish_request(int32_t stream_id, const HttpRequest& request, HttpResponse response) {
+    auto stream = streams_.find(stream_id);
+    if (stream == streams_.end()) {
+        // Reset by the client while the handler ran
+        return;
+    }
+    stream->second.responded = true;
+    
+    // Ensure response has a valid status
+    if (response.getStatus() == 0) {
+        response.setStatus(200);
+    }
+    
+    // Ensure content-type is set if there's a body
+    if (response.getContentLength() > 0 && response.getHeader("content-type").empty()) {
+        response.setHeader("content-type", "text/plain");
+    }
+    
+    // Debug log response headers and payload before sending
+    if (debugLogger_) {
+        debugLogger_->logResponseHeaders(response, request.getPath(), request.getMethod());
+        debugLogger_->logResponsePayload(response, request.getPath(), request.getMethod());
+    }
+    
+    send_response(stream_id, response);
+}
+
+void Http2Session::cancel_streams() {
+    for (auto& entry : streams_) {
+        if (entry.second.cancellation && !entry.second.responded) {
+            entry.second.cancellation->cancel(CancellationToken::Reason::CLIENT_GONE);
+        }
+    }
+}
+
 int Http2Session::on_frame_recv_callback(nghttp2_session* session,
                                         const nghttp2_frame* frame,
                                         void* user_data) {
@@ -304,105 +518,107 @@ int Http2Session::on_frame_recv_callback(nghttp2_session* session,
         auto& stream = sess->streams_[frame->hd.stream_id];
         stream.headers_complete = true;
         
-        std::cout << "DEBUG: Received HEADERS frame for stream " << frame->hd.stream_id << std::endl;
-        std::cout << "DEBUG: Method: '" << stream.method << "'" << std::endl;
-        std::cout << "DEBUG: Path: '" << stream.path << "'" << std::endl;
-        std::cout << "DEBUG: Scheme: '" << stream.scheme << "'" << std::endl;
-        std::cout << "DEBUG: Authority: '" << stream.authority << "'" << std::endl;
-        
-        // If no body expected or END_STREAM flag, process request
-        if ((frame->hd.flags & NGHTTP2_FLAG_END_STREAM) || stream.method == "GET") {
-            // Create HttpRequest
-            HttpRequest request(stream.method, stream.path, "HTTP/2");
-            request.setStreamId(frame->hd.stream_id);
-            
-            for (const auto& header : stream.headers) {
-                request.setHeader(header.first, header.second);
-            }
-            
-            if (!stream.body.empty()) {
-                request.setBody(stream.body);
-            }
-            
-            std::cout << "DEBUG: Processing request for path: " << stream.path << std::endl;
-            
-            // Debug log request headers and payload
-            if (sess->debugLogger_) {
-                sess->debugLogger_->logRequestHeaders(request);
-                sess->debugLogger_->logRequestPayload(request);
-            }
-            
-            // Process request
-            HttpResponse response;
-            try {
-                response = sess->request_processor_(request);
-                
-                std::cout << "DEBUG: Response from processor - Status: " << response.getStatus() << std::endl;
-                std::cout << "DEBUG: Response from processor - Body length: " << response.getBody().length() << std::endl;
-                
-                // Ensure response has a valid status
-                if (response.getStatus() == 0) {
-                    std::cout << "DEBUG: Response status was 0, setting to 200" << std::endl;
-                    response.setStatus(200);
-                }
-                
-                // Ensure content-type is set if there's a body
-                if (!response.getBody().empty() && response.getHeader("content-type").empty()) {
-                    std::cout << "DEBUG: Setting content-type to text/plain" << std::endl;
-                    response.setHeader("content-type", "text/plain");
-                }
-                
-            } catch (const std::exception& e) {
-                std::cerr << "Error processing request: " << e.what() << std::endl;
-                response.setStatus(500);
-                response.setHeader("content-type", "text/plain");
-                response.setBody("Internal Server Error");
-            }
-            
-            std::cout << "DEBUG: Final response status before send_response: " << response.getStatus() << std::endl;
-            
-            // Debug log response headers and payload before sending
-            if (sess->debugLogger_) {
-                sess->debugLogger_->logResponseHeaders(response, request.getPath(), request.getMethod());
-                sess->debugLogger_->logResponsePayload(response, request.getPath(), request.getMethod());
-            }
-            
-            sess->send_response(frame->hd.stream_id, response);
-            
-            // IMPORTANT: Don't clean up stream data until after the response is fully sent
-            // Clean up will happen in on_stream_close_callback
-            // sess->streams_.erase(frame->hd.stream_id);
-            // sess->header_strings_.erase(frame->hd.stream_id);
+        // No body follows: process right away
+        if (frame->hd.flags & NGHTTP2_FLAG_END_STREAM) {
+            sess->process_request(frame->hd.stream_id);
         }
-    } else if (frame->hd.type == NGHTTP2_DATA) {
-        // Handle request body data
-        // Note: This is a simplified implementation
-        // In a full implementation, you'd accumulate the body data
+    } else if (frame->hd.type == NGHTTP2_DATA &&
+               (frame->hd.flags & NGHTTP2_FLAG_END_STREAM)) {
+        // Body chunks were collected by on_data_chunk_recv_callback
+        sess->process_request(frame->hd.stream_id);
     }
     
     return 0;
 }
 
+int Http2Session::on_data_chunk_recv_callback(nghttp2_session* session, uint8_t flags,
+                                             int32_t stream_id, const uint8_t* data,
+                                             size_t len, void* user_data) {
+    (void)session;
+    (void)flags;
+    auto* sess = static_cast<Http2Session*>(user_data);
+    
+    auto it = sess->streams_.find(stream_id);
+    if (it != sess->streams_.end()) {
+        it->second.body.append(reinterpret_cast<const char*>(data), len);
+    }
+    return 0;
+}
+
 ssize_t Http2Session::data_source_read_callback(nghttp2_session* session, int32_t stream_id,
                                                uint8_t* buf, size_t length, uint32_t* data_flags,
                                                nghttp2_data_source* source, void* user_data) {
     (void)session;
     (void)stream_id;
+    (void)buf;
     (void)user_data;
-    auto* response_body = static_cast<std::string*>(source->ptr);
-    size_t copy_len = std::min(length, response_body->length());
-    std::memcpy(buf, response_body->data(), copy_len);
-    *data_flags |= NGHTTP2_DATA_FLAG_EOF;
-    delete response_body;
-    return copy_len;
+    // Only schedule the bytes here; send_data_callback hands the body
+    // itself to the socket without copying it into nghttp2's buffer
+    auto* stream = static_cast<StreamData*>(source->ptr);
+    size_t remaining = stream->response_body.size() - stream->response_scheduled;
+    size_t chunk = std::min(length, remaining);
+    stream->response_scheduled += chunk;
+    
+    *data_flags |= NGHTTP2_DATA_FLAG_NO_COPY;
+    if (stream->response_scheduled == stream->response_body.size()) {
+        *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+    }
+    return static_cast<ssize_t>(chunk);
+}
+
+int Http2Session::send_data_callback(nghttp2_session* session, nghttp2_frame* frame,
+                                    const uint8_t* framehd, size_t length,
+                                    nghttp2_data_source* source, void* user_data) {
+    (void)session;
+    auto* sess = static_cast<Http2Session*>(user_data);
+    auto* stream = static_cast<StreamData*>(source->ptr);
+    
+    sess->queue_bytes(framehd, 9);
+    
+    if (frame->data.padlen > 0) {
+        uint8_t padlen = static_cast<uint8_t>(frame->data.padlen - 1);
+        sess->queue_bytes(&padlen, 1);
+    }
+    
+    sess->queue_body(stream->response_body.slice(stream->response_sent, length));
+    stream->response_sent += length;
+    
+    if (frame->data.padlen > 1) {
+        std::vector<uint8_t> padding(frame->data.padlen - 1, 0);
+        sess->queue_bytes(padding.data(), padding.size());
+    }
+    return 0;
+}
+
+int Http2Session::on_frame_send_callback(nghttp2_session* session,
+                                        const nghttp2_frame* frame,
+                                        void* user_data) {
+    (void)session;
+    auto* sess = static_cast<Http2Session*>(user_data);
+    
+    if ((frame->hd.type == NGHTTP2_HEADERS || frame->hd.type == NGHTTP2_DATA) &&
+        (frame->hd.flags & NGHTTP2_FLAG_END_STREAM)) {
+        auto stream = sess->streams_.find(frame->hd.stream_id);
+        if (stream != sess->streams_.end() && stream->second.response_status != 0) {
+            CPPSWITCHBOARD_PROBE3(response_written, stream->second.response_status,
+                                  stream->second.response_length, frame->hd.stream_id);
+            stream->second.response_status = 0;
+        }
+    }
+    return 0;
 }
 
 int Http2Session::on_stream_close_callback(nghttp2_session* session, int32_t stream_id,
                                           uint32_t error_code, void* user_data) {
     (void)session;
+    (void)error_code;
     auto* sess = static_cast<Http2Session*>(user_data);
     
-    std::cout << "DEBUG: Stream " << stream_id << " closed with error code: " << error_code << std::endl;
+    // Reset before the response was ready: let the handler stop
+    auto stream = sess->streams_.find(stream_id);
+    if (stream != sess->streams_.end() && stream->second.cancellation && !stream->second.responded) {
+        stream->second.cancellation->cancel(CancellationToken::Reason::CLIENT_GONE);
+    }
     
     // Clean up stream data
     sess->streams_.erase(stream_id);
@@ -412,12 +628,58 @@ int Http2Session::on_stream_close_callback(nghttp2_session* session, int32_t str
     return 0;
 }
 
+// Http2WorkDispatch implementation
+void Http2WorkDispatch::submit(std::shared_ptr<const HttpRequest> request, Done done) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++inFlight_;
+    }
+    // Whichever answers first wins: the processor, or the error below
+    auto answered = std::make_shared<std::atomic<bool>>(false);
+    Done once = [self = shared_from_this(), answered, done = std::move(done)](HttpResponse response) {
+        if (answered->exchange(true)) {
+            return;
+        }
+        try {
+            done(std::move(response));
+        } catch (...) {
+            // Counted as done either way
+        }
+        self->finished();
+    };
+    try {
+        processor_(std::move(request), once);
+    } catch (const std::exception& e) {
+        std::cerr << "Error processing request: " << e.what() << std::endl;
+        once(HttpResponse::internalServerError("Internal Server Error"));
+    }
+}
+
+void Http2WorkDispatch::finished() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--inFlight_ == 0) {
+        idle_.notify_all();
+    }
+}
+
+void Http2WorkDispatch::drain() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (inFlight_ > 0) {
+        idle_.wait_for(lock, std::chrono::milliseconds(100));
+    }
+}
+
 // Http2Server implementation
 Http2Server::Http2Server(asio::io_context& ioc, const ServerConfig& config,
-                        std::function<HttpResponse(const HttpRequest&)> request_processor)
+                        std::function<HttpResponse(const HttpRequest&)> request_processor,
+                        Http2WorkDispatch::Processor async_processor)
     : ioc_(ioc), acceptor_(ioc), ssl_ctx_(ssl::context::tlsv12_server),
       request_processor_(request_processor), config_(config), running_(false) {
     
+    if (async_processor) {
+        dispatch_ = std::make_shared<Http2WorkDispatch>(std::move(async_processor));
+    }
+    
     // Initialize debug logger
     debugLogger_ = std::make_shared<DebugLogger>(config_.monitoring.debugLogging);
     
@@ -508,9 +770,18 @@ void Http2Server::start() {
     do_accept();
 }
 
+Http2Server::~Http2Server() {
+    if (dispatch_) {
+        dispatch_->drain();
+    }
+}
+
 void Http2Server::stop() {
     running_ = false;
     acceptor_.close();
+    if (dispatch_) {
+        dispatch_->drain();
+    }
 }
 
 void Http2Server::do_accept() {
@@ -519,11 +790,14 @@ void Http2Server::do_accept() {
     acceptor_.async_accept(
         [this](boost::system::error_code ec, tcp::socket socket) {
             if (!ec) {
-                auto session = std::make_shared<Http2Session>(
+                CPPSWITCHBOARD_PROBE2(connection_accept, static_cast<int>(socket.native_handle()), 2);
+                auto session = std::allocate_shared<Http2Session>(
+                    PoolAllocator<Http2Session>(),
                     std::move(socket), 
                     config_.ssl.enabled ? &ssl_ctx_ : nullptr,
                     request_processor_,
-                    debugLogger_);
+                    debugLogger_,
+                    dispatch_);
                 session->start();
             }
             
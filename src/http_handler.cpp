@@ -10,7 +10,12 @@ HttpResponse DefaultErrorHandler::handleError(const HttpRequest& request, const
     HttpResponse response;
     response.setStatus(HttpResponse::INTERNAL_SERVER_ERROR);
     response.setContentType("application/json");
-    response.setBody("{\"error\": \"Internal Server Error\", \"message\": \"" + std::string(error.what()) + "\"}");
+    JsonWriter body(128, JsonWriter::Spacing::SPACED);
+    body.beginObject()
+        .member("error", "Internal Server Error")
+        .member("message", error.what())
+        .endObject();
+    response.setBody(body.take());
     
     return response;
 }
@@ -1,68 +1,331 @@
 #include <cppSwitchboard/http_request.h>
+#include <cppSwitchboard/cancellation.h>
+#include "simd_scan.h"
+#include <nlohmann/json.hpp>
 #include <algorithm>
-#include <sstream>
+#include <cctype>
+#include <cstring>
 
 namespace cppSwitchboard {
 
 HttpRequest::HttpRequest(const std::string& method, const std::string& path, const std::string& protocol)
-    : method_(method), path_(path), protocol_(protocol) {
+    : HttpRequest(method, path, protocol, std::pmr::get_default_resource()) {
+}
+
+HttpRequest::HttpRequest(const std::string& method, const std::string& path, const std::string& protocol,
+                         std::pmr::memory_resource* resource)
+    : method_(method), path_(path), protocol_(protocol),
+      headers_(resource), queryString_(resource), queryIndex_(resource), pathParams_(resource) {
     updateHttpMethod();
     
-    // Parse query string if present
+    // Split off the query string; it is parsed on first access
     size_t queryPos = path_.find('?');
     if (queryPos != std::string::npos) {
-        std::string actualPath = path_.substr(0, queryPos);
-        std::string queryString = path_.substr(queryPos + 1);
-        path_ = actualPath;
-        parseQueryString(queryString);
+        queryString_.assign(path_, queryPos + 1, std::string::npos);
+        path_.resize(queryPos);
+    }
+}
+
+HttpRequest::HttpRequest(const HttpRequest& other, std::pmr::memory_resource* resource)
+    : method_(other.method_), httpMethod_(other.httpMethod_), path_(other.path_),
+      protocol_(other.protocol_), headers_(other.headers_, resource), body_(other.body_),
+      queryString_(other.queryString_, resource), queryIndex_(other.queryIndex_, resource),
+      pathParams_(other.pathParams_, resource),
+      streamId_(other.streamId_), receivedAt_(other.receivedAt_), cancellation_(other.cancellation_), jsonCache_(other.jsonCache_), lazyJsonCache_(other.lazyJsonCache_) {
+}
+
+namespace {
+    bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (std::tolower(static_cast<unsigned char>(a[i])) !=
+                std::tolower(static_cast<unsigned char>(b[i]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    template <typename Map>
+    std::map<std::string, std::string> toStdMap(const Map& source) {
+        std::map<std::string, std::string> result;
+        for (const auto& entry : source) {
+            result.emplace_hint(result.end(), std::string(entry.first), std::string(entry.second));
+        }
+        return result;
+    }
+    
+    template <typename Map>
+    void assignEntry(Map& map, std::string_view name, std::string_view value) {
+        auto it = map.find(name);
+        if (it != map.end()) {
+            it->second.assign(value);
+        } else {
+            map.emplace(name, value);
+        }
+    }
+    
+    int hexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+    
+    /**
+     * @brief Percent-decode a query component ('+' becomes a space)
+     * 
+     * Malformed escapes are kept literally.
+     */
+    std::string percentDecode(std::string_view encoded) {
+        std::string decoded;
+        decoded.reserve(encoded.size());
+        
+        const char* p = encoded.data();
+        const char* end = p + encoded.size();
+        while (p < end) {
+            const char* escape = simd::findFirstOf(p, end, '%', '+');
+            decoded.append(p, escape);
+            if (escape == end) {
+                break;
+            }
+            
+            if (*escape == '+') {
+                decoded.push_back(' ');
+                p = escape + 1;
+            } else if (end - escape >= 3 && hexValue(escape[1]) >= 0 && hexValue(escape[2]) >= 0) {
+                decoded.push_back(static_cast<char>(hexValue(escape[1]) * 16 + hexValue(escape[2])));
+                p = escape + 3;
+            } else {
+                decoded.push_back('%');
+                p = escape + 1;
+            }
+        }
+        return decoded;
+    }
+    
+    bool needsDecoding(const char* begin, const char* end) {
+        return simd::findFirstOf(begin, end, '%', '+') != end;
     }
 }
 
 std::string HttpRequest::getHeader(const std::string& name) const {
-    auto it = headers_.find(name);
+    auto it = headers_.find(std::string_view(name));
     if (it != headers_.end()) {
-        return it->second;
+        return std::string(it->second);
     }
     
     // Try case-insensitive search
-    std::string lowerName = name;
-    std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
-    
     for (const auto& header : headers_) {
-        std::string lowerHeaderName = header.first;
-        std::transform(lowerHeaderName.begin(), lowerHeaderName.end(), lowerHeaderName.begin(), ::tolower);
-        if (lowerHeaderName == lowerName) {
-            return header.second;
+        if (equalsIgnoreCase(header.first, name)) {
+            return std::string(header.second);
         }
     }
     
     return "";
 }
 
-void HttpRequest::setHeader(const std::string& name, const std::string& value) {
-    headers_[name] = value;
+bool HttpRequest::findHeader(std::string_view name, std::string_view& value) const {
+    auto it = headers_.find(name);
+    if (it == headers_.end()) {
+        it = std::find_if(headers_.begin(), headers_.end(),
+                          [name](const auto& header) { return equalsIgnoreCase(header.first, name); });
+    }
+    if (it == headers_.end()) {
+        return false;
+    }
+    value = it->second;
+    return true;
+}
+
+std::map<std::string, std::string> HttpRequest::getHeaders() const {
+    return toStdMap(headers_);
+}
+
+void HttpRequest::setHeader(std::string_view name, std::string_view value) {
+    assignEntry(headers_, name, value);
 }
 
 void HttpRequest::setBody(const std::vector<uint8_t>& body) {
-    body_ = std::string(body.begin(), body.end());
+    resetBody(BodyBuffer::copyOf(body.data(), body.size()));
+}
+
+// The cache holds the published instance until the body changes, so the
+// references returned below stay valid as long as before
+const nlohmann::json& HttpRequest::json() const {
+    if (auto cached = jsonCache_.load()) {
+        return *cached;
+    }
+    std::string_view body = body_.view();
+    return *jsonCache_.publish(
+        std::make_shared<const nlohmann::json>(nlohmann::json::parse(body.begin(), body.end())));
+}
+
+const LazyJson& HttpRequest::lazyJson() const {
+    if (auto cached = lazyJsonCache_.load()) {
+        return *cached;
+    }
+    return *lazyJsonCache_.publish(std::make_shared<const LazyJson>(body_));
+}
+
+// The source may be parsed by a reader of it meanwhile
+HttpRequest::QueryIndex::QueryIndex(const QueryIndex& other, std::pmr::memory_resource* resource)
+    : entries_(resource) {
+    std::lock_guard<std::mutex> lock(other.mutex_);
+    entries_.assign(other.entries_.begin(), other.entries_.end());
+    parsedUpTo_.store(other.parsedUpTo_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+HttpRequest::QueryIndex& HttpRequest::QueryIndex::operator=(const QueryIndex& other) {
+    if (this != &other) {
+        std::lock_guard<std::mutex> lock(other.mutex_);
+        entries_.assign(other.entries_.begin(), other.entries_.end());
+        parsedUpTo_.store(other.parsedUpTo_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    return *this;
+}
+
+const std::pmr::vector<HttpRequest::QueryEntry>& HttpRequest::QueryIndex::get(std::string_view query) {
+    if (parsedUpTo_.load(std::memory_order_acquire) >= query.size()) {
+        return entries_;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t parsedUpTo = parsedUpTo_.load(std::memory_order_relaxed);
+    if (parsedUpTo >= query.size()) {
+        return entries_;
+    }
+    
+    const char* base = query.data();
+    const char* p = base + parsedUpTo;
+    const char* end = base + query.size();
+    
+    while (p < end) {
+        const char* pairEnd = static_cast<const char*>(std::memchr(p, '&', static_cast<size_t>(end - p)));
+        if (!pairEnd) {
+            pairEnd = end;
+        }
+        
+        if (pairEnd != p) {
+            const char* equals = static_cast<const char*>(std::memchr(p, '=', static_cast<size_t>(pairEnd - p)));
+            const char* keyEnd = equals ? equals : pairEnd;
+            const char* valueBegin = equals ? equals + 1 : pairEnd;
+            
+            QueryEntry entry;
+            entry.keyOffset = static_cast<size_t>(p - base);
+            entry.keyLength = static_cast<size_t>(keyEnd - p);
+            entry.valueOffset = static_cast<size_t>(valueBegin - base);
+            entry.valueLength = static_cast<size_t>(pairEnd - valueBegin);
+            entry.keyEncoded = needsDecoding(p, keyEnd);
+            entry.valueEncoded = needsDecoding(valueBegin, pairEnd);
+            entries_.push_back(entry);
+        }
+        
+        p = pairEnd + 1;
+    }
+    
+    parsedUpTo_.store(query.size(), std::memory_order_release);
+    return entries_;
+}
+
+std::pmr::vector<HttpRequest::QueryEntry>& HttpRequest::QueryIndex::modify(std::string_view query) {
+    get(query);
+    return entries_;
+}
+
+void HttpRequest::QueryIndex::add(const QueryEntry& entry, size_t queryLength) {
+    entries_.push_back(entry);
+    parsedUpTo_.store(queryLength, std::memory_order_release);
+}
+
+std::string HttpRequest::decodeQueryPart(size_t offset, size_t length, bool encoded) const {
+    std::string_view raw(queryString_.data() + offset, length);
+    return encoded ? percentDecode(raw) : std::string(raw);
+}
+
+bool HttpRequest::queryKeyEquals(const QueryEntry& entry, std::string_view name) const {
+    std::string_view raw(queryString_.data() + entry.keyOffset, entry.keyLength);
+    if (!entry.keyEncoded) {
+        return raw == name;
+    }
+    return percentDecode(raw) == name;
+}
+
+std::map<std::string, std::string> HttpRequest::getQueryParams() const {
+    std::map<std::string, std::string> result;
+    for (const auto& entry : queryEntries()) {
+        result[decodeQueryPart(entry.keyOffset, entry.keyLength, entry.keyEncoded)] =
+            decodeQueryPart(entry.valueOffset, entry.valueLength, entry.valueEncoded);
+    }
+    return result;
 }
 
 std::string HttpRequest::getQueryParam(const std::string& name) const {
-    auto it = queryParams_.find(name);
-    return (it != queryParams_.end()) ? it->second : "";
+    const auto& entries = queryEntries();
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+        if (queryKeyEquals(*it, name)) {
+            return decodeQueryPart(it->valueOffset, it->valueLength, it->valueEncoded);
+        }
+    }
+    return "";
+}
+
+std::vector<std::string> HttpRequest::getQueryParamValues(const std::string& name) const {
+    std::vector<std::string> values;
+    for (const auto& entry : queryEntries()) {
+        if (queryKeyEquals(entry, name)) {
+            values.push_back(decodeQueryPart(entry.valueOffset, entry.valueLength, entry.valueEncoded));
+        }
+    }
+    return values;
+}
+
+bool HttpRequest::hasQueryParam(const std::string& name) const {
+    const auto& entries = queryEntries();
+    return std::any_of(entries.begin(), entries.end(),
+                       [&](const QueryEntry& entry) { return queryKeyEquals(entry, name); });
 }
 
 void HttpRequest::setQueryParam(const std::string& name, const std::string& value) {
-    queryParams_[name] = value;
+    auto& entries = queryIndex_.modify(queryString_);
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [&](const QueryEntry& entry) { return queryKeyEquals(entry, name); }),
+                  entries.end());
+    
+    // The literal name and value are kept in queryString_ and marked as not
+    // encoded, so they are returned exactly as given
+    if (!queryString_.empty()) {
+        queryString_.push_back('&');
+    }
+    QueryEntry entry;
+    entry.keyOffset = queryString_.size();
+    entry.keyLength = name.size();
+    queryString_.append(name).push_back('=');
+    entry.valueOffset = queryString_.size();
+    entry.valueLength = value.size();
+    queryString_.append(value);
+    entry.keyEncoded = false;
+    entry.valueEncoded = false;
+    
+    queryIndex_.add(entry, queryString_.size());
+}
+
+std::map<std::string, std::string> HttpRequest::getPathParams() const {
+    return toStdMap(pathParams_);
 }
 
 std::string HttpRequest::getPathParam(const std::string& name) const {
-    auto it = pathParams_.find(name);
-    return (it != pathParams_.end()) ? it->second : "";
+    auto it = pathParams_.find(std::string_view(name));
+    return (it != pathParams_.end()) ? std::string(it->second) : "";
 }
 
 void HttpRequest::setPathParam(const std::string& name, const std::string& value) {
-    pathParams_[name] = value;
+    assignEntry(pathParams_, name, value);
+}
+
+bool HttpRequest::isCancelled() const {
+    return cancellation_ && cancellation_->isCancelled();
 }
 
 std::string HttpRequest::getContentType() const {
@@ -81,20 +344,12 @@ bool HttpRequest::isFormData() const {
 }
 
 void HttpRequest::parseQueryString(const std::string& queryString) {
-    std::istringstream iss(queryString);
-    std::string pair;
-    
-    while (std::getline(iss, pair, '&')) {
-        size_t equalPos = pair.find('=');
-        if (equalPos != std::string::npos) {
-            std::string key = pair.substr(0, equalPos);
-            std::string value = pair.substr(equalPos + 1);
-            
-            // URL decode (basic implementation)
-            // TODO: Implement proper URL decoding
-            queryParams_[key] = value;
-        }
+    // Queue the new parameters behind the existing ones; they are parsed
+    // together on the next lookup
+    if (!queryString_.empty() && !queryString.empty()) {
+        queryString_.push_back('&');
     }
+    queryString_.append(queryString);
 }
 
 HttpMethod HttpRequest::stringToMethod(const std::string& method) {
@@ -3,6 +3,15 @@
 
 namespace cppSwitchboard {
 
+namespace {
+    /// {"error": "<message>"} with the message escaped
+    std::string errorBody(const std::string& message) {
+        JsonWriter writer(message.size() + 16, JsonWriter::Spacing::SPACED);
+        writer.beginObject().member("error", message).endObject();
+        return writer.take();
+    }
+}
+
 HttpResponse::HttpResponse(int status) : status_(status) {
 }
 
@@ -24,15 +33,29 @@ std::string HttpResponse::getHeader(const std::string& name) const {
         }
     }
     
+    if (lowerName == "content-length") {
+        return std::to_string(body_.size());
+    }
+    
     return "";
 }
 
+std::map<std::string, std::string> HttpResponse::getHeaders() const {
+    std::map<std::string, std::string> headers = headers_;
+    if (!body_.empty()) {
+        headers.emplace("Content-Length", std::to_string(body_.size()));
+    }
+    return headers;
+}
+
 void HttpResponse::setHeader(const std::string& name, const std::string& value) {
     headers_[name] = value;
+    canned_.reset();
 }
 
 void HttpResponse::removeHeader(const std::string& name) {
     headers_.erase(name);
+    canned_.reset();
 }
 
 void HttpResponse::setContentType(const std::string& contentType) {
@@ -44,71 +67,137 @@ std::string HttpResponse::getContentType() const {
 }
 
 void HttpResponse::setBody(const std::string& body) {
-    body_ = body;
-    updateContentLength();
+    body_ = BodyBuffer::copyOf(body);
+    bodyChanged();
+}
+
+void HttpResponse::setBody(std::string&& body) {
+    body_ = BodyBuffer(std::move(body));
+    bodyChanged();
+}
+
+void HttpResponse::setBody(std::string_view body) {
+    body_ = BodyBuffer::copyOf(body);
+    bodyChanged();
+}
+
+void HttpResponse::setBody(const void* data, size_t size) {
+    body_ = BodyBuffer::copyOf(data, size);
+    bodyChanged();
+}
+
+void HttpResponse::setBody(BodyBuffer body) {
+    body_ = std::move(body);
+    bodyChanged();
 }
 
 void HttpResponse::setBody(const std::vector<uint8_t>& body) {
-    body_ = std::string(body.begin(), body.end());
-    updateContentLength();
+    body_ = BodyBuffer::copyOf(body.data(), body.size());
+    bodyChanged();
+}
+
+void HttpResponse::setBody(std::vector<uint8_t>&& body) {
+    body_ = BodyBuffer(std::move(body));
+    bodyChanged();
 }
 
-void HttpResponse::appendBody(const std::string& data) {
-    body_ += data;
-    updateContentLength();
+std::string HttpResponse::takeBody() {
+    std::string body = body_.release();
+    bodyChanged();
+    return body;
 }
 
-void HttpResponse::updateContentLength() {
-    setHeader("Content-Length", std::to_string(body_.length()));
+void HttpResponse::appendBody(std::string_view data) {
+    std::string body = body_.release();
+    body.append(data.data(), data.size());
+    body_ = BodyBuffer(std::move(body));
+    bodyChanged();
+}
+
+void HttpResponse::bodyChanged() {
+    headers_.erase("Content-Length");
+    canned_.reset();
 }
 
 // Static convenience methods
-HttpResponse HttpResponse::ok(const std::string& body, const std::string& contentType) {
+HttpResponse HttpResponse::ok(std::string body, const std::string& contentType) {
     HttpResponse response(OK);
     response.setContentType(contentType);
-    response.setBody(body);
+    response.setBody(std::move(body));
     return response;
 }
 
-HttpResponse HttpResponse::json(const std::string& jsonBody) {
+HttpResponse HttpResponse::json(std::string jsonBody) {
     HttpResponse response(OK);
     response.setContentType("application/json");
-    response.setBody(jsonBody);
+    response.setBody(std::move(jsonBody));
     return response;
 }
 
-HttpResponse HttpResponse::html(const std::string& htmlBody) {
+HttpResponse HttpResponse::json(const std::function<void(JsonWriter&)>& writerFn) {
+    return json(writerFn, JsonWriter::DEFAULT_CAPACITY);
+}
+
+HttpResponse HttpResponse::json(const std::function<void(JsonWriter&)>& writerFn, size_t sizeHint) {
+    JsonWriter writer(sizeHint);
+    writerFn(writer);
+    return json(writer.take());
+}
+
+HttpResponse HttpResponse::html(std::string htmlBody) {
     HttpResponse response(OK);
     response.setContentType("text/html; charset=utf-8");
-    response.setBody(htmlBody);
+    response.setBody(std::move(htmlBody));
     return response;
 }
 
 HttpResponse HttpResponse::notFound(const std::string& message) {
     HttpResponse response(NOT_FOUND);
     response.setContentType("application/json");
-    response.setBody("{\"error\": \"" + message + "\"}");
+    response.setBody(errorBody(message));
     return response;
 }
 
 HttpResponse HttpResponse::badRequest(const std::string& message) {
     HttpResponse response(BAD_REQUEST);
     response.setContentType("application/json");
-    response.setBody("{\"error\": \"" + message + "\"}");
+    response.setBody(errorBody(message));
     return response;
 }
 
 HttpResponse HttpResponse::internalServerError(const std::string& message) {
     HttpResponse response(INTERNAL_SERVER_ERROR);
     response.setContentType("application/json");
-    response.setBody("{\"error\": \"" + message + "\"}");
+    response.setBody(errorBody(message));
     return response;
 }
 
 HttpResponse HttpResponse::methodNotAllowed(const std::string& message) {
     HttpResponse response(METHOD_NOT_ALLOWED);
     response.setContentType("application/json");
-    response.setBody("{\"error\": \"" + message + "\"}");
+    response.setBody(errorBody(message));
+    return response;
+}
+
+HttpResponse HttpResponse::payloadTooLarge(const std::string& message) {
+    HttpResponse response(PAYLOAD_TOO_LARGE);
+    response.setContentType("application/json");
+    response.setBody(errorBody(message));
+    return response;
+}
+
+HttpResponse HttpResponse::serviceUnavailable(const std::string& message, int64_t retryAfterSeconds) {
+    HttpResponse response(SERVICE_UNAVAILABLE);
+    response.setContentType("application/json");
+    response.setHeader("Retry-After", std::to_string(retryAfterSeconds));
+    response.setBody(errorBody(message));
+    return response;
+}
+
+HttpResponse HttpResponse::gatewayTimeout(const std::string& message) {
+    HttpResponse response(GATEWAY_TIMEOUT);
+    response.setContentType("application/json");
+    response.setBody(errorBody(message));
     return response;
 }
 
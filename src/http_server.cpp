@@ -1,18 +1,33 @@
 #include <cppSwitchboard/http_server.h>
+#include <cppSwitchboard/cancellation.h>
 #include <cppSwitchboard/http2_server_impl.h>
 #include <cppSwitchboard/debug_logger.h>
 #include <cppSwitchboard/middleware_pipeline.h>
+#include <cppSwitchboard/middleware_factory.h>
+#include <cppSwitchboard/request_arena.h>
+#include <cppSwitchboard/buffer_pool.h>
+#include <cppSwitchboard/http1_parser.h>
+#include "usdt_probes.h"
 #include <iostream>
 #include <iomanip>
 #include <chrono>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 #include <functional>
+#include <future>
+#include <optional>
+#include <array>
+#include <algorithm>
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
 #include <boost/beast/version.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/config.hpp>
 #include <boost/asio/signal_set.hpp>
+#include <poll.h>
+#include <cerrno>
 
 namespace beast = boost::beast;
 namespace http = beast::http;
@@ -21,18 +36,315 @@ using tcp = net::ip::tcp;
 
 namespace cppSwitchboard {
 
+namespace {
+    /// Beast header storage allocated from the connection's RequestArena
+    using ArenaFields = http::basic_fields<ArenaAllocator<char>>;
+    
+    /**
+     * @brief Beast body type that serializes a shared BodyBuffer in place
+     * 
+     * The response body goes from the handler to the socket without being
+     * copied into a Beast-owned string.
+     */
+    struct SharedBody {
+        using value_type = BodyBuffer;
+        
+        static std::uint64_t size(const value_type& body) { return body.size(); }
+        
+        class writer {
+        public:
+            using const_buffers_type = net::const_buffer;
+            
+            template <bool isRequest, class Fields>
+            writer(const http::header<isRequest, Fields>&, const value_type& body) : body_(body) {}
+            
+            void init(beast::error_code& ec) { ec = {}; }
+            
+            boost::optional<std::pair<const_buffers_type, bool>> get(beast::error_code& ec) {
+                ec = {};
+                if (body_.empty()) {
+                    return boost::none;
+                }
+                return {{const_buffers_type(body_.data(), body_.size()), false}};
+            }
+            
+        private:
+            const value_type& body_;
+        };
+    };
+    
+    using ArenaRequest = http::request<http::string_body, ArenaFields>;
+    using ArenaResponse = http::response<SharedBody, ArenaFields>;
+    
+    /// Connection read buffer drawn from the process-wide BufferPool
+    using PooledFlatBuffer = beast::basic_flat_buffer<PoolAllocator<char>>;
+    
+    /**
+     * @brief Wait for the next request on an idle keep-alive connection
+     * 
+     * Polls in short slices so that the connection thread notices a server
+     * shutdown promptly.
+     * 
+     * @return true when data is available, false on idle timeout, hang-up or shutdown
+     */
+    bool waitForNextRequest(tcp::socket& socket, std::chrono::seconds idleTimeout,
+                            const std::atomic<bool>& running) {
+        using clock = std::chrono::steady_clock;
+        const auto deadline = clock::now() + idleTimeout;
+        
+        pollfd pfd{};
+        pfd.fd = socket.native_handle();
+        pfd.events = POLLIN;
+        
+        while (running && clock::now() < deadline) {
+            int rc = ::poll(&pfd, 1, 100);
+            if (rc > 0) {
+                return (pfd.revents & POLLIN) != 0;
+            }
+            if (rc < 0 && errno != EINTR) {
+                return false;
+            }
+        }
+        return false;
+    }
+    
+    /**
+     * @brief Whether the client of a connection has closed or reset it
+     * 
+     * Used as the disconnect probe of the request being processed. Bytes
+     * of a pipelined request do not count; only the peer's FIN or an error.
+     */
+    bool peerClosed(int fd) {
+        pollfd pfd{};
+        pfd.fd = fd;
+#ifdef POLLRDHUP
+        pfd.events = POLLRDHUP;
+#else
+        pfd.events = 0;
+#endif
+        if (::poll(&pfd, 1, 0) <= 0) {
+            return false;
+        }
+#ifdef POLLRDHUP
+        if (pfd.revents & POLLRDHUP) {
+            return true;
+        }
+#endif
+        return (pfd.revents & (POLLHUP | POLLERR)) != 0;
+    }
+    
+    /// Same body limit Beast applies to request parsers by default
+    constexpr std::uint64_t REQUEST_BODY_LIMIT = 1024 * 1024;
+    
+    /// Bytes requested from the socket per read while collecting a request
+    constexpr std::size_t READ_CHUNK_SIZE = 4096;
+    
+    /**
+     * @brief A request the client got wrong, answered with @ref status before closing
+     */
+    class RequestParseError : public std::runtime_error {
+    public:
+        RequestParseError(int status, const std::string& message)
+            : std::runtime_error(message), status_(status) {}
+        
+        int status() const { return status_; }
+        
+    private:
+        int status_;
+    };
+    
+    /// Maps Beast's parse errors to RequestParseError; socket errors pass through
+    void throwReadError(const boost::system::error_code& readError) {
+        if (readError == http::error::body_limit) {
+            throw RequestParseError(HttpResponse::PAYLOAD_TOO_LARGE, readError.message());
+        }
+        if (readError.category() == http::make_error_code(http::error::bad_method).category() &&
+            readError != http::error::partial_message) {
+            throw RequestParseError(HttpResponse::BAD_REQUEST, readError.message());
+        }
+        throw boost::system::system_error(readError);
+    }
+    
+    /**
+     * @brief Read one request using the in-place Http1Parser engine
+     * 
+     * The head is parsed straight out of the connection buffer; header
+     * names and values are copied once, into the arena-backed HttpRequest.
+     * Bytes belonging to a pipelined follow-up request stay in the buffer.
+     * 
+     * @return false when the peer closed the connection before sending a request
+     * @throws RequestParseError on malformed or oversized requests
+     * @throws std::exception on socket errors
+     */
+    bool readRequestInPlace(tcp::socket& socket, PooledFlatBuffer& buffer,
+                            std::pmr::memory_resource* resource,
+                            std::optional<HttpRequest>& request, unsigned& version, bool& keepAlive) {
+        auto data = [&buffer]() { return static_cast<const char*>(buffer.data().data()); };
+        auto readMore = [&socket, &buffer](std::size_t hint) {
+            boost::system::error_code readError;
+            std::size_t n = socket.read_some(buffer.prepare(std::max(hint, READ_CHUNK_SIZE)), readError);
+            if (readError == net::error::eof) {
+                return false;
+            }
+            if (readError) {
+                throw boost::system::system_error(readError);
+            }
+            buffer.commit(n);
+            return true;
+        };
+        
+        Http1RequestHead head;
+        int headSize = Http1Parser::NEED_MORE;
+        while (true) {
+            if (buffer.size() > 0) {
+                headSize = Http1Parser::parse(data(), buffer.size(), head);
+            }
+            if (headSize >= 0) {
+                break;
+            }
+            if (headSize == Http1Parser::BAD_REQUEST) {
+                throw RequestParseError(HttpResponse::BAD_REQUEST, "Malformed HTTP/1.1 request");
+            }
+            if (!readMore(0)) {
+                if (buffer.size() == 0) {
+                    return false;
+                }
+                throw std::runtime_error("Connection closed inside HTTP/1.1 request head");
+            }
+        }
+        
+        BodyBuffer body;
+        std::size_t messageSize = static_cast<std::size_t>(headSize);
+        const std::size_t bufferedBeforeBody = buffer.size();
+        if (head.chunked) {
+            Http1ChunkedDecoder decoder;
+            std::string decoded;
+            while (true) {
+                long used = decoder.decode(data() + messageSize, buffer.size() - messageSize, decoded);
+                if (used < 0) {
+                    throw RequestParseError(HttpResponse::BAD_REQUEST, "Malformed HTTP/1.1 chunked body");
+                }
+                if (decoded.size() > REQUEST_BODY_LIMIT) {
+                    throw RequestParseError(HttpResponse::PAYLOAD_TOO_LARGE, "HTTP/1.1 request body exceeds limit");
+                }
+                messageSize += static_cast<std::size_t>(used);
+                if (decoder.isComplete()) {
+                    break;
+                }
+                if (!readMore(0)) {
+                    throw std::runtime_error("Connection closed inside HTTP/1.1 request body");
+                }
+            }
+            body = BodyBuffer(std::move(decoded));
+        } else if (head.hasContentLength) {
+            if (head.contentLength > REQUEST_BODY_LIMIT) {
+                throw RequestParseError(HttpResponse::PAYLOAD_TOO_LARGE, "HTTP/1.1 request body exceeds limit");
+            }
+            messageSize += static_cast<std::size_t>(head.contentLength);
+            while (buffer.size() < messageSize) {
+                if (!readMore(messageSize - buffer.size())) {
+                    throw std::runtime_error("Connection closed inside HTTP/1.1 request body");
+                }
+            }
+            body = BodyBuffer::copyOf(data() + headSize, static_cast<std::size_t>(head.contentLength));
+        }
+        
+        // Reading the body may have moved the buffer contents, which leaves
+        // the head's views dangling; parse the head again in that case.
+        if (buffer.size() != bufferedBeforeBody) {
+            Http1Parser::parse(data(), buffer.size(), head);
+        }
+        
+        request.emplace(std::string(head.method), std::string(head.target), "HTTP/1.1", resource);
+        for (std::size_t i = 0; i < head.headerCount; ++i) {
+            request->setHeader(head.headers[i].name, head.headers[i].value);
+        }
+        request->setBody(std::move(body));
+        version = head.version;
+        keepAlive = head.keepAlive;
+        
+        buffer.consume(messageSize);
+        return true;
+    }
+    
+    /**
+     * @brief Send a pre-serialized response with one gather write
+     * 
+     * Only the version token, Date and Connection lines vary between
+     * requests; everything else comes from the CannedResponse as is.
+     * The body is left out when answering HEAD.
+     */
+    void writeCannedResponse(tcp::socket& socket, const CannedResponse& canned, std::string_view serverHeader,
+                             unsigned version, bool keepAlive, bool withBody = true) {
+        std::string_view connection;
+        if (version >= 11 && !keepAlive) {
+            connection = "Connection: close\r\n";
+        } else if (version < 11 && keepAlive) {
+            connection = "Connection: keep-alive\r\n";
+        }
+        const std::string_view date = HttpDate::now();
+        const BodyBuffer& body = canned.getBody();
+        // Responses canned outside a server, e.g. by a plugin account, carry no Server line
+        if (canned.hasServerHeader()) {
+            serverHeader = {};
+        }
+        
+        const std::array<net::const_buffer, 11> buffers{
+            net::buffer(version >= 11 ? "HTTP/1.1" : "HTTP/1.0", 8),
+            net::buffer(canned.getHead()),
+            net::buffer("Server: ", serverHeader.empty() ? 0 : 8),
+            net::buffer(serverHeader.data(), serverHeader.size()),
+            net::buffer("\r\n", serverHeader.empty() ? 0 : 2),
+            net::buffer("Date: ", 6),
+            net::buffer(date.data(), date.size()),
+            net::buffer("\r\n", 2),
+            net::buffer(connection.data(), connection.size()),
+            net::buffer("\r\n", 2),
+            net::buffer(body.data(), withBody ? body.size() : 0)
+        };
+        net::write(socket, buffers);
+    }
+    
+    /**
+     * @brief Run a host's global middleware from @p index, then @p dispatch
+     */
+    HttpResponse runMiddleware(const std::vector<std::shared_ptr<Middleware>>& chain, size_t index,
+                               const HttpRequest& request, Context& context,
+                               const std::function<HttpResponse(const HttpRequest&)>& dispatch) {
+        while (index < chain.size() && !chain[index]->isEnabled()) {
+            ++index;
+        }
+        if (index == chain.size()) {
+            return dispatch(request);
+        }
+        
+        const auto& middleware = chain[index];
+        NextHandler next = [&chain, index, &dispatch](const HttpRequest& req, Context& ctx) {
+            return runMiddleware(chain, index + 1, req, ctx, dispatch);
+        };
+        CPPSWITCHBOARD_PROBE2(middleware_enter, middleware->getName().c_str(), request.getPath().c_str());
+        HttpResponse response = middleware->handle(request, context, next);
+        CPPSWITCHBOARD_PROBE2(middleware_exit, middleware->getName().c_str(), response.getStatus());
+        return response;
+    }
+}
+
+HttpServer::HttpServer() : HttpServer(ServerConfig()) {}
+
+HttpServer::HttpServer(const ServerConfig& config)
+    : config_(config),
+      routes_(std::make_unique<RouteRegistry>()),
+      errorHandler_(std::make_shared<DefaultErrorHandler>()),
+      cannedResponses_(std::make_shared<CannedResponseRegistry>(
+          config.application.name + "/" + config.application.version)),
+      virtualHosts_(std::make_unique<VirtualHostRouter>()) {}
+
 std::shared_ptr<HttpServer> HttpServer::create() {
-    auto server = std::shared_ptr<HttpServerImpl>(new HttpServerImpl());
-    server->routes_ = std::make_unique<RouteRegistry>();
-    server->errorHandler_ = std::make_shared<DefaultErrorHandler>();
-    return server;
+    return std::shared_ptr<HttpServerImpl>(new HttpServerImpl());
 }
 
 std::shared_ptr<HttpServer> HttpServer::create(const ServerConfig& config) {
-    auto server = std::shared_ptr<HttpServerImpl>(new HttpServerImpl(config));
-    server->routes_ = std::make_unique<RouteRegistry>();
-    server->errorHandler_ = std::make_shared<DefaultErrorHandler>();
-    return server;
+    return std::shared_ptr<HttpServerImpl>(new HttpServerImpl(config));
 }
 
 
@@ -49,6 +361,19 @@ void HttpServer::registerRouteWithMiddleware(const std::string& path, HttpMethod
     routes_->registerRouteWithMiddleware(path, method, pipeline);
 }
 
+void HttpServer::setConfig(const ServerConfig& config) {
+    config_ = config;
+    cannedResponses_ = std::make_shared<CannedResponseRegistry>(
+        config_.application.name + "/" + config_.application.version);
+}
+
+void HttpServer::registerCannedResponse(const std::string& path, HttpMethod method, HttpResponse response) {
+    auto canned = cannedResponses_->add(std::move(response));
+    routes_->registerRoute(path, method, makeHandler([canned](const HttpRequest&) {
+        return canned->toResponse();
+    }));
+}
+
 void HttpServer::get(const std::string& path, std::shared_ptr<HttpHandler> handler) {
     registerHandler(path, HttpMethod::GET, handler);
 }
@@ -82,7 +407,55 @@ void HttpServer::del(const std::string& path, std::function<HttpResponse(const H
 }
 
 void HttpServer::registerMiddleware(std::shared_ptr<Middleware> middleware) {
+    if (!middleware) {
+        throw std::invalid_argument("Middleware cannot be null");
+    }
     middleware_.push_back(middleware);
+    std::stable_sort(middleware_.begin(), middleware_.end(),
+        [](const std::shared_ptr<Middleware>& a, const std::shared_ptr<Middleware>& b) {
+            return a->getPriority() > b->getPriority();
+        });
+}
+
+MiddlewareConfigResult HttpServer::loadMiddlewareConfig(const std::string& filename) {
+    auto reloader = std::make_shared<MiddlewareReloader>(MiddlewareFactory::getInstance());
+    reloader->setLazyInstantiation(true);  // Warmed up by start()
+    auto result = reloader->load(filename);
+    if (!result.isSuccess()) {
+        return result;
+    }
+    
+    bulkheads_->configure(reloader->getCurrent()->getExecutors());
+    
+    // The executors follow every reload, watched or manual; the listener is
+    // owned by the reloader, so the raw pointer cannot dangle
+    HotReloadConfig hotReload = reloader->getHotReloadConfig();
+    const bool watch = hotReload.enabled && hotReload.reloadOnChange;
+    auto bulkheads = bulkheads_;
+    MiddlewareReloader* source = reloader.get();
+    reloader->setReloadListener([bulkheads, source, watch](const MiddlewareConfigResult& reload,
+                                                           std::chrono::microseconds latency) {
+        if (reload.isSuccess()) {
+            bulkheads->configure(source->getCurrent()->getExecutors());
+        }
+        if (!watch) {
+            return;
+        }
+        if (reload.isSuccess()) {
+            std::cout << "Middleware configuration reloaded in " << latency.count() << "us" << std::endl;
+        } else {
+            std::cerr << "Middleware configuration reload failed: " << reload.message << std::endl;
+        }
+    });
+    if (watch) {
+        reloader->startWatching();
+    }
+    middlewareReloader_ = std::move(reloader);
+    return result;
+}
+
+std::shared_ptr<VirtualHost> HttpServer::virtualHost(const std::string& hostPattern) {
+    return virtualHosts_->addHost(hostPattern);
 }
 
 void HttpServer::setErrorHandler(std::shared_ptr<ErrorHandler> errorHandler) {
@@ -115,6 +488,23 @@ void HttpServer::start() {
     }
     
     validateConfiguration();
+    startedAtNs_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    timeToFirstRequestUs_ = -1;
+    
+    // The pool outlives stop() so handlers can finish queued continuations
+    const size_t workerCount = WorkerPool::resolveThreadCount(config_.general.workerThreads);
+    if (!workerPool_ || workerPool_->getThreadCount() != workerCount) {
+        workerPool_ = std::make_shared<WorkerPool>(workerCount);
+    }
+    std::weak_ptr<WorkerPool> pool = workerPool_;
+    queueDelay_->configure(config_.general.admission);
+    queueDelay_->setOverloadListener([pool](bool overloaded) {
+        if (auto shared = pool.lock()) {
+            shared->setLifo(overloaded);
+        }
+    });
+    bulkheads_->setAdmissionControl(config_.general.admission);
     running_ = true;
     
     if (config_.http1.enabled) {
@@ -125,6 +515,12 @@ void HttpServer::start() {
         http2Thread_ = std::thread([this]() { runHttp2Server(); });
     }
     
+    // Deferred route middleware are built while the listeners come up
+    auto configured = middlewareReloader_ ? middlewareReloader_->getCurrent() : nullptr;
+    if (configured && configured->getPendingPipelineCount() > 0) {
+        warmUpThread_ = std::thread([configured]() { configured->warmUp(); });
+    }
+    
     printStartupInfo();
 }
 
@@ -143,6 +539,10 @@ void HttpServer::stop() {
     // Give the threads a moment to see the flag change and start shutting down
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
     
+    if (warmUpThread_.joinable()) {
+        warmUpThread_.join();
+    }
+    
     // Wait for both threads to finish
     if (http1Thread_.joinable()) {
         http1Thread_.join();
@@ -192,7 +592,8 @@ void HttpServer::printStartupInfo() const {
     }
     
     std::cout << "Max Connections: " << config_.general.maxConnections << std::endl;
-    std::cout << "Worker Threads: " << config_.general.workerThreads << std::endl;
+    std::cout << "Worker Threads: " << WorkerPool::resolveThreadCount(config_.general.workerThreads)
+              << (config_.general.workerThreads == 0 ? " (auto)" : "") << std::endl;
     std::cout << "Request Timeout: " << config_.general.requestTimeout.count() << "s" << std::endl;
     
     if (config_.security.rateLimitEnabled) {
@@ -213,33 +614,87 @@ void HttpServer::validateConfiguration() const {
     }
 }
 
+std::optional<std::chrono::microseconds> HttpServer::getTimeToFirstRequest() const {
+    int64_t elapsed = timeToFirstRequestUs_.load(std::memory_order_relaxed);
+    if (elapsed < 0) {
+        return std::nullopt;
+    }
+    return std::chrono::microseconds(elapsed);
+}
+
+HttpServer::ConfiguredRoute HttpServer::resolveConfiguredRoute(const HttpRequest& request) const {
+    ConfiguredRoute route;
+    if (middlewareReloader_) {
+        route.config = middlewareReloader_->getCurrent();
+    }
+    if (route.config) {
+        route.rule = route.config->findRule(request.getPath());
+    }
+    return route;
+}
+
 HttpResponse HttpServer::processRequest(const HttpRequest& request) {
+    return processRequest(request, resolveConfiguredRoute(request));
+}
+
+HttpResponse HttpServer::processRequest(const HttpRequest& request, const ConfiguredRoute& configured) {
+    // Records the first response after start(); one load per request afterwards
+    struct FirstRequestRecorder {
+        HttpServer& server;
+        ~FirstRequestRecorder() {
+            if (server.timeToFirstRequestUs_.load(std::memory_order_relaxed) >= 0) {
+                return;
+            }
+            int64_t startedAt = server.startedAtNs_.load(std::memory_order_relaxed);
+            if (startedAt == 0) {
+                return;
+            }
+            int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            int64_t expected = -1;
+            int64_t elapsed = (now - startedAt) / 1000;
+            if (server.timeToFirstRequestUs_.compare_exchange_strong(expected, elapsed)) {
+                CPPSWITCHBOARD_PROBE1(first_request, elapsed);
+                if (server.config_.general.enableLogging) {
+                    std::cout << "First request served " << elapsed << "us after start" << std::endl;
+                }
+            }
+        }
+    } firstRequest{*this};
+    
     try {
-        // Find matching route
-        auto match = routes_->findRoute(request.getPath(), request.getHttpMethod());
-        
-        if (!match.matched) {
-            return HttpResponse::notFound("Route not found: " + request.getMethod() + " " + request.getPath());
+        // Host selection comes before path routing
+        const RouteRegistry* routes = routes_.get();
+        const std::vector<std::shared_ptr<Middleware>>* middleware = &middleware_;
+        if (!virtualHosts_->empty()) {
+            if (auto host = virtualHosts_->findHost(request.getHeader("Host"))) {
+                routes = &host->getRoutes();
+                middleware = &host->getMiddleware();
+            }
         }
         
-        // Create a mutable copy of the request to add path parameters
-        HttpRequest mutableRequest = request;
-        for (const auto& param : match.pathParams) {
-            mutableRequest.setPathParam(param.first, param.second);
-        }
+        // YAML-configured middleware run on the generation resolved with the request
+        FunctionHandler route([this, routes](const HttpRequest& req) {
+            return routeRequest(*routes, req);
+        });
+        auto dispatch = [&configured, &route](const HttpRequest& req) {
+            if (configured.config) {
+                const auto& pipeline = configured.config->getRulePipeline(configured.rule);
+                if (pipeline->getMiddlewareCount() > 0) {
+                    Context context;
+                    return pipeline->execute(req, context, route);
+                }
+            }
+            return route.handle(req);
+        };
         
-        // Process with handler or middleware pipeline
-        if (match.hasMiddleware && match.middlewarePipeline) {
-            // Execute through middleware pipeline
-            return match.middlewarePipeline->execute(mutableRequest);
-        } else if (match.isAsync) {
-            // For now, we'll handle async requests synchronously
-            // In a full implementation, this would use proper async handling
-            return HttpResponse::internalServerError("Async handlers not yet supported in synchronous context");
-        } else {
-            // Execute handler directly (backward compatibility)
-            return match.handler->handle(mutableRequest);
+        if (middleware->empty()) {
+            return dispatch(request);
         }
+        
+        // Global middleware of the host wraps route dispatch
+        Context context;
+        return runMiddleware(*middleware, 0, request, context, dispatch);
     } catch (const std::exception& e) {
         if (errorHandler_) {
             return errorHandler_->handleError(request, e);
@@ -249,12 +704,270 @@ HttpResponse HttpServer::processRequest(const HttpRequest& request) {
     }
 }
 
+HttpResponse HttpServer::routeRequest(const RouteRegistry& routes, const HttpRequest& request) {
+    // Find matching route
+    auto match = routes.findRoute(request.getPath(), request.getHttpMethod());
+    
+    if (!match.matched) {
+        return unmatchedResponse(request, match);
+    }
+    
+    CPPSWITCHBOARD_PROBE3(route_matched, request.getMethod().c_str(),
+                          request.getPath().c_str(), match.pattern.c_str());
+    
+    // Create a mutable copy of the request to add path parameters; the
+    // copy stays on the request's arena when it has one
+    HttpRequest mutableRequest(request, request.getMemoryResource());
+    for (const auto& param : match.pathParams) {
+        mutableRequest.setPathParam(param.first, param.second);
+    }
+    
+    // Process with handler or middleware pipeline
+    HttpResponse response;
+    if (match.hasMiddleware && match.middlewarePipeline) {
+        // Execute through middleware pipeline
+        response = match.middlewarePipeline->execute(mutableRequest);
+    } else if (match.isAsync) {
+        response = runAsyncHandler(match.asyncHandler, mutableRequest);
+    } else {
+        // Execute handler directly (backward compatibility)
+        response = match.handler->handle(mutableRequest);
+    }
+    
+    // The only handler_done site: arg0 is the matched route pattern (as in
+    // route_matched), never the request path; arg1 is the response status
+    CPPSWITCHBOARD_PROBE2(handler_done, match.pattern.c_str(), response.getStatus());
+    return response;
+}
+
+HttpResponse HttpServer::runAsyncHandler(const std::shared_ptr<AsyncHttpHandler>& handler,
+                                         const HttpRequest& request) {
+    struct AsyncResult {
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::optional<HttpResponse> response;
+        std::exception_ptr error;
+    };
+    auto result = std::make_shared<AsyncResult>();
+    
+    // The handler may keep the request after the callback; it gets its own
+    // copy, off the connection arena
+    auto ownedRequest = std::make_shared<HttpRequest>(request, std::pmr::new_delete_resource());
+    AsyncHttpHandler::ResponseCallback callback = [result](const HttpResponse& response) {
+        std::lock_guard<std::mutex> lock(result->mutex);
+        if (!result->response) {
+            result->response = response;
+        }
+        result->ready.notify_all();
+    };
+    auto begin = [handler, ownedRequest, callback, result]() {
+        try {
+            handler->handleAsync(*ownedRequest, callback);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(result->mutex);
+            result->error = std::current_exception();
+            result->ready.notify_all();
+        }
+    };
+    
+    // On a worker (the shared pool or a bulkhead) the handler starts right
+    // here, so it cannot end up queued behind the task waiting for it.
+    // Tasks it queues on this worker lie above localFloor in its deque.
+    WorkerPool* pool = WorkerPool::current();
+    const bool onWorker = pool != nullptr;
+    size_t localFloor = 0;
+    if (onWorker) {
+        localFloor = pool->getLocalDepth();
+        begin();
+    } else {
+        auto sharedPool = workerPool_;
+        if (!sharedPool || !sharedPool->submit(begin)) {
+            begin();
+        }
+    }
+    
+    // Stop waiting once the client is gone or the request's deadline passed;
+    // the handler sees the same token through its copy of the request
+    const auto& token = request.getCancellation();
+    auto deadline = std::chrono::steady_clock::now() + config_.general.requestTimeout;
+    CancellationToken::CallbackId wakeOnCancel = 0;
+    if (token) {
+        deadline = std::min(deadline, token->getDeadline());
+        wakeOnCancel = token->onCancel([result]() {
+            std::lock_guard<std::mutex> lock(result->mutex);
+            result->ready.notify_all();
+        });
+    }
+    
+    std::unique_lock<std::mutex> lock(result->mutex);
+    while (!result->response && !result->error && std::chrono::steady_clock::now() < deadline) {
+        if (token) {
+            // Cancelling runs the callback above, which takes the lock
+            lock.unlock();
+            const bool cancelled = token->isCancelled();
+            lock.lock();
+            if (cancelled) {
+                break;
+            }
+        }
+        if (onWorker) {
+            // Run the handler's own continuations rather than block on them;
+            // unrelated queued requests are left to the other workers, so
+            // this wait neither nests without bound nor outlives its deadline
+            lock.unlock();
+            const bool ran = pool->tryRunLocal(localFloor);
+            lock.lock();
+            if (!ran) {
+                result->ready.wait_for(lock, std::chrono::milliseconds(1));
+            }
+        } else if (token) {
+            // Wake up for the disconnect probe as well
+            result->ready.wait_until(lock, std::min(deadline, std::chrono::steady_clock::now() +
+                                                              CancellationToken::PROBE_INTERVAL));
+        } else {
+            result->ready.wait_until(lock, deadline);
+        }
+    }
+    lock.unlock();
+    if (token) {
+        token->removeCallback(wakeOnCancel);
+    }
+    
+    if (result->error) {
+        std::rethrow_exception(result->error);
+    }
+    if (!result->response && token) {
+        // Tell the handler to stop; a no-op if the client already left
+        token->cancel(CancellationToken::Reason::DEADLINE);
+        return token->response();
+    }
+    if (!result->response) {
+        return cannedResponses_->error(HttpResponse::GATEWAY_TIMEOUT)->toResponse();
+    }
+    return *result->response;
+}
+
+std::shared_ptr<Bulkhead> HttpServer::findBulkhead(const ConfiguredRoute& route) const {
+    if (!route.config) {
+        return nullptr;
+    }
+    const std::string& executor = route.config->getRuleExecutor(route.rule);
+    return executor.empty() ? nullptr : bulkheads_->find(executor);
+}
+
+void HttpServer::applyRouteDeadline(const HttpRequest& request, const ConfiguredRoute& route) const {
+    const auto& token = request.getCancellation();
+    if (!token || !route.config) {
+        return;
+    }
+    const auto timeout = route.config->getRuleTimeout(route.rule);
+    if (timeout.count() > 0) {
+        const auto start = request.getReceivedAt() == std::chrono::steady_clock::time_point{}
+            ? std::chrono::steady_clock::now() : request.getReceivedAt();
+        token->tightenDeadline(start + timeout);
+    }
+}
+
+HttpResponse HttpServer::executeRequest(const HttpRequest& request) {
+    const ConfiguredRoute route = resolveConfiguredRoute(request);
+    applyRouteDeadline(request, route);
+    auto bulkhead = findBulkhead(route);
+    if (!bulkhead) {
+        if (request.isCancelled()) {
+            return request.getCancellation()->response();
+        }
+        return processRequest(request, route);
+    }
+    
+    // The connection thread waits, so the request can stay where it is
+    auto result = std::make_shared<std::promise<HttpResponse>>();
+    auto response = result->get_future();
+    auto unavailable = cannedResponses_->error(HttpResponse::SERVICE_UNAVAILABLE);
+    QueueDelayController* queueDelay = &bulkhead->getQueueDelay();
+    auto admission = bulkhead->submit(
+        [this, &request, &route, result, queueDelay]() {
+            try {
+                result->set_value(runQueuedRequest(request, *queueDelay, route));
+            } catch (...) {
+                result->set_exception(std::current_exception());
+            }
+        },
+        [result, unavailable]() { result->set_value(unavailable->toResponse()); });
+    
+    switch (admission) {
+        case Bulkhead::Admission::ADMITTED:
+            return response.get();
+        case Bulkhead::Admission::DEGRADED:
+            return processRequest(request, route);
+        case Bulkhead::Admission::REJECTED:
+            break;
+    }
+    return unavailable->toResponse();
+}
+
+void HttpServer::scheduleRequest(std::shared_ptr<const HttpRequest> request, std::function<void(HttpResponse)> done) {
+    const ConfiguredRoute route = resolveConfiguredRoute(*request);
+    applyRouteDeadline(*request, route);
+    
+    // The controller outlives the task: a bulkhead joins its threads before
+    // it goes away, and the shared one is held by the task
+    auto workOn = [this, request, done, route](QueueDelayController* queueDelay, std::shared_ptr<QueueDelayController> owner) {
+        return [this, request, done, route, queueDelay, owner]() {
+            HttpResponse response;
+            try {
+                response = runQueuedRequest(*request, *queueDelay, route);
+            } catch (const std::exception& e) {
+                response = HttpResponse::internalServerError("Internal server error: " + std::string(e.what()));
+            }
+            done(std::move(response));
+        };
+    };
+    
+    if (auto bulkhead = findBulkhead(route)) {
+        auto unavailable = cannedResponses_->error(HttpResponse::SERVICE_UNAVAILABLE);
+        auto admission = bulkhead->submit(workOn(&bulkhead->getQueueDelay(), nullptr),
+                                          [done, unavailable]() { done(unavailable->toResponse()); });
+        if (admission == Bulkhead::Admission::ADMITTED) {
+            return;
+        }
+        if (admission == Bulkhead::Admission::REJECTED) {
+            done(unavailable->toResponse());
+            return;
+        }
+        // DEGRADED: the shared pool takes it
+    }
+    
+    auto work = workOn(queueDelay_.get(), queueDelay_);
+    auto pool = workerPool_;
+    if (!pool || !pool->submit(work)) {
+        work();
+    }
+}
+
+HttpResponse HttpServer::runQueuedRequest(const HttpRequest& request, QueueDelayController& queueDelay,
+                                          const ConfiguredRoute& route) {
+    // Abandoned while it waited: nobody reads the response
+    if (request.isCancelled()) {
+        return request.getCancellation()->response();
+    }
+    if (!queueDelay.admit(request.getReceivedAt())) {
+        return cannedResponses_->error(HttpResponse::SERVICE_UNAVAILABLE)->toResponse();
+    }
+    return processRequest(request, route);
+}
+
 void HttpServer::processAsyncRequest(const HttpRequest& request, std::function<void(const HttpResponse&)> callback) {
     try {
-        auto match = routes_->findRoute(request.getPath(), request.getHttpMethod());
+        const RouteRegistry* routes = routes_.get();
+        if (!virtualHosts_->empty()) {
+            if (auto host = virtualHosts_->findHost(request.getHeader("Host"))) {
+                routes = &host->getRoutes();
+            }
+        }
+        auto match = routes->findRoute(request.getPath(), request.getHttpMethod());
         
         if (!match.matched) {
-            callback(HttpResponse::notFound("Route not found: " + request.getMethod() + " " + request.getPath()));
+            callback(unmatchedResponse(request, match));
             return;
         }
         
@@ -291,6 +1004,23 @@ void HttpServer::processAsyncRequest(const HttpRequest& request, std::function<v
     }
 }
 
+HttpResponse HttpServer::unmatchedResponse(const HttpRequest& request, const RouteMatch& match) const {
+    if (!match.pathMatched) {
+        return cannedResponses_->error(HttpResponse::NOT_FOUND)->toResponse();
+    }
+    
+    // Answered by the router; no handler or pipeline runs
+    if (request.getHttpMethod() == HttpMethod::OPTIONS) {
+        HttpResponse response(HttpResponse::NO_CONTENT);
+        response.setHeader("Allow", match.allowHeader());
+        return response;
+    }
+    
+    HttpResponse response = cannedResponses_->error(HttpResponse::METHOD_NOT_ALLOWED)->toResponse();
+    response.setHeader("Allow", match.allowHeader());
+    return response;
+}
+
 void HttpServer::logRequest(const HttpRequest& request, const HttpResponse& response) {
     if (config_.general.enableLogging) {
         auto now = std::chrono::system_clock::now();
@@ -311,62 +1041,154 @@ void HttpServerImpl::runHttp1Server() {
         
         // Lambda to handle individual connections
         std::function<void(tcp::socket)> handle_connection = [this](tcp::socket socket) {
-            // Handle request in a simple synchronous manner
-            beast::flat_buffer buffer;
-            http::request<http::string_body> req;
+            CPPSWITCHBOARD_PROBE2(connection_accept, static_cast<int>(socket.native_handle()), 1);
             
-            try {
-                http::read(socket, buffer, req);
-                
-                // Convert Beast request to our HttpRequest
-                HttpRequest qosRequest(std::string(req.method_string()), std::string(req.target()), "HTTP/1.1");
-                qosRequest.setBody(req.body());
-                
-                for (const auto& field : req) {
-                    qosRequest.setHeader(std::string(field.name_string()), std::string(field.value()));
-                }
-                
-                // Process request
-                HttpResponse qosResponse = processRequest(qosRequest);
-                
-                // Convert our HttpResponse to Beast response
-                http::response<http::string_body> res{
-                    static_cast<http::status>(qosResponse.getStatus()),
-                    req.version()
-                };
-                
-                // Add server identification
-                res.set("Server", config_.application.name + "/" + config_.application.version);
+            // Handle requests in a simple synchronous manner. Everything that
+            // lives for one request (parser fields, headers, parameters) comes
+            // from the connection arena, which is recycled between keep-alive
+            // requests instead of being freed. The read buffer is pooled and
+            // handed back while the connection sits idle.
+            PooledFlatBuffer buffer;
+            RequestArena arena;
+            const bool parseInPlace = config_.http1.parser == "simd";
+            const auto cannedResponses = cannedResponses_;
+            const std::string& serverHeader = cannedResponses->getServerHeader();
+            bool keepAlive = true;
+            
+            while (keepAlive && running_) {
+                arena.reset();
+                ArenaFields::allocator_type allocator(arena.resource());
+                unsigned version = 11;
                 
-                for (const auto& header : qosResponse.getHeaders()) {
-                    res.set(header.first, header.second);
+                try {
+                    std::optional<HttpRequest> parsedRequest;
+                    if (parseInPlace) {
+                        if (!readRequestInPlace(socket, buffer, arena.resource(), parsedRequest, version, keepAlive)) {
+                            break;
+                        }
+                    } else {
+                        ArenaRequest req{std::piecewise_construct, std::make_tuple(), std::make_tuple(allocator)};
+                        boost::system::error_code readError;
+                        http::read(socket, buffer, req, readError);
+                        if (readError == http::error::end_of_stream) {
+                            break;
+                        }
+                        if (readError) {
+                            throwReadError(readError);
+                        }
+                        
+                        // Convert Beast request to our HttpRequest
+                        parsedRequest.emplace(std::string(req.method_string()), std::string(req.target()),
+                                              "HTTP/1.1", arena.resource());
+                        parsedRequest->setBody(std::move(req.body()));
+                        
+                        for (const auto& field : req) {
+                            auto name = field.name_string();
+                            auto value = field.value();
+                            parsedRequest->setHeader(std::string_view(name.data(), name.size()),
+                                                     std::string_view(value.data(), value.size()));
+                        }
+                        version = req.version();
+                        keepAlive = req.keep_alive();
+                    }
+                    HttpRequest& qosRequest = *parsedRequest;
+                    qosRequest.setReceivedAt(std::chrono::steady_clock::now());
+                    
+                    CPPSWITCHBOARD_PROBE3(request_parsed, qosRequest.getMethod().c_str(),
+                                          qosRequest.getPath().c_str(), 0);
+                    
+                    // The handler can tell when the client hangs up; the
+                    // probe is gone before the socket is touched again
+                    auto cancellation = std::make_shared<CancellationToken>(
+                        CancellationToken::deadlineFromHeaders(qosRequest, qosRequest.getReceivedAt()));
+                    const int fd = socket.native_handle();
+                    cancellation->setProbe([fd]() { return peerClosed(fd); });
+                    qosRequest.setCancellation(cancellation);
+                    struct ProbeGuard {
+                        CancellationToken& token;
+                        ~ProbeGuard() { token.setProbe(nullptr); }
+                    };
+                    
+                    // Process request
+                    HttpResponse qosResponse;
+                    {
+                        ProbeGuard guard{*cancellation};
+                        qosResponse = executeRequest(qosRequest);
+                    }
+                    if (cancellation->getReason() == CancellationToken::Reason::CLIENT_GONE) {
+                        logRequest(qosRequest, qosResponse);
+                        break;
+                    }
+                    
+                    // HEAD gets the headers the GET handler produced, without the body
+                    const bool headRequest = qosRequest.getHttpMethod() == HttpMethod::HEAD;
+                    
+                    if (const auto& canned = qosResponse.getCanned()) {
+                        // Unmodified canned response: the bytes are ready
+                        writeCannedResponse(socket, *canned, serverHeader, version, keepAlive, !headRequest);
+                    } else {
+                        // Convert our HttpResponse to Beast response
+                        ArenaResponse res{std::piecewise_construct, std::make_tuple(), std::make_tuple(allocator)};
+                        res.result(static_cast<http::status>(qosResponse.getStatus()));
+                        res.version(version);
+                        
+                        // Add server identification
+                        res.set(http::field::server, serverHeader);
+                        const std::string_view date = HttpDate::now();
+                        res.set(http::field::date, beast::string_view(date.data(), date.size()));
+                        
+                        for (const auto& header : qosResponse.getHeaderFields()) {
+                            res.set(header.first, header.second);
+                        }
+                        
+                        // Content-Length is derived from the body here, once
+                        res.body() = qosResponse.getBodyBuffer();
+                        res.keep_alive(keepAlive);
+                        res.prepare_payload();
+                        
+                        // Send response
+                        if (headRequest) {
+                            http::response_serializer<SharedBody, ArenaFields> serializer{res};
+                            http::write_header(socket, serializer);
+                        } else {
+                            http::write(socket, res);
+                        }
+                    }
+                    CPPSWITCHBOARD_PROBE3(response_written, qosResponse.getStatus(),
+                                          qosResponse.getBodyBuffer().size(), 0);
+                    
+                    // Log request
+                    logRequest(qosRequest, qosResponse);
+                    
+                } catch (const RequestParseError& e) {
+                    // The rest of the stream cannot be framed: answer and close
+                    try {
+                        writeCannedResponse(socket, *cannedResponses->error(e.status()),
+                                            serverHeader, version, false);
+                    } catch (...) {
+                        // Ignore write errors
+                    }
+                    break;
+                } catch (const std::exception& e) {
+                    // Send error response
+                    try {
+                        writeCannedResponse(socket, *cannedResponses->error(HttpResponse::INTERNAL_SERVER_ERROR),
+                                            serverHeader, version, false);
+                    } catch (...) {
+                        // Ignore write errors
+                    }
+                    break;
                 }
                 
-                res.body() = qosResponse.getBody();
-                res.prepare_payload();
-                
-                // Send response
-                http::write(socket, res);
-                
-                // Log request
-                logRequest(qosRequest, qosResponse);
-                
-            } catch (const std::exception& e) {
-                // Send error response
-                http::response<http::string_body> res{http::status::internal_server_error, req.version()};
-                res.set(http::field::content_type, "application/json");
-                res.set("Server", config_.application.name + "/" + config_.application.version);
-                res.body() = "{\"error\": \"Internal Server Error\"}";
-                res.prepare_payload();
-                
-                try {
-                    http::write(socket, res);
-                } catch (...) {
-                    // Ignore write errors
+                if (keepAlive && buffer.size() == 0) {
+                    buffer.shrink_to_fit();
+                    keepAlive = waitForNextRequest(socket, config_.general.requestTimeout, running_);
                 }
             }
             
-            socket.shutdown(tcp::socket::shutdown_send);
+            CPPSWITCHBOARD_PROBE2(connection_close, static_cast<int>(socket.native_handle()), 1);
+            boost::system::error_code shutdownError;
+            socket.shutdown(tcp::socket::shutdown_send, shutdownError);
         };
         
         // Recursive lambda for async accept
@@ -423,14 +1245,22 @@ void HttpServerImpl::runHttp2Server() {
     }
     
     try {
-        net::io_context ioc{static_cast<int>(config_.general.workerThreads)};
+        // One thread drives the sockets; handlers run on the worker pool
+        net::io_context ioc{1};
         
-        // Create HTTP/2 server with request processor
+        // Create HTTP/2 server with request processor; requests are routed
+        // on the I/O thread and run on their bulkhead or the shared pool
         Http2Server http2Server(ioc, config_, 
             [this](const HttpRequest& request) -> HttpResponse {
                 HttpResponse response = processRequest(request);
                 logRequest(request, response);
                 return response;
+            },
+            [this](std::shared_ptr<const HttpRequest> request, std::function<void(HttpResponse)> done) {
+                scheduleRequest(request, [this, request, done](HttpResponse response) {
+                    logRequest(*request, response);
+                    done(std::move(response));
+                });
             });
         
         http2Server.start();
@@ -0,0 +1,165 @@
+/**
+ * @file json_writer.cpp
+ * @brief Implementation of the streaming JSON serializer
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-23
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/json_writer.h>
+#include "simd_scan.h"
+#include <charconv>
+#include <cmath>
+
+namespace cppSwitchboard {
+
+JsonWriter::JsonWriter(std::size_t expectedSize, Spacing spacing) : spacing_(spacing) {
+    out_.reserve(expectedSize);
+}
+
+void JsonWriter::separate() {
+    if (afterKey_) {
+        afterKey_ = false;
+        return;
+    }
+    if (!hasElements_.empty()) {
+        if (hasElements_.back()) {
+            out_.append(spacing_ == Spacing::SPACED ? ", " : ",");
+        }
+        hasElements_.back() = true;
+    }
+}
+
+JsonWriter& JsonWriter::beginObject() {
+    separate();
+    out_.push_back('{');
+    hasElements_.push_back(false);
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject() {
+    out_.push_back('}');
+    hasElements_.pop_back();
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray() {
+    separate();
+    out_.push_back('[');
+    hasElements_.push_back(false);
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray() {
+    out_.push_back(']');
+    hasElements_.pop_back();
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(std::string_view name) {
+    separate();
+    appendString(out_, name);
+    out_.append(spacing_ == Spacing::SPACED ? ": " : ":");
+    afterKey_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::string_view text) {
+    separate();
+    appendString(out_, text);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool flag) {
+    separate();
+    out_.append(flag ? "true" : "false");
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(double number) {
+    if (!std::isfinite(number)) {
+        return nullValue();
+    }
+    separate();
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    std::string_view digits(buffer, static_cast<std::size_t>(result.ptr - buffer));
+    out_.append(digits);
+    // Keep integral doubles recognizable as floating point ("1.0", not "1")
+    if (digits.find_first_of(".e") == std::string_view::npos) {
+        out_.append(".0");
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::writeInteger(int64_t number) {
+    separate();
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    out_.append(buffer, static_cast<std::size_t>(result.ptr - buffer));
+    return *this;
+}
+
+JsonWriter& JsonWriter::writeUnsigned(uint64_t number) {
+    separate();
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    out_.append(buffer, static_cast<std::size_t>(result.ptr - buffer));
+    return *this;
+}
+
+JsonWriter& JsonWriter::nullValue() {
+    separate();
+    out_.append("null");
+    return *this;
+}
+
+JsonWriter& JsonWriter::rawValue(std::string_view json) {
+    separate();
+    out_.append(json);
+    return *this;
+}
+
+std::string JsonWriter::take() {
+    std::string result = std::move(out_);
+    out_.clear();
+    hasElements_.clear();
+    afterKey_ = false;
+    return result;
+}
+
+void JsonWriter::appendString(std::string& out, std::string_view text) {
+    static const char HEX[] = "0123456789abcdef";
+
+    out.reserve(out.size() + text.size() + 2);
+    out.push_back('"');
+    const char* p = text.data();
+    const char* const end = p + text.size();
+    while (p < end) {
+        // Copy the run of bytes that need no escaping in one go
+        const char* special = simd::findJsonSpecial(p, end);
+        out.append(p, static_cast<std::size_t>(special - p));
+        if (special == end) {
+            break;
+        }
+        const unsigned char c = static_cast<unsigned char>(*special);
+        switch (c) {
+            case '"': out.append("\\\""); break;
+            case '\\': out.append("\\\\"); break;
+            case '\b': out.append("\\b"); break;
+            case '\f': out.append("\\f"); break;
+            case '\n': out.append("\\n"); break;
+            case '\r': out.append("\\r"); break;
+            case '\t': out.append("\\t"); break;
+            default: {
+                const char escaped[] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF]};
+                out.append(escaped, sizeof(escaped));
+                break;
+            }
+        }
+        p = special + 1;
+    }
+    out.push_back('"');
+}
+
+} // namespace cppSwitchboard
@@ -0,0 +1,416 @@
+/**
+ * @file lazy_json.cpp
+ * @brief Implementation of the on-demand JSON tape
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-23
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/lazy_json.h>
+#include "simd_scan.h"
+#include <nlohmann/json.hpp>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace cppSwitchboard {
+
+namespace {
+    inline bool isWhitespace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    inline bool isNumberChar(char c) {
+        return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+    }
+
+    int hexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    bool readHex4(std::string_view s, size_t pos, uint32_t& value) {
+        if (pos + 4 > s.size()) {
+            return false;
+        }
+        value = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            int digit = hexValue(s[pos + i]);
+            if (digit < 0) {
+                return false;
+            }
+            value = (value << 4) | static_cast<uint32_t>(digit);
+        }
+        return true;
+    }
+
+    void appendUtf8(std::string& out, uint32_t cp) {
+        if (cp < 0x80) {
+            out.push_back(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+
+    /**
+     * Decode the contents of a string token (without the quotes).
+     */
+    std::optional<std::string> unescape(std::string_view s) {
+        std::string out;
+        out.reserve(s.size());
+        for (size_t i = 0; i < s.size(); ++i) {
+            char c = s[i];
+            if (static_cast<unsigned char>(c) < 0x20) {
+                return std::nullopt;
+            }
+            if (c != '\\') {
+                out.push_back(c);
+                continue;
+            }
+            if (++i >= s.size()) {
+                return std::nullopt;
+            }
+            switch (s[i]) {
+                case '"': out.push_back('"'); break;
+                case '\\': out.push_back('\\'); break;
+                case '/': out.push_back('/'); break;
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'n': out.push_back('\n'); break;
+                case 'r': out.push_back('\r'); break;
+                case 't': out.push_back('\t'); break;
+                case 'u': {
+                    uint32_t cp;
+                    if (!readHex4(s, i + 1, cp)) {
+                        return std::nullopt;
+                    }
+                    i += 4;
+                    if (cp >= 0xD800 && cp <= 0xDBFF) {
+                        uint32_t low;
+                        if (i + 2 >= s.size() || s[i + 1] != '\\' || s[i + 2] != 'u' ||
+                            !readHex4(s, i + 3, low) || low < 0xDC00 || low > 0xDFFF) {
+                            return std::nullopt;
+                        }
+                        i += 6;
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                        return std::nullopt;
+                    }
+                    appendUtf8(out, cp);
+                    break;
+                }
+                default:
+                    return std::nullopt;
+            }
+        }
+        return out;
+    }
+}
+
+// LazyJson implementation
+
+LazyJson::LazyJson(BodyBuffer text) : text_(std::move(text)) {
+    build();
+}
+
+bool LazyJson::fail(std::string message, size_t offset) {
+    error_ = std::move(message) + " at offset " + std::to_string(offset);
+    tape_.clear();
+    return false;
+}
+
+bool LazyJson::build() {
+    enum class Expect { VALUE, VALUE_OR_END, KEY, KEY_OR_END, COLON, COMMA_OR_END, DONE };
+
+    const char* const begin = text_.data();
+    const size_t size = text_.size();
+    if (size > std::numeric_limits<uint32_t>::max()) {
+        return fail("Document too large", 0);
+    }
+
+    std::vector<uint32_t> open;   // tape indices of the containers being filled
+    Expect expect = Expect::VALUE;
+    size_t pos = 0;
+
+    auto push = [this](size_t start, size_t length, JsonCursor::Type type, bool escaped) {
+        uint32_t index = static_cast<uint32_t>(tape_.size());
+        tape_.push_back({static_cast<uint32_t>(start), static_cast<uint32_t>(length), index + 1, type, escaped});
+    };
+
+    // Scan a string token starting at the opening quote at pos
+    auto scanString = [&](bool& escaped) -> bool {
+        const char* p = begin + pos + 1;
+        const char* end = begin + size;
+        escaped = false;
+        while (true) {
+            p = simd::findFirstOf(p, end, '"', '\\');
+            if (p == end) {
+                return false;
+            }
+            if (*p == '"') {
+                pos = static_cast<size_t>(p - begin) + 1;
+                return true;
+            }
+            escaped = true;
+            p += 2;
+            if (p > end) {
+                return false;
+            }
+        }
+    };
+
+    while (expect != Expect::DONE) {
+        while (pos < size && isWhitespace(begin[pos])) {
+            ++pos;
+        }
+        if (pos >= size) {
+            return fail("Unexpected end of document", pos);
+        }
+        const char c = begin[pos];
+        const size_t start = pos;
+
+        if (expect == Expect::COLON) {
+            if (c != ':') {
+                return fail("Expected ':'", pos);
+            }
+            ++pos;
+            expect = Expect::VALUE;
+            continue;
+        }
+
+        if (expect == Expect::COMMA_OR_END || (expect == Expect::VALUE_OR_END && c == ']') ||
+            (expect == Expect::KEY_OR_END && c == '}')) {
+            const bool inObject = tape_[open.back()].type == JsonCursor::Type::OBJECT;
+            if (c == ',' && expect == Expect::COMMA_OR_END) {
+                ++pos;
+                expect = inObject ? Expect::KEY : Expect::VALUE;
+                continue;
+            }
+            if (c != (inObject ? '}' : ']')) {
+                return fail(inObject ? "Expected ',' or '}'" : "Expected ',' or ']'", pos);
+            }
+            TapeEntry& container = tape_[open.back()];
+            container.length = static_cast<uint32_t>(pos + 1 - container.start);
+            container.next = static_cast<uint32_t>(tape_.size());
+            open.pop_back();
+            ++pos;
+            expect = open.empty() ? Expect::DONE : Expect::COMMA_OR_END;
+            continue;
+        }
+
+        if (expect == Expect::KEY || expect == Expect::KEY_OR_END) {
+            bool escaped;
+            if (c != '"' || !scanString(escaped)) {
+                return fail("Expected member name", start);
+            }
+            push(start, pos - start, JsonCursor::Type::STRING, escaped);
+            expect = Expect::COLON;
+            continue;
+        }
+
+        // VALUE or VALUE_OR_END with a value
+        if (c == '{' || c == '[') {
+            if (open.size() >= MAX_DEPTH) {
+                return fail("Nesting too deep", pos);
+            }
+            const bool object = c == '{';
+            open.push_back(static_cast<uint32_t>(tape_.size()));
+            push(start, 1, object ? JsonCursor::Type::OBJECT : JsonCursor::Type::ARRAY, false);
+            ++pos;
+            expect = object ? Expect::KEY_OR_END : Expect::VALUE_OR_END;
+            continue;
+        }
+
+        if (c == '"') {
+            bool escaped;
+            if (!scanString(escaped)) {
+                return fail("Unterminated string", start);
+            }
+            push(start, pos - start, JsonCursor::Type::STRING, escaped);
+        } else if (c == '-' || (c >= '0' && c <= '9')) {
+            while (pos < size && isNumberChar(begin[pos])) {
+                ++pos;
+            }
+            push(start, pos - start, JsonCursor::Type::NUMBER, false);
+        } else {
+            std::string_view rest(begin + pos, size - pos);
+            JsonCursor::Type type;
+            size_t length;
+            if (rest.substr(0, 4) == "true" || rest.substr(0, 5) == "false") {
+                type = JsonCursor::Type::BOOLEAN;
+                length = c == 't' ? 4 : 5;
+            } else if (rest.substr(0, 4) == "null") {
+                type = JsonCursor::Type::NULL_VALUE;
+                length = 4;
+            } else {
+                return fail("Unexpected character", pos);
+            }
+            pos += length;
+            push(start, length, type, false);
+        }
+        expect = open.empty() ? Expect::DONE : Expect::COMMA_OR_END;
+    }
+
+    while (pos < size && isWhitespace(begin[pos])) {
+        ++pos;
+    }
+    if (pos != size) {
+        return fail("Trailing characters after document", pos);
+    }
+    return true;
+}
+
+JsonCursor LazyJson::root() const noexcept {
+    if (tape_.empty()) {
+        return JsonCursor();
+    }
+    return JsonCursor(this, 0);
+}
+
+// JsonCursor implementation
+
+JsonCursor::Type JsonCursor::type() const noexcept {
+    return doc_ ? doc_->tape_[index_].type : Type::INVALID;
+}
+
+std::string_view JsonCursor::raw() const noexcept {
+    if (!doc_) {
+        return {};
+    }
+    const auto& entry = doc_->tape_[index_];
+    return std::string_view(doc_->text_.data() + entry.start, entry.length);
+}
+
+JsonCursor JsonCursor::operator[](std::string_view key) const {
+    if (type() != Type::OBJECT) {
+        return JsonCursor();
+    }
+    const auto& tape = doc_->tape_;
+    const uint32_t end = tape[index_].next;
+    for (uint32_t i = index_ + 1; i < end; i = tape[i + 1].next) {
+        JsonCursor name(doc_, i);
+        std::string_view quoted = name.raw();
+        std::string_view content = quoted.substr(1, quoted.size() - 2);
+        if (tape[i].escaped ? name.getString() == key : content == key) {
+            return JsonCursor(doc_, i + 1);
+        }
+    }
+    return JsonCursor();
+}
+
+JsonCursor JsonCursor::operator[](std::size_t index) const {
+    if (type() != Type::ARRAY) {
+        return JsonCursor();
+    }
+    const auto& tape = doc_->tape_;
+    const uint32_t end = tape[index_].next;
+    for (uint32_t i = index_ + 1; i < end; i = tape[i].next) {
+        if (index-- == 0) {
+            return JsonCursor(doc_, i);
+        }
+    }
+    return JsonCursor();
+}
+
+std::size_t JsonCursor::size() const {
+    const Type t = type();
+    if (t != Type::OBJECT && t != Type::ARRAY) {
+        return 0;
+    }
+    const auto& tape = doc_->tape_;
+    const uint32_t end = tape[index_].next;
+    std::size_t count = 0;
+    for (uint32_t i = index_ + 1; i < end; ++count) {
+        // Object members occupy a name entry followed by the value subtree
+        i = t == Type::OBJECT ? tape[i + 1].next : tape[i].next;
+    }
+    return count;
+}
+
+std::vector<std::string> JsonCursor::keys() const {
+    std::vector<std::string> result;
+    if (type() != Type::OBJECT) {
+        return result;
+    }
+    const auto& tape = doc_->tape_;
+    const uint32_t end = tape[index_].next;
+    for (uint32_t i = index_ + 1; i < end; i = tape[i + 1].next) {
+        result.push_back(JsonCursor(doc_, i).getString().value_or(std::string()));
+    }
+    return result;
+}
+
+std::optional<std::string> JsonCursor::getString() const {
+    if (type() != Type::STRING) {
+        return std::nullopt;
+    }
+    std::string_view quoted = raw();
+    std::string_view content = quoted.substr(1, quoted.size() - 2);
+    if (!doc_->tape_[index_].escaped) {
+        for (char c : content) {
+            if (static_cast<unsigned char>(c) < 0x20) {
+                return std::nullopt;
+            }
+        }
+        return std::string(content);
+    }
+    return unescape(content);
+}
+
+std::optional<int64_t> JsonCursor::getInt() const {
+    if (type() != Type::NUMBER) {
+        return std::nullopt;
+    }
+    std::string_view text = raw();
+    int64_t value = 0;
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc() || ptr != text.data() + text.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+std::optional<double> JsonCursor::getDouble() const {
+    if (type() != Type::NUMBER) {
+        return std::nullopt;
+    }
+    // strtod accepts forms JSON does not (hex, inf); the tape only admits
+    // digits, signs, '.', 'e' and 'E', so a full conversion is sufficient
+    std::string text(raw());
+    char* end = nullptr;
+    double value = std::strtod(text.c_str(), &end);
+    if (end != text.c_str() + text.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+std::optional<bool> JsonCursor::getBool() const {
+    if (type() != Type::BOOLEAN) {
+        return std::nullopt;
+    }
+    return raw()[0] == 't';
+}
+
+nlohmann::json JsonCursor::materialize() const {
+    if (!doc_) {
+        return nlohmann::json(nlohmann::json::value_t::discarded);
+    }
+    std::string_view text = raw();
+    return nlohmann::json::parse(text.begin(), text.end(), nullptr, false);
+}
+
+} // namespace cppSwitchboard
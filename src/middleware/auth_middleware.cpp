@@ -7,6 +7,7 @@
  */
 
 #include <cppSwitchboard/middleware/auth_middleware.h>
+#include "usdt_probes.h"
 #include <openssl/hmac.h>
 #include <openssl/evp.h>
 #include <openssl/bio.h>
@@ -352,6 +353,8 @@ bool AuthMiddleware::verifyJwtSignature(const std::string& token, const std::str
 }
 
 HttpResponse AuthMiddleware::createAuthErrorResponse(const std::string& message) const {
+    CPPSWITCHBOARD_PROBE1(auth_fail, message.c_str());
+    
     HttpResponse response;
     response.setStatus(HttpResponse::UNAUTHORIZED);
     response.setHeader("Content-Type", "application/json");
@@ -291,7 +291,7 @@ LoggingMiddleware::LogEntry LoggingMiddleware::createLogEntry(
     
     entry.remoteAddr = extractClientIP(request);
     entry.responseStatus = response.getStatus();
-    entry.responseSize = response.getBody().size();
+    entry.responseSize = response.getContentLength();
     entry.duration = duration;
     
     auto userInfo = extractUserInfo(context);
@@ -318,11 +318,12 @@ LoggingMiddleware::LogEntry LoggingMiddleware::createLogEntry(
     
     // Include body if configured
     if (config_.includeBody) {
-        std::string body = request.getBody();
+        std::string_view body = request.getBodyView();
         if (body.size() > config_.maxBodySize) {
-            body = body.substr(0, config_.maxBodySize) + "... (truncated)";
+            entry.requestBody = std::string(body.substr(0, config_.maxBodySize)) + "... (truncated)";
+        } else {
+            entry.requestBody = std::string(body);
         }
-        entry.requestBody = body;
     }
     
     return entry;
@@ -7,6 +7,7 @@
  */
 
 #include <cppSwitchboard/middleware/rate_limit_middleware.h>
+#include "usdt_probes.h"
 #include <nlohmann/json.hpp>
 #include <algorithm>
 #include <sstream>
@@ -355,6 +356,8 @@ RateLimitMiddleware::BucketState& RateLimitMiddleware::getBucketStateRef(const s
 }
 
 HttpResponse RateLimitMiddleware::createRateLimitResponse(const std::string& key, int retryAfter) const {
+    CPPSWITCHBOARD_PROBE2(rate_limit_reject, key.c_str(), retryAfter);
+    
     HttpResponse response;
     response.setStatus(429); // Too Many Requests
     response.setHeader("Content-Type", "application/json");
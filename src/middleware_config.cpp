@@ -7,6 +7,7 @@
  */
 
 #include <cppSwitchboard/middleware_config.h>
+#include <cppSwitchboard/middleware_config_compiler.h>
 #include <cppSwitchboard/middleware_factory.h>
 #include <cppSwitchboard/middleware.h>
 #include <cppSwitchboard/middleware_pipeline.h>
@@ -30,187 +31,6 @@
 
 namespace cppSwitchboard {
 
-// Simple YAML parser node (reuse existing implementation pattern)
-struct YamlNode {
-    std::string value;
-    std::map<std::string, YamlNode> children;
-    std::vector<YamlNode> array;
-    bool isArray = false;
-    
-    bool hasChild(const std::string& key) const {
-        return children.find(key) != children.end();
-    }
-    
-    const YamlNode& getChild(const std::string& key) const {
-        auto it = children.find(key);
-        if (it != children.end()) {
-            return it->second;
-        }
-        static YamlNode empty;
-        return empty;
-    }
-    
-    std::string getString(const std::string& defaultValue = "") const {
-        return value.empty() ? defaultValue : value;
-    }
-    
-    int getInt(int defaultValue = 0) const {
-        if (value.empty()) return defaultValue;
-        try {
-            return std::stoi(value);
-        } catch (...) {
-            return defaultValue;
-        }
-    }
-    
-    bool getBool(bool defaultValue = false) const {
-        if (value.empty()) return defaultValue;
-        std::string lower = value;
-        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-        return lower == "true" || lower == "yes" || lower == "1";
-    }
-    
-    std::vector<std::string> getStringArray() const {
-        std::vector<std::string> result;
-        for (const auto& item : array) {
-            result.push_back(item.value);
-        }
-        return result;
-    }
-};
-
-// Simple YAML parser (reuse existing pattern from config.cpp)
-class MiddlewareYamlParser {
-public:
-    static YamlNode parse(const std::string& content) {
-        YamlNode root;
-        std::istringstream stream(content);
-        std::string line;
-        std::vector<std::pair<int, std::string>> lines;
-        
-        // Read all lines with indentation level
-        while (std::getline(stream, line)) {
-            if (line.empty() || line[0] == '#') continue;
-            
-            size_t indent = 0;
-            while (indent < line.length() && (line[indent] == ' ' || line[indent] == '\t')) {
-                indent++;
-            }
-            
-            if (indent < line.length()) {
-                lines.push_back({static_cast<int>(indent), line.substr(indent)});
-            }
-        }
-        
-        parseLines(lines, 0, lines.size(), 0, root);
-        return root;
-    }
-
-    static std::string removeQuotes(const std::string& str) {
-        if (str.length() >= 2 && 
-            ((str.front() == '"' && str.back() == '"') || 
-             (str.front() == '\'' && str.back() == '\''))) {
-            return str.substr(1, str.length() - 2);
-        }
-        return str;
-    }
-
-private:
-    static void parseLines(const std::vector<std::pair<int, std::string>>& lines, 
-                          size_t start, size_t end, int baseIndent, YamlNode& node) {
-        for (size_t i = start; i < end; ++i) {
-            int indent = lines[i].first;
-            const std::string& line = lines[i].second;
-            
-            if (indent < baseIndent) break;
-            if (indent > baseIndent) continue;
-            
-            // Handle array markers
-            if (line.front() == '-' && line.length() > 1 && line[1] == ' ') {
-                node.isArray = true;
-                YamlNode arrayItem;
-                std::string itemLine = trim(line.substr(2));
-                
-                // Parse key-value in array item
-                size_t colonPos = itemLine.find(':');
-                if (colonPos != std::string::npos) {
-                    std::string key = trim(itemLine.substr(0, colonPos));
-                    std::string value = trim(itemLine.substr(colonPos + 1));
-                    arrayItem.children[key].value = removeQuotes(value);
-                }
-                
-                // Find child lines for this array item
-                size_t childStart = i + 1;
-                size_t childEnd = childStart;
-                int childIndent = indent + 2;
-                
-                while (childEnd < end && childEnd < lines.size()) {
-                    if (lines[childEnd].first < childIndent) break;
-                    if (lines[childEnd].first == indent && lines[childEnd].second.front() == '-') break;
-                    childEnd++;
-                }
-                
-                if (childStart < childEnd) {
-                    parseLines(lines, childStart, childEnd, childIndent, arrayItem);
-                    i = childEnd - 1;
-                }
-                
-                node.array.push_back(arrayItem);
-                continue;
-            }
-            
-            // Parse key-value pair
-            size_t colonPos = line.find(':');
-            if (colonPos != std::string::npos) {
-                std::string key = trim(line.substr(0, colonPos));
-                std::string value = trim(line.substr(colonPos + 1));
-                
-                YamlNode& child = node.children[key];
-                
-                if (!value.empty() && value != "[]") {
-                    // Handle array notation [item1, item2]
-                    if (value.front() == '[' && value.back() == ']') {
-                        child.isArray = true;
-                        std::string arrayContent = value.substr(1, value.length() - 2);
-                        std::istringstream arrayStream(arrayContent);
-                        std::string item;
-                        while (std::getline(arrayStream, item, ',')) {
-                            YamlNode arrayItem;
-                            arrayItem.value = removeQuotes(trim(item));
-                            child.array.push_back(arrayItem);
-                        }
-                    } else {
-                        child.value = removeQuotes(value);
-                    }
-                }
-                
-                // Find child lines
-                size_t childStart = i + 1;
-                size_t childEnd = childStart;
-                int childIndent = indent + 2;
-                
-                while (childEnd < end && 
-                       (childEnd < lines.size() && lines[childEnd].first >= childIndent)) {
-                    childEnd++;
-                }
-                
-                if (childStart < childEnd) {
-                    parseLines(lines, childStart, childEnd, childIndent, child);
-                    i = childEnd - 1;
-                }
-            }
-        }
-    }
-    
-    static std::string trim(const std::string& str) {
-        size_t start = str.find_first_not_of(" \t\r\n");
-        if (start == std::string::npos) return "";
-        size_t end = str.find_last_not_of(" \t\r\n");
-        return str.substr(start, end - start + 1);
-    }
-};
-
-// MiddlewareInstanceConfig implementation
 bool MiddlewareInstanceConfig::validate(std::string& errorMessage) const {
     if (name.empty()) {
         errorMessage = "Middleware name cannot be empty";
@@ -301,6 +121,11 @@ bool RouteMiddlewareConfig::validate(std::string& errorMessage) const {
         }
     }
     
+    if (timeout.count() < 0) {
+        errorMessage = "Route '" + pattern + "' timeout cannot be negative";
+        return false;
+    }
+    
     // Validate all middleware in this route
     for (size_t i = 0; i < middlewares.size(); ++i) {
         std::string middlewareError;
@@ -386,6 +211,44 @@ bool HotReloadConfig::validate(std::string& errorMessage) const {
     return true;
 }
 
+// BulkheadConfig implementation
+bool BulkheadConfig::validate(std::string& errorMessage) const {
+    if (name.empty()) {
+        errorMessage = "Executor name cannot be empty";
+        return false;
+    }
+    
+    if (threads < 1) {
+        errorMessage = "Executor '" + name + "' must have at least 1 thread";
+        return false;
+    }
+    
+    if (maxQueue < 0) {
+        errorMessage = "Executor '" + name + "' max_queue cannot be negative";
+        return false;
+    }
+    
+    if (overflow == BulkheadOverflow::QUEUE && queueTimeout.count() < 1) {
+        errorMessage = "Executor '" + name + "' queue_timeout_ms must be at least 1";
+        return false;
+    }
+    
+    return true;
+}
+
+bool BulkheadConfig::parseOverflow(const std::string& text, BulkheadOverflow& overflow) {
+    if (text == "reject") {
+        overflow = BulkheadOverflow::REJECT;
+    } else if (text == "queue") {
+        overflow = BulkheadOverflow::QUEUE;
+    } else if (text == "degrade") {
+        overflow = BulkheadOverflow::DEGRADE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
 // ComprehensiveMiddlewareConfig implementation
 bool ComprehensiveMiddlewareConfig::validate(std::string& errorMessage) const {
     // Validate global middleware
@@ -417,6 +280,24 @@ bool ComprehensiveMiddlewareConfig::validate(std::string& errorMessage) const {
         patterns.insert(route.pattern);
     }
     
+    // Executors must be unique and every route's executor declared
+    std::unordered_set<std::string> executorNames;
+    for (const auto& executor : executors) {
+        if (!executor.validate(errorMessage)) {
+            return false;
+        }
+        if (!executorNames.insert(executor.name).second) {
+            errorMessage = "Duplicate executor: " + executor.name;
+            return false;
+        }
+    }
+    for (const auto& route : routes) {
+        if (!route.executor.empty() && executorNames.find(route.executor) == executorNames.end()) {
+            errorMessage = "Route '" + route.pattern + "' uses undeclared executor '" + route.executor + "'";
+            return false;
+        }
+    }
+    
     return true;
 }
 
@@ -488,10 +369,51 @@ bool ComprehensiveMiddlewareConfig::hasMiddleware(const std::string& middlewareN
     return false;
 }
 
+void ComprehensiveMiddlewareConfig::merge(const ComprehensiveMiddlewareConfig& overlay) {
+    // Merge global middleware (append overlay to base)
+    for (const auto& middleware : overlay.global.middlewares) {
+        global.middlewares.push_back(middleware);
+    }
+    
+    // Merge route middleware
+    for (const auto& route : overlay.routes) {
+        // Check if route pattern already exists
+        bool found = false;
+        for (auto& existingRoute : routes) {
+            if (existingRoute.pattern == route.pattern) {
+                // Replace existing route middleware
+                existingRoute.middlewares = route.middlewares;
+                existingRoute.executor = route.executor;
+                existingRoute.timeout = route.timeout;
+                found = true;
+                break;
+            }
+        }
+        
+        if (!found) {
+            routes.push_back(route);
+        }
+    }
+    
+    // Merge executors by name
+    for (const auto& executor : overlay.executors) {
+        auto existing = std::find_if(executors.begin(), executors.end(),
+                                     [&executor](const BulkheadConfig& other) { return other.name == executor.name; });
+        if (existing != executors.end()) {
+            *existing = executor;
+        } else {
+            executors.push_back(executor);
+        }
+    }
+    
+    // Merge hot reload configuration (overlay takes precedence)
+    if (overlay.hotReload.enabled) {
+        hotReload = overlay.hotReload;
+    }
+}
+
 // MiddlewareConfigLoader implementation
 MiddlewareConfigResult MiddlewareConfigLoader::loadFromFile(const std::string& filename) {
-    std::lock_guard<std::mutex> lock(configMutex_);
-    
     std::ifstream file(filename);
     if (!file.is_open()) {
         return MiddlewareConfigResult::failure(
@@ -504,75 +426,35 @@ MiddlewareConfigResult MiddlewareConfigLoader::loadFromFile(const std::string& f
                         std::istreambuf_iterator<char>());
     file.close();
     
-    // Add file to hot reload watch list
-    if (std::find(config_.hotReload.watchedFiles.begin(), 
-                  config_.hotReload.watchedFiles.end(), 
-                  filename) == config_.hotReload.watchedFiles.end()) {
-        config_.hotReload.watchedFiles.push_back(filename);
-    }
-    
-    return loadFromString(content);
+    return loadFromContent(content, filename);
 }
 
 MiddlewareConfigResult MiddlewareConfigLoader::loadFromString(const std::string& yamlContent) {
-    std::lock_guard<std::mutex> lock(configMutex_);
+    return loadFromContent(yamlContent, "");
+}
+
+MiddlewareConfigResult MiddlewareConfigLoader::loadFromContent(const std::string& yamlContent, const std::string& sourceFile) {
+    // Structure only: schemas are checked when pipelines are built from the factory
+    MiddlewareConfigCompiler compiler;
+    compiler.setEnvironmentSubstitution(environmentSubstitution_);
     
-    try {
-        YamlNode root = MiddlewareYamlParser::parse(yamlContent);
-        
-        // Parse middleware section
-        if (!root.hasChild("middleware")) {
-            return MiddlewareConfigResult::failure(
-                MiddlewareConfigError::INVALID_YAML,
-                "YAML must contain 'middleware' section"
-            );
-        }
-        
-        const YamlNode& middlewareNode = root.getChild("middleware");
-        
-        ComprehensiveMiddlewareConfig newConfig;
-        
-        // Parse global middleware
-        if (middlewareNode.hasChild("global")) {
-            auto result = parseGlobalMiddleware(middlewareNode.getChild("global"), newConfig.global);
-            if (!result.isSuccess()) {
-                return result;
-            }
-        }
-        
-        // Parse route middleware
-        if (middlewareNode.hasChild("routes")) {
-            auto result = parseRouteMiddleware(middlewareNode.getChild("routes"), newConfig.routes);
-            if (!result.isSuccess()) {
-                return result;
-            }
-        }
-        
-        // Parse hot reload configuration
-        if (middlewareNode.hasChild("hot_reload")) {
-            auto result = parseHotReloadConfig(middlewareNode.getChild("hot_reload"), newConfig.hotReload);
-            if (!result.isSuccess()) {
-                return result;
-            }
-        }
-        
-        // Validate the complete configuration
-        auto validationResult = validateConfiguration(newConfig);
-        if (!validationResult.isSuccess()) {
-            return validationResult;
-        }
-        
-        config_ = std::move(newConfig);
-        loaded_ = true;
-        
-        return MiddlewareConfigResult::success();
-        
-    } catch (const std::exception& e) {
-        return MiddlewareConfigResult::failure(
-            MiddlewareConfigError::INVALID_YAML,
-            "YAML parsing error: " + std::string(e.what())
-        );
+    std::vector<ConfigDiagnostic> diagnostics;
+    auto compiled = compiler.compile(yamlContent, sourceFile, diagnostics);
+    if (!compiled) {
+        return MiddlewareConfigCompiler::toResult(diagnostics);
+    }
+    
+    // Validate that all middleware types are known
+    auto validationResult = validateConfiguration(*compiled);
+    if (!validationResult.isSuccess()) {
+        return validationResult;
     }
+    
+    std::lock_guard<std::mutex> lock(configMutex_);
+    config_ = *compiled;
+    loaded_ = true;
+    
+    return MiddlewareConfigResult::success();
 }
 
 MiddlewareConfigResult MiddlewareConfigLoader::mergeFromFile(const std::string& filename) {
@@ -590,7 +472,7 @@ MiddlewareConfigResult MiddlewareConfigLoader::mergeFromFile(const std::string&
         );
     }
     
-    mergeConfigurations(config_, tempLoader.getConfiguration());
+    config_.merge(tempLoader.getConfiguration());
     return MiddlewareConfigResult::success();
 }
 
@@ -652,164 +534,6 @@ MiddlewareConfigResult MiddlewareConfigLoader::validateConfiguration(const Compr
     return MiddlewareConfigResult::success();
 }
 
-// Private helper methods
-MiddlewareConfigResult MiddlewareConfigLoader::parseMiddlewareInstance(const YamlNode& yamlNode, MiddlewareInstanceConfig& config) {
-    if (!yamlNode.hasChild("name")) {
-        return MiddlewareConfigResult::failure(
-            MiddlewareConfigError::MISSING_REQUIRED_CONFIG,
-            "Middleware instance must have 'name' field"
-        );
-    }
-    
-    config.name = yamlNode.getChild("name").getString();
-    config.enabled = yamlNode.getChild("enabled").getBool(true);
-    config.priority = yamlNode.getChild("priority").getInt(0);
-    
-    // Parse middleware-specific configuration
-    if (yamlNode.hasChild("config")) {
-        const YamlNode& configNode = yamlNode.getChild("config");
-        parseConfigNode(configNode, config.config);
-    }
-    
-    return MiddlewareConfigResult::success();
-}
-
-void MiddlewareConfigLoader::parseConfigNode(const YamlNode& node, std::unordered_map<std::string, std::any>& config) {
-    for (const auto& [key, childNode] : node.children) {
-        if (childNode.isArray) {
-            std::vector<std::string> arrayValues = childNode.getStringArray();
-            config[key] = arrayValues;
-        } else if (!childNode.children.empty()) {
-            std::unordered_map<std::string, std::any> nestedConfig;
-            parseConfigNode(childNode, nestedConfig);
-            config[key] = nestedConfig;
-        } else {
-            std::string value = childNode.getString();
-            if (environmentSubstitution_) {
-                value = substituteEnvironmentVariables(value);
-            }
-            
-            // Try to infer type
-            if (value == "true" || value == "false") {
-                config[key] = (value == "true");
-            } else {
-                try {
-                    int intVal = std::stoi(value);
-                    config[key] = intVal;
-                } catch (...) {
-                    config[key] = value;
-                }
-            }
-        }
-    }
-}
-
-MiddlewareConfigResult MiddlewareConfigLoader::parseGlobalMiddleware(const YamlNode& yamlNode, GlobalMiddlewareConfig& config) {
-    if (!yamlNode.isArray) {
-        return MiddlewareConfigResult::failure(
-            MiddlewareConfigError::INVALID_YAML,
-            "Global middleware must be an array"
-        );
-    }
-    
-    for (const auto& middlewareNode : yamlNode.array) {
-        MiddlewareInstanceConfig instance;
-        auto result = parseMiddlewareInstance(middlewareNode, instance);
-        if (!result.isSuccess()) {
-            return result;
-        }
-        config.middlewares.push_back(instance);
-    }
-    
-    return MiddlewareConfigResult::success();
-}
-
-MiddlewareConfigResult MiddlewareConfigLoader::parseRouteMiddleware(const YamlNode& yamlNode, std::vector<RouteMiddlewareConfig>& routes) {
-    for (const auto& [pattern, routeNode] : yamlNode.children) {
-        RouteMiddlewareConfig route;
-        route.pattern = MiddlewareYamlParser::removeQuotes(pattern);
-        route.isRegex = route.pattern.find(".*") != std::string::npos || route.pattern.find("\\") != std::string::npos;
-        
-        if (!routeNode.isArray) {
-            return MiddlewareConfigResult::failure(
-                MiddlewareConfigError::INVALID_YAML,
-                "Route middleware for pattern '" + route.pattern + "' must be an array"
-            );
-        }
-        
-        for (const auto& middlewareNode : routeNode.array) {
-            MiddlewareInstanceConfig instance;
-            auto result = parseMiddlewareInstance(middlewareNode, instance);
-            if (!result.isSuccess()) {
-                return result;
-            }
-            route.middlewares.push_back(instance);
-        }
-        
-        routes.push_back(route);
-    }
-    
-    return MiddlewareConfigResult::success();
-}
-
-MiddlewareConfigResult MiddlewareConfigLoader::parseHotReloadConfig(const YamlNode& yamlNode, HotReloadConfig& config) {
-    config.enabled = yamlNode.getChild("enabled").getBool(false);
-    config.checkInterval = std::chrono::seconds(yamlNode.getChild("check_interval").getInt(5));
-    config.reloadOnChange = yamlNode.getChild("reload_on_change").getBool(true);
-    config.validateBeforeReload = yamlNode.getChild("validate_before_reload").getBool(true);
-    
-    if (yamlNode.hasChild("watched_files")) {
-        config.watchedFiles = yamlNode.getChild("watched_files").getStringArray();
-    }
-    
-    return MiddlewareConfigResult::success();
-}
-
-std::string MiddlewareConfigLoader::substituteEnvironmentVariables(const std::string& value) const {
-    std::string result = value;
-    std::regex envVarRegex(R"(\$\{([^}]+)\})");
-    std::smatch match;
-    
-    while (std::regex_search(result, match, envVarRegex)) {
-        std::string envVar = match[1].str();
-        const char* envValue = std::getenv(envVar.c_str());
-        std::string replacement = envValue ? envValue : "";
-        result.replace(match.position(), match.length(), replacement);
-    }
-    
-    return result;
-}
-
-void MiddlewareConfigLoader::mergeConfigurations(ComprehensiveMiddlewareConfig& base, const ComprehensiveMiddlewareConfig& overlay) {
-    // Merge global middleware (append overlay to base)
-    for (const auto& middleware : overlay.global.middlewares) {
-        base.global.middlewares.push_back(middleware);
-    }
-    
-    // Merge route middleware
-    for (const auto& route : overlay.routes) {
-        // Check if route pattern already exists
-        bool found = false;
-        for (auto& existingRoute : base.routes) {
-            if (existingRoute.pattern == route.pattern) {
-                // Replace existing route middleware
-                existingRoute.middlewares = route.middlewares;
-                found = true;
-                break;
-            }
-        }
-        
-        if (!found) {
-            base.routes.push_back(route);
-        }
-    }
-    
-    // Merge hot reload configuration (overlay takes precedence)
-    if (overlay.hotReload.enabled) {
-        base.hotReload = overlay.hotReload;
-    }
-}
-
 // MiddlewareFactory implementation moved to middleware_factory.cpp
 
 } // namespace cppSwitchboard 
\ No newline at end of file
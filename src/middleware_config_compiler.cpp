@@ -0,0 +1,673 @@
+/**
+ * @file middleware_config_compiler.cpp
+ * @brief Implementation of the middleware configuration compiler
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/middleware_config_compiler.h>
+#include <cppSwitchboard/middleware_factory.h>
+#include <cppSwitchboard/config_schema.h>
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <regex>
+#include <sstream>
+#include <unordered_set>
+
+namespace cppSwitchboard {
+
+namespace {
+    /// Replace ${VAR} with the environment; unset variables become empty
+    std::string substituteEnvironmentVariables(std::string value) {
+        size_t pos = 0;
+        while ((pos = value.find("${", pos)) != std::string::npos) {
+            size_t end = value.find('}', pos);
+            if (end == std::string::npos) {
+                break;
+            }
+            const char* envValue = std::getenv(value.substr(pos + 2, end - pos - 2).c_str());
+            std::string replacement = envValue ? envValue : "";
+            value.replace(pos, end - pos + 1, replacement);
+            pos += replacement.length();
+        }
+        return value;
+    }
+
+    bool parseInteger(const std::string& text, int& value) {
+        if (text.empty()) {
+            return false;
+        }
+        char* end = nullptr;
+        errno = 0;
+        long long parsed = std::strtoll(text.c_str(), &end, 10);
+        if (errno != 0 || *end != '\0' || parsed < INT_MIN || parsed > INT_MAX) {
+            return false;
+        }
+        value = static_cast<int>(parsed);
+        return true;
+    }
+
+    bool parseNumber(const std::string& text, double& value) {
+        if (text.empty()) {
+            return false;
+        }
+        char* end = nullptr;
+        errno = 0;
+        value = std::strtod(text.c_str(), &end);
+        return errno == 0 && *end == '\0';
+    }
+
+    bool parseBoolean(std::string text, bool& value) {
+        std::transform(text.begin(), text.end(), text.begin(), ::tolower);
+        if (text == "true" || text == "yes" || text == "on" || text == "1") {
+            value = true;
+        } else if (text == "false" || text == "no" || text == "off" || text == "0") {
+            value = false;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * One compilation: walks the document once, collecting values and
+     * diagnostics
+     */
+    class Compilation {
+    public:
+        Compilation(const std::string& source, MiddlewareFactory* factory, bool environmentSubstitution,
+                    std::vector<ConfigDiagnostic>& diagnostics)
+            : source_(source), factory_(factory), environmentSubstitution_(environmentSubstitution),
+              diagnostics_(diagnostics) {}
+
+        bool failed() const { return errors_ > 0; }
+
+        void error(MiddlewareConfigError code, const YAML::Mark& mark, const std::string& path,
+                   const std::string& message) {
+            ConfigDiagnostic diagnostic;
+            diagnostic.error = code;
+            diagnostic.source = source_;
+            if (!mark.is_null()) {
+                diagnostic.line = mark.line + 1;
+                diagnostic.column = mark.column + 1;
+            }
+            diagnostic.path = path;
+            diagnostic.message = message;
+            diagnostics_.push_back(std::move(diagnostic));
+            ++errors_;
+        }
+
+        void error(MiddlewareConfigError code, const YAML::Node& node, const std::string& path,
+                   const std::string& message) {
+            error(code, node.Mark(), path, message);
+        }
+
+        void compileDocument(const YAML::Node& root, ComprehensiveMiddlewareConfig& config) {
+            const YAML::Node middleware = root.IsMap() ? root["middleware"] : YAML::Node();
+            if (!middleware) {
+                error(MiddlewareConfigError::INVALID_YAML, root, "", "YAML must contain 'middleware' section");
+                return;
+            }
+            if (!middleware.IsMap()) {
+                error(MiddlewareConfigError::INVALID_YAML, middleware, "middleware", "expected a mapping");
+                return;
+            }
+
+            for (const auto& entry : middleware) {
+                const std::string key = entry.first.Scalar();
+                if (key == "global") {
+                    compileStack(entry.second, "middleware.global", config.global.middlewares);
+                } else if (key == "routes") {
+                    compileRoutes(entry.second, config.routes);
+                } else if (key == "executors") {
+                    compileExecutors(entry.second, config.executors);
+                } else if (key == "hot_reload") {
+                    compileHotReload(entry.second, config.hotReload);
+                } else {
+                    error(MiddlewareConfigError::INVALID_YAML, entry.first, "middleware",
+                          "unknown key '" + key + "'");
+                }
+            }
+
+            // Executors may be declared after the routes using them
+            for (const auto& reference : executorReferences_) {
+                const bool declared = std::any_of(config.executors.begin(), config.executors.end(),
+                                                  [&reference](const BulkheadConfig& executor) {
+                                                      return executor.name == reference.name;
+                                                  });
+                if (!declared) {
+                    error(MiddlewareConfigError::VALIDATION_FAILED, reference.mark, reference.path,
+                          "unknown executor '" + reference.name + "'");
+                }
+            }
+        }
+
+    private:
+        std::string scalar(const YAML::Node& node) const {
+            std::string value = node.IsNull() ? std::string() : node.Scalar();
+            return environmentSubstitution_ ? substituteEnvironmentVariables(value) : value;
+        }
+
+        bool booleanValue(const YAML::Node& node, const std::string& path, bool& value) {
+            if (!node.IsScalar() || !parseBoolean(node.Scalar(), value)) {
+                error(MiddlewareConfigError::VALIDATION_FAILED, node, path, "expected a boolean");
+                return false;
+            }
+            return true;
+        }
+
+        bool integerValue(const YAML::Node& node, const std::string& path, int& value) {
+            if (!node.IsScalar() || !parseInteger(node.Scalar(), value)) {
+                error(MiddlewareConfigError::VALIDATION_FAILED, node, path, "expected an integer");
+                return false;
+            }
+            return true;
+        }
+
+        bool stringList(const YAML::Node& node, const std::string& path, std::vector<std::string>& values) {
+            if (node.IsNull()) {
+                return true;
+            }
+            if (!node.IsSequence()) {
+                error(MiddlewareConfigError::VALIDATION_FAILED, node, path, "expected a list of strings");
+                return false;
+            }
+            for (const auto& item : node) {
+                if (!item.IsScalar()) {
+                    error(MiddlewareConfigError::VALIDATION_FAILED, item, path, "expected a string");
+                    return false;
+                }
+                values.push_back(scalar(item));
+            }
+            return true;
+        }
+
+        void compileStack(const YAML::Node& node, const std::string& path,
+                          std::vector<MiddlewareInstanceConfig>& middlewares) {
+            if (node.IsNull()) {
+                return;
+            }
+            if (!node.IsSequence()) {
+                error(MiddlewareConfigError::INVALID_YAML, node, path, "expected a list of middleware");
+                return;
+            }
+            size_t index = 0;
+            for (const auto& item : node) {
+                MiddlewareInstanceConfig instance;
+                if (compileInstance(item, path + "[" + std::to_string(index++) + "]", instance)) {
+                    middlewares.push_back(std::move(instance));
+                }
+            }
+        }
+
+        bool compileInstance(const YAML::Node& node, const std::string& path, MiddlewareInstanceConfig& instance) {
+            const size_t errorsBefore = errors_;
+            if (!node.IsMap()) {
+                error(MiddlewareConfigError::INVALID_YAML, node, path, "expected a middleware mapping");
+                return false;
+            }
+
+            YAML::Node config;
+            for (const auto& entry : node) {
+                const std::string key = entry.first.Scalar();
+                const std::string keyPath = path + "." + key;
+                if (key == "name") {
+                    if (!entry.second.IsScalar() || entry.second.Scalar().empty()) {
+                        error(MiddlewareConfigError::MISSING_REQUIRED_CONFIG, entry.second, keyPath,
+                              "expected a middleware name");
+                    } else {
+                        instance.name = entry.second.Scalar();
+                    }
+                } else if (key == "enabled") {
+                    booleanValue(entry.second, keyPath, instance.enabled);
+                } else if (key == "priority") {
+                    if (integerValue(entry.second, keyPath, instance.priority) &&
+                        (instance.priority < -1000 || instance.priority > 1000)) {
+                        error(MiddlewareConfigError::INVALID_PRIORITY, entry.second, keyPath,
+                              "priority must be between -1000 and 1000");
+                    }
+                } else if (key == "config") {
+                    config = entry.second;
+                } else {
+                    error(MiddlewareConfigError::INVALID_YAML, entry.first, path, "unknown key '" + key + "'");
+                }
+            }
+            if (instance.name.empty()) {
+                if (!node["name"]) {
+                    error(MiddlewareConfigError::MISSING_REQUIRED_CONFIG, node, path,
+                          "Middleware instance must have 'name' field");
+                }
+                return false;
+            }
+
+            std::shared_ptr<const ConfigSchema> schema;
+            if (factory_) {
+                if (!factory_->isMiddlewareRegistered(instance.name)) {
+                    error(MiddlewareConfigError::UNKNOWN_MIDDLEWARE, node["name"], path + ".name",
+                          "Unknown middleware type: " + instance.name);
+                    return false;
+                }
+                schema = factory_->getConfigSchema(instance.name);
+            }
+
+            const std::string configPath = path + ".config";
+            if (config && !config.IsNull() && !config.IsMap()) {
+                error(MiddlewareConfigError::VALIDATION_FAILED, config, configPath, "expected a mapping");
+                return false;
+            }
+            if (config && config.IsMap()) {
+                compileConfig(config, configPath, schema.get(), instance.config);
+            }
+            if (schema) {
+                const YAML::Node& anchor = config && config.IsMap() ? config : node;
+                for (const auto& field : schema->getFields()) {
+                    if (instance.config.count(field.name)) {
+                        continue;
+                    }
+                    if (field.defaultValue.has_value()) {
+                        instance.config[field.name] = field.defaultValue;
+                    } else if (field.required) {
+                        error(MiddlewareConfigError::MISSING_REQUIRED_CONFIG, anchor, configPath,
+                              instance.name + " middleware requires '" + field.name + "'");
+                    }
+                }
+            }
+            return errors_ == errorsBefore;
+        }
+
+        void compileConfig(const YAML::Node& node, const std::string& path, const ConfigSchema* schema,
+                           std::unordered_map<std::string, std::any>& values) {
+            for (const auto& entry : node) {
+                const std::string key = entry.first.Scalar();
+                const std::string keyPath = path + "." + key;
+                const ConfigField* field = schema ? schema->findField(key) : nullptr;
+                if (field) {
+                    std::any value;
+                    std::string errorMessage;
+                    if (!convert(entry.second, *field, value) ||
+                        !ConfigSchema::checkValue(*field, value, errorMessage)) {
+                        if (errorMessage.empty()) {
+                            errorMessage = std::string("expected ") +
+                                           (field->type == ConfigValueType::INTEGER ? "an " : "a ") +
+                                           ConfigSchema::typeName(field->type);
+                        }
+                        error(MiddlewareConfigError::VALIDATION_FAILED, entry.second, keyPath, errorMessage);
+                        continue;
+                    }
+                    values[key] = std::move(value);
+                } else if (schema && schema->isStrict()) {
+                    error(MiddlewareConfigError::VALIDATION_FAILED, entry.first, keyPath, "unknown key '" + key + "'");
+                } else {
+                    values[key] = infer(entry.second, keyPath);
+                }
+            }
+        }
+
+        /// Convert to a declared type
+        bool convert(const YAML::Node& node, const ConfigField& field, std::any& value) {
+            if (field.type == ConfigValueType::STRING_ARRAY) {
+                if (!node.IsSequence()) {
+                    return false;
+                }
+                std::vector<std::string> items;
+                for (const auto& item : node) {
+                    if (!item.IsScalar()) {
+                        return false;
+                    }
+                    items.push_back(scalar(item));
+                }
+                value = std::move(items);
+                return true;
+            }
+            if (!node.IsScalar()) {
+                return false;
+            }
+
+            const std::string text = scalar(node);
+            switch (field.type) {
+                case ConfigValueType::STRING:
+                    value = text;
+                    return true;
+                case ConfigValueType::INTEGER: {
+                    int number = 0;
+                    if (parseInteger(text, number)) {
+                        value = number;
+                        return true;
+                    }
+                    return false;
+                }
+                case ConfigValueType::NUMBER: {
+                    double number = 0;
+                    if (parseNumber(text, number)) {
+                        value = number;
+                        return true;
+                    }
+                    return false;
+                }
+                case ConfigValueType::BOOLEAN: {
+                    bool flag = false;
+                    if (parseBoolean(text, flag)) {
+                        value = flag;
+                        return true;
+                    }
+                    return false;
+                }
+                case ConfigValueType::STRING_ARRAY:
+                    break;
+            }
+            return false;
+        }
+
+        /// Type of keys without a schema: lists of strings, nested mappings,
+        /// booleans and integers; anything else stays a string
+        std::any infer(const YAML::Node& node, const std::string& path) {
+            if (node.IsSequence()) {
+                std::vector<std::string> items;
+                stringList(node, path, items);
+                return items;
+            }
+            if (node.IsMap()) {
+                std::unordered_map<std::string, std::any> nested;
+                for (const auto& entry : node) {
+                    nested[entry.first.Scalar()] = infer(entry.second, path + "." + entry.first.Scalar());
+                }
+                return nested;
+            }
+
+            const std::string text = scalar(node);
+            int number = 0;
+            if (text == "true" || text == "false") {
+                return text == "true";
+            }
+            if (parseInteger(text, number)) {
+                return number;
+            }
+            return text;
+        }
+
+        void compileRoutes(const YAML::Node& node, std::vector<RouteMiddlewareConfig>& routes) {
+            if (node.IsNull()) {
+                return;
+            }
+            if (!node.IsMap()) {
+                error(MiddlewareConfigError::INVALID_YAML, node, "middleware.routes",
+                      "expected a mapping of route patterns");
+                return;
+            }
+            std::unordered_set<std::string> patterns;
+            for (const auto& entry : node) {
+                RouteMiddlewareConfig route;
+                route.pattern = entry.first.Scalar();
+                route.isRegex = route.pattern.find(".*") != std::string::npos ||
+                                route.pattern.find("\\") != std::string::npos;
+                const std::string path = "middleware.routes[\"" + route.pattern + "\"]";
+
+                if (route.pattern.empty()) {
+                    error(MiddlewareConfigError::VALIDATION_FAILED, entry.first, path, "Route pattern cannot be empty");
+                    continue;
+                }
+                if (!patterns.insert(route.pattern).second) {
+                    error(MiddlewareConfigError::DUPLICATE_MIDDLEWARE, entry.first, path,
+                          "Duplicate route pattern: " + route.pattern);
+                    continue;
+                }
+                if (route.isRegex) {
+                    try {
+                        std::regex check(route.pattern);
+                    } catch (const std::regex_error& e) {
+                        error(MiddlewareConfigError::VALIDATION_FAILED, entry.first, path,
+                              "Invalid regex pattern '" + route.pattern + "': " + e.what());
+                        continue;
+                    }
+                }
+                if (entry.second.IsMap()) {
+                    // Long form: {executor: name, timeout_ms: n, middleware: [...]}
+                    for (const auto& field : entry.second) {
+                        const std::string key = field.first.Scalar();
+                        if (key == "middleware") {
+                            compileStack(field.second, path + ".middleware", route.middlewares);
+                        } else if (key == "executor" && field.second.IsScalar()) {
+                            route.executor = scalar(field.second);
+                            executorReferences_.push_back({route.executor, field.second.Mark(), path + ".executor"});
+                        } else if (key == "executor") {
+                            error(MiddlewareConfigError::VALIDATION_FAILED, field.second, path + ".executor",
+                                  "expected an executor name");
+                        } else if (key == "timeout_ms") {
+                            int number = 0;
+                            if (integerValue(field.second, path + ".timeout_ms", number)) {
+                                if (number < 0) {
+                                    error(MiddlewareConfigError::VALIDATION_FAILED, field.second, path + ".timeout_ms",
+                                          "cannot be negative");
+                                } else {
+                                    route.timeout = std::chrono::milliseconds(number);
+                                }
+                            }
+                        } else {
+                            error(MiddlewareConfigError::INVALID_YAML, field.first, path,
+                                  "unknown key '" + key + "'");
+                        }
+                    }
+                    routes.push_back(std::move(route));
+                    continue;
+                }
+                if (!entry.second.IsSequence()) {
+                    error(MiddlewareConfigError::INVALID_YAML, entry.second, path,
+                          "Route middleware for pattern '" + route.pattern + "' must be an array");
+                    continue;
+                }
+                compileStack(entry.second, path, route.middlewares);
+                routes.push_back(std::move(route));
+            }
+        }
+
+        void compileExecutors(const YAML::Node& node, std::vector<BulkheadConfig>& executors) {
+            if (node.IsNull()) {
+                return;
+            }
+            if (!node.IsMap()) {
+                error(MiddlewareConfigError::INVALID_YAML, node, "middleware.executors",
+                      "expected a mapping of executor names");
+                return;
+            }
+            for (const auto& entry : node) {
+                BulkheadConfig executor;
+                executor.name = entry.first.Scalar();
+                const std::string path = "middleware.executors." + executor.name;
+                if (!entry.second.IsMap()) {
+                    error(MiddlewareConfigError::INVALID_YAML, entry.second, path, "expected a mapping");
+                    continue;
+                }
+                const size_t errorsBefore = errors_;
+                for (const auto& field : entry.second) {
+                    const std::string key = field.first.Scalar();
+                    int number = 0;
+                    if (key == "threads") {
+                        if (integerValue(field.second, path + ".threads", number)) {
+                            executor.threads = number;
+                        }
+                    } else if (key == "max_queue") {
+                        if (integerValue(field.second, path + ".max_queue", number)) {
+                            executor.maxQueue = number;
+                        }
+                    } else if (key == "queue_timeout_ms") {
+                        if (integerValue(field.second, path + ".queue_timeout_ms", number)) {
+                            executor.queueTimeout = std::chrono::milliseconds(number);
+                        }
+                    } else if (key == "overflow") {
+                        if (!field.second.IsScalar() ||
+                            !BulkheadConfig::parseOverflow(scalar(field.second), executor.overflow)) {
+                            error(MiddlewareConfigError::VALIDATION_FAILED, field.second, path + ".overflow",
+                                  "must be one of reject, queue, degrade");
+                        }
+                    } else {
+                        error(MiddlewareConfigError::INVALID_YAML, field.first, path, "unknown key '" + key + "'");
+                    }
+                }
+                std::string errorMessage;
+                if (errors_ == errorsBefore && !executor.validate(errorMessage)) {
+                    error(MiddlewareConfigError::VALIDATION_FAILED, entry.first, path, errorMessage);
+                    continue;
+                }
+                executors.push_back(std::move(executor));
+            }
+        }
+
+        void compileHotReload(const YAML::Node& node, HotReloadConfig& hotReload) {
+            if (node.IsNull()) {
+                return;
+            }
+            if (!node.IsMap()) {
+                error(MiddlewareConfigError::INVALID_YAML, node, "middleware.hot_reload", "expected a mapping");
+                return;
+            }
+            for (const auto& entry : node) {
+                const std::string key = entry.first.Scalar();
+                const std::string path = "middleware.hot_reload." + key;
+                if (key == "enabled") {
+                    booleanValue(entry.second, path, hotReload.enabled);
+                } else if (key == "check_interval") {
+                    int seconds = 0;
+                    if (integerValue(entry.second, path, seconds)) {
+                        hotReload.checkInterval = std::chrono::seconds(seconds);
+                    }
+                } else if (key == "reload_on_change") {
+                    booleanValue(entry.second, path, hotReload.reloadOnChange);
+                } else if (key == "validate_before_reload") {
+                    booleanValue(entry.second, path, hotReload.validateBeforeReload);
+                } else if (key == "watched_files") {
+                    stringList(entry.second, path, hotReload.watchedFiles);
+                } else {
+                    error(MiddlewareConfigError::INVALID_YAML, entry.first, "middleware.hot_reload",
+                          "unknown key '" + key + "'");
+                }
+            }
+        }
+
+        const std::string& source_;
+        MiddlewareFactory* factory_;
+        bool environmentSubstitution_;
+        std::vector<ConfigDiagnostic>& diagnostics_;
+        size_t errors_ = 0;
+
+        struct ExecutorReference {
+            std::string name;
+            YAML::Mark mark;
+            std::string path;
+        };
+        std::vector<ExecutorReference> executorReferences_;  ///< Checked once every executor is known
+    };
+}
+
+std::string ConfigDiagnostic::toString() const {
+    std::ostringstream out;
+    if (!source.empty()) {
+        out << source << ":";
+    }
+    if (line > 0) {
+        out << (source.empty() ? "line " : "") << line << ":" << column << ": ";
+    } else if (!source.empty()) {
+        out << " ";
+    }
+    if (!path.empty()) {
+        out << path << ": ";
+    }
+    out << message;
+    return out.str();
+}
+
+MiddlewareConfigCompiler::MiddlewareConfigCompiler(MiddlewareFactory* factory) : factory_(factory) {}
+
+std::shared_ptr<const ComprehensiveMiddlewareConfig> MiddlewareConfigCompiler::compile(
+    const std::string& yamlContent, const std::string& sourceFile, std::vector<ConfigDiagnostic>& diagnostics) const {
+
+    Compilation compilation(sourceFile, factory_, environmentSubstitution_, diagnostics);
+    auto config = std::make_shared<ComprehensiveMiddlewareConfig>();
+
+    try {
+        YAML::Node root = YAML::Load(yamlContent);
+        compilation.compileDocument(root, *config);
+    } catch (const YAML::Exception& e) {
+        compilation.error(MiddlewareConfigError::INVALID_YAML, e.mark, "", e.msg);
+    }
+    if (compilation.failed()) {
+        return nullptr;
+    }
+
+    // The file the configuration came from is always on the watch list
+    auto& watchedFiles = config->hotReload.watchedFiles;
+    if (!sourceFile.empty() &&
+        std::find(watchedFiles.begin(), watchedFiles.end(), sourceFile) == watchedFiles.end()) {
+        watchedFiles.push_back(sourceFile);
+    }
+
+    // Rules spanning the whole configuration
+    std::string errorMessage;
+    if (!config->validate(errorMessage)) {
+        compilation.error(MiddlewareConfigError::VALIDATION_FAILED, YAML::Mark::null_mark(), "", errorMessage);
+        return nullptr;
+    }
+    return config;
+}
+
+std::shared_ptr<const ComprehensiveMiddlewareConfig> MiddlewareConfigCompiler::compileFile(
+    const std::string& filename, std::vector<ConfigDiagnostic>& diagnostics) {
+
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        ConfigDiagnostic diagnostic;
+        diagnostic.error = MiddlewareConfigError::FILE_NOT_FOUND;
+        diagnostic.message = "Failed to open middleware config file: " + filename;
+        diagnostics.push_back(std::move(diagnostic));
+        return nullptr;
+    }
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    // Reading is cheap next to parsing and validating; the hash decides
+    const size_t contentHash = std::hash<std::string>{}(content);
+    const uint64_t generation = factory_ ? factory_->getCreatorGeneration() : 0;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto it = cache_.find(filename);
+        if (it != cache_.end() && it->second.contentHash == contentHash &&
+            it->second.factoryGeneration == generation) {
+            ++cacheHits_;
+            return it->second.config;
+        }
+    }
+
+    auto config = compile(content, filename, diagnostics);
+    if (config) {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        cache_[filename] = CacheEntry{contentHash, generation, config};
+    }
+    return config;
+}
+
+void MiddlewareConfigCompiler::clearCache() {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    cache_.clear();
+}
+
+uint64_t MiddlewareConfigCompiler::getCacheHits() const {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    return cacheHits_;
+}
+
+MiddlewareConfigResult MiddlewareConfigCompiler::toResult(const std::vector<ConfigDiagnostic>& diagnostics) {
+    if (diagnostics.empty()) {
+        return MiddlewareConfigResult::success();
+    }
+    std::string message;
+    for (const auto& diagnostic : diagnostics) {
+        message += (message.empty() ? "" : "\n") + diagnostic.toString();
+    }
+    return MiddlewareConfigResult::failure(diagnostics.front().error, message, diagnostics.front().source);
+}
+
+} // namespace cppSwitchboard
@@ -9,11 +9,14 @@
 #include "cppSwitchboard/middleware_factory.h"
 #include "cppSwitchboard/middleware_config.h"
 #include "cppSwitchboard/middleware_pipeline.h"
+#include "cppSwitchboard/compiled_middleware_config.h"
+#include "cppSwitchboard/file_watcher.h"
 #include "cppSwitchboard/middleware/auth_middleware.h"
 #include "cppSwitchboard/middleware/authz_middleware.h"
 #include "cppSwitchboard/middleware/cors_middleware.h"
 #include "cppSwitchboard/middleware/logging_middleware.h"
 #include "cppSwitchboard/middleware/rate_limit_middleware.h"
+#include <algorithm>
 #include <mutex>
 #include <stdexcept>
 #include <thread>
@@ -72,6 +75,16 @@ public:
         return "auth";
     }
     
+    std::shared_ptr<const ConfigSchema> getConfigSchema() const override {
+        static const auto schema = std::make_shared<const ConfigSchema>(ConfigSchema()
+            .field("jwt_secret", ConfigValueType::STRING).required()
+            .field("issuer", ConfigValueType::STRING)
+            .field("audience", ConfigValueType::STRING)
+            .field("leeway_seconds", ConfigValueType::INTEGER).minimum(0)
+            .field("token_header", ConfigValueType::STRING));
+        return schema;
+    }
+    
     bool validateConfig(const MiddlewareInstanceConfig& config, std::string& errorMessage) const override {
         // Check for required JWT secret
         auto jwtSecretIt = config.config.find("jwt_secret");
@@ -136,6 +149,15 @@ public:
         return "authz";
     }
     
+    std::shared_ptr<const ConfigSchema> getConfigSchema() const override {
+        static const auto schema = std::make_shared<const ConfigSchema>(ConfigSchema()
+            .field("required_roles", ConfigValueType::STRING_ARRAY)
+            .field("require_all_roles", ConfigValueType::BOOLEAN)
+            .field("require_authenticated_user", ConfigValueType::BOOLEAN)
+            .field("required_permissions", ConfigValueType::STRING_ARRAY));
+        return schema;
+    }
+    
     bool validateConfig(const MiddlewareInstanceConfig& config, std::string& errorMessage) const override {
         // Authorization middleware doesn't have strict required fields
         // Validate that roles and permissions are string arrays if present
@@ -202,6 +224,18 @@ public:
         return "cors";
     }
     
+    std::shared_ptr<const ConfigSchema> getConfigSchema() const override {
+        static const auto schema = std::make_shared<const ConfigSchema>(ConfigSchema()
+            .field("allowed_origins", ConfigValueType::STRING_ARRAY)
+            .field("allowed_methods", ConfigValueType::STRING_ARRAY)
+            .field("allowed_headers", ConfigValueType::STRING_ARRAY)
+            .field("expose_headers", ConfigValueType::STRING_ARRAY)
+            .field("allow_credentials", ConfigValueType::BOOLEAN)
+            .field("max_age", ConfigValueType::INTEGER).minimum(0)
+            .field("handle_preflight", ConfigValueType::BOOLEAN));
+        return schema;
+    }
+    
     bool validateConfig(const MiddlewareInstanceConfig& config, std::string& errorMessage) const override {
         // Validate string arrays if present
         auto originsIt = config.config.find("allowed_origins");
@@ -270,6 +304,16 @@ public:
         return "logging";
     }
     
+    std::shared_ptr<const ConfigSchema> getConfigSchema() const override {
+        static const auto schema = std::make_shared<const ConfigSchema>(ConfigSchema()
+            .field("format", ConfigValueType::STRING)
+                .oneOf({"json", "common", "apache_common", "combined", "apache_combined", "custom"})
+            .field("include_headers", ConfigValueType::BOOLEAN)
+            .field("include_body", ConfigValueType::BOOLEAN)
+            .field("custom_format", ConfigValueType::STRING));
+        return schema;
+    }
+    
     bool validateConfig(const MiddlewareInstanceConfig& config, std::string& errorMessage) const override {
         // Validate format if specified
         auto formatIt = config.config.find("format");
@@ -339,6 +383,16 @@ public:
         return "rate_limit";
     }
     
+    std::shared_ptr<const ConfigSchema> getConfigSchema() const override {
+        static const auto schema = std::make_shared<const ConfigSchema>(ConfigSchema()
+            .field("requests_per_second", ConfigValueType::INTEGER).minimum(1)
+            .field("requests_per_minute", ConfigValueType::INTEGER).minimum(1)
+            .field("requests_per_hour", ConfigValueType::INTEGER).minimum(1)
+            .field("requests_per_day", ConfigValueType::INTEGER).minimum(1)
+            .field("burst_capacity", ConfigValueType::INTEGER).minimum(1));
+        return schema;
+    }
+    
     bool validateConfig(const MiddlewareInstanceConfig& config, std::string& errorMessage) const override {
         // Check that at least one rate limit is specified
         bool hasRateLimit = config.config.find("requests_per_second") != config.config.end() ||
@@ -385,11 +439,7 @@ MiddlewareFactory& MiddlewareFactory::getInstance() {
 }
 
 MiddlewareFactory::~MiddlewareFactory() {
-    // Shutdown hot-reload thread
-    shutdownRequested_ = true;
-    if (hotReloadThread_ && hotReloadThread_->joinable()) {
-        hotReloadThread_->join();
-    }
+    stopPluginWatcher();
 }
 
 bool MiddlewareFactory::registerCreator(std::unique_ptr<MiddlewareCreator> creator) {
@@ -406,6 +456,7 @@ bool MiddlewareFactory::registerCreator(std::unique_ptr<MiddlewareCreator> creat
     }
     
     creators_[middlewareName] = std::move(creator);
+    creatorGeneration_.fetch_add(1, std::memory_order_release);
     return true;
 }
 
@@ -418,6 +469,7 @@ bool MiddlewareFactory::unregisterCreator(const std::string& middlewareName) {
     }
     
     creators_.erase(it);
+    creatorGeneration_.fetch_add(1, std::memory_order_release);
     return true;
 }
 
@@ -463,6 +515,11 @@ std::shared_ptr<MiddlewarePipeline> MiddlewareFactory::createPipeline(const std:
     return pipeline;
 }
 
+std::shared_ptr<const CompiledMiddlewareConfig> MiddlewareFactory::createPipelines(
+    const ComprehensiveMiddlewareConfig& config, std::string& errorMessage) {
+    return CompiledMiddlewareConfig::compile(config, *this, errorMessage);
+}
+
 std::vector<std::string> MiddlewareFactory::getRegisteredMiddleware() const {
     std::lock_guard<std::mutex> lock(creatorsMutex_);
     
@@ -493,6 +550,13 @@ bool MiddlewareFactory::validateMiddlewareConfig(const MiddlewareInstanceConfig&
     return it->second->validateConfig(config, errorMessage);
 }
 
+std::shared_ptr<const ConfigSchema> MiddlewareFactory::getConfigSchema(const std::string& middlewareName) const {
+    std::lock_guard<std::mutex> lock(creatorsMutex_);
+    
+    auto it = creators_.find(middlewareName);
+    return it != creators_.end() ? it->second->getConfigSchema() : nullptr;
+}
+
 void MiddlewareFactory::initializeBuiltinCreators() {
     if (builtinInitialized_) {
         return;
@@ -511,25 +575,35 @@ void MiddlewareFactory::initializeBuiltinCreators() {
 // Plugin integration implementation
 
 MiddlewareFactory::PluginMiddlewareCreator::PluginMiddlewareCreator(
-    std::shared_ptr<MiddlewarePlugin> plugin, const std::string& middlewareType)
-    : plugin_(std::move(plugin)), middlewareType_(middlewareType) {}
+    std::shared_ptr<MiddlewarePlugin> plugin, const std::string& middlewareType,
+    std::shared_ptr<PluginAccount> account)
+    : plugin_(std::move(plugin)), middlewareType_(middlewareType), account_(std::move(account)) {
+    // "{}" or a schema we cannot use means the plugin accepts any keys
+    std::string errorMessage;
+    std::string jsonSchema = plugin_ ? plugin_->getConfigSchema() : "{}";
+    if (jsonSchema != "{}") {
+        schema_ = ConfigSchema::fromJsonSchema(jsonSchema, errorMessage);
+    }
+}
 
 std::shared_ptr<Middleware> MiddlewareFactory::PluginMiddlewareCreator::create(const MiddlewareInstanceConfig& config) {
     if (!plugin_) {
         return nullptr;
     }
     
-    // Increment plugin reference count for safe usage
-    PluginManager::getInstance().incrementPluginRefCount(plugin_->getInfo().name);
-    
     auto middleware = plugin_->createMiddleware(config);
-    
-    // If creation failed, decrement reference count
     if (!middleware) {
-        PluginManager::getInstance().decrementPluginRefCount(plugin_->getInfo().name);
+        return nullptr;
     }
     
-    return middleware;
+    // The middleware's code lives in the plugin library: hand out a pointer
+    // that also owns this plugin generation, so a reload or unload cannot
+    // close the library under a pipeline still using the middleware
+    auto holder = std::make_shared<PluginMiddlewareHolder>();
+    holder->plugin = plugin_;
+    holder->middleware = std::move(middleware);
+    return std::make_shared<AccountedMiddleware>(
+        std::shared_ptr<Middleware>(holder, holder->middleware.get()), account_);
 }
 
 std::string MiddlewareFactory::PluginMiddlewareCreator::getMiddlewareName() const {
@@ -556,7 +630,7 @@ size_t MiddlewareFactory::loadPluginsFromDirectory(const std::string& pluginDire
     }
     
     // Discover and load plugins
-    auto results = pluginManager.discoverAndLoadPlugins();
+    auto results = pluginManager.discoverAndLoadPlugins(hotReloadEnabled_);
     
     size_t successCount = 0;
     for (const auto& [pluginPath, result] : results) {
@@ -570,13 +644,16 @@ size_t MiddlewareFactory::loadPluginsFromDirectory(const std::string& pluginDire
         }
     }
     
+    if (hotReloadEnabled_) {
+        startPluginWatcher(); // Picks up the new directory
+    }
     return successCount;
 }
 
 bool MiddlewareFactory::loadPlugin(const std::string& pluginPath) {
     PluginManager& pluginManager = PluginManager::getInstance();
     
-    auto result = pluginManager.loadPlugin(pluginPath);
+    auto result = pluginManager.loadPlugin(pluginPath, hotReloadEnabled_);
     if (result.first != PluginLoadResult::SUCCESS) {
         return false;
     }
@@ -585,6 +662,9 @@ bool MiddlewareFactory::loadPlugin(const std::string& pluginPath) {
     auto plugin = pluginManager.getPlugin(result.second);
     if (plugin) {
         registerPluginCreators(plugin, result.second);
+        if (hotReloadEnabled_) {
+            startPluginWatcher();
+        }
         return true;
     }
     
@@ -596,11 +676,54 @@ void MiddlewareFactory::registerPluginCreators(std::shared_ptr<MiddlewarePlugin>
     
     std::lock_guard<std::mutex> lock(creatorsMutex_);
     
+    // Drop creators of an earlier load of this plugin
+    for (auto it = pluginCreators_.begin(); it != pluginCreators_.end();) {
+        if (it->second == pluginName) {
+            creators_.erase(it->first);
+            it = pluginCreators_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    
+    // A new generation starts with a closed circuit; usage carries over
+    auto account = pluginAccount(pluginName);
+    account->reset();
+    
     for (const auto& middlewareType : supportedTypes) {
-        auto creator = std::make_unique<PluginMiddlewareCreator>(plugin, middlewareType);
+        auto creator = std::make_unique<PluginMiddlewareCreator>(plugin, middlewareType, account);
         creators_[middlewareType] = std::move(creator);
         pluginCreators_[middlewareType] = pluginName;
     }
+    creatorGeneration_.fetch_add(1, std::memory_order_release);
+}
+
+std::shared_ptr<PluginAccount> MiddlewareFactory::pluginAccount(const std::string& pluginName) {
+    auto& account = pluginAccounts_[pluginName];
+    if (!account) {
+        account = std::make_shared<PluginAccount>(pluginName);
+    }
+    return account;
+}
+
+void MiddlewareFactory::setPluginBudget(const std::string& pluginName, const PluginBudget& budget) {
+    std::lock_guard<std::mutex> lock(creatorsMutex_);
+    pluginAccount(pluginName)->setBudget(budget);
+}
+
+PluginUsage MiddlewareFactory::getPluginUsage(const std::string& pluginName) const {
+    std::lock_guard<std::mutex> lock(creatorsMutex_);
+    auto it = pluginAccounts_.find(pluginName);
+    return it != pluginAccounts_.end() ? it->second->getUsage() : PluginUsage{};
+}
+
+std::map<std::string, PluginUsage> MiddlewareFactory::getPluginUsage() const {
+    std::lock_guard<std::mutex> lock(creatorsMutex_);
+    std::map<std::string, PluginUsage> usage;
+    for (const auto& [pluginName, account] : pluginAccounts_) {
+        usage[pluginName] = account->getUsage();
+    }
+    return usage;
 }
 
 void MiddlewareFactory::setPluginHotReloadEnabled(bool enabled, int intervalSeconds) {
@@ -608,16 +731,9 @@ void MiddlewareFactory::setPluginHotReloadEnabled(bool enabled, int intervalSeco
     hotReloadInterval_ = intervalSeconds;
     
     if (enabled) {
-        if (!hotReloadThread_ || !hotReloadThread_->joinable()) {
-            shutdownRequested_ = false;
-            hotReloadThread_ = std::make_unique<std::thread>(&MiddlewareFactory::hotReloadLoop, this);
-        }
+        startPluginWatcher();
     } else {
-        if (hotReloadThread_ && hotReloadThread_->joinable()) {
-            shutdownRequested_ = true;
-            hotReloadThread_->join();
-            hotReloadThread_.reset();
-        }
+        stopPluginWatcher();
     }
     
     // Enable hot-reload in plugin manager as well
@@ -628,45 +744,66 @@ std::vector<std::string> MiddlewareFactory::getLoadedPlugins() const {
     return PluginManager::getInstance().getLoadedPlugins();
 }
 
-void MiddlewareFactory::hotReloadLoop() {
-    while (!shutdownRequested_) {
-        // Wait for the specified interval
-        auto waitTime = std::chrono::seconds(hotReloadInterval_.load());
-        auto startTime = std::chrono::steady_clock::now();
-        
-        while (!shutdownRequested_ && 
-               (std::chrono::steady_clock::now() - startTime) < waitTime) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
-        
-        if (shutdownRequested_) {
-            break;
+void MiddlewareFactory::startPluginWatcher() {
+    auto directories = PluginManager::getInstance().getWatchDirectories();
+    auto extensions = PluginManager::getInstance().getDiscoveryConfig().fileExtensions;
+    
+    std::lock_guard<std::mutex> lock(pluginWatcherMutex_);
+    if (pluginWatcher_) {
+        pluginWatcher_->stop();
+        pluginWatcher_.reset();
+    }
+    if (directories.empty()) {
+        return; // Restarted once a plugin directory is added
+    }
+    
+    pluginWatcher_ = std::make_unique<FileWatcher>(
+        std::move(directories), std::move(extensions),
+        [this](const std::vector<std::string>& changedPaths) { onPluginFilesChanged(changedPaths); });
+    pluginWatcher_->start(std::chrono::seconds(std::max(1, hotReloadInterval_.load())));
+}
+
+void MiddlewareFactory::stopPluginWatcher() {
+    std::unique_ptr<FileWatcher> watcher;
+    {
+        std::lock_guard<std::mutex> lock(pluginWatcherMutex_);
+        watcher = std::move(pluginWatcher_);
+    }
+    if (watcher) {
+        watcher->stop();
+    }
+}
+
+void MiddlewareFactory::onPluginFilesChanged(const std::vector<std::string>& changedPaths) {
+    PluginManager& pluginManager = PluginManager::getInstance();
+    
+    auto reloadedPlugins = pluginManager.reloadChangedPlugins(changedPaths);
+    for (const auto& pluginName : reloadedPlugins) {
+        auto plugin = pluginManager.getPlugin(pluginName);
+        if (plugin) {
+            registerPluginCreators(plugin, pluginName);
         }
-        
-        // Check for plugin reloads
-        auto reloadedPlugins = PluginManager::getInstance().checkAndReloadPlugins();
-        
-        // Re-register creators for reloaded plugins
-        for (const auto& pluginName : reloadedPlugins) {
-            auto plugin = PluginManager::getInstance().getPlugin(pluginName);
-            if (plugin) {
-                // Remove old creators for this plugin
-                std::lock_guard<std::mutex> lock(creatorsMutex_);
-                for (auto it = pluginCreators_.begin(); it != pluginCreators_.end();) {
-                    if (it->second == pluginName) {
-                        creators_.erase(it->first);
-                        it = pluginCreators_.erase(it);
-                    } else {
-                        ++it;
-                    }
-                }
-                
-                // Register new creators
-                registerPluginCreators(plugin, pluginName);
-            }
+    }
+    
+    if (!reloadedPlugins.empty()) {
+        std::lock_guard<std::mutex> lock(pluginReloadListenersMutex_);
+        for (const auto& [id, listener] : pluginReloadListeners_) {
+            listener(reloadedPlugins);
         }
     }
 }
 
+size_t MiddlewareFactory::addPluginReloadListener(PluginReloadListener listener) {
+    std::lock_guard<std::mutex> lock(pluginReloadListenersMutex_);
+    size_t id = nextPluginReloadListenerId_++;
+    pluginReloadListeners_.emplace(id, std::move(listener));
+    return id;
+}
+
+void MiddlewareFactory::removePluginReloadListener(size_t listenerId) {
+    std::lock_guard<std::mutex> lock(pluginReloadListenersMutex_);
+    pluginReloadListeners_.erase(listenerId);
+}
+
 } // namespace cppSwitchboard
  
\ No newline at end of file
@@ -7,7 +7,11 @@
  */
 
 #include <cppSwitchboard/middleware_pipeline.h>
+#include <cppSwitchboard/cancellation.h>
+#include <cppSwitchboard/c_abi_middleware.h>
+#include <cppSwitchboard/plugin_accounting.h>
 #include <cppSwitchboard/debug_logger.h>
+#include "usdt_probes.h"
 #include <algorithm>
 #include <sstream>
 
@@ -34,6 +38,7 @@ bool MiddlewarePipeline::removeMiddleware(const std::string& middlewareName) {
     if (it != middlewares_.end()) {
         // Debug logging removed for compilation
         middlewares_.erase(it);
+        middlewareSorted_ = false;  // C ABI lookup table is rebuilt with the sort
         return true;
     }
     
@@ -43,6 +48,7 @@ bool MiddlewarePipeline::removeMiddleware(const std::string& middlewareName) {
 void MiddlewarePipeline::clearMiddleware() {
     // Debug logging removed for compilation
     middlewares_.clear();
+    nativeMiddlewares_.clear();
     middlewareSorted_ = true;  // Empty list is technically sorted
 }
 
@@ -89,10 +95,10 @@ HttpResponse MiddlewarePipeline::execute(const HttpRequest& request, Context& co
         // Start pipeline execution
         if (middlewares_.empty()) {
             // No middleware, execute final handler directly
-            return executeFinalHandler(request, context);
+            return executeFinalHandler(request, context, nullptr);
         } else {
             // Execute middleware chain starting from index 0
-            return executeMiddlewareChain(request, context, 0);
+            return executeMiddlewareChain(request, context, 0, nullptr);
         }
     } catch (const PipelineException&) {
         // Re-throw pipeline exceptions as-is
@@ -103,15 +109,40 @@ HttpResponse MiddlewarePipeline::execute(const HttpRequest& request, Context& co
     }
 }
 
-HttpResponse MiddlewarePipeline::executeMiddlewareChain(const HttpRequest& request, Context& context, size_t index) {
+HttpResponse MiddlewarePipeline::execute(const HttpRequest& request, Context& context, HttpHandler& finalHandler) {
+    if (!middlewareSorted_) {
+        sortMiddleware();
+    }
+    
+    try {
+        return executeMiddlewareChain(request, context, 0, &finalHandler);
+    } catch (const PipelineException&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw PipelineException(std::string("Unexpected error during pipeline execution: ") + e.what());
+    }
+}
+
+HttpResponse MiddlewarePipeline::executeMiddlewareChain(const HttpRequest& request, Context& context, size_t index,
+                                                        HttpHandler* handler) {
+    // Stop between hops once the client is gone or the deadline passed
+    if (request.isCancelled()) {
+        return request.getCancellation()->response();
+    }
+    
     if (index >= middlewares_.size()) {
         // No more middleware, execute final handler
-        return executeFinalHandler(request, context);
+        return executeFinalHandler(request, context, handler);
+    }
+    
+    const NativeMiddleware& native = nativeMiddlewares_[index];
+    if (native.middleware) {
+        return executeNativeMiddleware(*native.middleware, native.account, request, context, index, handler);
     }
     
     // Create next handler that continues the chain
-    NextHandler next = [this, index](const HttpRequest& req, Context& ctx) -> HttpResponse {
-        return executeMiddlewareChain(req, ctx, index + 1);
+    NextHandler next = [this, index, handler](const HttpRequest& req, Context& ctx) -> HttpResponse {
+        return executeMiddlewareChain(req, ctx, index + 1, handler);
     };
     
     // Execute current middleware
@@ -144,6 +175,20 @@ void MiddlewarePipeline::sortMiddleware() {
             return a->getPriority() > b->getPriority();
         });
     
+    // Found once here so execution does not cast per request
+    nativeMiddlewares_.clear();
+    nativeMiddlewares_.reserve(middlewares_.size());
+    for (const auto& middleware : middlewares_) {
+        NativeMiddleware native;
+        if (const auto* accounted = dynamic_cast<const AccountedMiddleware*>(middleware.get())) {
+            native.middleware = dynamic_cast<const CAbiMiddleware*>(accounted->getMiddleware().get());
+            native.account = &accounted->getAccount();
+        } else {
+            native.middleware = dynamic_cast<const CAbiMiddleware*>(middleware.get());
+        }
+        nativeMiddlewares_.push_back(native);
+    }
+    
     middlewareSorted_ = true;
     
     // Debug logging removed for compilation
@@ -164,7 +209,9 @@ HttpResponse MiddlewarePipeline::executeMiddleware(std::shared_ptr<Middleware> m
     try {
         // Debug logging removed for compilation
         
+        CPPSWITCHBOARD_PROBE2(middleware_enter, middleware->getName().c_str(), request.getPath().c_str());
         HttpResponse response = middleware->handle(request, context, next);
+        CPPSWITCHBOARD_PROBE2(middleware_exit, middleware->getName().c_str(), response.getStatus());
         
         // Log performance if enabled
         if (performanceMonitoring_) {
@@ -186,9 +233,60 @@ HttpResponse MiddlewarePipeline::executeMiddleware(std::shared_ptr<Middleware> m
     }
 }
 
-HttpResponse MiddlewarePipeline::executeFinalHandler(const HttpRequest& request, Context& context) {
+HttpResponse MiddlewarePipeline::executeNativeMiddleware(const CAbiMiddleware& middleware, PluginAccount* account,
+                                                         const HttpRequest& request, Context& context, size_t index,
+                                                         HttpHandler* handler) {
+    if (!middleware.isEnabled()) {
+        return executeMiddlewareChain(request, context, index + 1, handler);
+    }
+    if (account) {
+        switch (account->admit()) {
+            case PluginAccount::Admission::BYPASS:
+                return executeMiddlewareChain(request, context, index + 1, handler);
+            case PluginAccount::Admission::REJECT:
+                return account->rejection();
+            case PluginAccount::Admission::RUN:
+                break;
+        }
+    }
+    
+    auto startTime = std::chrono::steady_clock::now();
+    PluginCostMeter meter;
+    if (account) {
+        meter.start();
+    }
+    
+    // The hooks run inline around the rest of the chain; no NextHandler is built.
+    // C hooks do not throw, so only the hooks' own time is charged.
+    CPPSWITCHBOARD_PROBE2(middleware_enter, middleware.getName().c_str(), request.getPath().c_str());
+    HttpResponse response;
+    if (middleware.before(request, context, response)) {
+        if (account) {
+            meter.pause();
+        }
+        response = executeMiddlewareChain(request, context, index + 1, handler);
+        if (account) {
+            meter.resume();
+        }
+        middleware.after(request, context, response);
+    }
+    CPPSWITCHBOARD_PROBE2(middleware_exit, middleware.getName().c_str(), response.getStatus());
+    
+    if (account) {
+        account->record(meter.stop(), false);
+    }
+    if (performanceMonitoring_) {
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime);
+        logPerformance(middleware.getName(), duration);
+    }
+    
+    return response;
+}
+
+HttpResponse MiddlewarePipeline::executeFinalHandler(const HttpRequest& request, Context& context, HttpHandler* handler) {
     (void)context; // Context not used in current implementation but part of interface
-    if (!hasFinalHandler()) {
+    if (!handler && !hasFinalHandler()) {
         throw std::runtime_error("No final handler available for execution");
     }
     
@@ -197,7 +295,10 @@ HttpResponse MiddlewarePipeline::executeFinalHandler(const HttpRequest& request,
     try {
         HttpResponse response;
         
-        if (finalHandler_) {
+        if (handler) {
+            // Handler supplied by the caller of execute()
+            response = handler->handle(request);
+        } else if (finalHandler_) {
             // Execute synchronous final handler
             // Debug logging removed for compilation
             
@@ -0,0 +1,537 @@
+/**
+ * @file multipart_parser.cpp
+ * @brief Implementation of the streaming multipart/form-data parser
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-23
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/multipart_parser.h>
+#include <cppSwitchboard/http_request.h>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace cppSwitchboard {
+
+namespace {
+    bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (std::tolower(static_cast<unsigned char>(a[i])) !=
+                std::tolower(static_cast<unsigned char>(b[i]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::string_view trim(std::string_view s) {
+        while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+        while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) s.remove_suffix(1);
+        return s;
+    }
+
+    /**
+     * @brief Split "value; key=val; key2=\"quoted\"" into its parameters
+     *
+     * Calls @p visit(key, value) for each parameter after the first
+     * segment; quoted values are unescaped.
+     */
+    template <typename Visitor>
+    void forEachParameter(std::string_view header, Visitor&& visit) {
+        size_t pos = header.find(';');
+        while (pos != std::string_view::npos && pos < header.size()) {
+            ++pos;
+            size_t equals = header.find('=', pos);
+            if (equals == std::string_view::npos) {
+                return;
+            }
+            std::string_view key = trim(header.substr(pos, equals - pos));
+            pos = equals + 1;
+            while (pos < header.size() && (header[pos] == ' ' || header[pos] == '\t')) {
+                ++pos;
+            }
+
+            std::string value;
+            if (pos < header.size() && header[pos] == '"') {
+                ++pos;
+                while (pos < header.size() && header[pos] != '"') {
+                    if (header[pos] == '\\' && pos + 1 < header.size()) {
+                        ++pos;
+                    }
+                    value.push_back(header[pos++]);
+                }
+                pos = header.find(';', pos);
+            } else {
+                size_t next = header.find(';', pos);
+                value = std::string(trim(header.substr(pos, next == std::string_view::npos ? next : next - pos)));
+                pos = next;
+            }
+            visit(key, std::move(value));
+        }
+    }
+
+    bool writeAll(int fd, const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t written = ::write(fd, data, size);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Create an unnamed temporary file in @p directory
+     * @param anonymous Set when the file was created with O_TMPFILE
+     * @return Descriptor, or -1 on failure
+     */
+    int createSpillFile(const std::string& directory, bool& anonymous) {
+#ifdef O_TMPFILE
+        int fd = ::open(directory.c_str(), O_TMPFILE | O_RDWR | O_CLOEXEC, 0600);
+        if (fd >= 0) {
+            anonymous = true;
+            return fd;
+        }
+#endif
+        // File systems without O_TMPFILE: create and unlink right away
+        std::string path = directory + "/cppswitchboard-part-XXXXXX";
+        int fallback = ::mkostemp(path.data(), O_CLOEXEC);
+        if (fallback >= 0) {
+            ::unlink(path.c_str());
+        }
+        anonymous = false;
+        return fallback;
+    }
+}
+
+MultipartPart::SpillFile::~SpillFile() {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+std::string MultipartPart::getHeader(const std::string& name) const {
+    for (const auto& header : headers_) {
+        if (equalsIgnoreCase(header.first, name)) {
+            return header.second;
+        }
+    }
+    return "";
+}
+
+int MultipartPart::getFileDescriptor() const noexcept {
+    return file_ ? file_->fd : -1;
+}
+
+std::string MultipartPart::readAll() const {
+    if (!file_) {
+        return data_.str();
+    }
+
+    std::string content(size_, '\0');
+    size_t offset = 0;
+    while (offset < size_) {
+        ssize_t n = ::pread(file_->fd, content.data() + offset, size_ - offset, static_cast<off_t>(offset));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            content.resize(offset);
+            break;
+        }
+        offset += static_cast<size_t>(n);
+    }
+    return content;
+}
+
+bool MultipartPart::saveAs(const std::string& path) const {
+    if (file_ && file_->anonymous) {
+        std::string procPath = "/proc/self/fd/" + std::to_string(file_->fd);
+        if (::linkat(AT_FDCWD, procPath.c_str(), AT_FDCWD, path.c_str(), AT_SYMLINK_FOLLOW) == 0) {
+            return true;
+        }
+    }
+
+    int out = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (out < 0) {
+        return false;
+    }
+
+    bool ok = true;
+    if (!file_) {
+        ok = writeAll(out, data_.data(), data_.size());
+    } else {
+        char buffer[65536];
+        size_t offset = 0;
+        while (ok && offset < size_) {
+            ssize_t n = ::pread(file_->fd, buffer, std::min(sizeof(buffer), size_ - offset),
+                                static_cast<off_t>(offset));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                ok = false;
+                break;
+            }
+            ok = writeAll(out, buffer, static_cast<size_t>(n));
+            offset += static_cast<size_t>(n);
+        }
+    }
+    return ::close(out) == 0 && ok;
+}
+
+MultipartParser::DelimiterSearch::DelimiterSearch(std::string delimiter)
+    : delimiter_(std::move(delimiter)) {
+    const size_t n = delimiter_.size();
+    shift_.fill(n);
+    for (size_t i = 0; i + 1 < n; ++i) {
+        shift_[static_cast<unsigned char>(delimiter_[i])] = n - 1 - i;
+    }
+}
+
+std::size_t MultipartParser::DelimiterSearch::find(const char* data, std::size_t size,
+                                                   std::size_t from) const noexcept {
+    const size_t n = delimiter_.size();
+    const char last = delimiter_[n - 1];
+    size_t pos = from;
+    while (pos + n <= size) {
+        char c = data[pos + n - 1];
+        if (c == last && std::memcmp(data + pos, delimiter_.data(), n - 1) == 0) {
+            return pos;
+        }
+        pos += shift_[static_cast<unsigned char>(c)];
+    }
+    return std::string::npos;
+}
+
+MultipartParser::MultipartParser(std::string boundary)
+    : MultipartParser(std::move(boundary), Options()) {}
+
+MultipartParser::MultipartParser(std::string boundary, Options options)
+    : search_("\r\n--" + boundary), options_(std::move(options)) {
+    // The first boundary is not preceded by a line break; pretend one was
+    // seen so that the same delimiter search finds it
+    tail_ = "\r\n";
+    if (boundary.empty() || boundary.size() > MAX_BOUNDARY_LENGTH) {
+        fail("Invalid multipart boundary");
+    }
+}
+
+std::optional<std::string> MultipartParser::boundaryFromContentType(std::string_view contentType) {
+    std::string_view type = trim(contentType.substr(0, contentType.find(';')));
+    if (type.size() < 10 || !equalsIgnoreCase(type.substr(0, 10), "multipart/")) {
+        return std::nullopt;
+    }
+
+    std::optional<std::string> boundary;
+    forEachParameter(contentType, [&](std::string_view key, std::string value) {
+        if (equalsIgnoreCase(key, "boundary")) {
+            boundary = std::move(value);
+        }
+    });
+    if (!boundary || boundary->empty() || boundary->size() > MAX_BOUNDARY_LENGTH) {
+        return std::nullopt;
+    }
+    return boundary;
+}
+
+std::optional<std::vector<MultipartPart>> MultipartParser::parse(const HttpRequest& request) {
+    return parse(request, Options());
+}
+
+std::optional<std::vector<MultipartPart>> MultipartParser::parse(const HttpRequest& request, Options options) {
+    auto boundary = boundaryFromContentType(request.getContentType());
+    if (!boundary) {
+        return std::nullopt;
+    }
+    MultipartParser parser(std::move(*boundary), std::move(options));
+    if (!parser.feed(request.getBodyBuffer()) || !parser.finish()) {
+        return std::nullopt;
+    }
+    return parser.takeParts();
+}
+
+bool MultipartParser::feed(const BodyBuffer& chunk) {
+    return consume(chunk.data(), chunk.size(), &chunk);
+}
+
+bool MultipartParser::feed(const char* data, std::size_t size) {
+    return consume(data, size, nullptr);
+}
+
+bool MultipartParser::finish() {
+    if (state_ == State::EPILOGUE) {
+        return true;
+    }
+    if (state_ == State::FAILED) {
+        return false;
+    }
+    return fail("Multipart body ended before the closing boundary");
+}
+
+bool MultipartParser::consume(const char* data, std::size_t size, const BodyBuffer* owner) {
+    const char* p = data;
+    const char* end = data + size;
+
+    while (p < end) {
+        switch (state_) {
+            case State::PREAMBLE:
+            case State::BODY:
+                if (scanForDelimiter(p, end, owner)) {
+                    if (state_ == State::BODY && !finishPart()) {
+                        return false;
+                    }
+                    if (state_ != State::FAILED) {
+                        state_ = State::AFTER_DELIMITER;
+                        lineBuffer_.clear();
+                    }
+                }
+                break;
+
+            case State::AFTER_DELIMITER:
+                // Either "--" (close delimiter) or optional padding and CRLF
+                lineBuffer_.push_back(*p++);
+                if (lineBuffer_.size() == 2 && lineBuffer_ == "--") {
+                    state_ = State::EPILOGUE;
+                } else if (lineBuffer_.size() >= 2 && lineBuffer_.compare(lineBuffer_.size() - 2, 2, "\r\n") == 0) {
+                    if (trim(std::string_view(lineBuffer_).substr(0, lineBuffer_.size() - 2)).size() != 0) {
+                        return fail("Unexpected data after multipart boundary");
+                    }
+                    state_ = State::HEADERS;
+                    lineBuffer_.clear();
+                } else if (lineBuffer_.size() > 256) {
+                    return fail("Unexpected data after multipart boundary");
+                }
+                break;
+
+            case State::HEADERS: {
+                const size_t before = lineBuffer_.size();
+                const size_t room = options_.maxHeaderSize + 4 - std::min(before, options_.maxHeaderSize + 4);
+                const size_t take = std::min(room, static_cast<size_t>(end - p));
+                lineBuffer_.append(p, take);
+
+                size_t headerEnd = std::string::npos;
+                if (lineBuffer_.size() >= 2 && lineBuffer_.compare(0, 2, "\r\n") == 0) {
+                    headerEnd = 2;
+                } else {
+                    size_t found = lineBuffer_.find("\r\n\r\n", before >= 3 ? before - 3 : 0);
+                    if (found != std::string::npos) {
+                        headerEnd = found + 4;
+                    }
+                }
+
+                if (headerEnd == std::string::npos) {
+                    if (lineBuffer_.size() >= options_.maxHeaderSize + 4) {
+                        return fail("Multipart part headers exceed limit");
+                    }
+                    p += take;
+                    break;
+                }
+
+                p += headerEnd - before;
+                lineBuffer_.resize(headerEnd);
+                if (!parseHeaders()) {
+                    return false;
+                }
+                state_ = State::BODY;
+                break;
+            }
+
+            case State::EPILOGUE:
+                return true;
+
+            case State::FAILED:
+                return false;
+        }
+
+        if (state_ == State::FAILED) {
+            return false;
+        }
+    }
+    return state_ != State::FAILED;
+}
+
+bool MultipartParser::scanForDelimiter(const char*& p, const char* end, const BodyBuffer* owner) {
+    const size_t length = search_.length();
+
+    if (!tail_.empty()) {
+        // A delimiter may start in the bytes kept from the previous chunk
+        const size_t take = std::min(length - 1, static_cast<size_t>(end - p));
+        window_.assign(tail_);
+        window_.append(p, take);
+
+        size_t found = search_.find(window_.data(), window_.size(), 0);
+        if (found != std::string::npos) {
+            if (!emitData(window_.data(), found, nullptr)) {
+                return false;
+            }
+            p += found + length - tail_.size();
+            tail_.clear();
+            return true;
+        }
+
+        if (take < length - 1) {
+            // The chunk was absorbed entirely; keep whatever may still
+            // turn out to be the start of a delimiter
+            size_t decided = window_.size() >= length ? window_.size() - length + 1 : 0;
+            if (!emitData(window_.data(), decided, nullptr)) {
+                return false;
+            }
+            tail_.assign(window_, decided, std::string::npos);
+            p = end;
+            return false;
+        }
+
+        if (!emitData(tail_.data(), tail_.size(), nullptr)) {
+            return false;
+        }
+        tail_.clear();
+    }
+
+    const size_t available = static_cast<size_t>(end - p);
+    size_t found = search_.find(p, available, 0);
+    if (found != std::string::npos) {
+        if (!emitData(p, found, owner)) {
+            return false;
+        }
+        p += found + length;
+        return true;
+    }
+
+    const size_t keep = std::min(length - 1, available);
+    if (!emitData(p, available - keep, owner)) {
+        return false;
+    }
+    tail_.assign(end - keep, keep);
+    p = end;
+    return false;
+}
+
+bool MultipartParser::emitData(const char* data, std::size_t size, const BodyBuffer* owner) {
+    if (state_ != State::BODY || size == 0) {
+        return true;
+    }
+
+    if (current_.file_) {
+        if (!writeAll(current_.file_->fd, data, size)) {
+            return fail("Failed to write multipart spill file");
+        }
+        current_.size_ += size;
+        return true;
+    }
+
+    if (!copying_) {
+        const bool fromOwner = owner && data >= owner->data() && data + size <= owner->data() + owner->size();
+        if (fromOwner && currentSlice_.empty()) {
+            currentSlice_ = owner->slice(static_cast<size_t>(data - owner->data()), size);
+        } else if (fromOwner && currentSlice_.data() + currentSlice_.size() == data &&
+                   currentSlice_.data() >= owner->data()) {
+            currentSlice_ = owner->slice(static_cast<size_t>(currentSlice_.data() - owner->data()),
+                                         currentSlice_.size() + size);
+        } else {
+            copying_ = true;
+            currentCopy_.assign(currentSlice_.view());
+            currentSlice_ = BodyBuffer();
+        }
+    }
+    if (copying_) {
+        currentCopy_.append(data, size);
+    }
+    current_.size_ += size;
+
+    if (current_.size_ > options_.spillThreshold) {
+        return spill();
+    }
+    return true;
+}
+
+bool MultipartParser::spill() {
+    bool anonymous = false;
+    int fd = createSpillFile(options_.tempDirectory, anonymous);
+    if (fd < 0) {
+        return fail("Cannot create multipart spill file in " + options_.tempDirectory + ": " + std::strerror(errno));
+    }
+    current_.file_ = std::make_shared<MultipartPart::SpillFile>(fd);
+    current_.file_->anonymous = anonymous;
+
+    std::string_view pending = copying_ ? std::string_view(currentCopy_) : currentSlice_.view();
+    if (!writeAll(fd, pending.data(), pending.size())) {
+        return fail("Failed to write multipart spill file");
+    }
+    currentSlice_ = BodyBuffer();
+    currentCopy_ = std::string();
+    copying_ = false;
+    return true;
+}
+
+bool MultipartParser::parseHeaders() {
+    current_ = MultipartPart();
+    currentSlice_ = BodyBuffer();
+    currentCopy_.clear();
+    copying_ = false;
+
+    std::string_view block(lineBuffer_);
+    while (!block.empty()) {
+        size_t lineEnd = block.find("\r\n");
+        std::string_view line = block.substr(0, lineEnd);
+        block.remove_prefix(lineEnd == std::string_view::npos ? block.size() : lineEnd + 2);
+        if (line.empty()) {
+            continue;
+        }
+
+        size_t colon = line.find(':');
+        if (colon == std::string_view::npos || colon == 0) {
+            return fail("Malformed multipart part header");
+        }
+        std::string name(trim(line.substr(0, colon)));
+        std::string value(trim(line.substr(colon + 1)));
+
+        if (equalsIgnoreCase(name, "Content-Disposition")) {
+            forEachParameter(value, [this](std::string_view key, std::string parameter) {
+                if (equalsIgnoreCase(key, "name")) {
+                    current_.name_ = std::move(parameter);
+                } else if (equalsIgnoreCase(key, "filename")) {
+                    current_.filename_ = std::move(parameter);
+                }
+            });
+        } else if (equalsIgnoreCase(name, "Content-Type")) {
+            current_.contentType_ = value;
+        }
+        current_.headers_[std::move(name)] = std::move(value);
+    }
+
+    lineBuffer_.clear();
+    return true;
+}
+
+bool MultipartParser::finishPart() {
+    if (!current_.file_) {
+        current_.data_ = copying_ ? BodyBuffer(std::move(currentCopy_)) : std::move(currentSlice_);
+    }
+    currentSlice_ = BodyBuffer();
+    currentCopy_ = std::string();
+    copying_ = false;
+
+    if (partHandler_) {
+        partHandler_(std::move(current_));
+    } else {
+        parts_.push_back(std::move(current_));
+    }
+    current_ = MultipartPart();
+    return true;
+}
+
+bool MultipartParser::fail(std::string message) {
+    error_ = std::move(message);
+    state_ = State::FAILED;
+    return false;
+}
+
+} // namespace cppSwitchboard
@@ -0,0 +1,271 @@
+/**
+ * @file plugin_accounting.cpp
+ * @brief Implementation of per-plugin resource accounting and circuit breaking
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/plugin_accounting.h>
+#include "usdt_probes.h"
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+
+namespace cppSwitchboard {
+
+namespace {
+    thread_local uint64_t allocationCount = 0;
+
+    std::chrono::nanoseconds threadCpuTime() {
+        timespec now{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        return std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec);
+    }
+
+    int64_t steadyNanoseconds() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void raiseMaximum(std::atomic<int64_t>& maximum, int64_t value) {
+        int64_t current = maximum.load(std::memory_order_relaxed);
+        while (value > current && !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+}
+
+void PluginCostMeter::start() {
+    cost_ = PluginCost{};
+    paused_ = false;
+    wallStart_ = std::chrono::steady_clock::now();
+    cpuStart_ = threadCpuTime();
+    allocationsStart_ = threadAllocations();
+}
+
+void PluginCostMeter::pause() {
+    if (paused_) {
+        return;
+    }
+    cost_.wallTime += std::chrono::steady_clock::now() - wallStart_;
+    cost_.cpuTime += threadCpuTime() - cpuStart_;
+    cost_.allocations += threadAllocations() - allocationsStart_;
+    paused_ = true;
+}
+
+void PluginCostMeter::resume() {
+    if (!paused_) {
+        return;
+    }
+    wallStart_ = std::chrono::steady_clock::now();
+    cpuStart_ = threadCpuTime();
+    allocationsStart_ = threadAllocations();
+    paused_ = false;
+}
+
+PluginCost PluginCostMeter::stop() {
+    pause();
+    return cost_;
+}
+
+uint64_t PluginCostMeter::threadAllocations() noexcept {
+    return allocationCount;
+}
+
+PluginAccount::PluginAccount(std::string pluginName) : pluginName_(std::move(pluginName)) {
+    setBudget(PluginBudget());
+}
+
+void PluginAccount::setBudget(const PluginBudget& budget) {
+    maxLatencyNs_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(budget.maxLatency).count());
+    maxFailureRate_.store(budget.maxFailureRate);
+    minCalls_.store(budget.minCalls);
+    windowSize_.store(budget.windowSize > 0 ? budget.windowSize : 1);
+    openDurationNs_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(budget.openDuration).count());
+    failClosed_.store(budget.failureMode == PluginFailureMode::FAIL_CLOSED);
+    // No Server value: the account is not tied to one server
+    const int64_t retryAfter = std::max<int64_t>(
+        1, std::chrono::duration_cast<std::chrono::seconds>(budget.openDuration).count());
+    std::atomic_store(&rejection_, CannedResponse::create(
+        HttpResponse::serviceUnavailable("Service Unavailable", retryAfter), {}));
+    reset();
+}
+
+PluginBudget PluginAccount::getBudget() const {
+    PluginBudget budget;
+    budget.maxLatency = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::nanoseconds(maxLatencyNs_.load()));
+    budget.maxFailureRate = maxFailureRate_.load();
+    budget.minCalls = minCalls_.load();
+    budget.windowSize = windowSize_.load();
+    budget.openDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::nanoseconds(openDurationNs_.load()));
+    budget.failureMode = failClosed_.load() ? PluginFailureMode::FAIL_CLOSED : PluginFailureMode::FAIL_OPEN;
+    return budget;
+}
+
+PluginAccount::Admission PluginAccount::admit() {
+    int state = state_.load(std::memory_order_acquire);
+    if (state == static_cast<int>(PluginCircuitState::CLOSED)) {
+        return Admission::RUN;
+    }
+
+    // Only the caller moving OPEN to HALF_OPEN makes the trial call
+    if (state == static_cast<int>(PluginCircuitState::OPEN) &&
+        steadyNanoseconds() - openedAt_.load(std::memory_order_relaxed) >= openDurationNs_.load(std::memory_order_relaxed) &&
+        state_.compare_exchange_strong(state, static_cast<int>(PluginCircuitState::HALF_OPEN))) {
+        return Admission::RUN;
+    }
+
+    if (failClosed_.load(std::memory_order_relaxed)) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return Admission::REJECT;
+    }
+    bypassed_.fetch_add(1, std::memory_order_relaxed);
+    return Admission::BYPASS;
+}
+
+void PluginAccount::record(const PluginCost& cost, bool threw) {
+    const int64_t wallNs = cost.wallTime.count();
+    calls_.fetch_add(1, std::memory_order_relaxed);
+    wallTimeNs_.fetch_add(wallNs, std::memory_order_relaxed);
+    cpuTimeNs_.fetch_add(cost.cpuTime.count(), std::memory_order_relaxed);
+    allocations_.fetch_add(cost.allocations, std::memory_order_relaxed);
+    raiseMaximum(maxWallTimeNs_, wallNs);
+
+    const int64_t maxLatency = maxLatencyNs_.load(std::memory_order_relaxed);
+    const bool slow = maxLatency > 0 && wallNs > maxLatency;
+    if (threw) {
+        exceptions_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (slow) {
+        slowCalls_.fetch_add(1, std::memory_order_relaxed);
+    }
+    const bool failed = threw || slow;
+
+    const int state = state_.load(std::memory_order_acquire);
+    if (state == static_cast<int>(PluginCircuitState::HALF_OPEN)) {
+        // Outcome of the trial call
+        if (failed) {
+            trip();
+        } else {
+            reset();
+        }
+        return;
+    }
+    if (state == static_cast<int>(PluginCircuitState::OPEN)) {
+        return;  // Admitted before the circuit opened
+    }
+
+    // Counted per window without a lock; concurrent calls at a window
+    // boundary may land in either window
+    const uint32_t calls = windowCalls_.fetch_add(1, std::memory_order_relaxed) + 1;
+    const uint32_t failures = failed ? windowFailures_.fetch_add(1, std::memory_order_relaxed) + 1
+                                     : windowFailures_.load(std::memory_order_relaxed);
+    if (failed && calls >= minCalls_.load(std::memory_order_relaxed) &&
+        static_cast<double>(failures) / calls > maxFailureRate_.load(std::memory_order_relaxed)) {
+        trip();
+    } else if (calls >= windowSize_.load(std::memory_order_relaxed)) {
+        windowCalls_.store(0, std::memory_order_relaxed);
+        windowFailures_.store(0, std::memory_order_relaxed);
+    }
+}
+
+void PluginAccount::trip() {
+    openedAt_.store(steadyNanoseconds(), std::memory_order_relaxed);
+    windowCalls_.store(0, std::memory_order_relaxed);
+    windowFailures_.store(0, std::memory_order_relaxed);
+    if (state_.exchange(static_cast<int>(PluginCircuitState::OPEN), std::memory_order_release) !=
+        static_cast<int>(PluginCircuitState::OPEN)) {
+        trips_.fetch_add(1, std::memory_order_relaxed);
+        CPPSWITCHBOARD_PROBE2(plugin_circuit_open, pluginName_.c_str(), failClosed_.load() ? 1 : 0);
+    }
+}
+
+void PluginAccount::reset() {
+    windowCalls_.store(0, std::memory_order_relaxed);
+    windowFailures_.store(0, std::memory_order_relaxed);
+    state_.store(static_cast<int>(PluginCircuitState::CLOSED), std::memory_order_release);
+}
+
+PluginCircuitState PluginAccount::getState() const {
+    return static_cast<PluginCircuitState>(state_.load(std::memory_order_acquire));
+}
+
+PluginUsage PluginAccount::getUsage() const {
+    PluginUsage usage;
+    usage.calls = calls_.load(std::memory_order_relaxed);
+    usage.exceptions = exceptions_.load(std::memory_order_relaxed);
+    usage.slowCalls = slowCalls_.load(std::memory_order_relaxed);
+    usage.bypassed = bypassed_.load(std::memory_order_relaxed);
+    usage.rejected = rejected_.load(std::memory_order_relaxed);
+    usage.trips = trips_.load(std::memory_order_relaxed);
+    usage.wallTime = std::chrono::nanoseconds(wallTimeNs_.load(std::memory_order_relaxed));
+    usage.cpuTime = std::chrono::nanoseconds(cpuTimeNs_.load(std::memory_order_relaxed));
+    usage.maxWallTime = std::chrono::nanoseconds(maxWallTimeNs_.load(std::memory_order_relaxed));
+    usage.allocations = allocations_.load(std::memory_order_relaxed);
+    usage.state = getState();
+    return usage;
+}
+
+HttpResponse PluginAccount::rejection() const {
+    return std::atomic_load(&rejection_)->toResponse();
+}
+
+AccountedMiddleware::AccountedMiddleware(std::shared_ptr<Middleware> middleware,
+                                         std::shared_ptr<PluginAccount> account)
+    : middleware_(std::move(middleware)), account_(std::move(account)) {}
+
+HttpResponse AccountedMiddleware::handle(const HttpRequest& request, Context& context, NextHandler next) {
+    switch (account_->admit()) {
+        case PluginAccount::Admission::BYPASS:
+            return next(request, context);
+        case PluginAccount::Admission::REJECT:
+            return account_->rejection();
+        case PluginAccount::Admission::RUN:
+            break;
+    }
+
+    PluginCostMeter meter;
+    bool inChain = false;  // An exception thrown by the rest of the chain is not the plugin's
+    meter.start();
+    try {
+        HttpResponse response = middleware_->handle(request, context,
+            [&meter, &inChain, &next](const HttpRequest& req, Context& ctx) {
+                meter.pause();
+                inChain = true;
+                HttpResponse result = next(req, ctx);
+                inChain = false;
+                meter.resume();
+                return result;
+            });
+        account_->record(meter.stop(), false);
+        return response;
+    } catch (...) {
+        account_->record(meter.stop(), !inChain);
+        throw;
+    }
+}
+
+} // namespace cppSwitchboard
+
+#ifdef CPPSWITCHBOARD_ACCOUNT_ALLOCATIONS
+// Replaces the global allocation functions to count allocations per thread.
+// The array and nothrow forms forward to these.
+void* operator new(std::size_t size) {
+    ++cppSwitchboard::allocationCount;
+    if (void* memory = std::malloc(size != 0 ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+#endif
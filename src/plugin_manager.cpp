@@ -7,6 +7,7 @@
  */
 
 #include <cppSwitchboard/plugin_manager.h>
+#include <cppSwitchboard/c_abi_middleware.h>
 #include <cppSwitchboard/debug_logger.h>
 
 #include <algorithm>
@@ -20,10 +21,129 @@
     #include <libloaderapi.h>
 #else
     #include <dlfcn.h>
+    #include <cstdlib>
+    #include <unistd.h>
 #endif
 
 namespace cppSwitchboard {
 
+namespace {
+    void closeLibrary(void* handle) {
+#ifdef _WIN32
+        FreeLibrary(static_cast<HMODULE>(handle));
+#else
+        dlclose(handle);
+#endif
+    }
+
+    void* findSymbol(void* handle, const char* name) {
+#ifdef _WIN32
+        return reinterpret_cast<void*>(GetProcAddress(static_cast<HMODULE>(handle), name));
+#else
+        return dlsym(handle, name);
+#endif
+    }
+
+    /**
+     * @brief Destroys a plugin, then lets go of its library
+     *
+     * Every middleware created by the plugin holds the plugin, so the library
+     * stays mapped until the last pipeline using it is gone.
+     */
+    struct PluginDeleter {
+        cppSwitchboard_destroy_plugin_t destroy;
+        std::shared_ptr<void> library;  ///< Released with the deleter, after destroy()
+
+        void operator()(MiddlewarePlugin* plugin) const {
+            plugin->shutdown();
+            destroy(plugin);
+        }
+    };
+
+    /**
+     * @brief Name and required dependencies of an opened plugin library
+     */
+    void describeLibrary(void* handle, std::string& name, std::vector<std::string>& dependencies) {
+        if (auto info = static_cast<const MiddlewarePluginInfo*>(findSymbol(handle, "cppSwitchboard_plugin_info"))) {
+            name = info->name ? info->name : "";
+            for (size_t i = 0; i < info->dependency_count; ++i) {
+                if (!info->dependencies[i].optional && info->dependencies[i].name) {
+                    dependencies.push_back(info->dependencies[i].name);
+                }
+            }
+        } else if (auto descriptor = static_cast<const cppSwitchboard_c_plugin*>(
+                       findSymbol(handle, "cppSwitchboard_c_plugin_info"))) {
+            name = descriptor->name ? descriptor->name : "";
+        }
+    }
+
+    /**
+     * @brief Run work(0) .. work(count - 1) on up to @p concurrency threads
+     * @param concurrency Thread limit; 0 for one per hardware thread
+     */
+    void runConcurrently(size_t count, size_t concurrency, const std::function<void(size_t)>& work) {
+        if (concurrency == 0) {
+            concurrency = std::max(1u, std::thread::hardware_concurrency());
+        }
+        size_t threads = std::min(count, concurrency);
+        if (threads <= 1) {
+            for (size_t i = 0; i < count; ++i) {
+                work(i);
+            }
+            return;
+        }
+        std::atomic<size_t> next{0};
+        auto worker = [&]() {
+            for (size_t i = next++; i < count; i = next++) {
+                work(i);
+            }
+        };
+        std::vector<std::thread> pool;
+        for (size_t i = 1; i < threads; ++i) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    }
+
+#ifndef _WIN32
+    /**
+     * @brief Copy a plugin library to a private temporary file
+     *
+     * dlopen() returns the already loaded library for a path it has seen, so
+     * a new generation must be opened from a path of its own. Loading a copy
+     * also leaves the original free to be overwritten in place.
+     *
+     * @return Path of the copy, empty on failure
+     */
+    std::string copyToTemporary(const std::string& filePath) {
+        std::error_code error;
+        std::string extension = std::filesystem::path(filePath).extension().string();
+        std::string pattern = (std::filesystem::temp_directory_path(error) / "cppSwitchboard-plugin-XXXXXX").string() +
+                              extension;
+        int fd = mkstemps(pattern.data(), static_cast<int>(extension.size()));
+        if (fd < 0) {
+            return std::string();
+        }
+        close(fd);
+        if (!std::filesystem::copy_file(filePath, pattern, std::filesystem::copy_options::overwrite_existing, error)) {
+            std::filesystem::remove(pattern, error);
+            return std::string();
+        }
+        return pattern;
+    }
+#endif
+
+    /// Lexical form used to compare watcher paths with loaded plugin paths
+    std::string normalizedPath(const std::string& path) {
+        std::error_code error;
+        auto absolute = std::filesystem::absolute(path, error);
+        return (error ? std::filesystem::path(path) : absolute).lexically_normal().string();
+    }
+}
+
 PluginManager& PluginManager::getInstance() {
     static PluginManager instance;
     return instance;
@@ -78,18 +198,33 @@ bool PluginManager::removePluginDirectory(const std::string& directory) {
 }
 
 std::pair<PluginLoadResult, std::string> PluginManager::loadPlugin(const std::string& filePath, bool hotReload) {
+    return loadPluginFile(filePath, hotReload, nullptr);
+}
+
+std::pair<PluginLoadResult, std::string> PluginManager::loadPluginFile(
+    const std::string& filePath, bool hotReload, const std::shared_ptr<LoadedPluginInfo>& replacing) {
+    std::shared_ptr<void> library;
+    PluginLoadResult opened = openPluginLibrary(filePath, hotReload, library);
+    if (opened != PluginLoadResult::SUCCESS) {
+        return {opened, ""};
+    }
+    return completePluginLoad(std::move(library), filePath, hotReload, replacing);
+}
+
+PluginLoadResult PluginManager::openPluginLibrary(const std::string& filePath, bool hotReload,
+                                                  std::shared_ptr<void>& library) {
     totalLoadAttempts_++;
     
     // Check if file exists
     if (!std::filesystem::exists(filePath)) {
         fireEvent("error", "", "Plugin file not found: " + filePath);
-        return {PluginLoadResult::FILE_NOT_FOUND, ""};
+        return PluginLoadResult::FILE_NOT_FOUND;
     }
     
     // Check if it's a valid plugin file
     if (!isValidPluginFile(filePath)) {
         fireEvent("error", "", "Invalid plugin file format: " + filePath);
-        return {PluginLoadResult::INVALID_FORMAT, ""};
+        return PluginLoadResult::INVALID_FORMAT;
     }
     
     void* handle = nullptr;
@@ -101,25 +236,37 @@ std::pair<PluginLoadResult, std::string> PluginManager::loadPlugin(const std::st
         std::stringstream ss;
         ss << "Failed to load library " << filePath << " (error: " << error << ")";
         fireEvent("error", "", ss.str());
-        return {PluginLoadResult::INVALID_FORMAT, ""};
+        return PluginLoadResult::INVALID_FORMAT;
     }
 #else
-    handle = dlopen(filePath.c_str(), RTLD_LAZY | RTLD_LOCAL);
+    // Hot-reload plugins are opened from a copy so every generation gets its own mapping
+    std::string libraryPath = hotReload ? copyToTemporary(filePath) : filePath;
+    if (libraryPath.empty()) {
+        fireEvent("error", "", "Failed to copy plugin library " + filePath);
+        return PluginLoadResult::INVALID_FORMAT;
+    }
+    handle = dlopen(libraryPath.c_str(), RTLD_LAZY | RTLD_LOCAL);
+    if (hotReload) {
+        std::error_code removeError;
+        std::filesystem::remove(libraryPath, removeError); // The mapping outlives the file
+    }
     if (!handle) {
         std::string error = dlerror();
         fireEvent("error", "", "Failed to load library " + filePath + ": " + error);
-        return {PluginLoadResult::INVALID_FORMAT, ""};
+        return PluginLoadResult::INVALID_FORMAT;
     }
 #endif
     
-    auto result = loadPluginFromHandle(handle, filePath, hotReload);
+    // Closed when the last plugin or middleware of this generation is released
+    library = std::shared_ptr<void>(handle, closeLibrary);
+    return PluginLoadResult::SUCCESS;
+}
+
+std::pair<PluginLoadResult, std::string> PluginManager::completePluginLoad(
+    std::shared_ptr<void> library, const std::string& filePath, bool hotReload,
+    const std::shared_ptr<LoadedPluginInfo>& replacing) {
+    auto result = loadPluginFromHandle(std::move(library), filePath, hotReload, replacing);
     if (result.first != PluginLoadResult::SUCCESS) {
-        // Cleanup handle on failure
-#ifdef _WIN32
-        FreeLibrary(static_cast<HMODULE>(handle));
-#else
-        dlclose(handle);
-#endif
         return {result.first, ""};
     }
     
@@ -129,21 +276,31 @@ std::pair<PluginLoadResult, std::string> PluginManager::loadPlugin(const std::st
 }
 
 std::pair<PluginLoadResult, std::shared_ptr<LoadedPluginInfo>> PluginManager::loadPluginFromHandle(
-    void* handle, const std::string& filePath, bool hotReload) {
+    std::shared_ptr<void> library, const std::string& filePath, bool hotReload,
+    const std::shared_ptr<LoadedPluginInfo>& replacing) {
+    void* handle = library.get();
     
     // Get plugin info
-#ifdef _WIN32
-    auto infoSymbol = GetProcAddress(static_cast<HMODULE>(handle), "cppSwitchboard_plugin_info");
-#else
-    auto infoSymbol = dlsym(handle, "cppSwitchboard_plugin_info");
-#endif
+    const MiddlewarePluginInfo* pluginInfo = nullptr;
+    cppSwitchboard_destroy_plugin_t destroyFunc = nullptr;
+    std::unique_ptr<MiddlewarePlugin, cppSwitchboard_destroy_plugin_t> plugin(nullptr, nullptr);
     
-    if (!infoSymbol) {
-        return {PluginLoadResult::MISSING_EXPORTS, nullptr};
+    if (auto infoSymbol = findSymbol(handle, "cppSwitchboard_plugin_info")) {
+        pluginInfo = static_cast<const MiddlewarePluginInfo*>(infoSymbol);
+    } else {
+        // No C++ exports: a plugin written against the C ABI
+        auto descriptor = static_cast<const cppSwitchboard_c_plugin*>(findSymbol(handle, "cppSwitchboard_c_plugin_info"));
+        if (!descriptor) {
+            return {PluginLoadResult::MISSING_EXPORTS, nullptr};
+        }
+        if (descriptor->abi_version != CPPSWITCH_C_ABI_VERSION || !descriptor->name) {
+            return {PluginLoadResult::VERSION_MISMATCH, nullptr};
+        }
+        destroyFunc = [](MiddlewarePlugin* cPlugin) { delete cPlugin; };
+        plugin = {new CAbiPlugin(*descriptor), destroyFunc};
+        pluginInfo = &plugin->getInfo();
     }
     
-    auto pluginInfo = static_cast<MiddlewarePluginInfo*>(infoSymbol);
-    
     // Validate plugin version
     if (!validatePluginVersion(*pluginInfo)) {
         return {PluginLoadResult::VERSION_MISMATCH, nullptr};
@@ -152,32 +309,28 @@ std::pair<PluginLoadResult, std::shared_ptr<LoadedPluginInfo>> PluginManager::lo
     // Check if plugin with same name is already loaded
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        if (loadedPlugins_.find(pluginInfo->name) != loadedPlugins_.end()) {
+        auto it = loadedPlugins_.find(pluginInfo->name);
+        if (it != loadedPlugins_.end() && it->second != replacing) {
             return {PluginLoadResult::ALREADY_LOADED, nullptr};
         }
     }
     
-    // Get plugin factory function
-#ifdef _WIN32
-    auto createFunc = reinterpret_cast<cppSwitchboard_create_plugin_t>(
-        GetProcAddress(static_cast<HMODULE>(handle), "cppSwitchboard_create_plugin"));
-    auto destroyFunc = reinterpret_cast<cppSwitchboard_destroy_plugin_t>(
-        GetProcAddress(static_cast<HMODULE>(handle), "cppSwitchboard_destroy_plugin"));
-#else
-    auto createFunc = reinterpret_cast<cppSwitchboard_create_plugin_t>(
-        dlsym(handle, "cppSwitchboard_create_plugin"));
-    auto destroyFunc = reinterpret_cast<cppSwitchboard_destroy_plugin_t>(
-        dlsym(handle, "cppSwitchboard_destroy_plugin"));
-#endif
-    
-    if (!createFunc || !destroyFunc) {
-        return {PluginLoadResult::MISSING_EXPORTS, nullptr};
-    }
-    
-    // Create plugin instance
-    std::unique_ptr<MiddlewarePlugin, cppSwitchboard_destroy_plugin_t> plugin(createFunc(), destroyFunc);
     if (!plugin) {
-        return {PluginLoadResult::INITIALIZATION_FAILED, nullptr};
+        // Get plugin factory function
+        auto createFunc = reinterpret_cast<cppSwitchboard_create_plugin_t>(
+            findSymbol(handle, "cppSwitchboard_create_plugin"));
+        destroyFunc = reinterpret_cast<cppSwitchboard_destroy_plugin_t>(
+            findSymbol(handle, "cppSwitchboard_destroy_plugin"));
+        
+        if (!createFunc || !destroyFunc) {
+            return {PluginLoadResult::MISSING_EXPORTS, nullptr};
+        }
+        
+        // Create plugin instance
+        plugin = {createFunc(), destroyFunc};
+        if (!plugin) {
+            return {PluginLoadResult::INITIALIZATION_FAILED, nullptr};
+        }
     }
     
     // Initialize plugin
@@ -190,7 +343,7 @@ std::pair<PluginLoadResult, std::shared_ptr<LoadedPluginInfo>> PluginManager::lo
     loadedInfo->filePath = filePath;
     loadedInfo->name = pluginInfo->name;
     loadedInfo->version = pluginInfo->plugin_version;
-    loadedInfo->plugin = std::shared_ptr<MiddlewarePlugin>(plugin.release(), destroyFunc);
+    loadedInfo->plugin = std::shared_ptr<MiddlewarePlugin>(plugin.release(), PluginDeleter{destroyFunc, std::move(library)});
     loadedInfo->handle = handle;
     loadedInfo->loadTime = std::chrono::steady_clock::now();
     loadedInfo->hotReloadEnabled = hotReload;
@@ -219,13 +372,23 @@ std::pair<PluginLoadResult, std::shared_ptr<LoadedPluginInfo>> PluginManager::lo
     }
     
     if (!missingDeps.empty()) {
-        loadedInfo->plugin->shutdown();
         return {PluginLoadResult::DEPENDENCY_MISSING, nullptr};
     }
     
-    // Store in loaded plugins map
+    // Store in loaded plugins map, swapping out the generation being replaced
     {
         std::lock_guard<std::mutex> lock(mutex_);
+        if (replacing) {
+            auto it = loadedPlugins_.find(replacing->name);
+            if (it != loadedPlugins_.end() && it->second == replacing) {
+                loadedPlugins_.erase(it);
+            }
+            // Counts taken through the plugin name carry over to the new generation
+            loadedInfo->refCount = replacing->refCount.load();
+        }
+        if (loadedPlugins_.find(pluginInfo->name) != loadedPlugins_.end()) {
+            return {PluginLoadResult::ALREADY_LOADED, nullptr};
+        }
         loadedPlugins_[pluginInfo->name] = loadedInfo;
     }
     
@@ -258,21 +421,12 @@ bool PluginManager::unloadPlugin(const std::string& pluginName) {
     }
     
     // Check if other plugins depend on this one
-    auto dependents = getDependentPlugins(pluginName);
+    auto dependents = dependentsOf(pluginName);
     if (!dependents.empty()) {
         return false; // Other plugins depend on this one
     }
     
-    // Shutdown plugin
-    pluginInfo->plugin->shutdown();
-    
-    // Close library handle
-#ifdef _WIN32
-    FreeLibrary(static_cast<HMODULE>(pluginInfo->handle));
-#else
-    dlclose(pluginInfo->handle);
-#endif
-    
+    // Shut down and closed once middleware created from it is released
     loadedPlugins_.erase(it);
     totalUnloads_++;
     
@@ -288,18 +442,9 @@ bool PluginManager::forceUnloadPlugin(const std::string& pluginName) {
         return false;
     }
     
-    auto& pluginInfo = it->second;
-    
-    // Shutdown plugin
-    pluginInfo->plugin->shutdown();
-    
-    // Close library handle
-#ifdef _WIN32
-    FreeLibrary(static_cast<HMODULE>(pluginInfo->handle));
-#else
-    dlclose(pluginInfo->handle);
-#endif
+    auto pluginInfo = it->second;
     
+    // Shut down and closed once middleware created from it is released
     loadedPlugins_.erase(it);
     totalUnloads_++;
     
@@ -351,13 +496,78 @@ std::vector<std::string> PluginManager::discoverPlugins() const {
     return discoveredPlugins;
 }
 
-std::unordered_map<std::string, std::pair<PluginLoadResult, std::string>> PluginManager::discoverAndLoadPlugins() {
+std::unordered_map<std::string, std::pair<PluginLoadResult, std::string>> PluginManager::discoverAndLoadPlugins(bool hotReload) {
     auto discoveredPlugins = discoverPlugins();
     std::unordered_map<std::string, std::pair<PluginLoadResult, std::string>> results;
+    size_t concurrency;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        concurrency = discoveryConfig_.loadConcurrency;
+    }
     
-    for (const auto& pluginPath : discoveredPlugins) {
-        auto result = loadPlugin(pluginPath);
-        results[pluginPath] = result;
+    // Open every library at once; the name and dependencies are readable
+    // before the plugin is created
+    struct PendingPlugin {
+        std::shared_ptr<void> library;
+        std::string name;
+        std::vector<std::string> dependencies;
+        PluginLoadResult opened = PluginLoadResult::SUCCESS;
+        size_t wave = 0;
+    };
+    std::vector<PendingPlugin> pending(discoveredPlugins.size());
+    runConcurrently(pending.size(), concurrency, [&](size_t i) {
+        PendingPlugin& plugin = pending[i];
+        plugin.opened = openPluginLibrary(discoveredPlugins[i], hotReload, plugin.library);
+        if (plugin.opened == PluginLoadResult::SUCCESS) {
+            describeLibrary(plugin.library.get(), plugin.name, plugin.dependencies);
+        }
+    });
+    
+    // A plugin initializes in the wave after the last of its required
+    // dependencies found in this batch. Dependencies already loaded or
+    // absent are left to the usual check; cycles end up in the last wave
+    // and fail it.
+    std::unordered_map<std::string, size_t> byName;
+    for (size_t i = 0; i < pending.size(); ++i) {
+        if (pending[i].opened == PluginLoadResult::SUCCESS && !pending[i].name.empty()) {
+            byName.emplace(pending[i].name, i);
+        }
+    }
+    size_t waves = 1;
+    for (bool changed = true; changed && waves <= pending.size();) {
+        changed = false;
+        for (auto& plugin : pending) {
+            for (const auto& dependency : plugin.dependencies) {
+                auto it = byName.find(dependency);
+                if (it != byName.end() && pending[it->second].wave >= plugin.wave) {
+                    plugin.wave = pending[it->second].wave + 1;
+                    waves = std::max(waves, plugin.wave + 1);
+                    changed = true;
+                }
+            }
+        }
+    }
+    
+    for (size_t wave = 0; wave < waves; ++wave) {
+        std::vector<size_t> members;
+        for (size_t i = 0; i < pending.size(); ++i) {
+            if (pending[i].opened == PluginLoadResult::SUCCESS && std::min(pending[i].wave, waves - 1) == wave) {
+                members.push_back(i);
+            }
+        }
+        std::vector<std::pair<PluginLoadResult, std::string>> loaded(members.size());
+        runConcurrently(members.size(), concurrency, [&](size_t i) {
+            size_t index = members[i];
+            loaded[i] = completePluginLoad(std::move(pending[index].library), discoveredPlugins[index], hotReload, nullptr);
+        });
+        for (size_t i = 0; i < members.size(); ++i) {
+            results[discoveredPlugins[members[i]]] = loaded[i];
+        }
+    }
+    for (size_t i = 0; i < pending.size(); ++i) {
+        if (pending[i].opened != PluginLoadResult::SUCCESS) {
+            results[discoveredPlugins[i]] = {pending[i].opened, ""};
+        }
     }
     
     return results;
@@ -436,59 +646,115 @@ int PluginManager::getPluginRefCount(const std::string& pluginName) const {
 }
 
 std::vector<std::string> PluginManager::checkAndReloadPlugins() {
+    std::vector<std::pair<std::string, std::filesystem::file_time_type>> candidates;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [name, pluginInfo] : loadedPlugins_) {
+            if (pluginInfo->hotReloadEnabled) {
+                candidates.emplace_back(pluginInfo->filePath, pluginInfo->lastModified);
+            }
+        }
+    }
+    
+    // Stat outside the lock so lookups are not held up by the filesystem
+    std::vector<std::string> changedPaths;
+    for (const auto& [filePath, lastModified] : candidates) {
+        std::error_code error;
+        auto currentModTime = std::filesystem::last_write_time(filePath, error);
+        if (!error && currentModTime > lastModified) {
+            changedPaths.push_back(filePath);
+        }
+    }
+    
+    return changedPaths.empty() ? std::vector<std::string>() : reloadChangedPlugins(changedPaths);
+}
+
+std::vector<std::string> PluginManager::reloadChangedPlugins(const std::vector<std::string>& changedPaths) {
     std::vector<std::string> reloadedPlugins;
-    std::lock_guard<std::mutex> lock(mutex_);
     
-    for (auto& [name, pluginInfo] : loadedPlugins_) {
-        if (!pluginInfo->hotReloadEnabled) {
+    for (const auto& changedPath : changedPaths) {
+        const std::string path = normalizedPath(changedPath);
+        std::shared_ptr<LoadedPluginInfo> previous;
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& [name, pluginInfo] : loadedPlugins_) {
+                if (normalizedPath(pluginInfo->filePath) == path) {
+                    previous = pluginInfo;
+                    break;
+                }
+            }
+        }
+        
+        if (previous && !previous->hotReloadEnabled) {
+            continue;
+        }
+        if (!previous && (!isValidPluginFile(path) || !std::filesystem::is_regular_file(path))) {
             continue;
         }
         
-        try {
-            auto currentModTime = std::filesystem::last_write_time(pluginInfo->filePath);
-            if (currentModTime > pluginInfo->lastModified) {
-                // File has been modified, attempt reload
-                if (pluginInfo->refCount.load() == 0) {
-                    // Safe to reload
-                    std::string filePath = pluginInfo->filePath;
-                    
-                    // Shutdown current plugin
-                    pluginInfo->plugin->shutdown();
-                    
-                    // Close handle
-#ifdef _WIN32
-                    FreeLibrary(static_cast<HMODULE>(pluginInfo->handle));
-#else
-                    dlclose(pluginInfo->handle);
-#endif
-                    
-                    // Remove from map temporarily
-                    loadedPlugins_.erase(name);
-                    
-                    // Reload plugin
-                    mutex_.unlock(); // Unlock to avoid deadlock in loadPlugin
-                    auto result = loadPlugin(filePath, true);
-                    mutex_.lock();
-                    
-                    if (result.first == PluginLoadResult::SUCCESS) {
-                        reloadedPlugins.push_back(name);
-                        hotReloads_++;
-                        fireEvent("hot_reload", name, "Plugin hot-reloaded successfully");
-                    } else {
-                        fireEvent("error", name, "Failed to hot-reload plugin: " + 
-                                 std::string(pluginLoadResultToString(result.first)));
-                    }
-                }
+        // The previous generation stays loaded, and in the map, until the
+        // new one is ready; middleware created from it keeps it mapped
+        auto result = loadPluginFile(previous ? previous->filePath : path, true, previous);
+        if (result.first == PluginLoadResult::SUCCESS) {
+            reloadedPlugins.push_back(result.second);
+            if (previous) {
+                hotReloads_++;
+                fireEvent("hot_reload", result.second, "Plugin hot-reloaded successfully");
             }
-        } catch (const std::filesystem::filesystem_error& e) {
-            // File may have been deleted or is inaccessible
-            fireEvent("error", name, "Failed to check file modification time: " + std::string(e.what()));
+        } else if (previous) {
+            fireEvent("error", previous->name, "Failed to hot-reload plugin, keeping the loaded version: " + 
+                     std::string(pluginLoadResultToString(result.first)));
         }
     }
     
     return reloadedPlugins;
 }
 
+std::vector<std::string> PluginManager::getWatchDirectories() const {
+    std::vector<std::string> directories;
+    auto add = [&directories](const std::filesystem::path& directory) {
+        std::string normalized = normalizedPath(directory.empty() ? "." : directory.string());
+        if (std::find(directories.begin(), directories.end(), normalized) == directories.end()) {
+            directories.push_back(std::move(normalized));
+        }
+    };
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    for (const auto& directory : discoveryConfig_.searchDirectories) {
+        std::error_code error;
+        if (!std::filesystem::is_directory(directory, error)) {
+            continue;
+        }
+        add(directory);
+        if (!discoveryConfig_.recursive) {
+            continue;
+        }
+        
+        auto options = discoveryConfig_.followSymlinks ?
+            std::filesystem::directory_options::follow_directory_symlink :
+            std::filesystem::directory_options::none;
+        options |= std::filesystem::directory_options::skip_permission_denied;
+        for (std::filesystem::recursive_directory_iterator it(directory, options, error), end;
+             !error && it != end; it.increment(error)) {
+            if (static_cast<size_t>(it.depth()) >= discoveryConfig_.maxDepth) {
+                it.disable_recursion_pending();
+            } else if (it->is_directory(error)) {
+                add(it->path());
+            }
+        }
+    }
+    
+    for (const auto& [name, pluginInfo] : loadedPlugins_) {
+        if (pluginInfo->hotReloadEnabled) {
+            add(std::filesystem::path(pluginInfo->filePath).parent_path());
+        }
+    }
+    
+    return directories;
+}
+
 bool PluginManager::validatePluginDependencies(const std::string& pluginName, std::vector<std::string>& missingDeps) const {
     std::lock_guard<std::mutex> lock(mutex_);
     
@@ -520,8 +786,12 @@ bool PluginManager::validatePluginDependencies(const std::string& pluginName, st
 }
 
 std::vector<std::string> PluginManager::getDependentPlugins(const std::string& pluginName) const {
-    std::vector<std::string> dependents;
     std::lock_guard<std::mutex> lock(mutex_);
+    return dependentsOf(pluginName);
+}
+
+std::vector<std::string> PluginManager::dependentsOf(const std::string& pluginName) const {
+    std::vector<std::string> dependents;
     
     for (const auto& [name, pluginInfo] : loadedPlugins_) {
         if (name == pluginName) continue;
@@ -560,7 +830,7 @@ size_t PluginManager::unloadAllPlugins(bool force) {
         }
         
         // First add all dependents
-        for (const auto& dependent : getDependentPlugins(pluginName)) {
+        for (const auto& dependent : dependentsOf(pluginName)) {
             addToUnloadOrder(dependent);
         }
         
@@ -585,16 +855,7 @@ size_t PluginManager::unloadAllPlugins(bool force) {
             continue; // Skip plugins still in use
         }
         
-        // Shutdown plugin
-        pluginInfo->plugin->shutdown();
-        
-        // Close library handle
-#ifdef _WIN32
-        FreeLibrary(static_cast<HMODULE>(pluginInfo->handle));
-#else
-        dlclose(pluginInfo->handle);
-#endif
-        
+        // Shut down and closed once middleware created from it is released
         loadedPlugins_.erase(it);
         unloadedCount++;
         totalUnloads_++;
@@ -670,6 +931,8 @@ std::string PluginManager::getLibraryExtension() {
 }
 
 void PluginManager::fireEvent(const std::string& eventType, const std::string& pluginName, const std::string& message) {
+    // Plugins load concurrently; the callback sees one event at a time
+    std::lock_guard<std::recursive_mutex> lock(eventMutex_);
     if (eventCallback_) {
         try {
             eventCallback_(eventType, pluginName, message);
@@ -0,0 +1,111 @@
+/**
+ * @file queue_delay.cpp
+ * @brief Implementation of queue-delay admission control
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/queue_delay.h>
+#include "usdt_probes.h"
+#include <algorithm>
+
+namespace cppSwitchboard {
+
+void QueueDelayController::configure(const AdmissionControlConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+    firstAbove_ = Clock::time_point{};
+    firstBelow_ = Clock::time_point{};
+    if (!config_.enabled) {
+        setOverloaded(false);
+    }
+}
+
+bool QueueDelayController::admit(Clock::time_point receivedAt, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (receivedAt == Clock::time_point{}) {
+        ++admitted_;
+        return true;
+    }
+    const auto delay = std::chrono::duration_cast<std::chrono::microseconds>(now - receivedAt);
+    lastDelay_ = delay;
+    maxDelay_ = std::max(maxDelay_, delay);
+    if (!config_.enabled) {
+        ++admitted_;
+        return true;
+    }
+
+    bool admitted = true;
+    if (delay <= config_.target) {
+        firstAbove_ = Clock::time_point{};
+        // Under LIFO fresh requests are fast even while old ones still
+        // wait; leave overload only after a whole interval within target
+        if (overloaded_) {
+            if (firstBelow_ == Clock::time_point{}) {
+                firstBelow_ = now;
+            } else if (now - firstBelow_ >= config_.interval) {
+                firstBelow_ = Clock::time_point{};
+                setOverloaded(false);
+            }
+        }
+    } else {
+        firstBelow_ = Clock::time_point{};
+        if (overloaded_) {
+            admitted = false;
+        } else if (firstAbove_ == Clock::time_point{}) {
+            firstAbove_ = now;
+        } else if (now - firstAbove_ >= config_.interval) {
+            // Above target for a whole interval: a standing queue, not a burst
+            ++overloads_;
+            setOverloaded(true);
+            admitted = false;
+        }
+    }
+
+    if (admitted) {
+        ++admitted_;
+    } else {
+        ++dropped_;
+        CPPSWITCHBOARD_PROBE1(request_shed, static_cast<long>(delay.count()));
+    }
+    return admitted;
+}
+
+bool QueueDelayController::isOverloaded() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return overloaded_;
+}
+
+QueueDelayController::Stats QueueDelayController::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.enabled = config_.enabled;
+    stats.overloaded = overloaded_;
+    stats.admitted = admitted_;
+    stats.dropped = dropped_;
+    stats.overloads = overloads_;
+    stats.lastDelay = lastDelay_;
+    stats.maxDelay = maxDelay_;
+    return stats;
+}
+
+void QueueDelayController::setOverloadListener(std::function<void(bool overloaded)> listener) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    listener_ = std::move(listener);
+    if (listener_) {
+        listener_(overloaded_);
+    }
+}
+
+void QueueDelayController::setOverloaded(bool overloaded) {
+    if (overloaded_ == overloaded) {
+        return;
+    }
+    overloaded_ = overloaded;
+    if (listener_) {
+        listener_(overloaded);
+    }
+}
+
+} // namespace cppSwitchboard
@@ -0,0 +1,59 @@
+/**
+ * @file request_arena.cpp
+ * @brief Implementation of the per-connection request arena
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-20
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/request_arena.h>
+#include <algorithm>
+
+namespace cppSwitchboard {
+
+void* RequestArena::OverflowCounter::do_allocate(std::size_t bytes, std::size_t alignment) {
+    ++allocations;
+    cycleBytes += bytes;
+    return upstream_->allocate(bytes, alignment);
+}
+
+void RequestArena::OverflowCounter::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    upstream_->deallocate(p, bytes, alignment);
+}
+
+bool RequestArena::OverflowCounter::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+RequestArena::RequestArena(std::size_t initialSize, std::pmr::memory_resource* upstream)
+    : counter_(upstream), bufferSize_(std::max<std::size_t>(initialSize, 256)) {
+    rebuild();
+}
+
+void RequestArena::reset() {
+    ++resetCount_;
+
+    if (counter_.cycleBytes > 0 && bufferSize_ < MAX_INITIAL_SIZE) {
+        // The last request did not fit; grow so the next one (most likely
+        // of the same shape) is served from the owned buffer.
+        std::size_t wanted = bufferSize_ + counter_.cycleBytes;
+        std::size_t grown = bufferSize_;
+        while (grown < wanted && grown < MAX_INITIAL_SIZE) {
+            grown *= 2;
+        }
+        bufferSize_ = std::min(grown, MAX_INITIAL_SIZE);
+        rebuild();
+    } else {
+        monotonic_->release();
+    }
+
+    counter_.cycleBytes = 0;
+}
+
+void RequestArena::rebuild() {
+    monotonic_.reset();
+    buffer_ = std::make_unique<std::byte[]>(bufferSize_);
+    monotonic_.emplace(buffer_.get(), bufferSize_, &counter_);
+}
+
+} // namespace cppSwitchboard
@@ -5,6 +5,27 @@
 
 namespace cppSwitchboard {
 
+namespace {
+    /// Characters that make a route pattern more than a literal path
+    constexpr const char* PATTERN_SYNTAX = "{}*^$+?()[]|\\";
+    
+    constexpr HttpMethod ALL_METHODS[] = {
+        HttpMethod::GET, HttpMethod::POST, HttpMethod::PUT, HttpMethod::DELETE,
+        HttpMethod::PATCH, HttpMethod::HEAD, HttpMethod::OPTIONS
+    };
+    
+    void fillMatch(RouteMatch& match, const RouteInfo& route, std::map<std::string, std::string>&& pathParams) {
+        match.matched = true;
+        match.pattern = route.pattern;
+        match.pathParams = std::move(pathParams);
+        match.handler = route.handler;
+        match.asyncHandler = route.asyncHandler;
+        match.middlewarePipeline = route.middlewarePipeline;
+        match.isAsync = route.isAsync;
+        match.hasMiddleware = route.hasMiddleware;
+    }
+}
+
 void RouteInfo::compilePattern() {
     // Extract parameter names from pattern like /users/{id}/posts/{postId}
     std::regex paramRegex("\\{([^}]+)\\}");
@@ -15,8 +36,8 @@ void RouteInfo::compilePattern() {
         paramNames.push_back((*iter)[1].str());
     }
     
-    // Convert pattern to regex
-    std::string regexPattern = pattern;
+    // Convert pattern to regex; '.' is a literal dot, as in /favicon.ico
+    std::string regexPattern = std::regex_replace(pattern, std::regex("\\."), "\\.");
     
     // Replace {param} with ([^/]+) for regex matching
     regexPattern = std::regex_replace(regexPattern, std::regex("\\{[^}]+\\}"), "([^/]+)");
@@ -39,17 +60,11 @@ void RouteInfo::compilePattern() {
 }
 
 void RouteRegistry::registerRoute(const std::string& path, HttpMethod method, std::shared_ptr<HttpHandler> handler) {
-    // Remove existing route with same path and method
-    removeRoute(path, method);
-    
-    routes_.emplace_back(path, method, handler);
+    addRoute(RouteInfo(path, method, handler));
 }
 
 void RouteRegistry::registerAsyncRoute(const std::string& path, HttpMethod method, std::shared_ptr<AsyncHttpHandler> handler) {
-    // Remove existing route with same path and method
-    removeRoute(path, method);
-    
-    routes_.emplace_back(path, method, handler);
+    addRoute(RouteInfo(path, method, handler));
 }
 
 void RouteRegistry::registerRouteWithMiddleware(const std::string& path, HttpMethod method, std::shared_ptr<MiddlewarePipeline> pipeline) {
@@ -61,31 +76,66 @@ void RouteRegistry::registerRouteWithMiddleware(const std::string& path, HttpMet
         throw std::runtime_error("Middleware pipeline must have a final handler set before registration");
     }
     
-    // Remove existing route with same path and method
-    removeRoute(path, method);
-    
-    routes_.emplace_back(path, method, pipeline);
+    addRoute(RouteInfo(path, method, pipeline));
 }
 
 RouteMatch RouteRegistry::findRoute(const std::string& path, HttpMethod method) const {
     RouteMatch match;
+    uint32_t methodsSeen = 0;
+    const RouteInfo* headFallback = nullptr;
+    std::map<std::string, std::string> headFallbackParams;
     
-    for (const auto& route : routes_) {
-        if (route.method == method) {
-            std::map<std::string, std::string> pathParams;
-            if (matchPath(route, path, pathParams)) {
-                match.matched = true;
-                match.pathParams = pathParams;
-                match.handler = route.handler;
-                match.asyncHandler = route.asyncHandler;
-                match.middlewarePipeline = route.middlewarePipeline;
-                match.isAsync = route.isAsync;
-                match.hasMiddleware = route.hasMiddleware;
-                break;
+    // Returns true once the route for the method has been found
+    auto consider = [&](const PathEntry& entry, std::map<std::string, std::string>& pathParams) {
+        match.pathMatched = true;
+        for (const auto& route : entry.routes) {
+            methodsSeen |= 1u << static_cast<unsigned>(route.method);
+        }
+        if (const RouteInfo* route = entry.find(method)) {
+            fillMatch(match, *route, std::move(pathParams));
+            return true;
+        }
+        if (method == HttpMethod::HEAD && !headFallback) {
+            headFallback = entry.find(HttpMethod::GET);
+            if (headFallback) {
+                headFallbackParams = pathParams;
             }
         }
+        return false;
+    };
+    
+    auto literal = literalPaths_.find(path);
+    if (literal != literalPaths_.end()) {
+        std::map<std::string, std::string> pathParams;
+        if (consider(paths_[literal->second], pathParams)) {
+            return match;
+        }
+    }
+    
+    for (const auto& entry : paths_) {
+        if (entry.literal) {
+            continue;
+        }
+        std::map<std::string, std::string> pathParams;
+        if (matchPath(entry.routes.front(), path, pathParams) && consider(entry, pathParams)) {
+            return match;
+        }
     }
     
+    if (headFallback) {
+        fillMatch(match, *headFallback, std::move(headFallbackParams));
+        return match;
+    }
+    
+    if (match.pathMatched) {
+        for (HttpMethod m : ALL_METHODS) {
+            const bool implicit = m == HttpMethod::OPTIONS ||
+                                  (m == HttpMethod::HEAD && (methodsSeen & (1u << static_cast<unsigned>(HttpMethod::GET))));
+            if (implicit || (methodsSeen & (1u << static_cast<unsigned>(m)))) {
+                match.allowedMethods.push_back(m);
+            }
+        }
+    }
     return match;
 }
 
@@ -97,22 +147,88 @@ bool RouteRegistry::hasRoute(const std::string& path, HttpMethod method) const {
     return findRoute(path, method).matched;
 }
 
+std::vector<RouteInfo> RouteRegistry::getAllRoutes() const {
+    std::vector<RouteInfo> routes;
+    for (const auto& entry : paths_) {
+        routes.insert(routes.end(), entry.routes.begin(), entry.routes.end());
+    }
+    return routes;
+}
+
 void RouteRegistry::removeRoute(const std::string& path, HttpMethod method) {
-    routes_.erase(
-        std::remove_if(routes_.begin(), routes_.end(),
+    auto entry = std::find_if(paths_.begin(), paths_.end(),
+                              [&](const PathEntry& e) { return e.pattern == path; });
+    if (entry == paths_.end()) {
+        return;
+    }
+    entry->routes.erase(
+        std::remove_if(entry->routes.begin(), entry->routes.end(),
             [&](const RouteInfo& route) {
-                return route.pattern == path && route.method == method;
+                return route.method == method;
             }),
-        routes_.end()
+        entry->routes.end()
     );
+    if (entry->routes.empty()) {
+        paths_.erase(entry);
+        rebuildLiteralIndex();
+    }
 }
 
 void RouteRegistry::clear() {
-    routes_.clear();
+    paths_.clear();
+    literalPaths_.clear();
+}
+
+void RouteRegistry::addRoute(RouteInfo route) {
+    // Replace an existing route with the same path and method
+    removeRoute(route.pattern, route.method);
+    
+    auto entry = std::find_if(paths_.begin(), paths_.end(),
+                              [&](const PathEntry& e) { return e.pattern == route.pattern; });
+    if (entry == paths_.end()) {
+        PathEntry created;
+        created.pattern = route.pattern;
+        created.literal = route.pattern.find_first_of(PATTERN_SYNTAX) == std::string::npos;
+        if (created.literal) {
+            literalPaths_[created.pattern] = paths_.size();
+        }
+        paths_.push_back(std::move(created));
+        entry = paths_.end() - 1;
+    }
+    entry->routes.push_back(std::move(route));
+}
+
+void RouteRegistry::rebuildLiteralIndex() {
+    literalPaths_.clear();
+    for (size_t i = 0; i < paths_.size(); ++i) {
+        if (paths_[i].literal) {
+            literalPaths_[paths_[i].pattern] = i;
+        }
+    }
+}
+
+const RouteInfo* RouteRegistry::PathEntry::find(HttpMethod method) const {
+    for (const auto& route : routes) {
+        if (route.method == method) {
+            return &route;
+        }
+    }
+    return nullptr;
+}
+
+std::string RouteMatch::allowHeader() const {
+    std::string allow;
+    for (HttpMethod method : allowedMethods) {
+        if (!allow.empty()) {
+            allow += ", ";
+        }
+        allow += HttpRequest::methodToString(method);
+    }
+    return allow;
 }
 
 std::string RouteRegistry::pathToRegex(const std::string& path, std::vector<std::string>& paramNames) const {
-    std::string regexPattern = path;
+    std::string regexPattern = std::regex_replace(path, std::regex("\\."), "\\.");
     
     // Extract parameter names
     std::regex paramRegex("\\{([^}]+)\\}");
@@ -0,0 +1,179 @@
+/**
+ * @file session_memory_pool.cpp
+ * @brief Implementation of the per-session memory pool
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-21
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/session_memory_pool.h>
+#include <cppSwitchboard/buffer_pool.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+
+namespace cppSwitchboard {
+
+SessionMemoryPool::~SessionMemoryPool() {
+    // Bulk release: whatever the session did not free itself goes away here
+    for (uint8_t* chunk : chunks_) {
+        BufferPool::getInstance().deallocate(chunk, CHUNK_SIZE);
+    }
+
+    LargeLink* link = largeBlocks_;
+    while (link) {
+        LargeLink* next = link->next;
+        std::free(link);
+        link = next;
+    }
+}
+
+int SessionMemoryPool::classIndex(std::size_t size) noexcept {
+    for (std::size_t i = 0; i < SIZE_CLASSES.size(); ++i) {
+        if (size <= SIZE_CLASSES[i]) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void* SessionMemoryPool::allocate(std::size_t size) noexcept {
+    int index = classIndex(size);
+    void* p = index >= 0 ? allocateSmall(index) : allocateLarge(size);
+    if (p) {
+        ++liveBlocks_;
+    }
+    return p;
+}
+
+void* SessionMemoryPool::allocateSmall(int index) noexcept {
+    FreeBlock*& freeList = freeLists_[static_cast<std::size_t>(index)];
+    if (freeList) {
+        FreeBlock* block = freeList;
+        freeList = block->next;
+        ++reusedBlocks_;
+        return block;
+    }
+
+    const std::size_t capacity = SIZE_CLASSES[static_cast<std::size_t>(index)];
+    const std::size_t needed = sizeof(BlockHeader) + capacity;
+
+    if (static_cast<std::size_t>(chunkEnd_ - cursor_) < needed) {
+        uint8_t* chunk = nullptr;
+        try {
+            chunks_.reserve(chunks_.size() + 1);
+            chunk = static_cast<uint8_t*>(BufferPool::getInstance().allocate(CHUNK_SIZE));
+        } catch (const std::bad_alloc&) {
+            return nullptr;
+        }
+        chunks_.push_back(chunk);
+        cursor_ = chunk;
+        chunkEnd_ = chunk + CHUNK_SIZE;
+    }
+
+    auto* header = reinterpret_cast<BlockHeader*>(cursor_);
+    header->capacity = capacity;
+    cursor_ += needed;
+    return header + 1;
+}
+
+void* SessionMemoryPool::allocateLarge(std::size_t size) noexcept {
+    if (size > std::numeric_limits<std::size_t>::max() - sizeof(LargeLink) - sizeof(BlockHeader)) {
+        return nullptr;
+    }
+
+    void* raw = std::malloc(sizeof(LargeLink) + sizeof(BlockHeader) + size);
+    if (!raw) {
+        return nullptr;
+    }
+
+    auto* link = static_cast<LargeLink*>(raw);
+    link->prev = nullptr;
+    link->next = largeBlocks_;
+    if (largeBlocks_) {
+        largeBlocks_->prev = link;
+    }
+    largeBlocks_ = link;
+
+    auto* header = reinterpret_cast<BlockHeader*>(link + 1);
+    header->capacity = size;
+    ++largeCount_;
+    largeBytes_ += size;
+    return header + 1;
+}
+
+void* SessionMemoryPool::callocate(std::size_t count, std::size_t size) noexcept {
+    if (size != 0 && count > std::numeric_limits<std::size_t>::max() / size) {
+        return nullptr;
+    }
+    void* p = allocate(count * size);
+    if (p) {
+        std::memset(p, 0, count * size);
+    }
+    return p;
+}
+
+void* SessionMemoryPool::reallocate(void* p, std::size_t size) noexcept {
+    if (!p) {
+        return allocate(size);
+    }
+    if (size == 0) {
+        deallocate(p);
+        return nullptr;
+    }
+
+    const std::size_t capacity = (static_cast<BlockHeader*>(p) - 1)->capacity;
+    if (size <= capacity && (capacity <= MAX_SMALL_SIZE || size > MAX_SMALL_SIZE)) {
+        return p;
+    }
+
+    void* resized = allocate(size);
+    if (resized) {
+        std::memcpy(resized, p, std::min(size, capacity));
+        deallocate(p);
+    }
+    return resized;
+}
+
+void SessionMemoryPool::deallocate(void* p) noexcept {
+    if (!p) {
+        return;
+    }
+    --liveBlocks_;
+
+    auto* header = static_cast<BlockHeader*>(p) - 1;
+    int index = header->capacity <= MAX_SMALL_SIZE ? classIndex(header->capacity) : -1;
+    if (index >= 0 && SIZE_CLASSES[static_cast<std::size_t>(index)] == header->capacity) {
+        auto* block = static_cast<FreeBlock*>(p);
+        block->next = freeLists_[static_cast<std::size_t>(index)];
+        freeLists_[static_cast<std::size_t>(index)] = block;
+        return;
+    }
+
+    auto* link = reinterpret_cast<LargeLink*>(header) - 1;
+    if (link->prev) {
+        link->prev->next = link->next;
+    } else {
+        largeBlocks_ = link->next;
+    }
+    if (link->next) {
+        link->next->prev = link->prev;
+    }
+    --largeCount_;
+    largeBytes_ -= header->capacity;
+    std::free(link);
+}
+
+std::unordered_map<std::string, std::size_t> SessionMemoryPool::getStatistics() const {
+    return {
+        {"chunks", chunks_.size()},
+        {"reserved_bytes", chunks_.size() * CHUNK_SIZE + largeBytes_},
+        {"live_blocks", liveBlocks_},
+        {"large_blocks", largeCount_},
+        {"reused_blocks", reusedBlocks_}
+    };
+}
+
+} // namespace cppSwitchboard
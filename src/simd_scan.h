@@ -0,0 +1,85 @@
+/**
+ * @file simd_scan.h
+ * @brief Vectorized byte scanning helpers (private)
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-22
+ * @version 1.2.0
+ *
+ * Small building blocks for hot parsing loops. With SSE2 (every x86-64
+ * target) 16 bytes are compared per step; other targets use the scalar
+ * loop.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define CPPSWITCHBOARD_HAVE_SSE2 1
+#endif
+
+namespace cppSwitchboard {
+namespace simd {
+
+/**
+ * @brief Find the first byte equal to @p a or @p b
+ * @return Pointer to the match, or @p end when there is none
+ */
+inline const char* findFirstOf(const char* begin, const char* end, char a, char b) noexcept {
+    const char* p = begin;
+#if defined(CPPSWITCHBOARD_HAVE_SSE2)
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    while (end - p >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb)));
+        if (mask != 0) {
+            return p + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+        p += 16;
+    }
+#endif
+    for (; p < end; ++p) {
+        if (*p == a || *p == b) {
+            return p;
+        }
+    }
+    return end;
+}
+
+/**
+ * @brief Find the first byte that must be escaped in a JSON string
+ *        ('"', '\\' or a control character below 0x20)
+ * @return Pointer to the match, or @p end when there is none
+ */
+inline const char* findJsonSpecial(const char* begin, const char* end) noexcept {
+    const char* p = begin;
+#if defined(CPPSWITCHBOARD_HAVE_SSE2)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+    while (end - p >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        // Unsigned c <= 0x1F  <=>  max(c, 0x1F) == 0x1F
+        __m128i special = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+            _mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control));
+        int mask = _mm_movemask_epi8(special);
+        if (mask != 0) {
+            return p + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+        p += 16;
+    }
+#endif
+    for (; p < end; ++p) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\' || c < 0x20) {
+            return p;
+        }
+    }
+    return end;
+}
+
+} // namespace simd
+} // namespace cppSwitchboard
@@ -0,0 +1,56 @@
+/**
+ * @file usdt_probes.h
+ * @brief USDT (user-level statically defined tracing) probe macros
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-20
+ * @version 1.2.0
+ *
+ * Internal header that defines the static tracepoints fired along the
+ * request hot path. Probes are only compiled in when the library is built
+ * with `-DENABLE_USDT_PROBES=ON` and `<sys/sdt.h>` is available; otherwise
+ * every macro expands to an empty statement and its arguments are never
+ * evaluated, so disabled builds pay nothing.
+ *
+ * When enabled, each probe is a single `nop` in the instruction stream plus
+ * an ELF note, so the cost stays negligible until a tracer attaches:
+ *
+ * @code{.sh}
+ * bpftrace -e 'usdt:./libcppSwitchboard.so:cppswitchboard:route_matched
+ *              { @[str(arg2)] = count(); }'
+ * @endcode
+ *
+ * Probe provider is `cppswitchboard`; the probe list and argument layout
+ * are documented in docs/markdown/PERFORMANCE.md. A probe's arguments mean
+ * the same thing at every site that fires it, and a request fires it once:
+ * `handler_done` (route pattern, status) fires only in
+ * HttpServer::routeRequest(), not again in MiddlewarePipeline.
+ */
+
+#pragma once
+
+#if defined(CPPSWITCHBOARD_ENABLE_USDT) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define CPPSWITCHBOARD_USDT_AVAILABLE 1
+#endif
+#endif
+
+#ifdef CPPSWITCHBOARD_USDT_AVAILABLE
+
+#define CPPSWITCHBOARD_PROBE1(name, a1) \
+    DTRACE_PROBE1(cppswitchboard, name, a1)
+#define CPPSWITCHBOARD_PROBE2(name, a1, a2) \
+    DTRACE_PROBE2(cppswitchboard, name, a1, a2)
+#define CPPSWITCHBOARD_PROBE3(name, a1, a2, a3) \
+    DTRACE_PROBE3(cppswitchboard, name, a1, a2, a3)
+#define CPPSWITCHBOARD_PROBE4(name, a1, a2, a3, a4) \
+    DTRACE_PROBE4(cppswitchboard, name, a1, a2, a3, a4)
+
+#else
+
+#define CPPSWITCHBOARD_PROBE1(name, a1) do {} while (0)
+#define CPPSWITCHBOARD_PROBE2(name, a1, a2) do {} while (0)
+#define CPPSWITCHBOARD_PROBE3(name, a1, a2, a3) do {} while (0)
+#define CPPSWITCHBOARD_PROBE4(name, a1, a2, a3, a4) do {} while (0)
+
+#endif
@@ -0,0 +1,133 @@
+/**
+ * @file virtual_host.cpp
+ * @brief Implementation of host based route table selection
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-25
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/virtual_host.h>
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+namespace cppSwitchboard {
+
+// VirtualHost implementation
+
+VirtualHost::VirtualHost(std::string pattern)
+    : pattern_(std::move(pattern)), routes_(std::make_unique<RouteRegistry>()) {}
+
+void VirtualHost::registerHandler(const std::string& path, HttpMethod method, std::shared_ptr<HttpHandler> handler) {
+    routes_->registerRoute(path, method, handler);
+}
+
+void VirtualHost::registerAsyncHandler(const std::string& path, HttpMethod method, std::shared_ptr<AsyncHttpHandler> handler) {
+    routes_->registerAsyncRoute(path, method, handler);
+}
+
+void VirtualHost::registerRouteWithMiddleware(const std::string& path, HttpMethod method, std::shared_ptr<MiddlewarePipeline> pipeline) {
+    routes_->registerRouteWithMiddleware(path, method, pipeline);
+}
+
+void VirtualHost::get(const std::string& path, std::function<HttpResponse(const HttpRequest&)> handler) {
+    registerHandler(path, HttpMethod::GET, makeHandler(handler));
+}
+
+void VirtualHost::post(const std::string& path, std::function<HttpResponse(const HttpRequest&)> handler) {
+    registerHandler(path, HttpMethod::POST, makeHandler(handler));
+}
+
+void VirtualHost::put(const std::string& path, std::function<HttpResponse(const HttpRequest&)> handler) {
+    registerHandler(path, HttpMethod::PUT, makeHandler(handler));
+}
+
+void VirtualHost::del(const std::string& path, std::function<HttpResponse(const HttpRequest&)> handler) {
+    registerHandler(path, HttpMethod::DELETE, makeHandler(handler));
+}
+
+void VirtualHost::registerMiddleware(std::shared_ptr<Middleware> middleware) {
+    if (!middleware) {
+        throw std::invalid_argument("Middleware cannot be null");
+    }
+    // Kept sorted on insertion; equal priorities run in registration order
+    auto position = std::upper_bound(middleware_.begin(), middleware_.end(), middleware,
+        [](const std::shared_ptr<Middleware>& a, const std::shared_ptr<Middleware>& b) {
+            return a->getPriority() > b->getPriority();
+        });
+    middleware_.insert(position, std::move(middleware));
+}
+
+// VirtualHostRouter implementation
+
+std::shared_ptr<VirtualHost> VirtualHostRouter::addHost(const std::string& pattern) {
+    std::string name = normalize(pattern);
+    const bool wildcard = name.size() > 2 && name.compare(0, 2, "*.") == 0;
+    if (name.empty() || name.find('*', wildcard ? 1 : 0) != std::string::npos) {
+        throw std::invalid_argument("Invalid virtual host pattern: " + pattern);
+    }
+
+    if (wildcard) {
+        auto& host = wildcards_[name.substr(1)];
+        if (!host) {
+            host = std::make_shared<VirtualHost>(name);
+        }
+        return host;
+    }
+
+    auto& host = exact_[name];
+    if (!host) {
+        host = std::make_shared<VirtualHost>(name);
+    }
+    return host;
+}
+
+std::shared_ptr<VirtualHost> VirtualHostRouter::findHost(std::string_view host) const {
+    if (empty() || host.empty()) {
+        return nullptr;
+    }
+
+    const std::string name = normalize(host);
+    auto exact = exact_.find(name);
+    if (exact != exact_.end()) {
+        return exact->second;
+    }
+
+    if (!wildcards_.empty()) {
+        // ".b.example.com", then ".example.com", then ".com"
+        std::string_view suffix(name);
+        for (size_t dot = suffix.find('.'); dot != std::string_view::npos; dot = suffix.find('.', 1)) {
+            suffix.remove_prefix(dot);
+            auto wildcard = wildcards_.find(suffix);
+            if (wildcard != wildcards_.end()) {
+                return wildcard->second;
+            }
+        }
+    }
+    return nullptr;
+}
+
+std::string VirtualHostRouter::normalize(std::string_view host) {
+    // Strip the port: "[::1]:8443" keeps the brackets, "example.com:80" loses ":80"
+    if (!host.empty() && host.front() == '[') {
+        size_t close = host.find(']');
+        if (close != std::string_view::npos) {
+            host = host.substr(0, close + 1);
+        }
+    } else {
+        size_t colon = host.find(':');
+        if (colon != std::string_view::npos && host.find(':', colon + 1) == std::string_view::npos) {
+            host = host.substr(0, colon);
+        }
+    }
+    while (!host.empty() && host.back() == '.') {
+        host.remove_suffix(1);
+    }
+
+    std::string name(host);
+    std::transform(name.begin(), name.end(), name.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return name;
+}
+
+} // namespace cppSwitchboard
@@ -0,0 +1,371 @@
+/**
+ * @file worker_pool.cpp
+ * @brief Implementation of the work-stealing thread pool
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ */
+
+#include <cppSwitchboard/worker_pool.h>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace cppSwitchboard {
+
+namespace {
+    thread_local WorkerPool* currentPool = nullptr;
+    thread_local size_t currentWorker = 0;
+
+    // Every this many tasks a worker looks at the injection queue before its
+    // own deque, so a worker that keeps feeding itself cannot starve it
+    constexpr uint32_t INJECTION_CHECK_INTERVAL = 61;
+
+    // Upper bound of a parked worker's sleep; it looks for work again after
+    constexpr std::chrono::milliseconds PARK_INTERVAL{100};
+
+    /**
+     * Chase-Lev deque with the memory orderings of Lê et al., "Correct and
+     * Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013). The owner
+     * pushes and pops at the bottom; thieves take from the top. A buffer
+     * that was outgrown is kept until the deque is destroyed, since a thief
+     * may still be reading from it.
+     */
+    class TaskDeque {
+    public:
+        using Task = WorkerPool::Task;
+
+        TaskDeque() {
+            buffers_.push_back(std::make_unique<Buffer>(INITIAL_CAPACITY));
+            buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+        }
+
+        /// Owner only
+        void push(Task* task) {
+            const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+            const int64_t top = top_.load(std::memory_order_acquire);
+            Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+            if (bottom - top > buffer->capacity - 1) {
+                buffer = grow(buffer, top, bottom);
+            }
+            buffer->put(bottom, task);
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        /// Owner only; nullptr if empty
+        Task* pop() {
+            const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+            Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+            bottom_.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = top_.load(std::memory_order_relaxed);
+
+            if (top > bottom) {
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            Task* task = buffer->get(bottom);
+            if (top == bottom) {
+                // Last task: a thief may be taking it at the same time
+                if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed)) {
+                    task = nullptr;
+                }
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return task;
+        }
+
+        /// Any thread; nullptr if empty or another thread won the task
+        Task* steal() {
+            int64_t top = top_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t bottom = bottom_.load(std::memory_order_acquire);
+            if (top >= bottom) {
+                return nullptr;
+            }
+            Task* task = buffer_.load(std::memory_order_acquire)->get(top);
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            return task;
+        }
+
+        size_t size() const {
+            const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+            const int64_t top = top_.load(std::memory_order_relaxed);
+            return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+        }
+
+    private:
+        static constexpr int64_t INITIAL_CAPACITY = 64;
+
+        struct Buffer {
+            explicit Buffer(int64_t size)
+                : capacity(size), slots(new std::atomic<Task*>[static_cast<size_t>(size)]) {}
+
+            Task* get(int64_t index) const {
+                return slots[static_cast<size_t>(index & (capacity - 1))].load(std::memory_order_relaxed);
+            }
+            void put(int64_t index, Task* task) {
+                slots[static_cast<size_t>(index & (capacity - 1))].store(task, std::memory_order_relaxed);
+            }
+
+            const int64_t capacity;  ///< Power of two
+            std::unique_ptr<std::atomic<Task*>[]> slots;
+        };
+
+        Buffer* grow(Buffer* buffer, int64_t top, int64_t bottom) {
+            buffers_.push_back(std::make_unique<Buffer>(buffer->capacity * 2));
+            Buffer* larger = buffers_.back().get();
+            for (int64_t index = top; index < bottom; ++index) {
+                larger->put(index, buffer->get(index));
+            }
+            buffer_.store(larger, std::memory_order_release);
+            return larger;
+        }
+
+        alignas(64) std::atomic<int64_t> top_{0};
+        alignas(64) std::atomic<int64_t> bottom_{0};
+        std::atomic<Buffer*> buffer_{nullptr};
+        std::vector<std::unique_ptr<Buffer>> buffers_;  ///< Current buffer last; touched by the owner only
+    };
+}
+
+struct WorkerPool::Worker {
+    TaskDeque deque;
+    std::thread thread;
+    std::atomic<uint64_t> executed{0};
+    std::atomic<uint64_t> steals{0};
+    uint32_t victimSeed = 1;  ///< xorshift state picking the first worker to steal from
+    uint32_t ticks = 0;       ///< Tasks looked for; drives INJECTION_CHECK_INTERVAL
+};
+
+WorkerPool::WorkerPool(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = resolveThreadCount(0);
+    }
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+        workers_.back()->victimSeed = static_cast<uint32_t>(i * 2654435761u + 1);
+    }
+    // Every deque exists before the first worker can try to steal
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers_[i]->thread = std::thread([this, i]() { workerLoop(i); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    shutdown();
+}
+
+bool WorkerPool::submit(Task task) {
+    if (!task) {
+        return false;
+    }
+    const bool fromWorker = currentPool == this;
+    // Continuations of running tasks are still accepted while draining
+    if (!fromWorker && stopping_.load()) {
+        return false;
+    }
+
+    // Counted before it is visible, so a thief cannot take it first and
+    // leave the counter below zero
+    pending_.fetch_add(1);
+    auto* queued = new Task(std::move(task));
+    if (fromWorker) {
+        workers_[currentWorker]->deque.push(queued);
+    } else {
+        std::lock_guard<std::mutex> lock(injectionMutex_);
+        injected_.push_back(queued);
+    }
+
+    // Pairs with the sleepers_ increment in workerLoop: either this thread
+    // sees the sleeper, or the sleeper sees pending_ before it parks
+    if (sleepers_.load() > 0) {
+        std::lock_guard<std::mutex> lock(parkMutex_);
+        parkCondition_.notify_one();
+    }
+    return true;
+}
+
+bool WorkerPool::tryRunOne() {
+    Worker* self = currentPool == this ? workers_[currentWorker].get() : nullptr;
+    Task* task = findTask(self);
+    if (!task) {
+        return false;
+    }
+    run(task, self);
+    return true;
+}
+
+bool WorkerPool::tryRunLocal(size_t floor) {
+    if (currentPool != this) {
+        return false;
+    }
+    // Tasks above the floor are the newest, and pop() takes the newest, so
+    // this never reaches below it even when thieves took older ones
+    Worker* self = workers_[currentWorker].get();
+    if (self->deque.size() <= floor) {
+        return false;
+    }
+    Task* task = self->deque.pop();
+    if (!task) {
+        return false;
+    }
+    pending_.fetch_sub(1);
+    run(task, self);
+    return true;
+}
+
+size_t WorkerPool::getLocalDepth() const {
+    return currentPool == this ? workers_[currentWorker]->deque.size() : 0;
+}
+
+void WorkerPool::shutdown() {
+    if (currentPool == this) {
+        throw std::logic_error("WorkerPool::shutdown() called from one of its workers");
+    }
+    std::lock_guard<std::mutex> guard(shutdownMutex_);
+    {
+        std::lock_guard<std::mutex> lock(parkMutex_);
+        stopping_ = true;
+    }
+    parkCondition_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+    // Tasks submitted while the last worker was exiting
+    while (tryRunOne()) {
+    }
+}
+
+std::vector<WorkerPool::WorkerStats> WorkerPool::getWorkerStats() const {
+    std::vector<WorkerStats> stats;
+    stats.reserve(workers_.size());
+    for (const auto& worker : workers_) {
+        WorkerStats entry;
+        entry.queueDepth = worker->deque.size();
+        entry.executed = worker->executed.load(std::memory_order_relaxed);
+        entry.steals = worker->steals.load(std::memory_order_relaxed);
+        stats.push_back(entry);
+    }
+    return stats;
+}
+
+size_t WorkerPool::getInjectionQueueDepth() const {
+    std::lock_guard<std::mutex> lock(injectionMutex_);
+    return injected_.size();
+}
+
+WorkerPool* WorkerPool::current() {
+    return currentPool;
+}
+
+size_t WorkerPool::resolveThreadCount(int configured) {
+    if (configured > 0) {
+        return static_cast<size_t>(configured);
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void WorkerPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentWorker = index;
+    Worker* self = workers_[index].get();
+
+    while (true) {
+        if (Task* task = findTask(self)) {
+            run(task, self);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(parkMutex_);
+        sleepers_.fetch_add(1);
+        parkCondition_.wait_for(lock, PARK_INTERVAL, [this]() { return pending_.load() > 0 || stopping_.load(); });
+        sleepers_.fetch_sub(1);
+        if (stopping_.load() && pending_.load() == 0) {
+            break;
+        }
+    }
+    currentPool = nullptr;
+}
+
+WorkerPool::Task* WorkerPool::findTask(Worker* self) {
+    if (self && ++self->ticks % INJECTION_CHECK_INTERVAL == 0) {
+        if (Task* task = popInjected()) {
+            return task;
+        }
+    }
+    if (self) {
+        if (Task* task = self->deque.pop()) {
+            pending_.fetch_sub(1);
+            return task;
+        }
+    }
+    if (Task* task = popInjected()) {
+        return task;
+    }
+    return steal(self);
+}
+
+WorkerPool::Task* WorkerPool::popInjected() {
+    std::lock_guard<std::mutex> lock(injectionMutex_);
+    if (injected_.empty()) {
+        return nullptr;
+    }
+    Task* task;
+    if (lifo_.load(std::memory_order_relaxed)) {
+        task = injected_.back();
+        injected_.pop_back();
+    } else {
+        task = injected_.front();
+        injected_.pop_front();
+    }
+    pending_.fetch_sub(1);
+    return task;
+}
+
+WorkerPool::Task* WorkerPool::steal(Worker* thief) {
+    size_t start = 0;
+    if (thief) {
+        uint32_t& seed = thief->victimSeed;
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        start = seed % workers_.size();
+    }
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        Worker* victim = workers_[(start + i) % workers_.size()].get();
+        if (victim == thief) {
+            continue;
+        }
+        if (Task* task = victim->deque.steal()) {
+            pending_.fetch_sub(1);
+            if (thief) {
+                thief->steals.fetch_add(1, std::memory_order_relaxed);
+            }
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void WorkerPool::run(Task* task, Worker* self) {
+    std::unique_ptr<Task> owned(task);
+    try {
+        (*owned)();
+    } catch (...) {
+        // A throwing task must not take its worker down
+    }
+    if (self) {
+        self->executed.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace cppSwitchboard
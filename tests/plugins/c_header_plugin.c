@@ -0,0 +1,85 @@
+/**
+ * @file c_header_plugin.c
+ * @brief C ABI middleware plugin used by the plugin tests
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ *
+ * Written in C to keep the ABI header honest. Requests carrying X-Block are
+ * answered with 403; other responses get a configured header, and the hook
+ * leaves a context value for the handler chain.
+ */
+
+#include <cppSwitchboard/plugin_c_abi.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct header_instance {
+    char name[64];
+    char value[64];
+} header_instance;
+
+static int equals(cppSwitchboard_str str, const char* text) {
+    return str.size == strlen(text) && memcmp(str.data, text, str.size) == 0;
+}
+
+static void copy(char* target, size_t capacity, cppSwitchboard_str str) {
+    size_t size = str.size < capacity - 1 ? str.size : capacity - 1;
+    memcpy(target, str.data, size);
+    target[size] = '\0';
+}
+
+static cppSwitchboard_str text(const char* value) {
+    cppSwitchboard_str str = {value, strlen(value)};
+    return str;
+}
+
+static void* create(const cppSwitchboard_config_entry* entries, size_t count) {
+    header_instance* instance = calloc(1, sizeof(header_instance));
+    size_t i;
+    if (!instance) {
+        return NULL;
+    }
+    for (i = 0; i < count; ++i) {
+        if (equals(entries[i].key, "header")) {
+            copy(instance->name, sizeof(instance->name), entries[i].value);
+        } else if (equals(entries[i].key, "value")) {
+            copy(instance->value, sizeof(instance->value), entries[i].value);
+        }
+    }
+    return instance;
+}
+
+static void destroy(void* instance) {
+    free(instance);
+}
+
+static int on_request(void* instance, const cppSwitchboard_host_api* host, const cppSwitchboard_request_view* request,
+                      cppSwitchboard_context* context, cppSwitchboard_response* response) {
+    cppSwitchboard_str value;
+    (void)instance;
+    if (host->request_header(request->request, text("x-block"), &value)) {
+        host->response_set_status(response, 403);
+        host->response_set_body(response, text("blocked"));
+        return CPPSWITCH_C_RESPOND;
+    }
+    host->context_set(context, text("c_plugin.path"), request->path);
+    return CPPSWITCH_C_CONTINUE;
+}
+
+static void on_response(void* instance, const cppSwitchboard_host_api* host, const cppSwitchboard_request_view* request,
+                        cppSwitchboard_context* context, cppSwitchboard_response* response) {
+    const header_instance* header = instance;
+    (void)request;
+    (void)context;
+    host->response_set_header(response, text(header->name), text(header->value));
+}
+
+static const cppSwitchboard_c_middleware middleware[] = {
+    {"c_header", 50, create, destroy, on_request, on_response}
+};
+
+CPPSWITCH_PLUGIN_EXPORT const cppSwitchboard_c_plugin cppSwitchboard_c_plugin_info = {
+    CPPSWITCH_C_ABI_VERSION, "CHeaderPlugin", "Sets a header from C", "Test Suite",
+    {1, 0, 0}, {1, 2, 0}, middleware, 1, NULL, NULL
+};
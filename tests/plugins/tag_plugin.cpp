@@ -0,0 +1,75 @@
+/**
+ * @file tag_plugin.cpp
+ * @brief Minimal middleware plugin used by the plugin hot-reload tests
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-26
+ * @version 1.2.0
+ *
+ * Built once per TAG_PLUGIN_VALUE. The middleware sets X-Plugin-Tag to that
+ * value, which tells the tests which generation of the plugin served a request.
+ * With TAG_PLUGIN_DEPENDENCY defined the build is a separate plugin,
+ * "DependentTagPlugin", requiring the named plugin.
+ */
+
+#include <cppSwitchboard/middleware_plugin.h>
+
+using namespace cppSwitchboard;
+
+#ifdef TAG_PLUGIN_DEPENDENCY
+#define TAG_PLUGIN_NAME "DependentTagPlugin"
+#define TAG_PLUGIN_TYPE "plugin_tag_dependent"
+static const PluginDependency tagPluginDependencies[] = {{TAG_PLUGIN_DEPENDENCY, {1, 0, 0}, false}};
+#define TAG_PLUGIN_DEPENDENCIES tagPluginDependencies, 1
+#else
+#define TAG_PLUGIN_NAME "TagPlugin"
+#define TAG_PLUGIN_TYPE "plugin_tag"
+#define TAG_PLUGIN_DEPENDENCIES nullptr, 0
+#endif
+
+namespace {
+
+class TagMiddleware : public Middleware {
+public:
+    HttpResponse handle(const HttpRequest& request, Context& context, NextHandler next) override {
+        HttpResponse response = next(request, context);
+        response.setHeader("X-Plugin-Tag", TAG_PLUGIN_VALUE);
+        return response;
+    }
+
+    std::string getName() const override { return "PluginTag"; }
+};
+
+class TagPlugin : public MiddlewarePlugin {
+public:
+    bool initialize(const PluginVersion&) override { return true; }
+    void shutdown() override {}
+
+    std::shared_ptr<Middleware> createMiddleware(const MiddlewareInstanceConfig&) override {
+        return std::make_shared<TagMiddleware>();
+    }
+
+    bool validateConfig(const MiddlewareInstanceConfig&, std::string&) const override { return true; }
+    std::vector<std::string> getSupportedTypes() const override { return {TAG_PLUGIN_TYPE}; }
+    const MiddlewarePluginInfo& getInfo() const override;
+};
+
+} // namespace
+
+extern "C" {
+    CPPSWITCH_PLUGIN_EXPORT MiddlewarePluginInfo cppSwitchboard_plugin_info = {
+        CPPSWITCH_PLUGIN_VERSION, TAG_PLUGIN_NAME, "Tags responses with the plugin build", "Test Suite",
+        {1, 0, 0}, {1, 2, 0}, TAG_PLUGIN_DEPENDENCIES
+    };
+
+    CPPSWITCH_PLUGIN_EXPORT MiddlewarePlugin* cppSwitchboard_create_plugin() {
+        return new TagPlugin();
+    }
+
+    CPPSWITCH_PLUGIN_EXPORT void cppSwitchboard_destroy_plugin(MiddlewarePlugin* plugin) {
+        delete plugin;
+    }
+}
+
+const MiddlewarePluginInfo& TagPlugin::getInfo() const {
+    return cppSwitchboard_plugin_info;
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <cppSwitchboard/body_buffer.h>
+#include <cppSwitchboard/http_request.h>
+#include <cppSwitchboard/http_response.h>
+#include <string>
+#include <vector>
+
+using namespace cppSwitchboard;
+
+TEST(BodyBufferTest, TakesOwnershipWithoutCopy) {
+    std::string payload(4096, 'x');
+    const char* original = payload.data();
+
+    BodyBuffer body(std::move(payload));
+    EXPECT_EQ(body.data(), original);
+    EXPECT_EQ(body.size(), 4096u);
+    EXPECT_EQ(body.useCount(), 1);
+
+    BodyBuffer shared = body;
+    EXPECT_EQ(shared.data(), original);
+    EXPECT_EQ(body.useCount(), 2);
+}
+
+TEST(BodyBufferTest, StaticAndEmptyBuffers) {
+    BodyBuffer empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.view(), "");
+    EXPECT_EQ(empty.useCount(), 0);
+
+    static const char text[] = "Service ready";
+    BodyBuffer banner = BodyBuffer::fromStatic(text);
+    EXPECT_EQ(banner.data(), text);
+    EXPECT_EQ(banner, "Service ready");
+    EXPECT_EQ(banner.useCount(), 0);
+}
+
+TEST(BodyBufferTest, SlicesShareStorage) {
+    BodyBuffer body(std::string("Hello, World!"));
+    BodyBuffer world = body.slice(7, 5);
+    EXPECT_EQ(world, "World");
+    EXPECT_EQ(world.data(), body.data() + 7);
+    EXPECT_EQ(body.useCount(), 2);
+
+    EXPECT_EQ(body.slice(7), "World!");
+    EXPECT_TRUE(body.slice(100).empty());
+}
+
+TEST(BodyBufferTest, ReleaseMovesWhenUnique) {
+    std::string payload(1024, 'y');
+    const char* original = payload.data();
+    BodyBuffer body(std::move(payload));
+
+    std::string out = body.release();
+    EXPECT_EQ(out.data(), original);
+    EXPECT_TRUE(body.empty());
+
+    BodyBuffer first(std::move(out));
+    BodyBuffer second = first;
+    std::string copy = first.release();
+    EXPECT_NE(copy.data(), second.data());
+    EXPECT_EQ(copy, second.view());
+}
+
+TEST(BodyBufferTest, VectorStorage) {
+    std::vector<uint8_t> bytes = {0x00, 0xFF, 0x10};
+    const uint8_t* original = bytes.data();
+    BodyBuffer body(std::move(bytes));
+    EXPECT_EQ(reinterpret_cast<const uint8_t*>(body.data()), original);
+    EXPECT_EQ(body.size(), 3u);
+    EXPECT_EQ(body.release(), std::string("\x00\xFF\x10", 3));
+}
+
+TEST(BodyBufferTest, ResponseMoveAndShare) {
+    std::string page(8192, 'p');
+    const char* original = page.data();
+
+    HttpResponse response;
+    response.setBody(std::move(page));
+    EXPECT_EQ(response.getBodyView().data(), original);
+    EXPECT_EQ(response.getHeader("Content-Length"), "8192");
+
+    // Copies of the response share the bytes
+    HttpResponse copy = response;
+    EXPECT_EQ(copy.getBodyBuffer().data(), original);
+
+    // Appending to a shared body leaves the other copy untouched
+    copy.appendBody("!");
+    EXPECT_EQ(copy.getContentLength(), 8193u);
+    EXPECT_EQ(response.getContentLength(), 8192u);
+    EXPECT_EQ(response.getBodyView().data(), original);
+
+    std::string taken = response.takeBody();
+    EXPECT_EQ(taken.size(), 8192u);
+    EXPECT_EQ(response.getContentLength(), 0u);
+    EXPECT_EQ(response.getHeader("Content-Length"), "0");
+}
+
+TEST(BodyBufferTest, ResponseOverloads) {
+    HttpResponse response;
+    response.setBody("literal");
+    EXPECT_EQ(response.getBody(), "literal");
+
+    std::string_view view = "view";
+    response.setBody(view);
+    EXPECT_EQ(response.getBodyView(), "view");
+
+    const uint8_t raw[] = {'r', 'a', 'w'};
+    response.setBody(raw, sizeof(raw));
+    EXPECT_EQ(response.getBodyView(), "raw");
+
+    response.setBody(BodyBuffer::fromStatic("static"));
+    EXPECT_EQ(response.getHeader("Content-Length"), "6");
+}
+
+TEST(BodyBufferTest, RequestCopiesShareBody) {
+    HttpRequest request("POST", "/upload", "HTTP/1.1");
+    std::string payload(2048, 'u');
+    const char* original = payload.data();
+    request.setBody(std::move(payload));
+
+    HttpRequest copy(request);
+    EXPECT_EQ(copy.getBodyView().data(), original);
+    EXPECT_EQ(copy.getBody().size(), 2048u);
+}
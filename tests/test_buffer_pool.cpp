@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <cppSwitchboard/buffer_pool.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace cppSwitchboard;
+
+class BufferPoolTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        BufferPool::getInstance().setMaxCachedPerClass(BufferPool::DEFAULT_MAX_CACHED_PER_CLASS);
+        BufferPool::getInstance().trim();
+    }
+};
+
+TEST_F(BufferPoolTest, SizeClassRounding) {
+    EXPECT_EQ(BufferPool::roundUp(1), 256u);
+    EXPECT_EQ(BufferPool::roundUp(256), 256u);
+    EXPECT_EQ(BufferPool::roundUp(257), 512u);
+    EXPECT_EQ(BufferPool::roundUp(5000), 8192u);
+    EXPECT_EQ(BufferPool::roundUp(65536), 65536u);
+    EXPECT_EQ(BufferPool::roundUp(100000), 100000u);
+
+    EXPECT_EQ(BufferPool::nextClass(4096), 8192u);
+    EXPECT_EQ(BufferPool::nextClass(65536), 65536u);
+    EXPECT_EQ(BufferPool::previousClass(4096), 2048u);
+    EXPECT_EQ(BufferPool::previousClass(256), 256u);
+}
+
+TEST_F(BufferPoolTest, ReleasedBlocksAreReused) {
+    auto& pool = BufferPool::getInstance();
+    uint8_t* first = nullptr;
+    {
+        auto buffer = pool.acquire(3000);
+        EXPECT_EQ(buffer.size(), 4096u);
+        first = buffer.data();
+    }
+    EXPECT_EQ(pool.getStatistics()["cached_blocks"], 1u);
+
+    size_t reusesBefore = pool.getStatistics()["reuses"];
+    auto again = pool.acquire(4096);
+    EXPECT_EQ(again.data(), first);
+    EXPECT_EQ(pool.getStatistics()["reuses"], reusesBefore + 1);
+}
+
+TEST_F(BufferPoolTest, CacheIsBounded) {
+    auto& pool = BufferPool::getInstance();
+    pool.setMaxCachedPerClass(2);
+
+    {
+        std::vector<BufferPool::Buffer> buffers;
+        for (int i = 0; i < 5; ++i) {
+            buffers.push_back(pool.acquire(1024));
+        }
+    }
+    auto stats = pool.getStatistics();
+    EXPECT_EQ(stats["cached_blocks"], 2u);
+    EXPECT_EQ(stats["cached_bytes"], 2048u);
+
+    pool.trim();
+    EXPECT_EQ(pool.getStatistics()["cached_blocks"], 0u);
+}
+
+TEST_F(BufferPoolTest, OversizedRequestsBypassPool) {
+    auto& pool = BufferPool::getInstance();
+    {
+        auto buffer = pool.acquire(200000);
+        EXPECT_EQ(buffer.size(), 200000u);
+        buffer.data()[199999] = 1;
+    }
+    EXPECT_EQ(pool.getStatistics()["cached_blocks"], 0u);
+}
+
+TEST_F(BufferPoolTest, PoolAllocatorWithSharedObjects) {
+    struct Session {
+        char payload[600];
+        int id;
+    };
+
+    auto& pool = BufferPool::getInstance();
+    size_t outstanding = pool.getStatistics()["outstanding_blocks"];
+    {
+        auto session = std::allocate_shared<Session>(PoolAllocator<Session>());
+        session->id = 7;
+        EXPECT_EQ(pool.getStatistics()["outstanding_blocks"], outstanding + 1);
+    }
+    EXPECT_EQ(pool.getStatistics()["outstanding_blocks"], outstanding);
+
+    size_t reusesBefore = pool.getStatistics()["reuses"];
+    auto recycled = std::allocate_shared<Session>(PoolAllocator<Session>());
+    EXPECT_EQ(pool.getStatistics()["reuses"], reusesBefore + 1);
+}
+
+TEST_F(BufferPoolTest, ConcurrentAcquireRelease) {
+    auto& pool = BufferPool::getInstance();
+    size_t outstanding = pool.getStatistics()["outstanding_blocks"];
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&pool, t]() {
+            for (int i = 0; i < 1000; ++i) {
+                auto buffer = pool.acquire(static_cast<size_t>(256 << ((i + t) % 9)));
+                buffer.data()[0] = static_cast<uint8_t>(i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(pool.getStatistics()["outstanding_blocks"], outstanding);
+}
+
+TEST_F(BufferPoolTest, AdaptiveBufferGrowsAndShrinks) {
+    AdaptiveBuffer buffer(4096, 16384);
+    EXPECT_FALSE(buffer.holdsBuffer());
+
+    buffer.prepare();
+    EXPECT_TRUE(buffer.holdsBuffer());
+    EXPECT_EQ(buffer.capacity(), 4096u);
+
+    // Full reads indicate a bulk transfer
+    buffer.commit(4096);
+    EXPECT_EQ(buffer.capacity(), 8192u);
+    buffer.commit(8192);
+    EXPECT_EQ(buffer.capacity(), 16384u);
+    buffer.commit(16384);
+    EXPECT_EQ(buffer.capacity(), 16384u);
+
+    // A run of small reads shrinks it back, but not below the initial size
+    for (int i = 0; i < AdaptiveBuffer::SHRINK_AFTER_SMALL_READS * 4; ++i) {
+        buffer.prepare();
+        buffer.commit(100);
+    }
+    EXPECT_EQ(buffer.capacity(), 4096u);
+
+    buffer.release();
+    EXPECT_FALSE(buffer.holdsBuffer());
+}
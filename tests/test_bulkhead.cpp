@@ -0,0 +1,291 @@
+/**
+ * @file test_bulkhead.cpp
+ * @brief Tests for per-route executor pools
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cppSwitchboard/bulkhead.h>
+#include <cppSwitchboard/compiled_middleware_config.h>
+#include <cppSwitchboard/middleware_config_compiler.h>
+#include <cppSwitchboard/middleware_factory.h>
+#include <cppSwitchboard/http_server.h>
+#include "test_server.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <thread>
+
+using namespace cppSwitchboard;
+using namespace testing;
+
+namespace {
+    BulkheadConfig makeConfig(BulkheadOverflow overflow, int maxQueue = 1) {
+        BulkheadConfig config;
+        config.name = "reports";
+        config.threads = 1;
+        config.maxQueue = maxQueue;
+        config.overflow = overflow;
+        config.queueTimeout = std::chrono::milliseconds(20);
+        return config;
+    }
+
+    // Holds the bulkhead's only thread until released
+    class Gate {
+    public:
+        Bulkhead::Task blocker() {
+            auto released = released_;
+            auto started = std::make_shared<std::promise<void>>();
+            started_ = started->get_future();
+            return [started, released]() {
+                started->set_value();
+                released.wait();
+            };
+        }
+        void waitStarted() { started_.wait(); }
+        void release() { release_.set_value(); }
+    private:
+        std::promise<void> release_;
+        std::shared_future<void> released_ = release_.get_future().share();
+        std::future<void> started_;
+    };
+}
+
+// Test each overflow policy once the queue is full
+TEST(BulkheadTest, AppliesOverflowPolicy) {
+    for (auto overflow : {BulkheadOverflow::REJECT, BulkheadOverflow::DEGRADE, BulkheadOverflow::QUEUE}) {
+        Bulkhead bulkhead(makeConfig(overflow));
+        Gate gate;
+        std::atomic<int> ran{0};
+        std::atomic<int> expired{0};
+
+        ASSERT_EQ(bulkhead.submit(gate.blocker()), Bulkhead::Admission::ADMITTED);
+        gate.waitStarted();
+        EXPECT_EQ(bulkhead.submit([&ran]() { ran++; }), Bulkhead::Admission::ADMITTED);
+
+        auto overflowed = bulkhead.submit([&ran]() { ran++; }, [&expired]() { expired++; });
+        auto stats = bulkhead.getStats();
+        EXPECT_EQ(stats.running, 1u);
+        EXPECT_EQ(stats.queued, overflow == BulkheadOverflow::QUEUE ? 2u : 1u);
+
+        // The request past the limit waits longer than queueTimeout
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        gate.release();
+        bulkhead.shutdown();
+        stats = bulkhead.getStats();
+
+        switch (overflow) {
+            case BulkheadOverflow::REJECT:
+                EXPECT_EQ(overflowed, Bulkhead::Admission::REJECTED);
+                EXPECT_EQ(stats.rejected, 1u);
+                break;
+            case BulkheadOverflow::DEGRADE:
+                EXPECT_EQ(overflowed, Bulkhead::Admission::DEGRADED);
+                EXPECT_EQ(stats.degraded, 1u);
+                break;
+            case BulkheadOverflow::QUEUE:
+                EXPECT_EQ(overflowed, Bulkhead::Admission::ADMITTED);
+                EXPECT_EQ(expired.load(), 1);
+                EXPECT_EQ(stats.expired, 1u);
+                break;
+        }
+        EXPECT_EQ(ran.load(), 1);
+        EXPECT_EQ(bulkhead.getOccupancy(), 0u);
+        EXPECT_EQ(bulkhead.submit([]() {}), Bulkhead::Admission::REJECTED);
+    }
+}
+
+// Test reloads keep unchanged bulkheads and shut retired ones down once idle
+TEST(BulkheadTest, RegistryRetiresIdleBulkheads) {
+    BulkheadRegistry registry;
+    BulkheadConfig config = makeConfig(BulkheadOverflow::REJECT);
+    config.threads = 0;
+    registry.configure({config});
+    auto reports = registry.find("reports");
+    ASSERT_NE(reports, nullptr);
+    EXPECT_EQ(reports->getThreadCount(), 1u);
+
+    // Clamped to the same single thread: kept
+    registry.configure({config});
+    EXPECT_EQ(registry.find("reports"), reports);
+
+    Gate gate;
+    ASSERT_EQ(reports->submit(gate.blocker()), Bulkhead::Admission::ADMITTED);
+    gate.waitStarted();
+    registry.configure({});
+    EXPECT_EQ(registry.find("reports"), nullptr);
+
+    // Still draining; shut down when the last task finishes, without another configure()
+    gate.release();
+    bool stopped = false;
+    for (int i = 0; i < 300 && !stopped; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        stopped = reports->submit([]() {}) == Bulkhead::Admission::REJECTED;
+    }
+    EXPECT_TRUE(stopped);
+}
+
+// Test executors are declared in YAML and bound to route groups
+TEST(BulkheadTest, CompilesExecutorBindings) {
+    MiddlewareConfigCompiler compiler(&MiddlewareFactory::getInstance());
+    std::vector<ConfigDiagnostic> diagnostics;
+    std::string yaml =
+        "middleware:\n"
+        "  routes:\n"
+        "    \"/reports/*\":\n"
+        "      executor: reports\n"
+        "      middleware: []\n"
+        "    \"/api/*\":\n"
+        "      - name: logging\n"
+        "  executors:\n"
+        "    reports:\n"
+        "      threads: 2\n"
+        "      max_queue: 8\n"
+        "      overflow: queue\n"
+        "      queue_timeout_ms: 250\n";
+
+    auto config = compiler.compile(yaml, "", diagnostics);
+    ASSERT_NE(config, nullptr) << MiddlewareConfigCompiler::toResult(diagnostics).message;
+    ASSERT_EQ(config->executors.size(), 1u);
+    EXPECT_EQ(config->executors[0].threads, 2);
+    EXPECT_EQ(config->executors[0].maxQueue, 8);
+    EXPECT_EQ(config->executors[0].overflow, BulkheadOverflow::QUEUE);
+    EXPECT_EQ(config->executors[0].queueTimeout, std::chrono::milliseconds(250));
+
+    std::string error;
+    auto compiled = CompiledMiddlewareConfig::compile(*config, MiddlewareFactory::getInstance(), error);
+    ASSERT_NE(compiled, nullptr) << error;
+    EXPECT_EQ(compiled->getExecutor("/reports/daily"), "reports");
+    EXPECT_EQ(compiled->getExecutor("/api/users"), "");
+    EXPECT_EQ(compiled->getExecutor("/health"), "");
+
+    diagnostics.clear();
+    yaml =
+        "middleware:\n"
+        "  executors:\n"
+        "    reports: {threads: 0, overflow: later}\n"
+        "  routes:\n"
+        "    \"/reports/*\":\n"
+        "      executor: missing\n";
+    EXPECT_EQ(compiler.compile(yaml, "", diagnostics), nullptr);
+    ASSERT_EQ(diagnostics.size(), 2u);
+    EXPECT_THAT(diagnostics[0].message, HasSubstr("must be one of"));
+    EXPECT_EQ(diagnostics[1].line, 6);
+    EXPECT_THAT(diagnostics[1].message, HasSubstr("unknown executor 'missing'"));
+}
+
+// Test a saturated route is shed without delaying the others
+TEST(BulkheadTest, ServerIsolatesBoundRoutes) {
+    std::string path = "/tmp/cppswitchboard_bulkhead_test.yaml";
+    {
+        std::ofstream out(path);
+        out << "middleware:\n"
+               "  executors:\n"
+               "    reports: {threads: 1, max_queue: 0, overflow: reject}\n"
+               "  routes:\n"
+               "    \"/reports/*\":\n"
+               "      executor: reports\n"
+               "      middleware: []\n";
+    }
+
+    test::TestServer server;
+    ASSERT_TRUE(server.loadMiddlewareConfig(path).isSuccess());
+    std::remove(path.c_str());
+    auto bulkhead = server.getBulkhead("reports");
+    ASSERT_NE(bulkhead, nullptr);
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::promise<std::thread::id> reportThread;
+    server.registerHandler("/reports/daily", HttpMethod::GET, makeHandler([&](const HttpRequest&) {
+        reportThread.set_value(std::this_thread::get_id());
+        released.wait();
+        return HttpResponse::ok("report");
+    }));
+    server.registerHandler("/health", HttpMethod::GET, makeHandler([](const HttpRequest&) {
+        return HttpResponse::ok("up");
+    }));
+
+    auto slow = std::async(std::launch::async, [&server]() {
+        return server.executeRequest(HttpRequest("GET", "/reports/daily", "HTTP/1.1"));
+    });
+    EXPECT_NE(reportThread.get_future().get(), std::this_thread::get_id());
+
+    // The bulkhead is full: reports are shed, health checks still answer
+    HttpResponse shed = server.executeRequest(HttpRequest("GET", "/reports/daily", "HTTP/1.1"));
+    EXPECT_EQ(shed.getStatus(), HttpResponse::SERVICE_UNAVAILABLE);
+    EXPECT_EQ(shed.getHeader("Retry-After"), "1");
+    EXPECT_NE(shed.getCanned(), nullptr);
+    EXPECT_EQ(server.executeRequest(HttpRequest("GET", "/health", "HTTP/1.1")).getBody(), "up");
+
+    std::promise<int> scheduled;
+    server.scheduleRequest(std::make_shared<HttpRequest>("GET", "/reports/daily", "HTTP/1.1"),
+                           [&scheduled](HttpResponse response) { scheduled.set_value(response.getStatus()); });
+    EXPECT_EQ(scheduled.get_future().get(), HttpResponse::SERVICE_UNAVAILABLE);
+
+    release.set_value();
+    EXPECT_EQ(slow.get().getBody(), "report");
+    EXPECT_EQ(bulkhead->getStats().admitted, 1u);
+    EXPECT_EQ(bulkhead->getStats().rejected, 2u);
+    EXPECT_EQ(server.getBulkhead("missing"), nullptr);
+}
+
+// Test a queued request is answered at queueTimeout while the thread is still busy
+TEST(BulkheadTest, ExpiresQueuedRequestsOnTime) {
+    std::string path = "/tmp/cppswitchboard_bulkhead_expiry_test.yaml";
+    {
+        std::ofstream out(path);
+        out << "middleware:\n"
+               "  executors:\n"
+               "    reports: {threads: 1, max_queue: 0, overflow: queue, queue_timeout_ms: 50}\n"
+               "  routes:\n"
+               "    \"/reports/*\":\n"
+               "      executor: reports\n"
+               "      middleware: []\n";
+    }
+
+    test::TestServer server;
+    ASSERT_TRUE(server.loadMiddlewareConfig(path).isSuccess());
+    std::remove(path.c_str());
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::promise<void> started;
+    std::atomic<int> calls{0};
+    server.registerHandler("/reports/daily", HttpMethod::GET, makeHandler([&](const HttpRequest&) {
+        if (calls++ == 0) {
+            started.set_value();
+            released.wait();
+        }
+        return HttpResponse::ok("report");
+    }));
+
+    auto slow = std::async(std::launch::async, [&server]() {
+        return server.executeRequest(HttpRequest("GET", "/reports/daily", "HTTP/1.1"));
+    });
+    started.get_future().wait();
+
+    const auto start = std::chrono::steady_clock::now();
+    HttpResponse expired = server.executeRequest(HttpRequest("GET", "/reports/daily", "HTTP/1.1"));
+    const auto waited = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(expired.getStatus(), HttpResponse::SERVICE_UNAVAILABLE);
+    EXPECT_NE(expired.getCanned(), nullptr);
+    EXPECT_GE(waited, std::chrono::milliseconds(50));
+    EXPECT_LT(waited, std::chrono::milliseconds(500));
+
+    auto bulkhead = server.getBulkhead("reports");
+    EXPECT_EQ(bulkhead->getStats().expired, 1u);
+    EXPECT_EQ(bulkhead->getOccupancy(), 1u);
+
+    // The expired task is skipped once the thread frees up
+    release.set_value();
+    EXPECT_EQ(slow.get().getBody(), "report");
+    bulkhead->shutdown();
+    EXPECT_EQ(calls.load(), 1);
+    EXPECT_EQ(bulkhead->getOccupancy(), 0u);
+}
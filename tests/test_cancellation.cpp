@@ -0,0 +1,190 @@
+/**
+ * @file test_cancellation.cpp
+ * @brief Tests for request cancellation and deadlines
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ */
+
+#include <gtest/gtest.h>
+#include <cppSwitchboard/cancellation.h>
+#include <cppSwitchboard/middleware_pipeline.h>
+#include <cppSwitchboard/http_server.h>
+#include "test_server.h"
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <thread>
+
+using namespace cppSwitchboard;
+using namespace std::chrono_literals;
+
+namespace {
+    using Clock = CancellationToken::Clock;
+
+    // Cancels the request's token, as a reset stream would
+    class HangUpMiddleware : public Middleware {
+    public:
+        HttpResponse handle(const HttpRequest& request, Context& context, NextHandler next) override {
+            request.getCancellation()->cancel(CancellationToken::Reason::CLIENT_GONE);
+            return next(request, context);
+        }
+        std::string getName() const override { return "hang_up"; }
+        int getPriority() const override { return 10; }
+    };
+
+    class CountingMiddleware : public Middleware {
+    public:
+        HttpResponse handle(const HttpRequest& request, Context& context, NextHandler next) override {
+            calls++;
+            return next(request, context);
+        }
+        std::string getName() const override { return "counting"; }
+        std::atomic<int> calls{0};
+    };
+
+    HttpRequest requestWithToken(const std::string& path) {
+        HttpRequest request("GET", path, "HTTP/2");
+        request.setReceivedAt(Clock::now());
+        request.setCancellation(std::make_shared<CancellationToken>());
+        return request;
+    }
+}
+
+// Test callbacks run once, on cancel or at registration if already cancelled
+TEST(CancellationTest, CancelRunsCallbacksOnce) {
+    CancellationToken token;
+    int runs = 0;
+    int removed = 0;
+    token.onCancel([&runs]() { runs++; });
+    auto id = token.onCancel([&removed]() { removed++; });
+    token.removeCallback(id);
+    EXPECT_FALSE(token.isCancelled());
+
+    EXPECT_TRUE(token.cancel(CancellationToken::Reason::CLIENT_GONE));
+    EXPECT_FALSE(token.cancel(CancellationToken::Reason::DEADLINE));
+    EXPECT_TRUE(token.isCancelled());
+    EXPECT_EQ(token.getReason(), CancellationToken::Reason::CLIENT_GONE);
+    EXPECT_EQ(token.response().getStatus(), 499);
+    EXPECT_EQ(runs, 1);
+    EXPECT_EQ(removed, 0);
+
+    EXPECT_EQ(token.onCancel([&runs]() { runs++; }), 0u);
+    EXPECT_EQ(runs, 2);
+
+    // The probe is rate limited and only consulted until it reports the client gone
+    CancellationToken probed;
+    int probes = 0;
+    probed.setProbe([&probes]() { return ++probes == 2; });
+    EXPECT_FALSE(probed.isCancelled());
+    EXPECT_FALSE(probed.isCancelled());
+    EXPECT_EQ(probes, 1);
+    std::this_thread::sleep_for(CancellationToken::PROBE_INTERVAL + 1ms);
+    EXPECT_TRUE(probed.isCancelled());
+    EXPECT_EQ(probed.getReason(), CancellationToken::Reason::CLIENT_GONE);
+}
+
+// Test deadlines come from client headers and only move earlier
+TEST(CancellationTest, DeadlineFromHeaders) {
+    const auto now = Clock::now();
+    HttpRequest request("GET", "/", "HTTP/2");
+    EXPECT_EQ(CancellationToken::deadlineFromHeaders(request, now), Clock::time_point::max());
+
+    request.setHeader("grpc-timeout", "250m");
+    EXPECT_EQ(CancellationToken::deadlineFromHeaders(request, now), now + 250ms);
+    request.setHeader("grpc-timeout", "2S");
+    EXPECT_EQ(CancellationToken::deadlineFromHeaders(request, now), now + 2s);
+    request.setHeader("X-Request-Timeout", "1500");
+    EXPECT_EQ(CancellationToken::deadlineFromHeaders(request, now), now + 1500ms);
+
+    HttpRequest invalid("GET", "/", "HTTP/2");
+    invalid.setHeader("grpc-timeout", "123456789S");
+    invalid.setHeader("X-Request-Timeout", "soon");
+    EXPECT_EQ(CancellationToken::deadlineFromHeaders(invalid, now), Clock::time_point::max());
+
+    CancellationToken token(now + 1h);
+    token.tightenDeadline(now + 2h);
+    EXPECT_EQ(token.getDeadline(), now + 1h);
+    token.tightenDeadline(now - 1ms);
+    EXPECT_TRUE(token.hasDeadline());
+    EXPECT_TRUE(token.isCancelled());
+    EXPECT_EQ(token.getReason(), CancellationToken::Reason::DEADLINE);
+    EXPECT_EQ(token.response().getStatus(), HttpResponse::GATEWAY_TIMEOUT);
+}
+
+// Test the pipeline stops at the next hop once the request is cancelled
+TEST(CancellationTest, PipelineStopsBetweenHops) {
+    MiddlewarePipeline pipeline;
+    auto counting = std::make_shared<CountingMiddleware>();
+    pipeline.addMiddleware(std::make_shared<HangUpMiddleware>());
+    pipeline.addMiddleware(counting);
+    bool handled = false;
+    pipeline.setFinalHandler(makeHandler([&handled](const HttpRequest&) {
+        handled = true;
+        return HttpResponse::ok("late");
+    }));
+
+    HttpRequest request = requestWithToken("/");
+    HttpResponse response = pipeline.execute(request);
+    EXPECT_EQ(response.getStatus(), 499);
+    EXPECT_EQ(counting->calls.load(), 0);
+    EXPECT_FALSE(handled);
+
+    // Requests without a token run through
+    MiddlewarePipeline plainPipeline;
+    plainPipeline.addMiddleware(counting);
+    plainPipeline.setFinalHandler(makeHandler([](const HttpRequest&) { return HttpResponse::ok("done"); }));
+    EXPECT_EQ(plainPipeline.execute(HttpRequest("GET", "/", "HTTP/1.1")).getBody(), "done");
+    EXPECT_EQ(counting->calls.load(), 1);
+}
+
+// Test an async handler is released by a disconnect and by its route's timeout
+TEST(CancellationTest, AsyncHandlerStopsOnCancel) {
+    std::string path = "/tmp/cppswitchboard_cancellation_test.yaml";
+    {
+        std::ofstream out(path);
+        out << "middleware:\n"
+               "  routes:\n"
+               "    \"/slow/*\":\n"
+               "      timeout_ms: 30\n"
+               "      middleware: []\n";
+    }
+    test::TestServer server;
+    ASSERT_TRUE(server.loadMiddlewareConfig(path).isSuccess());
+    std::remove(path.c_str());
+
+    // Never answers; only stops when told to
+    auto aborted = std::make_shared<std::atomic<int>>(0);
+    auto neverAnswers = makeAsyncHandler([aborted](const HttpRequest& request, AsyncHttpHandler::ResponseCallback) {
+        request.getCancellation()->onCancel([aborted]() { (*aborted)++; });
+    });
+    server.registerAsyncHandler("/hang", HttpMethod::GET, neverAnswers);
+    server.registerAsyncHandler("/slow/report", HttpMethod::GET, neverAnswers);
+
+    HttpRequest hang = requestWithToken("/hang");
+    auto token = hang.getCancellation();
+    auto response = std::async(std::launch::async, [&server, &hang]() { return server.executeRequest(hang); });
+    std::this_thread::sleep_for(20ms);
+    token->cancel(CancellationToken::Reason::CLIENT_GONE);
+    ASSERT_EQ(response.wait_for(5s), std::future_status::ready);
+    EXPECT_EQ(response.get().getStatus(), 499);
+
+    const auto start = Clock::now();
+    HttpResponse timedOut = server.executeRequest(requestWithToken("/slow/report"));
+    EXPECT_EQ(timedOut.getStatus(), HttpResponse::GATEWAY_TIMEOUT);
+    EXPECT_LT(Clock::now() - start, 5s);
+    EXPECT_EQ(aborted->load(), 2);
+
+    // The server-wide timeout cancels the token as well
+    ServerConfig impatient;
+    impatient.general.requestTimeout = std::chrono::seconds(0);
+    test::TestServer impatientServer(impatient);
+    impatientServer.registerAsyncHandler("/hang", HttpMethod::GET, neverAnswers);
+    HttpRequest late = requestWithToken("/hang");
+    HttpResponse gaveUp = impatientServer.executeRequest(late);
+    EXPECT_EQ(gaveUp.getStatus(), HttpResponse::GATEWAY_TIMEOUT);
+    EXPECT_EQ(gaveUp.getHeader("Content-Type"), "application/json");
+    EXPECT_EQ(late.getCancellation()->getReason(), CancellationToken::Reason::DEADLINE);
+    EXPECT_EQ(aborted->load(), 3);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <cppSwitchboard/canned_response.h>
+#include <cppSwitchboard/http_server.h>
+#include <regex>
+#include <string>
+
+using namespace cppSwitchboard;
+
+TEST(CannedResponseTest, HttpDateIsImfFixdate) {
+    std::string date(HttpDate::now());
+    EXPECT_TRUE(std::regex_match(date, std::regex(
+        "(Mon|Tue|Wed|Thu|Fri|Sat|Sun), [0-9]{2} "
+        "(Jan|Feb|Mar|Apr|May|Jun|Jul|Aug|Sep|Oct|Nov|Dec) [0-9]{4} [0-9]{2}:[0-9]{2}:[0-9]{2} GMT")))
+        << date;
+}
+
+TEST(CannedResponseTest, SerializesHeadOnce) {
+    HttpResponse response = HttpResponse::json("{\"status\":\"ok\"}");
+    response.setHeader("Cache-Control", "no-store");
+    auto canned = CannedResponse::create(response, "svc/2.1");
+
+    EXPECT_EQ(canned->getStatus(), 200);
+    EXPECT_EQ(canned->getHead(),
+              " 200 OK\r\n"
+              "Cache-Control: no-store\r\n"
+              "Content-Type: application/json\r\n"
+              "Server: svc/2.1\r\n"
+              "Content-Length: 15\r\n");
+    EXPECT_EQ(canned->getBody().view(), "{\"status\":\"ok\"}");
+
+    // A Server header set on the response wins; bodiless statuses get no length
+    HttpResponse noContent(HttpResponse::NO_CONTENT);
+    noContent.setHeader("Server", "custom");
+    noContent.setBody("ignored");
+    auto empty = CannedResponse::create(noContent, "svc/2.1");
+    EXPECT_EQ(empty->getHead(), " 204 No Content\r\nServer: custom\r\n");
+    EXPECT_TRUE(empty->getBody().empty());
+}
+
+TEST(CannedResponseTest, ResponsesStayLinkedUntilModified) {
+    auto canned = CannedResponse::create(HttpResponse::ok("pong"), "svc/1.0");
+
+    HttpResponse response = canned->toResponse();
+    EXPECT_EQ(response.getCanned(), canned);
+    EXPECT_EQ(response.getBody(), "pong");
+    EXPECT_EQ(response.getBodyBuffer().data(), canned->getBody().data());
+
+    HttpResponse copy = response;
+    EXPECT_EQ(copy.getCanned(), canned);
+
+    response.setHeader("X-Trace", "1");
+    EXPECT_EQ(response.getCanned(), nullptr);
+
+    copy.setStatus(HttpResponse::CREATED);
+    EXPECT_EQ(copy.getCanned(), nullptr);
+
+    HttpResponse body = canned->toResponse();
+    body.appendBody("!");
+    EXPECT_EQ(body.getCanned(), nullptr);
+}
+
+TEST(CannedResponseTest, RegistryProvidesStandardErrors) {
+    CannedResponseRegistry registry("svc/1.0");
+    EXPECT_EQ(registry.getServerHeader(), "svc/1.0");
+
+    for (int status : {400, 404, 405, 413, 500, 503, 504}) {
+        auto canned = registry.error(status);
+        ASSERT_NE(canned, nullptr) << status;
+        EXPECT_EQ(canned->getStatus(), status);
+        EXPECT_NE(canned->getHead().find("Server: svc/1.0\r\n"), std::string::npos);
+    }
+    EXPECT_EQ(registry.error(404)->toResponse().getBody(), "{\"error\": \"Not Found\"}");
+    EXPECT_NE(registry.error(503)->getHead().find("Retry-After: 1\r\n"), std::string::npos);
+    EXPECT_EQ(registry.error(418), nullptr);
+    EXPECT_TRUE(registry.error(404)->hasServerHeader());
+    EXPECT_FALSE(CannedResponse::create(HttpResponse::ok("up"), {})->hasServerHeader());
+
+    ServerConfig config;
+    config.application.name = "inventory";
+    config.application.version = "3.4";
+    auto server = HttpServer::create(config);
+    EXPECT_EQ(server->getCannedResponses().getServerHeader(), "inventory/3.4");
+}
+
+TEST(CannedResponseTest, ContentLengthIsDerivedFromBody) {
+    HttpResponse response;
+    response.setBody("hello");
+    response.appendBody(" world");
+
+    EXPECT_EQ(response.getHeaderFields().count("Content-Length"), 0u);
+    EXPECT_EQ(response.getHeader("content-length"), "11");
+    EXPECT_EQ(response.getHeaders().at("Content-Length"), "11");
+
+    // An explicit value set after the body is kept until the body changes
+    response.setHeader("Content-Length", "42");
+    EXPECT_EQ(response.getHeader("Content-Length"), "42");
+    response.setBody("x");
+    EXPECT_EQ(response.getHeader("Content-Length"), "1");
+}
@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+#include <cppSwitchboard/compiled_middleware_config.h>
+#include <cppSwitchboard/middleware_factory.h>
+#include <atomic>
+#include <string>
+
+using namespace cppSwitchboard;
+
+namespace {
+    std::atomic<int> createdCount{0};
+
+    // Prepends its "tag" setting to the X-Chain response header
+    class TagMiddleware : public Middleware {
+    public:
+        TagMiddleware(std::string tag, int priority) : tag_(std::move(tag)), priority_(priority) {}
+        HttpResponse handle(const HttpRequest& request, Context& context, NextHandler next) override {
+            HttpResponse response = next(request, context);
+            response.setHeader("X-Chain", tag_ + response.getHeader("X-Chain"));
+            return response;
+        }
+        std::string getName() const override { return "tag:" + tag_; }
+        int getPriority() const override { return priority_; }
+    private:
+        std::string tag_;
+        int priority_;
+    };
+
+    class TagCreator : public MiddlewareCreator {
+    public:
+        std::shared_ptr<Middleware> create(const MiddlewareInstanceConfig& config) override {
+            ++createdCount;
+            return std::make_shared<TagMiddleware>(config.getString("tag"), config.priority);
+        }
+        std::string getMiddlewareName() const override { return "compile_test_tag"; }
+        bool validateConfig(const MiddlewareInstanceConfig&, std::string&) const override { return true; }
+    };
+
+    MiddlewareInstanceConfig tag(const std::string& value, int priority) {
+        MiddlewareInstanceConfig config;
+        config.name = "compile_test_tag";
+        config.priority = priority;
+        config.config["tag"] = value;
+        return config;
+    }
+
+    RouteMiddlewareConfig rule(const std::string& pattern, bool isRegex, std::vector<MiddlewareInstanceConfig> middlewares) {
+        RouteMiddlewareConfig route;
+        route.pattern = pattern;
+        route.isRegex = isRegex;
+        route.middlewares = std::move(middlewares);
+        return route;
+    }
+
+    std::string chainFor(const std::shared_ptr<HttpHandler>& handler, const std::string& path) {
+        HttpRequest request("GET", path, "HTTP/1.1");
+        return handler->handle(request).getHeader("X-Chain");
+    }
+}
+
+class CompiledMiddlewareConfigTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        factory_ = &MiddlewareFactory::getInstance();
+        factory_->registerCreator(std::make_unique<TagCreator>());
+        createdCount = 0;
+    }
+
+    void TearDown() override {
+        factory_->unregisterCreator("compile_test_tag");
+    }
+
+    MiddlewareFactory* factory_;
+};
+
+TEST_F(CompiledMiddlewareConfigTest, MatchesLikeGetMiddlewareForRoute) {
+    ComprehensiveMiddlewareConfig config;
+    config.global.middlewares.push_back(tag("g", 0));
+    config.routes.push_back(rule("/api/v?/*", false, {tag("auth", 100)}));
+    config.routes.push_back(rule("^/files/[0-9]+$", true, {tag("files", 50)}));
+    config.routes.push_back(rule("/api/*", false, {tag("api", 10)}));
+
+    std::string error;
+    auto compiled = factory_->createPipelines(config, error);
+    ASSERT_NE(compiled, nullptr) << error;
+
+    for (const std::string path : {"/api/v1/users", "/api/users", "/files/42", "/files/x", "/"}) {
+        int expected = CompiledMiddlewareConfig::NO_RULE;
+        for (size_t i = 0; i < config.routes.size(); ++i) {
+            if (config.routes[i].matchesPath(path)) {
+                expected = static_cast<int>(i);
+                break;
+            }
+        }
+        EXPECT_EQ(compiled->findRule(path), expected) << path;
+        EXPECT_EQ(compiled->getPipeline(path)->getMiddlewareCount(),
+                  config.getMiddlewareForRoute(path).size()) << path;
+    }
+}
+
+TEST_F(CompiledMiddlewareConfigTest, SharesInstancesAndPipelines) {
+    ComprehensiveMiddlewareConfig config;
+    config.global.middlewares.push_back(tag("g", 0));
+    config.routes.push_back(rule("/a/*", false, {tag("auth", 100)}));
+    config.routes.push_back(rule("/b/*", false, {tag("auth", 100)}));
+    config.routes.push_back(rule("/c/*", false, {tag("other", 100)}));
+    auto disabled = tag("off", 5);
+    disabled.enabled = false;
+    config.routes.push_back(rule("/d/*", false, {disabled}));
+
+    std::string error;
+    auto compiled = CompiledMiddlewareConfig::compile(config, *factory_, error);
+    ASSERT_NE(compiled, nullptr) << error;
+
+    // g, auth and other are each created once; /a and /b share a pipeline and
+    // /d runs the global-only one
+    EXPECT_EQ(createdCount, 3);
+    EXPECT_EQ(compiled->getMiddlewareInstanceCount(), 3u);
+    EXPECT_EQ(compiled->getPipelineCount(), 3u);
+    EXPECT_EQ(compiled->getPipeline("/a/1"), compiled->getPipeline("/b/2"));
+    EXPECT_EQ(compiled->getPipeline("/d/1"), compiled->getPipeline("/elsewhere"));
+}
+
+TEST_F(CompiledMiddlewareConfigTest, WrapsHandlersWithSharedPipelines) {
+    ComprehensiveMiddlewareConfig config;
+    config.global.middlewares.push_back(tag("g", 0));
+    config.routes.push_back(rule("/admin/*", false, {tag("auth", 100)}));
+
+    std::string error;
+    auto compiled = factory_->createPipelines(config, error);
+    ASSERT_NE(compiled, nullptr) << error;
+
+    auto handler = makeHandler([](const HttpRequest& request) {
+        return HttpResponse::ok(request.getPath());
+    });
+    auto fixed = compiled->wrap("/admin/users", handler);
+    auto resolved = compiled->wrap("/{section}/users", handler);
+
+    EXPECT_EQ(chainFor(fixed, "/admin/users"), "authg");
+    EXPECT_EQ(chainFor(resolved, "/admin/users"), "authg");
+    EXPECT_EQ(chainFor(resolved, "/public/users"), "g");
+    EXPECT_EQ(createdCount, 2);
+
+    // Nothing configured: the handler is registered as is
+    ComprehensiveMiddlewareConfig empty;
+    auto none = factory_->createPipelines(empty, error);
+    ASSERT_NE(none, nullptr);
+    EXPECT_EQ(none->wrap("/x", handler), handler);
+}
+
+TEST_F(CompiledMiddlewareConfigTest, ReportsErrors) {
+    ComprehensiveMiddlewareConfig badRegex;
+    badRegex.routes.push_back(rule("([", true, {tag("a", 0)}));
+    std::string error;
+    EXPECT_EQ(factory_->createPipelines(badRegex, error), nullptr);
+    EXPECT_NE(error.find("Invalid regex"), std::string::npos);
+
+    ComprehensiveMiddlewareConfig unknown;
+    MiddlewareInstanceConfig missing;
+    missing.name = "no_such_middleware";
+    unknown.global.middlewares.push_back(missing);
+    EXPECT_EQ(factory_->createPipelines(unknown, error), nullptr);
+    EXPECT_EQ(error, "Failed to create middleware: no_such_middleware");
+}
+
+TEST_F(CompiledMiddlewareConfigTest, LazyInstantiationDefersRouteStacks) {
+    ComprehensiveMiddlewareConfig config;
+    config.global.middlewares.push_back(tag("g", 0));
+    config.routes.push_back(rule("/a/*", false, {tag("auth", 100)}));
+    config.routes.push_back(rule("/b/*", false, {tag("auth", 100)}));
+    config.routes.push_back(rule("/c/*", false, {tag("other", 100)}));
+
+    std::string error;
+    auto compiled = CompiledMiddlewareConfig::compile(config, *factory_, error, MiddlewareInstantiation::LAZY);
+    ASSERT_NE(compiled, nullptr) << error;
+
+    // Only the global stack exists; /a and /b still share one pending pipeline
+    EXPECT_EQ(createdCount, 1);
+    EXPECT_EQ(compiled->getPipelineCount(), 3u);
+    EXPECT_EQ(compiled->getPendingPipelineCount(), 2u);
+
+    auto handler = makeHandler([](const HttpRequest& request) {
+        return HttpResponse::ok(request.getPath());
+    });
+    auto wrapped = compiled->wrap("/a/users", handler);
+    EXPECT_EQ(createdCount, 1);
+    EXPECT_EQ(chainFor(wrapped, "/a/users"), "authg");
+    EXPECT_EQ(createdCount, 2);
+    EXPECT_EQ(compiled->getPipeline("/a/1"), compiled->getPipeline("/b/2"));
+
+    EXPECT_EQ(compiled->warmUp(), 1u);
+    EXPECT_EQ(compiled->getPendingPipelineCount(), 0u);
+    EXPECT_EQ(compiled->getMiddlewareInstanceCount(), 3u);
+
+    // Configurations are still validated up front
+    ComprehensiveMiddlewareConfig unknown;
+    MiddlewareInstanceConfig missing;
+    missing.name = "no_such_middleware";
+    unknown.routes.push_back(rule("/x/*", false, {missing}));
+    EXPECT_EQ(CompiledMiddlewareConfig::compile(unknown, *factory_, error, MiddlewareInstantiation::LAZY), nullptr);
+    EXPECT_NE(error.find("no_such_middleware"), std::string::npos);
+}
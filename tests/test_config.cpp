@@ -276,4 +276,59 @@ http1:
     EXPECT_EQ(config->application.name, "StringLoadedApp");
     EXPECT_EQ(config->application.version, "2.0.0");
     EXPECT_EQ(config->http1.port, 9090);
-} 
\ No newline at end of file
+} 
+TEST_F(ConfigTest, Http1ParserEngine) {
+    auto defaults = ConfigLoader::createDefault();
+    EXPECT_EQ(defaults->http1.parser, "beast");
+    
+    auto config = ConfigLoader::loadFromString(R"(
+http1:
+  port: 9090
+  parser: simd
+)");
+    ASSERT_TRUE(config != nullptr);
+    EXPECT_EQ(config->http1.parser, "simd");
+    
+    std::string errorMessage;
+    EXPECT_TRUE(ConfigValidator::validateConfig(*config, errorMessage)) << errorMessage;
+    
+    config->http1.parser = "fast";
+    EXPECT_FALSE(ConfigValidator::validateConfig(*config, errorMessage));
+    EXPECT_NE(errorMessage.find("parser"), std::string::npos);
+}
+
+TEST_F(ConfigTest, WorkerThreadsAuto) {
+    auto config = ConfigLoader::loadFromString(R"(
+general:
+  workerThreads: auto
+)");
+    ASSERT_TRUE(config != nullptr);
+    EXPECT_EQ(config->general.workerThreads, 0);
+    
+    std::string errorMessage;
+    EXPECT_TRUE(ConfigValidator::validateConfig(*config, errorMessage)) << errorMessage;
+    
+    config->general.workerThreads = -1;
+    EXPECT_FALSE(ConfigValidator::validateConfig(*config, errorMessage));
+}
+
+TEST_F(ConfigTest, AdmissionControl) {
+    auto config = ConfigLoader::loadFromString(R"(
+general:
+  admission:
+    enabled: true
+    target_ms: 10
+    interval_ms: 200
+)");
+    ASSERT_TRUE(config != nullptr);
+    EXPECT_TRUE(config->general.admission.enabled);
+    EXPECT_EQ(config->general.admission.target, std::chrono::milliseconds(10));
+    EXPECT_EQ(config->general.admission.interval, std::chrono::milliseconds(200));
+    
+    std::string errorMessage;
+    EXPECT_TRUE(ConfigValidator::validateConfig(*config, errorMessage)) << errorMessage;
+    
+    config->general.admission.interval = std::chrono::milliseconds(5);
+    EXPECT_FALSE(ConfigValidator::validateConfig(*config, errorMessage));
+    EXPECT_NE(errorMessage.find("Admission"), std::string::npos);
+}
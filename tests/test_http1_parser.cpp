@@ -0,0 +1,396 @@
+#include <gtest/gtest.h>
+#include <cppSwitchboard/http1_parser.h>
+#include <boost/asio/buffer.hpp>
+#include <boost/beast/http.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cppSwitchboard;
+namespace http = boost::beast::http;
+
+namespace {
+    /**
+     * @brief Request head as seen by either parser, for comparison
+     */
+    struct ParsedHead {
+        bool accepted = false;
+        size_t consumed = 0;
+        std::string method;
+        std::string target;
+        unsigned version = 0;
+        std::vector<std::pair<std::string, std::string>> fields;
+        bool keepAlive = false;
+        bool chunked = false;
+        bool hasContentLength = false;
+        uint64_t contentLength = 0;
+    };
+
+    ParsedHead parseWithBeast(const std::string& input) {
+        ParsedHead result;
+        http::request_parser<http::empty_body> parser;
+        parser.eager(false);
+        parser.body_limit(std::numeric_limits<std::uint64_t>::max());
+
+        boost::system::error_code ec;
+        size_t used = parser.put(boost::asio::buffer(input), ec);
+        if (ec || !parser.is_header_done()) {
+            return result;
+        }
+
+        const auto& message = parser.get();
+        result.accepted = true;
+        result.consumed = used;
+        result.method = std::string(message.method_string());
+        result.target = std::string(message.target());
+        result.version = message.version();
+        for (const auto& field : message) {
+            result.fields.emplace_back(std::string(field.name_string()), std::string(field.value()));
+        }
+        result.keepAlive = parser.keep_alive();
+        result.chunked = parser.chunked();
+        if (parser.content_length()) {
+            result.hasContentLength = true;
+            result.contentLength = *parser.content_length();
+        }
+        return result;
+    }
+
+    ParsedHead parseInPlace(const std::string& input) {
+        ParsedHead result;
+        Http1RequestHead head;
+        int consumed = Http1Parser::parse(input.data(), input.size(), head);
+        if (consumed < 0) {
+            return result;
+        }
+
+        result.accepted = true;
+        result.consumed = static_cast<size_t>(consumed);
+        result.method = std::string(head.method);
+        result.target = std::string(head.target);
+        result.version = head.version;
+        for (size_t i = 0; i < head.headerCount; ++i) {
+            result.fields.emplace_back(std::string(head.headers[i].name), std::string(head.headers[i].value));
+        }
+        result.keepAlive = head.keepAlive;
+        result.chunked = head.chunked;
+        result.hasContentLength = head.hasContentLength;
+        result.contentLength = head.contentLength;
+        return result;
+    }
+
+    std::string lowercase(std::string text) {
+        for (char& c : text) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return text;
+    }
+
+    /**
+     * @brief Beast's field container keeps repeated names next to each
+     *        other; order both lists the same way before comparing
+     */
+    std::vector<std::pair<std::string, std::string>> groupedByName(
+            std::vector<std::pair<std::string, std::string>> fields) {
+        std::stable_sort(fields.begin(), fields.end(), [](const auto& a, const auto& b) {
+            return lowercase(a.first) < lowercase(b.first);
+        });
+        return fields;
+    }
+
+    void expectSameHead(const ParsedHead& expected, const ParsedHead& actual, const std::string& input) {
+        SCOPED_TRACE(input);
+        EXPECT_EQ(actual.consumed, expected.consumed);
+        EXPECT_EQ(actual.method, expected.method);
+        EXPECT_EQ(actual.target, expected.target);
+        EXPECT_EQ(actual.version, expected.version);
+        EXPECT_EQ(groupedByName(actual.fields), groupedByName(expected.fields));
+        EXPECT_EQ(actual.keepAlive, expected.keepAlive);
+        EXPECT_EQ(actual.chunked, expected.chunked);
+        EXPECT_EQ(actual.hasContentLength, expected.hasContentLength);
+        EXPECT_EQ(actual.contentLength, expected.contentLength);
+    }
+
+    /**
+     * @brief Generator of valid request heads covering both short and
+     *        SIMD-sized targets and values
+     */
+    class RequestGenerator {
+    public:
+        explicit RequestGenerator(uint32_t seed) : rng_(seed) {}
+
+        std::string next() {
+            static const char* methods[] = {"GET", "POST", "PUT", "DELETE", "PATCH", "HEAD", "OPTIONS", "M-SEARCH"};
+            static const char* names[] = {"Host", "User-Agent", "Accept", "Accept-Encoding", "Authorization",
+                                          "X-Request-Id", "cookie", "X_Odd|Name~"};
+
+            std::string request = methods[pick(8)];
+            request += ' ';
+            request += '/';
+            request += text(pick(3) == 0 ? 200 : 40, "abcXYZ019-._~%/?&=+;:@!$'()*,", true);
+            request += pick(4) == 0 ? " HTTP/1.0\r\n" : " HTTP/1.1\r\n";
+
+            // Beast lets "keep-alive" override "close" on HTTP/1.0, so at
+            // most one Connection field is generated
+            bool framed = false;
+            bool connection = false;
+            size_t fieldCount = pick(16);
+            for (size_t i = 0; i < fieldCount; ++i) {
+                switch (pick(8)) {
+                    case 0:
+                        if (connection) continue;
+                        connection = true;
+                        request += "Connection: ";
+                        request += pick(2) ? "close" : "Keep-Alive, Upgrade";
+                        break;
+                    case 1:
+                        if (framed) continue;
+                        framed = true;
+                        request += "Content-Length: " + std::to_string(pick(100000));
+                        break;
+                    case 2:
+                        if (framed) continue;
+                        framed = true;
+                        request += pick(2) ? "Transfer-Encoding: chunked" : "transfer-encoding: gzip, chunked";
+                        break;
+                    default:
+                        request += names[pick(8)];
+                        request += ':';
+                        request += whitespace();
+                        request += text(pick(3) == 0 ? 120 : 24, "abc XYZ 0123 ,;=/\"\t()", true);
+                        request += whitespace();
+                        break;
+                }
+                request += "\r\n";
+            }
+            request += "\r\n";
+            return request;
+        }
+
+        std::string mutate(std::string input) {
+            static const char interesting[] = {'\r', '\n', ' ', '\t', ':', ',', '\0', '\x7f', '\x80', 'a', '1', '/'};
+            size_t edits = 1 + pick(3);
+            for (size_t i = 0; i < edits && !input.empty(); ++i) {
+                size_t position = pick(input.size());
+                switch (pick(3)) {
+                    case 0:
+                        input[position] = interesting[pick(sizeof(interesting))];
+                        break;
+                    case 1:
+                        input.erase(position, 1);
+                        break;
+                    default:
+                        input.insert(position, 1, interesting[pick(sizeof(interesting))]);
+                        break;
+                }
+            }
+            return input;
+        }
+
+        size_t pick(size_t bound) {
+            return std::uniform_int_distribution<size_t>(0, bound - 1)(rng_);
+        }
+
+    private:
+        std::string text(size_t maxLength, const std::string& alphabet, bool allowObsText) {
+            std::string result;
+            size_t length = pick(maxLength + 1);
+            for (size_t i = 0; i < length; ++i) {
+                if (allowObsText && pick(40) == 0) {
+                    result += static_cast<char>(0x80 + pick(128));
+                } else {
+                    result += alphabet[pick(alphabet.size())];
+                }
+            }
+            // Field values never start or end with whitespace once trimmed;
+            // keep targets free of spaces entirely
+            if (alphabet.find(' ') == std::string::npos) {
+                return result;
+            }
+            while (!result.empty() && (result.back() == ' ' || result.back() == '\t')) result.pop_back();
+            while (!result.empty() && (result.front() == ' ' || result.front() == '\t')) result.erase(0, 1);
+            return result;
+        }
+
+        std::string whitespace() {
+            static const char* options[] = {"", " ", "\t", "  \t"};
+            return options[pick(4)];
+        }
+
+        std::mt19937 rng_;
+    };
+}
+
+TEST(Http1ParserTest, ParsesRequestHead) {
+    std::string input =
+        "POST /api/users?page=2 HTTP/1.1\r\n"
+        "Host: api.example.com\r\n"
+        "Content-Type:application/json  \r\n"
+        "Content-Length: 13\r\n"
+        "\r\n"
+        "{\"name\":\"x\"}\n";
+
+    Http1RequestHead head;
+    int consumed = Http1Parser::parse(input.data(), input.size(), head);
+    ASSERT_GT(consumed, 0);
+    EXPECT_EQ(input.substr(consumed), "{\"name\":\"x\"}\n");
+
+    EXPECT_EQ(head.method, "POST");
+    EXPECT_EQ(head.target, "/api/users?page=2");
+    EXPECT_EQ(head.version, 11u);
+    ASSERT_EQ(head.headerCount, 3u);
+    EXPECT_EQ(head.headers[1].name, "Content-Type");
+    EXPECT_EQ(head.headers[1].value, "application/json");
+    EXPECT_EQ(head.findHeader("host"), "api.example.com");
+    EXPECT_TRUE(head.hasContentLength);
+    EXPECT_EQ(head.contentLength, 13u);
+    EXPECT_TRUE(head.keepAlive);
+
+    // Views point into the input buffer, nothing was copied
+    EXPECT_GE(head.target.data(), input.data());
+    EXPECT_LT(head.target.data(), input.data() + input.size());
+}
+
+TEST(Http1ParserTest, IncompleteHeadNeedsMore) {
+    std::string input = "GET /index.html HTTP/1.1\r\nHost: example.com\r\nAccept: */*\r\n\r\n";
+    Http1RequestHead head;
+    for (size_t length = 0; length < input.size(); ++length) {
+        EXPECT_EQ(Http1Parser::parse(input.data(), length, head), Http1Parser::NEED_MORE) << length;
+    }
+    EXPECT_EQ(Http1Parser::parse(input.data(), input.size(), head), static_cast<int>(input.size()));
+}
+
+TEST(Http1ParserTest, RejectsMalformedHeads) {
+    const char* inputs[] = {
+        "GET  / HTTP/1.1\r\n\r\n",                       // empty target
+        "GET / HTTP/1.1\n\r\n",                          // bare LF
+        "GET / HTTQ/1.1\r\n\r\n",                        // bad version
+        "G(T / HTTP/1.1\r\n\r\n",                        // method is not a token
+        "GET / HTTP/1.1\r\nBad Name: x\r\n\r\n",         // space in field name
+        "GET / HTTP/1.1\r\n: x\r\n\r\n",                 // empty field name
+        "GET / HTTP/1.1\r\nX: a\x01" "b\r\n\r\n",        // control character in value
+        "GET / HTTP/1.1\r\nX: a\r\n folded\r\n\r\n",     // obsolete line folding
+        "GET / HTTP/1.1\r\nContent-Length: 1x\r\n\r\n",
+        "GET / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 2\r\n\r\n",
+        "GET / HTTP/1.1\r\nContent-Length: 1\r\nTransfer-Encoding: chunked\r\n\r\n",
+        "GET / HTTP/1.1\r\nConnection: keep alive\r\n\r\n",
+        "GET / HTTP/1.1\r\nTransfer-Encoding: :chunked\r\n\r\n",
+    };
+    for (const char* input : inputs) {
+        Http1RequestHead head;
+        EXPECT_EQ(Http1Parser::parse(input, std::strlen(input), head), Http1Parser::BAD_REQUEST) << input;
+    }
+}
+
+TEST(Http1ParserTest, ConnectionPersistence) {
+    struct Case {
+        const char* input;
+        bool keepAlive;
+    };
+    const Case cases[] = {
+        {"GET / HTTP/1.1\r\n\r\n", true},
+        {"GET / HTTP/1.1\r\nConnection: close\r\n\r\n", false},
+        {"GET / HTTP/1.0\r\n\r\n", false},
+        {"GET / HTTP/1.0\r\nConnection: Keep-Alive\r\n\r\n", true},
+        {"GET / HTTP/1.1\r\nConnection: upgrade, Close\r\n\r\n", false},
+    };
+    for (const auto& c : cases) {
+        Http1RequestHead head;
+        ASSERT_GT(Http1Parser::parse(c.input, std::strlen(c.input), head), 0) << c.input;
+        EXPECT_EQ(head.keepAlive, c.keepAlive) << c.input;
+    }
+}
+
+TEST(Http1ParserTest, EnforcesLimits) {
+    std::string manyHeaders = "GET / HTTP/1.1\r\n";
+    for (size_t i = 0; i <= Http1RequestHead::MAX_HEADERS; ++i) {
+        manyHeaders += "X-" + std::to_string(i) + ": v\r\n";
+    }
+    manyHeaders += "\r\n";
+    Http1RequestHead head;
+    EXPECT_EQ(Http1Parser::parse(manyHeaders.data(), manyHeaders.size(), head), Http1Parser::BAD_REQUEST);
+
+    std::string oversized = "GET / HTTP/1.1\r\nX-Big: " + std::string(Http1Parser::HEADER_LIMIT, 'a');
+    EXPECT_EQ(Http1Parser::parse(oversized.data(), oversized.size(), head), Http1Parser::BAD_REQUEST);
+}
+
+TEST(Http1ParserTest, ReportsSimdLevel) {
+    std::string level = Http1Parser::simdLevel();
+    EXPECT_TRUE(level == "avx2" || level == "sse4.2" || level == "scalar") << level;
+}
+
+TEST(Http1ChunkedDecoderTest, DecodesIncrementally) {
+    std::string encoded = "4\r\nWiki\r\n5;name=value\r\npedia\r\nE\r\n in\r\n\r\nchunks.\r\n0\r\nX-Trailer: 1\r\n\r\nNEXT";
+
+    // Whole input at once: the bytes after the final chunk are left alone
+    {
+        Http1ChunkedDecoder decoder;
+        std::string body;
+        long used = decoder.decode(encoded.data(), encoded.size(), body);
+        EXPECT_TRUE(decoder.isComplete());
+        EXPECT_EQ(body, "Wikipedia in\r\n\r\nchunks.");
+        EXPECT_EQ(encoded.substr(static_cast<size_t>(used)), "NEXT");
+    }
+
+    // One byte at a time
+    {
+        Http1ChunkedDecoder decoder;
+        std::string body;
+        size_t offset = 0;
+        while (!decoder.isComplete() && offset < encoded.size()) {
+            long used = decoder.decode(encoded.data() + offset, 1, body);
+            ASSERT_GE(used, 0);
+            offset += static_cast<size_t>(used);
+        }
+        EXPECT_TRUE(decoder.isComplete());
+        EXPECT_EQ(body, "Wikipedia in\r\n\r\nchunks.");
+    }
+}
+
+TEST(Http1ChunkedDecoderTest, RejectsMalformedChunks) {
+    const char* inputs[] = {"x\r\n", "4\r\nWikiX", "4\nWiki\r\n", "\r\n", "11111111111111111\r\n"};
+    for (const char* input : inputs) {
+        Http1ChunkedDecoder decoder;
+        std::string body;
+        EXPECT_EQ(decoder.decode(input, std::strlen(input), body), -1) << input;
+    }
+}
+
+TEST(Http1ParserDifferentialTest, MatchesBeastOnValidRequests) {
+    RequestGenerator generator(20250622);
+    for (int i = 0; i < 5000; ++i) {
+        std::string input = generator.next();
+        ParsedHead expected = parseWithBeast(input);
+        ParsedHead actual = parseInPlace(input);
+        ASSERT_TRUE(expected.accepted) << input;
+        ASSERT_TRUE(actual.accepted) << input;
+        expectSameHead(expected, actual, input);
+
+        // Every proper prefix is incomplete, never an error
+        size_t cut = generator.pick(input.size());
+        Http1RequestHead head;
+        ASSERT_EQ(Http1Parser::parse(input.data(), cut, head), Http1Parser::NEED_MORE) << input.substr(0, cut);
+    }
+}
+
+TEST(Http1ParserDifferentialTest, NeverMoreLenientThanBeast) {
+    RequestGenerator generator(7);
+    size_t accepted = 0;
+    for (int i = 0; i < 20000; ++i) {
+        std::string input = generator.mutate(generator.next());
+        ParsedHead actual = parseInPlace(input);
+        if (!actual.accepted) {
+            continue;
+        }
+        ++accepted;
+        ParsedHead expected = parseWithBeast(input);
+        ASSERT_TRUE(expected.accepted) << "accepted input that Beast rejects: " << input;
+        expectSameHead(expected, actual, input);
+    }
+    // The mutations must leave enough requests intact to exercise the comparison
+    EXPECT_GT(accepted, 1000u);
+}
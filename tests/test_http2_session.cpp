@@ -0,0 +1,168 @@
+/**
+ * @file test_http2_session.cpp
+ * @brief End-to-end tests for the HTTP/2 session over cleartext connections
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ */
+
+#include <gtest/gtest.h>
+#include <cppSwitchboard/http2_server_impl.h>
+#include <cppSwitchboard/config.h>
+#include <boost/asio.hpp>
+#include <nghttp2/nghttp2.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cppSwitchboard;
+namespace asio = boost::asio;
+using asio::ip::tcp;
+
+namespace {
+    // Minimal blocking h2c client speaking prior-knowledge HTTP/2
+    class Http2Client {
+    public:
+        explicit Http2Client(unsigned short port) : socket_(ioc_) {
+            socket_.connect(tcp::endpoint(asio::ip::make_address("127.0.0.1"), port));
+
+            nghttp2_session_callbacks* callbacks;
+            nghttp2_session_callbacks_new(&callbacks);
+            nghttp2_session_callbacks_set_send_callback(callbacks, send_callback);
+            nghttp2_session_callbacks_set_on_header_callback(callbacks, on_header_callback);
+            nghttp2_session_callbacks_set_on_data_chunk_recv_callback(callbacks, on_data_chunk_recv_callback);
+            nghttp2_session_callbacks_set_on_stream_close_callback(callbacks, on_stream_close_callback);
+            nghttp2_session_client_new(&session_, callbacks, this);
+            nghttp2_session_callbacks_del(callbacks);
+            nghttp2_submit_settings(session_, NGHTTP2_FLAG_NONE, nullptr, 0);
+        }
+
+        ~Http2Client() { nghttp2_session_del(session_); }
+
+        // Sends a GET and blocks until its stream closes or the peer hangs up
+        void get(const std::string& path, const std::vector<std::pair<std::string, std::string>>& extra) {
+            std::vector<std::pair<std::string, std::string>> fields = {
+                {":method", "GET"}, {":scheme", "http"}, {":authority", "localhost"}, {":path", path}};
+            fields.insert(fields.end(), extra.begin(), extra.end());
+
+            std::vector<nghttp2_nv> nva;
+            for (auto& field : fields) {
+                nva.push_back({reinterpret_cast<uint8_t*>(field.first.data()),
+                               reinterpret_cast<uint8_t*>(field.second.data()),
+                               field.first.size(), field.second.size(), NGHTTP2_NV_FLAG_NONE});
+            }
+            nghttp2_submit_request(session_, nullptr, nva.data(), nva.size(), nullptr, nullptr);
+            status.clear();
+            body.clear();
+            closed_ = false;
+
+            uint8_t buffer[16384];
+            while (!closed_) {
+                nghttp2_session_send(session_);
+                boost::system::error_code ec;
+                size_t n = socket_.read_some(asio::buffer(buffer), ec);
+                if (ec) {
+                    break;
+                }
+                nghttp2_session_mem_recv(session_, buffer, n);
+            }
+        }
+
+        std::string status;
+        std::string body;
+
+    private:
+        static ssize_t send_callback(nghttp2_session*, const uint8_t* data, size_t length, int, void* user_data) {
+            auto* client = static_cast<Http2Client*>(user_data);
+            boost::system::error_code ec;
+            asio::write(client->socket_, asio::buffer(data, length), ec);
+            return ec ? NGHTTP2_ERR_CALLBACK_FAILURE : static_cast<ssize_t>(length);
+        }
+
+        static int on_header_callback(nghttp2_session*, const nghttp2_frame*, const uint8_t* name, size_t namelen,
+                                      const uint8_t* value, size_t valuelen, uint8_t, void* user_data) {
+            if (std::string(reinterpret_cast<const char*>(name), namelen) == ":status") {
+                static_cast<Http2Client*>(user_data)->status.assign(reinterpret_cast<const char*>(value), valuelen);
+            }
+            return 0;
+        }
+
+        static int on_data_chunk_recv_callback(nghttp2_session*, uint8_t, int32_t, const uint8_t* data,
+                                               size_t len, void* user_data) {
+            static_cast<Http2Client*>(user_data)->body.append(reinterpret_cast<const char*>(data), len);
+            return 0;
+        }
+
+        static int on_stream_close_callback(nghttp2_session*, int32_t, uint32_t, void* user_data) {
+            static_cast<Http2Client*>(user_data)->closed_ = true;
+            return 0;
+        }
+
+        asio::io_context ioc_;
+        tcp::socket socket_;
+        nghttp2_session* session_ = nullptr;
+        bool closed_ = false;
+    };
+
+    unsigned short freePort() {
+        asio::io_context ioc;
+        tcp::acceptor probe(ioc, tcp::endpoint(asio::ip::make_address("127.0.0.1"), 0));
+        return probe.local_endpoint().port();
+    }
+}
+
+class Http2SessionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config_.ssl.enabled = false;
+        config_.http2.enabled = true;
+        config_.http2.bindAddress = "127.0.0.1";
+        config_.http2.port = freePort();
+    }
+
+    void TearDown() override {
+        ioc_.stop();
+        if (runner_.joinable()) {
+            runner_.join();
+        }
+        if (server_) {
+            server_->stop();
+        }
+    }
+
+    void startServer(std::function<HttpResponse(const HttpRequest&)> processor) {
+        server_ = std::make_unique<Http2Server>(ioc_, config_, std::move(processor));
+        server_->start();
+        runner_ = std::thread([this] {
+            auto guard = asio::make_work_guard(ioc_);
+            ioc_.run();
+        });
+    }
+
+    ServerConfig config_;
+    asio::io_context ioc_;
+    std::unique_ptr<Http2Server> server_;
+    std::thread runner_;
+};
+
+TEST_F(Http2SessionTest, InlineRequestWithHeadersLargerThanTheArena) {
+    // No async processor: the request is built on the session arena and
+    // handled on the I/O thread
+    startServer([](const HttpRequest& request) {
+        return HttpResponse::ok(std::to_string(request.getHeader("x-large").size()));
+    });
+
+    // Well past the arena's initial 8 KB block
+    const std::string large(12 * 1024, 'h');
+    Http2Client client(static_cast<unsigned short>(config_.http2.port));
+    client.get("/large", {{"x-large", large}, {"x-other", std::string(2048, 'o')}});
+
+    EXPECT_EQ(client.status, "200");
+    EXPECT_EQ(client.body, std::to_string(large.size()));
+
+    // The arena is reset and reused for the next request on the session
+    client.get("/again", {{"x-large", "small"}});
+    EXPECT_EQ(client.status, "200");
+    EXPECT_EQ(client.body, "5");
+}
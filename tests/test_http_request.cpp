@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <cppSwitchboard/http_request.h>
+#include <nlohmann/json.hpp>
+#include <thread>
+#include <vector>
 
 using namespace cppSwitchboard;
 
@@ -109,10 +112,63 @@ TEST_F(HttpRequestTest, QueryStringParsing) {
     EXPECT_EQ(request.getQueryParam("empty"), "");
     EXPECT_EQ(request.getQueryParam("test"), "value");
     
-    // Test URL encoded values - the implementation doesn't decode URLs automatically
-    request.parseQueryString("name=John%20Doe&city=New%20York");
-    EXPECT_EQ(request.getQueryParam("name"), "John%20Doe");  // URL encoded form
-    EXPECT_EQ(request.getQueryParam("city"), "New%20York");  // URL encoded form
+    // Test URL encoded values
+    request.parseQueryString("name=John%20Doe&city=New+York");
+    EXPECT_EQ(request.getQueryParam("name"), "John Doe");
+    EXPECT_EQ(request.getQueryParam("city"), "New York");
+}
+
+TEST_F(HttpRequestTest, QueryStringDecoding) {
+    HttpRequest request("GET", "/search?q=caf%C3%A9+au+lait&path=%2Fhome%2Fuser&bad=100%&odd=%zz&a%5Bb%5D=1",
+                        "HTTP/1.1");
+    
+    EXPECT_EQ(request.getPath(), "/search");
+    EXPECT_EQ(request.getQueryParam("q"), "caf\xC3\xA9 au lait");
+    EXPECT_EQ(request.getQueryParam("path"), "/home/user");
+    EXPECT_EQ(request.getQueryParam("bad"), "100%");
+    EXPECT_EQ(request.getQueryParam("odd"), "%zz");
+    EXPECT_EQ(request.getQueryParam("a[b]"), "1");
+    
+    // Long values exercise the vectorized scan past its 16-byte blocks
+    std::string longValue(100, 'x');
+    HttpRequest longRequest("GET", "/?v=" + longValue + "%21" + longValue, "HTTP/1.1");
+    EXPECT_EQ(longRequest.getQueryParam("v"), longValue + "!" + longValue);
+}
+
+TEST_F(HttpRequestTest, RepeatedQueryParameters) {
+    HttpRequest request("GET", "/items?tag=red&tag=blue&flag&&tag=green", "HTTP/1.1");
+    
+    auto tags = request.getQueryParamValues("tag");
+    ASSERT_EQ(tags.size(), 3u);
+    EXPECT_EQ(tags[0], "red");
+    EXPECT_EQ(tags[1], "blue");
+    EXPECT_EQ(tags[2], "green");
+    
+    EXPECT_EQ(request.getQueryParam("tag"), "green");
+    EXPECT_TRUE(request.hasQueryParam("flag"));
+    EXPECT_EQ(request.getQueryParam("flag"), "");
+    EXPECT_FALSE(request.hasQueryParam("missing"));
+    EXPECT_TRUE(request.getQueryParamValues("missing").empty());
+    
+    // setQueryParam replaces every occurrence
+    request.setQueryParam("tag", "black");
+    EXPECT_EQ(request.getQueryParamValues("tag"), std::vector<std::string>{"black"});
+    
+    auto params = request.getQueryParams();
+    EXPECT_EQ(params.size(), 2u);
+    EXPECT_EQ(params["tag"], "black");
+}
+
+TEST_F(HttpRequestTest, QueryParametersSurviveCopies) {
+    std::string target = "/items?name=first%20item&page=3";
+    HttpRequest original("GET", target, "HTTP/1.1");
+    EXPECT_EQ(original.getQueryParam("page"), "3");
+    
+    HttpRequest copy(original);
+    HttpRequest moved(std::move(original));
+    EXPECT_EQ(copy.getQueryParam("name"), "first item");
+    EXPECT_EQ(moved.getQueryParam("name"), "first item");
+    EXPECT_EQ(moved.getQueryParam("page"), "3");
 }
 
 TEST_F(HttpRequestTest, HttpMethodConversion) {
@@ -174,4 +230,65 @@ TEST_F(HttpRequestTest, StreamIdManagement) {
     // Set stream ID (for HTTP/2)
     request.setStreamId(42);
     EXPECT_EQ(request.getStreamId(), 42);
-} 
\ No newline at end of file
+}
+
+TEST_F(HttpRequestTest, JsonBodyIsParsedOnceAndCached) {
+    HttpRequest request("POST", "/users", "HTTP/1.1");
+    request.setBody("{\"name\": \"John\", \"roles\": [\"admin\", \"dev\"]}");
+    
+    const nlohmann::json& first = request.json();
+    EXPECT_EQ(first["name"], "John");
+    EXPECT_EQ(first["roles"].size(), 2u);
+    EXPECT_EQ(&request.json(), &first);
+    
+    // Copies share the parsed document
+    HttpRequest copy(request, std::pmr::get_default_resource());
+    EXPECT_EQ(&copy.json(), &first);
+    
+    // Replacing the body invalidates the cache
+    request.setBody("[1, 2, 3]");
+    EXPECT_TRUE(request.json().is_array());
+    EXPECT_EQ(copy.json()["name"], "John");
+    
+    request.setBody("{not json");
+    EXPECT_THROW(request.json(), nlohmann::json::parse_error);
+}
+
+TEST_F(HttpRequestTest, LazyJsonBodyIsCached) {
+    HttpRequest request("POST", "/users", "HTTP/1.1");
+    request.setBody("{\"user\": {\"id\": 7}}");
+    
+    const LazyJson& doc = request.lazyJson();
+    ASSERT_TRUE(doc.isValid());
+    EXPECT_EQ(doc["user"]["id"].getInt(), 7);
+    EXPECT_EQ(&request.lazyJson(), &doc);
+    
+    request.setBody("{\"user\": null}");
+    EXPECT_TRUE(request.lazyJson()["user"].isNull());
+}
+
+TEST_F(HttpRequestTest, ConstAccessorsAreSafeToShare) {
+    auto request = std::make_shared<HttpRequest>("POST", "/items?page=3&tag=a&tag=b", "HTTP/1.1");
+    request->setBody("{\"id\": 7}");
+    std::shared_ptr<const HttpRequest> shared = request;
+    
+    // Every thread is the first reader of a fresh cache
+    std::vector<std::thread> readers;
+    std::vector<const nlohmann::json*> documents(8);
+    std::vector<std::string> pages(8);
+    for (size_t i = 0; i < documents.size(); ++i) {
+        readers.emplace_back([&, i]() {
+            HttpRequest copy(*shared);
+            pages[i] = shared->getQueryParam("page") + copy.getQueryParamValues("tag").back();
+            documents[i] = &shared->json();
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    for (size_t i = 0; i < documents.size(); ++i) {
+        EXPECT_EQ(pages[i], "3b");
+        EXPECT_EQ(documents[i], documents[0]);
+    }
+    EXPECT_EQ((*documents[0])["id"], 7);
+}
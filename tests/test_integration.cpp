@@ -3,6 +3,7 @@
 #include <cppSwitchboard/http_request.h>
 #include <cppSwitchboard/http_response.h>
 #include <cppSwitchboard/config.h>
+#include <boost/asio.hpp>
 #include <thread>
 #include <chrono>
 #include <fstream>
@@ -29,6 +30,30 @@ private:
     HttpRequest lastRequest_;
 };
 
+// Sends raw bytes to a local HTTP/1.1 server and reads until it closes
+static std::string exchange(int port, const std::string& bytes) {
+    namespace asio = boost::asio;
+    asio::io_context ioc;
+    asio::ip::tcp::socket socket(ioc);
+    boost::system::error_code ec;
+    const asio::ip::tcp::endpoint endpoint(asio::ip::make_address("127.0.0.1"), static_cast<unsigned short>(port));
+    for (int attempt = 0; attempt < 50; ++attempt) {
+        socket.connect(endpoint, ec);
+        if (!ec) {
+            break;
+        }
+        socket = asio::ip::tcp::socket(ioc);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    if (ec) {
+        return "";
+    }
+    asio::write(socket, asio::buffer(bytes), ec);
+    std::string reply;
+    asio::read(socket, asio::dynamic_buffer(reply), ec);
+    return reply;
+}
+
 class IntegrationTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -275,4 +300,30 @@ TEST_F(IntegrationTest, ResponseTypes) {
     
     HttpResponse errorResponse = HttpResponse::internalServerError();
     EXPECT_EQ(errorResponse.getStatus(), 500);
-} 
\ No newline at end of file
+} 
+
+TEST_F(IntegrationTest, MalformedRequestsGetClientErrors) {
+    for (const std::string parser : {"simd", "beast"}) {
+        SCOPED_TRACE(parser);
+        config.http1.parser = parser;
+        config.http1.port = parser == "simd" ? testPort : testPort + 100;
+        server = HttpServer::create(config);
+        server->get("/", [](const HttpRequest&) { return HttpResponse::ok("root"); });
+        server->start();
+        const int port = config.http1.port;
+
+        std::string reply = exchange(port, "GET / HTTP/1.1\r\nHost: localhost\r\nNo colon here\r\n\r\n");
+        EXPECT_EQ(reply.rfind("HTTP/1.1 400 ", 0), 0u) << reply;
+        EXPECT_NE(reply.find("Connection: close\r\n"), std::string::npos);
+
+        reply = exchange(port, "POST / HTTP/1.1\r\nHost: localhost\r\nContent-Length: 2000000\r\n\r\n");
+        EXPECT_EQ(reply.rfind("HTTP/1.1 413 ", 0), 0u) << reply;
+
+        reply = exchange(port, "POST / HTTP/1.1\r\nHost: localhost\r\nTransfer-Encoding: chunked\r\n\r\nzz\r\n");
+        EXPECT_EQ(reply.rfind("HTTP/1.1 400 ", 0), 0u) << reply;
+
+        reply = exchange(port, "GET / HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n");
+        EXPECT_EQ(reply.rfind("HTTP/1.1 200 ", 0), 0u) << reply;
+        server->stop();
+    }
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <cppSwitchboard/json_writer.h>
+#include <cppSwitchboard/http_response.h>
+#include <nlohmann/json.hpp>
+#include <limits>
+#include <string>
+
+using namespace cppSwitchboard;
+
+TEST(JsonWriterTest, WritesNestedDocuments) {
+    JsonWriter writer;
+    writer.beginObject()
+        .member("name", "widget")
+        .member("count", 3)
+        .member("ratio", 0.25)
+        .member("active", true);
+    writer.key("tags").beginArray().value("a").value("b").endArray();
+    writer.key("empty").beginObject().endObject();
+    writer.key("nothing").nullValue();
+    writer.key("raw").rawValue("[1,2]");
+    writer.endObject();
+
+    EXPECT_EQ(writer.view(),
+              R"({"name":"widget","count":3,"ratio":0.25,"active":true,"tags":["a","b"],)"
+              R"("empty":{},"nothing":null,"raw":[1,2]})");
+
+    std::string body = writer.take();
+    EXPECT_EQ(nlohmann::json::parse(body)["tags"][1], "b");
+    EXPECT_EQ(writer.size(), 0u);
+}
+
+TEST(JsonWriterTest, SpacedLayout) {
+    JsonWriter writer(64, JsonWriter::Spacing::SPACED);
+    writer.beginObject().member("a", 1).key("b").beginArray().value(2).value(3).endArray().endObject();
+    EXPECT_EQ(writer.view(), R"({"a": 1, "b": [2, 3]})");
+}
+
+TEST(JsonWriterTest, EscapesLikeNlohmann) {
+    // Every control character, quotes and backslashes at positions that
+    // straddle the 16-byte vector stride, plus UTF-8 passed through
+    std::string text;
+    for (int c = 0; c < 0x20; ++c) {
+        text += "abcdefghijklmno";
+        text.push_back(static_cast<char>(c));
+    }
+    text += "\"quoted\" back\\slash /slash caf\xC3\xA9 \xF0\x9F\x98\x80";
+
+    std::string escaped;
+    JsonWriter::appendString(escaped, text);
+    EXPECT_EQ(escaped, nlohmann::json(text).dump());
+    EXPECT_EQ(nlohmann::json::parse(escaped).get<std::string>(), text);
+
+    std::string plain(1000, 'x');
+    escaped.clear();
+    JsonWriter::appendString(escaped, plain);
+    EXPECT_EQ(escaped, "\"" + plain + "\"");
+}
+
+TEST(JsonWriterTest, FormatsNumbers) {
+    JsonWriter writer;
+    writer.beginArray()
+        .value(std::numeric_limits<int64_t>::min())
+        .value(std::numeric_limits<uint64_t>::max())
+        .value(static_cast<short>(-7))
+        .value(1.0)
+        .value(-2.5e-300)
+        .value(0.1)
+        .value(std::numeric_limits<double>::infinity())
+        .value(std::numeric_limits<double>::quiet_NaN())
+        .endArray();
+
+    nlohmann::json parsed = nlohmann::json::parse(writer.view());
+    EXPECT_EQ(parsed[0].get<int64_t>(), std::numeric_limits<int64_t>::min());
+    EXPECT_EQ(parsed[1].get<uint64_t>(), std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(parsed[2].get<int>(), -7);
+    EXPECT_TRUE(parsed[3].is_number_float());
+    EXPECT_DOUBLE_EQ(parsed[4].get<double>(), -2.5e-300);
+    EXPECT_EQ(parsed[5].get<double>(), 0.1);
+    EXPECT_TRUE(parsed[6].is_null());
+    EXPECT_TRUE(parsed[7].is_null());
+}
+
+TEST(JsonWriterTest, ResponseHelperWritesBodyInOnePass) {
+    HttpResponse response = HttpResponse::json([](JsonWriter& out) {
+        out.beginObject().key("items").beginArray();
+        for (int i = 0; i < 100; ++i) {
+            out.beginObject().member("id", i).member("label", "item " + std::to_string(i)).endObject();
+        }
+        out.endArray().endObject();
+    }, 4096);
+
+    EXPECT_EQ(response.getStatus(), HttpResponse::OK);
+    EXPECT_EQ(response.getContentType(), "application/json");
+    nlohmann::json parsed = nlohmann::json::parse(response.getBody());
+    ASSERT_EQ(parsed["items"].size(), 100u);
+    EXPECT_EQ(parsed["items"][99]["label"], "item 99");
+}
+
+TEST(JsonWriterTest, ErrorHelpersEscapeMessages) {
+    HttpResponse response = HttpResponse::badRequest("Unexpected \"}\" in\ninput");
+    EXPECT_EQ(response.getBody(), R"({"error": "Unexpected \"}\" in\ninput"})");
+    EXPECT_EQ(nlohmann::json::parse(response.getBody())["error"], "Unexpected \"}\" in\ninput");
+}
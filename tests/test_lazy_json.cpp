@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <cppSwitchboard/lazy_json.h>
+#include <nlohmann/json.hpp>
+#include <string>
+
+using namespace cppSwitchboard;
+
+namespace {
+    LazyJson index(const std::string& text) {
+        return LazyJson(BodyBuffer::copyOf(text));
+    }
+}
+
+TEST(LazyJsonTest, NavigatesObjectsAndArrays) {
+    LazyJson doc = index(R"( {
+        "user": {"id": 42, "name": "Ana", "active": true, "manager": null},
+        "scores": [1.5, -2, 3e2],
+        "nested": [[], {}, [{"deep": "x"}]]
+    } )");
+    ASSERT_TRUE(doc.isValid()) << doc.getError();
+
+    JsonCursor user = doc["user"];
+    EXPECT_TRUE(user.isObject());
+    EXPECT_EQ(user.size(), 4u);
+    EXPECT_EQ(user.keys(), (std::vector<std::string>{"id", "name", "active", "manager"}));
+    EXPECT_EQ(user["id"].getInt(), 42);
+    EXPECT_EQ(user["name"].getString(), "Ana");
+    EXPECT_EQ(user["active"].getBool(), true);
+    EXPECT_TRUE(user["manager"].isNull());
+
+    JsonCursor scores = doc["scores"];
+    EXPECT_EQ(scores.size(), 3u);
+    EXPECT_DOUBLE_EQ(*scores[0].getDouble(), 1.5);
+    EXPECT_EQ(scores[1].getInt(), -2);
+    EXPECT_FALSE(scores[2].getInt().has_value());
+    EXPECT_DOUBLE_EQ(*scores[2].getDouble(), 300.0);
+    EXPECT_EQ(scores[2].raw(), "3e2");
+
+    EXPECT_EQ(doc["nested"][0].size(), 0u);
+    EXPECT_EQ(doc["nested"][1].size(), 0u);
+    EXPECT_EQ(doc["nested"][2][0]["deep"].getString(), "x");
+}
+
+TEST(LazyJsonTest, MissingValuesChainSafely) {
+    LazyJson doc = index(R"({"a": [1, 2], "b": "text"})");
+    ASSERT_TRUE(doc.isValid());
+
+    EXPECT_FALSE(doc["missing"].exists());
+    EXPECT_FALSE(doc["missing"]["deeper"][3].exists());
+    EXPECT_FALSE(doc["a"][2].exists());
+    EXPECT_FALSE(doc["b"]["x"].exists());
+    EXPECT_EQ(doc["missing"].type(), JsonCursor::Type::INVALID);
+    EXPECT_FALSE(doc["b"].getInt().has_value());
+    EXPECT_FALSE(doc["a"].getString().has_value());
+    EXPECT_TRUE(doc["missing"].materialize().is_discarded());
+}
+
+TEST(LazyJsonTest, DecodesEscapes) {
+    LazyJson doc = index(R"({"k\"ey": "line\nbreak é 😀 \/", "plain": "a\\b"})");
+    ASSERT_TRUE(doc.isValid()) << doc.getError();
+
+    EXPECT_EQ(doc["k\"ey"].getString(), "line\nbreak \xC3\xA9 \xF0\x9F\x98\x80 /");
+    EXPECT_EQ(doc["plain"].getString(), "a\\b");
+    EXPECT_EQ(doc.root().keys(), (std::vector<std::string>{"k\"ey", "plain"}));
+
+    LazyJson bad = index(R"(["\ud83d", "\q"])");
+    ASSERT_TRUE(bad.isValid());
+    EXPECT_FALSE(bad[0].getString().has_value());
+    EXPECT_FALSE(bad[1].getString().has_value());
+}
+
+TEST(LazyJsonTest, MaterializesSubtreesOnly) {
+    LazyJson doc = index(R"({"skip": [1, 2, 3], "keep": {"a": [true, null], "b": 2.5}})");
+    ASSERT_TRUE(doc.isValid());
+
+    nlohmann::json keep = doc["keep"].materialize();
+    EXPECT_EQ(keep, nlohmann::json::parse(R"({"a": [true, null], "b": 2.5})"));
+    EXPECT_EQ(doc.root().materialize(), nlohmann::json::parse(std::string(doc.root().raw())));
+}
+
+TEST(LazyJsonTest, RejectsMalformedStructure) {
+    const char* invalid[] = {
+        "", "   ", "{", "[1, 2", "{\"a\" 1}", "{\"a\": 1,}", "[1,]", "[,1]", "{1: 2}",
+        "[1 2]", "{\"a\": 1]", "[1}", "\"open", "tru", "nul", "[1] [2]", "{} x", "@",
+    };
+    for (const char* text : invalid) {
+        LazyJson doc = index(text);
+        EXPECT_FALSE(doc.isValid()) << text;
+        EXPECT_FALSE(doc.getError().empty()) << text;
+        EXPECT_FALSE(doc.root().exists()) << text;
+    }
+
+    EXPECT_TRUE(index(std::string(LazyJson::MAX_DEPTH, '[') + std::string(LazyJson::MAX_DEPTH, ']')).isValid());
+    EXPECT_FALSE(index(std::string(LazyJson::MAX_DEPTH + 1, '[') + std::string(LazyJson::MAX_DEPTH + 1, ']')).isValid());
+}
+
+TEST(LazyJsonTest, AgreesWithFullParser) {
+    const std::string text = R"({"items": [)"
+        R"({"id": 1, "tags": ["a", "b"], "price": 9.99},)"
+        R"({"id": 2, "tags": [], "price": 0},)"
+        R"({"id": 3, "tags": ["c"], "price": -1.25e1, "extra": {"x": [null, false]}})"
+        R"(], "count": 3})";
+    nlohmann::json dom = nlohmann::json::parse(text);
+    LazyJson doc = index(text);
+    ASSERT_TRUE(doc.isValid());
+
+    JsonCursor items = doc["items"];
+    ASSERT_EQ(items.size(), dom["items"].size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        EXPECT_EQ(items[i]["id"].getInt(), dom["items"][i]["id"].get<int64_t>());
+        EXPECT_DOUBLE_EQ(*items[i]["price"].getDouble(), dom["items"][i]["price"].get<double>());
+        EXPECT_EQ(items[i]["tags"].size(), dom["items"][i]["tags"].size());
+        EXPECT_EQ(items[i].materialize(), dom["items"][i]);
+    }
+    EXPECT_EQ(doc["count"].getInt(), 3);
+}
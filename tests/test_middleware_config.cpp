@@ -11,6 +11,8 @@
 #include <cppSwitchboard/middleware_config.h>
 #include <cppSwitchboard/middleware_factory.h>
 #include <cppSwitchboard/middleware_pipeline.h>
+#include <cstdio>
+#include <fstream>
 #include <memory>
 #include <string>
 #include <vector>
@@ -441,6 +443,24 @@ TEST_F(MiddlewareConfigTest, HotReloadConfiguration) {
     EXPECT_TRUE(hotReload.validate(errorMessage));
 }
 
+// Test loading from a file adds it to the hot-reload watch list
+TEST_F(MiddlewareConfigTest, LoadFromFileWatchesSourceFile) {
+    std::string path = "/tmp/cppswitchboard_middleware_config_test.yaml";
+    {
+        std::ofstream out(path);
+        out << "middleware:\n"
+               "  global:\n"
+               "    - name: \"logging\"\n"
+               "  hot_reload:\n"
+               "    enabled: true\n";
+    }
+    
+    auto result = loader_->loadFromFile(path);
+    std::remove(path.c_str());
+    ASSERT_TRUE(result.isSuccess()) << result.message;
+    EXPECT_THAT(loader_->getConfiguration().hotReload.watchedFiles, ElementsAre(path));
+}
+
 // Test configuration merging
 TEST_F(MiddlewareConfigTest, ConfigurationMerging) {
     // Load base configuration
@@ -0,0 +1,204 @@
+/**
+ * @file test_middleware_config_compiler.cpp
+ * @brief Tests for the typed middleware configuration compiler
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cppSwitchboard/middleware_config_compiler.h>
+#include <cppSwitchboard/config_schema.h>
+#include <cppSwitchboard/middleware_factory.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace cppSwitchboard;
+using namespace testing;
+
+class MiddlewareConfigCompilerTest : public ::testing::Test {
+protected:
+    MiddlewareConfigCompiler compiler_{&MiddlewareFactory::getInstance()};
+    std::vector<ConfigDiagnostic> diagnostics_;
+};
+
+// Test every error is reported, each with its position
+TEST_F(MiddlewareConfigCompilerTest, ReportsEveryErrorWithPosition) {
+    std::string yaml =
+        "middleware:\n"
+        "  global:\n"
+        "    - name: \"cors\"\n"
+        "      config:\n"
+        "        max_age: soon\n"
+        "    - name: \"logging\"\n"
+        "      priority: 5000\n"
+        "    - name: \"no_such_middleware\"\n";
+
+    auto config = compiler_.compile(yaml, "", diagnostics_);
+    EXPECT_EQ(config, nullptr);
+    ASSERT_EQ(diagnostics_.size(), 3u);
+
+    EXPECT_EQ(diagnostics_[0].error, MiddlewareConfigError::VALIDATION_FAILED);
+    EXPECT_EQ(diagnostics_[0].line, 5);
+    EXPECT_EQ(diagnostics_[0].path, "middleware.global[0].config.max_age");
+    EXPECT_THAT(diagnostics_[0].message, HasSubstr("integer"));
+
+    EXPECT_EQ(diagnostics_[1].error, MiddlewareConfigError::INVALID_PRIORITY);
+    EXPECT_EQ(diagnostics_[1].line, 7);
+
+    EXPECT_EQ(diagnostics_[2].error, MiddlewareConfigError::UNKNOWN_MIDDLEWARE);
+    EXPECT_EQ(diagnostics_[2].line, 8);
+
+    auto result = MiddlewareConfigCompiler::toResult(diagnostics_);
+    EXPECT_EQ(result.error, MiddlewareConfigError::VALIDATION_FAILED);
+    EXPECT_THAT(result.message, HasSubstr("line 7:"));
+}
+
+// Test syntax errors carry the position yaml-cpp reports
+TEST_F(MiddlewareConfigCompilerTest, SyntaxErrorHasLine) {
+    auto config = compiler_.compile("middleware:\n  global: [unclosed\n", "app.yaml", diagnostics_);
+    EXPECT_EQ(config, nullptr);
+    ASSERT_EQ(diagnostics_.size(), 1u);
+    EXPECT_EQ(diagnostics_[0].error, MiddlewareConfigError::INVALID_YAML);
+    EXPECT_GT(diagnostics_[0].line, 0);
+    EXPECT_THAT(diagnostics_[0].toString(), StartsWith("app.yaml:"));
+}
+
+// Test values are converted to the types the creator's schema declares
+TEST_F(MiddlewareConfigCompilerTest, ConvertsValuesToSchemaTypes) {
+    std::string yaml =
+        "middleware:\n"
+        "  global:\n"
+        "    - name: cors\n"
+        "      config:\n"
+        "        max_age: \"600\"\n"
+        "        allow_credentials: yes\n"
+        "        allowed_origins: [\"https://example.com\"]\n"
+        "        vendor_option: 42\n";
+
+    auto config = compiler_.compile(yaml, "", diagnostics_);
+    ASSERT_NE(config, nullptr) << MiddlewareConfigCompiler::toResult(diagnostics_).message;
+    const auto& values = config->global.middlewares.at(0).config;
+    EXPECT_EQ(std::any_cast<int>(values.at("max_age")), 600);
+    EXPECT_TRUE(std::any_cast<bool>(values.at("allow_credentials")));
+    EXPECT_THAT(std::any_cast<std::vector<std::string>>(values.at("allowed_origins")),
+                ElementsAre("https://example.com"));
+    EXPECT_EQ(std::any_cast<int>(values.at("vendor_option")), 42);  // Not in the schema: inferred
+}
+
+// Test required keys and enumerations
+TEST_F(MiddlewareConfigCompilerTest, ChecksRequiredAndAllowedValues) {
+    std::string yaml =
+        "middleware:\n"
+        "  global:\n"
+        "    - name: auth\n"
+        "      config:\n"
+        "        issuer: example\n"
+        "    - name: logging\n"
+        "      config:\n"
+        "        format: xml\n";
+
+    EXPECT_EQ(compiler_.compile(yaml, "", diagnostics_), nullptr);
+    ASSERT_EQ(diagnostics_.size(), 2u);
+    EXPECT_EQ(diagnostics_[0].error, MiddlewareConfigError::MISSING_REQUIRED_CONFIG);
+    EXPECT_THAT(diagnostics_[0].message, HasSubstr("jwt_secret"));
+    EXPECT_THAT(diagnostics_[1].message, HasSubstr("must be one of"));
+}
+
+// Test a compiler without a factory checks structure only
+TEST_F(MiddlewareConfigCompilerTest, StructureOnlyWithoutFactory) {
+    MiddlewareConfigCompiler compiler;
+    std::string yaml =
+        "middleware:\n"
+        "  global:\n"
+        "    - name: anything\n"
+        "      config:\n"
+        "        limits:\n"
+        "          burst: 5\n"
+        "  routes:\n"
+        "    \"/api/*\":\n"
+        "      - name: other\n";
+
+    auto config = compiler.compile(yaml, "", diagnostics_);
+    ASSERT_NE(config, nullptr);
+    auto limits = std::any_cast<std::unordered_map<std::string, std::any>>(
+        config->global.middlewares.at(0).config.at("limits"));
+    EXPECT_EQ(std::any_cast<int>(limits.at("burst")), 5);
+    ASSERT_EQ(config->routes.size(), 1u);
+    EXPECT_EQ(config->routes[0].pattern, "/api/*");
+}
+
+// Test plugin JSON schemas
+TEST_F(MiddlewareConfigCompilerTest, ConvertsJsonSchema) {
+    std::string errorMessage;
+    auto schema = ConfigSchema::fromJsonSchema(R"({
+        "type": "object",
+        "properties": {
+            "level": {"type": "integer", "minimum": 1, "maximum": 9, "default": 6},
+            "algorithms": {"type": "array", "items": {"type": "string", "enum": ["gzip", "br"]}},
+            "name": {"type": "string"}
+        },
+        "required": ["name"],
+        "additionalProperties": false
+    })", errorMessage);
+    ASSERT_NE(schema, nullptr) << errorMessage;
+    EXPECT_TRUE(schema->isStrict());
+    ASSERT_NE(schema->findField("level"), nullptr);
+    EXPECT_EQ(std::any_cast<int>(schema->findField("level")->defaultValue), 6);
+
+    std::vector<std::string> errors;
+    EXPECT_TRUE(schema->validate({{"name", std::string("x")}, {"level", 9}}, errors));
+    EXPECT_FALSE(schema->validate({{"level", 10},
+                                   {"algorithms", std::vector<std::string>{"zstd"}},
+                                   {"extra", true}}, errors));
+    EXPECT_EQ(errors.size(), 4u);  // name missing, level range, algorithm, extra key
+
+    EXPECT_EQ(ConfigSchema::fromJsonSchema("[]", errorMessage), nullptr);
+    EXPECT_EQ(ConfigSchema::fromJsonSchema(R"({"properties": {"x": {"type": "object"}}})", errorMessage), nullptr);
+}
+
+// Test unchanged files are not compiled again
+TEST_F(MiddlewareConfigCompilerTest, CachesUnchangedFiles) {
+    std::string path = "/tmp/cppswitchboard_config_compiler_test.yaml";
+    auto write = [&path](const std::string& format) {
+        std::ofstream out(path);
+        out << "middleware:\n"
+               "  global:\n"
+               "    - name: logging\n"
+               "      config:\n"
+               "        format: " << format << "\n";
+    };
+
+    write("json");
+    auto first = compiler_.compileFile(path, diagnostics_);
+    auto second = compiler_.compileFile(path, diagnostics_);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(compiler_.getCacheHits(), 1u);
+    EXPECT_THAT(first->hotReload.watchedFiles, ElementsAre(path));
+
+    write("combined");
+    auto third = compiler_.compileFile(path, diagnostics_);
+    ASSERT_NE(third, nullptr);
+    EXPECT_NE(third, first);
+    EXPECT_EQ(std::any_cast<std::string>(third->global.middlewares.at(0).config.at("format")), "combined");
+
+    // A change to the registered creators invalidates the cache
+    MiddlewareFactory::getInstance().unregisterCreator("compiler_test_unused");
+    class UnusedCreator : public MiddlewareCreator {
+    public:
+        std::shared_ptr<Middleware> create(const MiddlewareInstanceConfig&) override { return nullptr; }
+        std::string getMiddlewareName() const override { return "compiler_test_unused"; }
+        bool validateConfig(const MiddlewareInstanceConfig&, std::string&) const override { return true; }
+    };
+    ASSERT_TRUE(MiddlewareFactory::getInstance().registerCreator(std::make_unique<UnusedCreator>()));
+    EXPECT_NE(compiler_.compileFile(path, diagnostics_), third);
+    EXPECT_EQ(compiler_.getCacheHits(), 1u);
+
+    MiddlewareFactory::getInstance().unregisterCreator("compiler_test_unused");
+    std::remove(path.c_str());
+    EXPECT_TRUE(diagnostics_.empty());
+}
@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+#include <cppSwitchboard/middleware_reloader.h>
+#include <cppSwitchboard/middleware_factory.h>
+#include <cppSwitchboard/file_watcher.h>
+#include <cppSwitchboard/http_server.h>
+#include "test_server.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using namespace cppSwitchboard;
+using cppSwitchboard::test::TestServer;
+
+namespace {
+    class TagMiddleware : public Middleware {
+    public:
+        explicit TagMiddleware(std::string tag) : tag_(std::move(tag)) {}
+        HttpResponse handle(const HttpRequest& request, Context& context, NextHandler next) override {
+            HttpResponse response = next(request, context);
+            response.setHeader("X-Tag", tag_);
+            return response;
+        }
+        std::string getName() const override { return "ReloadTag"; }
+    private:
+        std::string tag_;
+    };
+
+    class TagCreator : public MiddlewareCreator {
+    public:
+        std::shared_ptr<Middleware> create(const MiddlewareInstanceConfig& config) override {
+            return std::make_shared<TagMiddleware>(config.getString("tag"));
+        }
+        std::string getMiddlewareName() const override { return "reload_test_tag"; }
+        bool validateConfig(const MiddlewareInstanceConfig&, std::string&) const override { return true; }
+    };
+
+    std::string configWithTag(const std::string& tag, bool hotReload = true) {
+        return "middleware:\n"
+               "  global:\n"
+               "    - name: \"reload_test_tag\"\n"
+               "      config:\n"
+               "        tag: \"" + tag + "\"\n"
+               "  hot_reload:\n"
+               "    enabled: " + std::string(hotReload ? "true" : "false") + "\n";
+    }
+
+    std::string tagOf(const std::shared_ptr<const CompiledMiddlewareConfig>& generation) {
+        auto handler = generation->wrap("/", makeHandler([](const HttpRequest&) {
+            return HttpResponse::ok("ok");
+        }));
+        HttpRequest request("GET", "/", "HTTP/1.1");
+        return handler->handle(request).getHeader("X-Tag");
+    }
+
+    template <typename Predicate>
+    bool waitFor(Predicate predicate) {
+        for (int i = 0; i < 300 && !predicate(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return predicate();
+    }
+}
+
+class MiddlewareReloaderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        MiddlewareFactory::getInstance().registerCreator(std::make_unique<TagCreator>());
+        char pattern[] = "/tmp/cppswitchboard_reload_XXXXXX";
+        directory_ = mkdtemp(pattern);
+        path_ = directory_ + "/middleware.yaml";
+    }
+
+    void TearDown() override {
+        MiddlewareFactory::getInstance().unregisterCreator("reload_test_tag");
+        std::remove(path_.c_str());
+        std::remove((path_ + ".tmp").c_str());
+        rmdir(directory_.c_str());
+    }
+
+    // Replaces the file the way editors and deployment tools do
+    void writeConfig(const std::string& content) {
+        {
+            std::ofstream out(path_ + ".tmp");
+            out << content;
+        }
+        std::rename((path_ + ".tmp").c_str(), path_.c_str());
+    }
+
+    std::string directory_;
+    std::string path_;
+};
+
+TEST_F(MiddlewareReloaderTest, ReloadPublishesNewGeneration) {
+    writeConfig(configWithTag("one"));
+    MiddlewareReloader reloader(MiddlewareFactory::getInstance());
+    EXPECT_EQ(reloader.getCurrent(), nullptr);
+    ASSERT_TRUE(reloader.load(path_).isSuccess());
+
+    auto first = reloader.getCurrent();
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(tagOf(first), "one");
+
+    writeConfig(configWithTag("two"));
+    ASSERT_TRUE(reloader.reload().isSuccess());
+    EXPECT_EQ(tagOf(reloader.getCurrent()), "two");
+
+    // A request holding the old generation finishes on it
+    EXPECT_EQ(tagOf(first), "one");
+
+    auto stats = reloader.getStats();
+    EXPECT_EQ(stats.generation, 2u);
+    EXPECT_EQ(stats.reloads, 1u);
+    EXPECT_EQ(stats.failures, 0u);
+    EXPECT_GT(stats.maxLatency.count(), 0);
+}
+
+TEST_F(MiddlewareReloaderTest, FailedReloadKeepsCurrentGeneration) {
+    writeConfig(configWithTag("good"));
+    MiddlewareReloader reloader(MiddlewareFactory::getInstance());
+    ASSERT_TRUE(reloader.load(path_).isSuccess());
+    auto good = reloader.getCurrent();
+
+    MiddlewareConfigResult reported;
+    reloader.setReloadListener([&reported](const MiddlewareConfigResult& result, std::chrono::microseconds) {
+        reported = result;
+    });
+
+    writeConfig("server:\n  port: 8080\n");
+    auto result = reloader.reload();
+    EXPECT_FALSE(result.isSuccess());
+    EXPECT_EQ(reported.error, result.error);
+    EXPECT_EQ(reloader.getCurrent(), good);
+
+    auto stats = reloader.getStats();
+    EXPECT_EQ(stats.failures, 1u);
+    EXPECT_EQ(stats.generation, 1u);
+    EXPECT_FALSE(stats.lastError.empty());
+}
+
+TEST_F(MiddlewareReloaderTest, WatcherReloadsOnFileReplace) {
+    writeConfig(configWithTag("before"));
+    MiddlewareReloader reloader(MiddlewareFactory::getInstance());
+    ASSERT_TRUE(reloader.load(path_).isSuccess());
+    ASSERT_TRUE(reloader.startWatching());
+    EXPECT_TRUE(reloader.isWatching());
+
+    writeConfig(configWithTag("after"));
+    EXPECT_TRUE(waitFor([&] { return tagOf(reloader.getCurrent()) == "after"; }));
+    EXPECT_GE(reloader.getStats().reloads, 1u);
+
+    reloader.stopWatching();
+    EXPECT_FALSE(reloader.isWatching());
+}
+
+TEST_F(MiddlewareReloaderTest, FileWatcherFoldsBurstsAndIgnoresOtherFiles) {
+    writeConfig(configWithTag("x"));
+    std::atomic<int> changes{0};
+    FileWatcher watcher({path_}, [&changes] { ++changes; });
+    watcher.setDebounce(std::chrono::milliseconds(100));
+    ASSERT_TRUE(watcher.start());
+    EXPECT_TRUE(watcher.isUsingInotify());
+
+    {
+        std::ofstream other(directory_ + "/unrelated.txt");
+        other << "noise";
+    }
+    std::remove((directory_ + "/unrelated.txt").c_str());
+    for (int i = 0; i < 3; ++i) {
+        writeConfig(configWithTag("burst" + std::to_string(i)));
+    }
+
+    EXPECT_TRUE(waitFor([&] { return changes.load() > 0; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    EXPECT_EQ(changes.load(), 1);
+    watcher.stop();
+}
+
+TEST_F(MiddlewareReloaderTest, DirectoryWatcherReportsCompletedMatchingFiles) {
+    std::mutex mutex;
+    std::vector<std::string> reported;
+    FileWatcher watcher({directory_ + "/"}, {".so"}, [&](const std::vector<std::string>& changed) {
+        std::lock_guard<std::mutex> lock(mutex);
+        reported.insert(reported.end(), changed.begin(), changed.end());
+    });
+    ASSERT_TRUE(watcher.start());
+    EXPECT_TRUE(watcher.isUsingInotify());
+
+    {
+        std::ofstream library(directory_ + "/staging.tmp");
+        library << "library";
+    }
+    std::rename((directory_ + "/staging.tmp").c_str(), (directory_ + "/new_plugin.so").c_str());
+    {
+        std::ofstream other(directory_ + "/notes.txt");
+        other << "noise";
+    }
+
+    EXPECT_TRUE(waitFor([&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        return !reported.empty();
+    }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    watcher.stop();
+    std::remove((directory_ + "/new_plugin.so").c_str());
+    std::remove((directory_ + "/notes.txt").c_str());
+
+    ASSERT_EQ(reported.size(), 1u);
+    EXPECT_EQ(reported[0], directory_ + "/new_plugin.so");
+}
+
+TEST_F(MiddlewareReloaderTest, ServerRunsConfiguredMiddleware) {
+    writeConfig(configWithTag("server"));
+    TestServer server;
+    server.get("/", [](const HttpRequest&) { return HttpResponse::ok("ok"); });
+    ASSERT_TRUE(server.loadMiddlewareConfig(path_).isSuccess());
+    ASSERT_NE(server.getMiddlewareReloader(), nullptr);
+    EXPECT_TRUE(server.getMiddlewareReloader()->isWatching());
+
+    HttpRequest request("GET", "/", "HTTP/1.1");
+    EXPECT_EQ(server.processRequest(request).getHeader("X-Tag"), "server");
+
+    writeConfig(configWithTag("reloaded"));
+    EXPECT_TRUE(waitFor([&] { return server.processRequest(request).getHeader("X-Tag") == "reloaded"; }));
+}
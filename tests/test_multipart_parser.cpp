@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include <cppSwitchboard/multipart_parser.h>
+#include <cppSwitchboard/http_request.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+using namespace cppSwitchboard;
+
+namespace {
+    const std::string BOUNDARY = "----WebKitFormBoundary7MA4YWxkTrZu0gW";
+
+    std::string part(const std::string& headers, const std::string& content) {
+        return "--" + BOUNDARY + "\r\n" + headers + "\r\n" + content + "\r\n";
+    }
+
+    std::string sampleBody() {
+        return "preamble is ignored\r\n" +
+               part("Content-Disposition: form-data; name=\"title\"\r\n", "Quarterly report") +
+               part("Content-Disposition: form-data; name=\"file\"; filename=\"report \\\"q3\\\".csv\"\r\n"
+                    "Content-Type: text/csv\r\n",
+                    "a,b\r\n1,2\r\n--" + BOUNDARY.substr(0, 10) + "\r\n") +
+               part("Content-Disposition: form-data; name=\"empty\"\r\n", "") +
+               "--" + BOUNDARY + "--\r\nepilogue is ignored";
+    }
+
+    void expectSampleParts(const std::vector<MultipartPart>& parts) {
+        ASSERT_EQ(parts.size(), 3u);
+        EXPECT_EQ(parts[0].getName(), "title");
+        EXPECT_EQ(parts[0].getFilename(), "");
+        EXPECT_EQ(parts[0].getContentType(), "text/plain");
+        EXPECT_EQ(parts[0].view(), "Quarterly report");
+
+        EXPECT_EQ(parts[1].getName(), "file");
+        EXPECT_EQ(parts[1].getFilename(), "report \"q3\".csv");
+        EXPECT_EQ(parts[1].getContentType(), "text/csv");
+        EXPECT_EQ(parts[1].getHeader("content-type"), "text/csv");
+        EXPECT_EQ(parts[1].view(), "a,b\r\n1,2\r\n--" + BOUNDARY.substr(0, 10) + "\r\n");
+
+        EXPECT_EQ(parts[2].getName(), "empty");
+        EXPECT_EQ(parts[2].size(), 0u);
+    }
+
+    std::string readFile(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        std::stringstream content;
+        content << in.rdbuf();
+        return content.str();
+    }
+}
+
+TEST(MultipartParserTest, BoundaryFromContentType) {
+    EXPECT_EQ(MultipartParser::boundaryFromContentType("multipart/form-data; boundary=abc123"), "abc123");
+    EXPECT_EQ(MultipartParser::boundaryFromContentType("Multipart/Form-Data; charset=utf-8; Boundary=\"a b:c\""), "a b:c");
+    EXPECT_FALSE(MultipartParser::boundaryFromContentType("application/json; boundary=abc"));
+    EXPECT_FALSE(MultipartParser::boundaryFromContentType("multipart/form-data"));
+    EXPECT_FALSE(MultipartParser::boundaryFromContentType("multipart/form-data; boundary=" + std::string(71, 'x')));
+}
+
+TEST(MultipartParserTest, ParsesRequestBodyAsSharedSlices) {
+    HttpRequest request("POST", "/upload", "HTTP/1.1");
+    request.setHeader("Content-Type", "multipart/form-data; boundary=" + BOUNDARY);
+    request.setBody(sampleBody());
+
+    auto parts = MultipartParser::parse(request);
+    ASSERT_TRUE(parts.has_value());
+    expectSampleParts(*parts);
+
+    // Part contents point into the request body instead of being copied
+    const BodyBuffer& body = request.getBodyBuffer();
+    for (const auto& p : *parts) {
+        EXPECT_FALSE(p.isSpilled());
+        if (p.size() > 0) {
+            EXPECT_GE(p.getData().data(), body.data());
+            EXPECT_LE(p.getData().data() + p.size(), body.data() + body.size());
+        }
+    }
+}
+
+TEST(MultipartParserTest, ChunkBoundariesDoNotMatter) {
+    const std::string body = sampleBody();
+
+    for (size_t split = 0; split <= body.size(); ++split) {
+        MultipartParser parser(BOUNDARY);
+        ASSERT_TRUE(parser.feed(body.data(), split)) << split;
+        ASSERT_TRUE(parser.feed(body.data() + split, body.size() - split)) << split;
+        ASSERT_TRUE(parser.finish()) << split << ": " << parser.getError();
+        SCOPED_TRACE(split);
+        expectSampleParts(parser.getParts());
+    }
+
+    MultipartParser bytewise(BOUNDARY);
+    for (char c : body) {
+        ASSERT_TRUE(bytewise.feed(&c, 1));
+    }
+    ASSERT_TRUE(bytewise.finish());
+    expectSampleParts(bytewise.getParts());
+}
+
+TEST(MultipartParserTest, LargePartsSpillToDisk) {
+    std::string payload;
+    for (int i = 0; i < 20000; ++i) {
+        payload.push_back(static_cast<char>('a' + i % 26));
+    }
+    const std::string body =
+        part("Content-Disposition: form-data; name=\"note\"\r\n", "short") +
+        part("Content-Disposition: form-data; name=\"upload\"; filename=\"big.bin\"\r\n"
+             "Content-Type: application/octet-stream\r\n", payload) +
+        "--" + BOUNDARY + "--\r\n";
+
+    MultipartParser::Options options;
+    options.spillThreshold = 4096;
+    MultipartParser parser(BOUNDARY, options);
+
+    std::vector<MultipartPart> received;
+    parser.setPartHandler([&received](MultipartPart p) { received.push_back(std::move(p)); });
+    for (size_t offset = 0; offset < body.size(); offset += 1000) {
+        ASSERT_TRUE(parser.feed(BodyBuffer::copyOf(std::string_view(body).substr(offset, 1000))));
+    }
+    ASSERT_TRUE(parser.finish()) << parser.getError();
+    EXPECT_TRUE(parser.getParts().empty());
+
+    ASSERT_EQ(received.size(), 2u);
+    EXPECT_FALSE(received[0].isSpilled());
+    EXPECT_EQ(received[0].view(), "short");
+
+    const MultipartPart& upload = received[1];
+    EXPECT_TRUE(upload.isSpilled());
+    EXPECT_GE(upload.getFileDescriptor(), 0);
+    EXPECT_TRUE(upload.view().empty());
+    EXPECT_EQ(upload.size(), payload.size());
+    EXPECT_EQ(upload.readAll(), payload);
+
+    std::string path = "/tmp/cppswitchboard_multipart_test_" + std::to_string(::getpid());
+    std::remove(path.c_str());
+    ASSERT_TRUE(upload.saveAs(path));
+    EXPECT_EQ(readFile(path), payload);
+    std::remove(path.c_str());
+
+    ASSERT_TRUE(received[0].saveAs(path));
+    EXPECT_EQ(readFile(path), "short");
+    std::remove(path.c_str());
+}
+
+TEST(MultipartParserTest, RejectsMalformedBodies) {
+    {
+        MultipartParser parser(BOUNDARY);
+        EXPECT_TRUE(parser.feed(part("Content-Disposition: form-data; name=\"a\"\r\n", "x").data(), 10));
+        EXPECT_FALSE(parser.finish());
+        EXPECT_FALSE(parser.getError().empty());
+    }
+    {
+        MultipartParser parser(BOUNDARY);
+        std::string body = "--" + BOUNDARY + "\r\nnot a header\r\n\r\nx\r\n--" + BOUNDARY + "--";
+        EXPECT_FALSE(parser.feed(body.data(), body.size()));
+    }
+    {
+        MultipartParser parser(BOUNDARY);
+        std::string body = "--" + BOUNDARY + "garbage\r\n\r\nx\r\n--" + BOUNDARY + "--";
+        EXPECT_FALSE(parser.feed(body.data(), body.size()));
+    }
+    {
+        MultipartParser::Options options;
+        options.maxHeaderSize = 64;
+        MultipartParser parser(BOUNDARY, options);
+        std::string body = "--" + BOUNDARY + "\r\nX-Long: " + std::string(100, 'h') + "\r\n\r\n";
+        EXPECT_FALSE(parser.feed(body.data(), body.size()));
+    }
+
+    HttpRequest json("POST", "/upload", "HTTP/1.1");
+    json.setHeader("Content-Type", "application/json");
+    EXPECT_FALSE(MultipartParser::parse(json).has_value());
+}
@@ -11,6 +11,8 @@
 #include <cppSwitchboard/middleware_factory.h>
 #include <cppSwitchboard/middleware_plugin.h>
 #include <cppSwitchboard/middleware.h>
+#include <cppSwitchboard/middleware_pipeline.h>
+#include <cppSwitchboard/plugin_accounting.h>
 #include <filesystem>
 #include <fstream>
 #include <thread>
@@ -260,6 +262,255 @@ TEST_F(PluginSystemTest, HotReloadFunctionality) {
     EXPECT_TRUE(true);
 }
 
+// Test that hot-reload reacts to new plugin files without polling
+TEST_F(PluginSystemTest, HotReloadPicksUpNewPluginFiles) {
+    factory_->setPluginHotReloadEnabled(true, 60);  // Polling interval far beyond the test
+    factory_->loadPluginsFromDirectory(testPluginDir_);
+    
+    auto attemptsBefore = pluginManager_->getStatistics()["total_load_attempts"];
+    {
+        std::ofstream library(testPluginDir_ + "/late_plugin.so");
+        library << "not a shared library";
+    }
+    
+    // The watcher attempts to load the new file; it fails as it is not a library
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (pluginManager_->getStatistics()["total_load_attempts"] == attemptsBefore &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_GT(pluginManager_->getStatistics()["total_load_attempts"], attemptsBefore);
+    EXPECT_FALSE(pluginManager_->isPluginLoaded("late_plugin"));
+    
+    factory_->setPluginHotReloadEnabled(false);
+}
+
+// Test that a plugin is swapped under live middleware without unloading its code
+TEST_F(PluginSystemTest, HotSwapKeepsInUseGenerationLoaded) {
+    std::string pluginPath = testPluginDir_ + "/tag_plugin.so";
+    std::filesystem::copy_file(TEST_TAG_PLUGIN_V1, pluginPath);
+    factory_->setPluginHotReloadEnabled(true, 60);
+    ASSERT_TRUE(factory_->loadPlugin(pluginPath));
+    
+    MiddlewareInstanceConfig config;
+    config.name = "plugin_tag";
+    auto tagOf = [](const std::shared_ptr<Middleware>& middleware) {
+        HttpRequest request("GET", "/", "HTTP/1.1");
+        Context context;
+        return middleware->handle(request, context, [](const HttpRequest&, Context&) {
+            return HttpResponse::ok("ok");
+        }).getHeader("X-Plugin-Tag");
+    };
+    
+    auto inUse = factory_->createMiddleware(config);
+    ASSERT_NE(inUse, nullptr);
+    EXPECT_EQ(tagOf(inUse), "v1");
+    auto reloadsBefore = pluginManager_->getStatistics()["hot_reloads"];
+    
+    // Replace the library the way deployments do: write aside, rename over
+    std::filesystem::copy_file(TEST_TAG_PLUGIN_V2, pluginPath + ".new");
+    std::filesystem::rename(pluginPath + ".new", pluginPath);
+    
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    std::string latest;
+    while (latest != "v2" && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        auto fresh = factory_->createMiddleware(config);
+        latest = fresh ? tagOf(fresh) : "";
+    }
+    EXPECT_EQ(latest, "v2");
+    EXPECT_EQ(pluginManager_->getStatistics()["hot_reloads"], reloadsBefore + 1);
+    EXPECT_TRUE(pluginManager_->isPluginLoaded("TagPlugin"));
+    
+    // Middleware created before the swap still runs the first generation's code
+    EXPECT_EQ(tagOf(inUse), "v1");
+    inUse.reset();
+    
+    factory_->setPluginHotReloadEnabled(false);
+}
+
+// Test parallel discovery initializes a plugin after the plugin it requires
+TEST_F(PluginSystemTest, ParallelLoadingFollowsDependencies) {
+    // Named so that directory order would put the dependent plugin first
+    std::filesystem::copy_file(TEST_TAG_PLUGIN_DEPENDENT, testPluginDir_ + "/a_dependent.so");
+    std::filesystem::copy_file(TEST_TAG_PLUGIN_V1, testPluginDir_ + "/z_tag.so");
+    
+    const PluginDiscoveryConfig original = pluginManager_->getDiscoveryConfig();
+    PluginDiscoveryConfig config = original;
+    config.searchDirectories = {testPluginDir_};
+    config.loadConcurrency = 4;
+    pluginManager_->setDiscoveryConfig(config);
+    
+    std::vector<std::string> loadOrder;
+    pluginManager_->setEventCallback([&loadOrder](const std::string& event, const std::string& name, const std::string&) {
+        if (event == "loaded") {
+            loadOrder.push_back(name);
+        }
+    });
+    auto results = pluginManager_->discoverAndLoadPlugins();
+    pluginManager_->setEventCallback(nullptr);
+    pluginManager_->setDiscoveryConfig(original);
+    
+    ASSERT_EQ(results.size(), 2u);
+    for (const auto& [path, result] : results) {
+        EXPECT_EQ(result.first, PluginLoadResult::SUCCESS) << path;
+    }
+    EXPECT_EQ(loadOrder, (std::vector<std::string>{"TagPlugin", "DependentTagPlugin"}));
+}
+
+// Test a plugin exporting the C ABI descriptor through the pipeline fast path
+TEST_F(PluginSystemTest, CAbiPluginRunsInPipeline) {
+    ASSERT_TRUE(factory_->loadPlugin(TEST_C_HEADER_PLUGIN));
+    EXPECT_TRUE(pluginManager_->isPluginLoaded("CHeaderPlugin"));
+    
+    MiddlewareInstanceConfig config;
+    config.name = "c_header";
+    config.config["header"] = std::string("X-From-C");
+    config.config["value"] = std::string("yes");
+    auto middleware = factory_->createMiddleware(config);
+    ASSERT_NE(middleware, nullptr);
+    EXPECT_EQ(middleware->getName(), "c_header");
+    EXPECT_EQ(middleware->getPriority(), 50);
+    
+    MiddlewarePipeline pipeline;
+    pipeline.addMiddleware(middleware);
+    int handlerCalls = 0;
+    pipeline.setFinalHandler(std::make_shared<FunctionHandler>([&](const HttpRequest&) {
+        ++handlerCalls;
+        return HttpResponse::ok("ok");
+    }));
+    
+    HttpRequest request("GET", "/c/path", "HTTP/1.1");
+    Context context;
+    HttpResponse response = pipeline.execute(request, context);
+    EXPECT_EQ(response.getStatus(), 200);
+    EXPECT_EQ(response.getHeader("X-From-C"), "yes");
+    EXPECT_EQ(std::any_cast<std::string>(context["c_plugin.path"]), "/c/path");
+    EXPECT_EQ(handlerCalls, 1);
+    
+    // on_request answers without running the rest of the chain
+    HttpRequest blocked("GET", "/c/path", "HTTP/1.1");
+    blocked.setHeader("X-Block", "1");
+    Context blockedContext;
+    response = pipeline.execute(blocked, blockedContext);
+    EXPECT_EQ(response.getStatus(), 403);
+    EXPECT_EQ(response.getBody(), "blocked");
+    EXPECT_EQ(handlerCalls, 1);
+    
+    // Outside a pipeline the hooks run around next()
+    Context direct;
+    response = middleware->handle(request, direct, [](const HttpRequest&, Context&) {
+        return HttpResponse::ok("ok");
+    });
+    EXPECT_EQ(response.getHeader("X-From-C"), "yes");
+    
+    // Every run of the hooks was charged to the plugin
+    EXPECT_EQ(factory_->getPluginUsage("CHeaderPlugin").calls, 3u);
+    
+    middleware.reset();
+}
+
+// Middleware whose failures and latency the tests control
+class FaultyMiddleware : public Middleware {
+public:
+    HttpResponse handle(const HttpRequest& request, Context& context, NextHandler next) override {
+        if (delay.count() > 0) {
+            std::this_thread::sleep_for(delay);
+        }
+        if (fail) {
+            throw std::runtime_error("plugin failure");
+        }
+        return next(request, context);
+    }
+    std::string getName() const override { return "faulty"; }
+    
+    bool fail = false;
+    std::chrono::milliseconds delay{0};
+};
+
+// Test the circuit breaker bypassing a failing plugin and recovering
+TEST_F(PluginSystemTest, CircuitBreakerBypassesFailingPlugin) {
+    auto faulty = std::make_shared<FaultyMiddleware>();
+    auto account = std::make_shared<PluginAccount>("FaultyPlugin");
+    PluginBudget budget;
+    budget.maxFailureRate = 0.5;
+    budget.minCalls = 4;
+    budget.openDuration = std::chrono::milliseconds(30);
+    account->setBudget(budget);
+    
+    MiddlewarePipeline pipeline;
+    pipeline.addMiddleware(std::make_shared<AccountedMiddleware>(faulty, account));
+    pipeline.setFinalHandler(std::make_shared<FunctionHandler>([](const HttpRequest&) {
+        return HttpResponse::ok("ok");
+    }));
+    HttpRequest request("GET", "/", "HTTP/1.1");
+    
+    faulty->fail = true;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_THROW(pipeline.execute(request), PipelineException);
+    }
+    EXPECT_EQ(account->getState(), PluginCircuitState::OPEN);
+    
+    // Fail-open: the chain continues without the plugin
+    EXPECT_EQ(pipeline.execute(request).getStatus(), 200);
+    
+    // The trial call after the open period fails and opens the circuit again
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    EXPECT_THROW(pipeline.execute(request), PipelineException);
+    EXPECT_EQ(account->getState(), PluginCircuitState::OPEN);
+    
+    faulty->fail = false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    EXPECT_EQ(pipeline.execute(request).getStatus(), 200);
+    EXPECT_EQ(account->getState(), PluginCircuitState::CLOSED);
+    
+    PluginUsage usage = account->getUsage();
+    EXPECT_EQ(usage.calls, 6u);
+    EXPECT_EQ(usage.exceptions, 5u);
+    EXPECT_EQ(usage.bypassed, 1u);
+    EXPECT_EQ(usage.trips, 2u);
+}
+
+// Test latency budgets charging only the plugin's own time, and failing closed
+TEST_F(PluginSystemTest, CircuitBreakerRejectsSlowPlugin) {
+    auto faulty = std::make_shared<FaultyMiddleware>();
+    auto account = std::make_shared<PluginAccount>("SlowPlugin");
+    PluginBudget budget;
+    budget.maxLatency = std::chrono::milliseconds(10);
+    budget.maxFailureRate = 0.0;
+    budget.minCalls = 1;
+    budget.failureMode = PluginFailureMode::FAIL_CLOSED;
+    account->setBudget(budget);
+    
+    MiddlewarePipeline pipeline;
+    pipeline.addMiddleware(std::make_shared<AccountedMiddleware>(faulty, account));
+    pipeline.setFinalHandler(std::make_shared<FunctionHandler>([](const HttpRequest&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return HttpResponse::ok("ok");
+    }));
+    HttpRequest request("GET", "/", "HTTP/1.1");
+    
+    // A slow handler is not the plugin's latency
+    EXPECT_EQ(pipeline.execute(request).getStatus(), 200);
+    EXPECT_EQ(account->getUsage().slowCalls, 0u);
+    EXPECT_LT(account->getUsage().maxWallTime, std::chrono::milliseconds(10));
+    
+    faulty->delay = std::chrono::milliseconds(15);
+    EXPECT_EQ(pipeline.execute(request).getStatus(), 200);
+    EXPECT_EQ(account->getState(), PluginCircuitState::OPEN);
+    
+    HttpResponse rejected = pipeline.execute(request);
+    EXPECT_EQ(rejected.getStatus(), 503);
+    EXPECT_FALSE(rejected.getHeader("Retry-After").empty());
+    EXPECT_NE(rejected.getCanned(), nullptr);
+    
+    PluginUsage usage = account->getUsage();
+    EXPECT_EQ(usage.calls, 2u);
+    EXPECT_EQ(usage.slowCalls, 1u);
+    EXPECT_EQ(usage.rejected, 1u);
+    EXPECT_GE(usage.maxWallTime, std::chrono::milliseconds(15));
+}
+
 // Test plugin validation
 TEST_F(PluginSystemTest, PluginValidation) {
     MockPlugin plugin;
@@ -0,0 +1,156 @@
+/**
+ * @file test_queue_delay.cpp
+ * @brief Tests for queue-delay admission control
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ */
+
+#include <gtest/gtest.h>
+#include <cppSwitchboard/queue_delay.h>
+#include <cppSwitchboard/worker_pool.h>
+#include <cppSwitchboard/http_server.h>
+#include "test_server.h"
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace cppSwitchboard;
+using namespace std::chrono_literals;
+
+namespace {
+    using Clock = QueueDelayController::Clock;
+
+    AdmissionControlConfig enabledConfig() {
+        AdmissionControlConfig config;
+        config.enabled = true;
+        config.target = 5ms;
+        config.interval = 100ms;
+        return config;
+    }
+
+    class SheddingServer : public test::TestServer {
+    public:
+        SheddingServer() {
+            AdmissionControlConfig admission;
+            admission.enabled = true;
+            admission.target = 1ms;
+            admission.interval = 1ms;
+            queueDelay_->configure(admission);
+        }
+    };
+}
+
+// Test only a delay that stays above target for an interval sheds requests
+TEST(QueueDelayTest, ShedsOnSustainedDelay) {
+    QueueDelayController controller(enabledConfig());
+    std::vector<bool> transitions;
+    controller.setOverloadListener([&transitions](bool overloaded) { transitions.push_back(overloaded); });
+    ASSERT_EQ(transitions, std::vector<bool>{false});
+
+    const auto t = Clock::now();
+    // A burst that clears within the interval is let through
+    EXPECT_TRUE(controller.admit(t - 10ms, t));
+    EXPECT_TRUE(controller.admit(t + 40ms, t + 50ms));
+    EXPECT_TRUE(controller.admit(t + 59ms, t + 60ms));
+    EXPECT_TRUE(controller.admit(t + 140ms, t + 150ms));
+    EXPECT_FALSE(controller.isOverloaded());
+
+    // Above target from t+150ms on
+    EXPECT_TRUE(controller.admit(t + 190ms, t + 200ms));
+    EXPECT_FALSE(controller.admit(t + 240ms, t + 250ms));
+    EXPECT_TRUE(controller.isOverloaded());
+
+    // Fresh requests run while old ones are shed; overload ends after an
+    // interval within target
+    EXPECT_TRUE(controller.admit(t + 259ms, t + 260ms));
+    EXPECT_FALSE(controller.admit(t + 200ms, t + 270ms));
+    EXPECT_TRUE(controller.admit(t + 279ms, t + 280ms));
+    EXPECT_TRUE(controller.admit(t + 360ms, t + 361ms));
+    EXPECT_TRUE(controller.isOverloaded());
+    EXPECT_TRUE(controller.admit(t + 380ms, t + 381ms));
+    EXPECT_FALSE(controller.isOverloaded());
+
+    auto stats = controller.getStats();
+    EXPECT_TRUE(stats.enabled);
+    EXPECT_EQ(stats.dropped, 2u);
+    EXPECT_EQ(stats.admitted, 9u);
+    EXPECT_EQ(stats.overloads, 1u);
+    EXPECT_EQ(stats.lastDelay, 1ms);
+    EXPECT_EQ(stats.maxDelay, 70ms);
+    EXPECT_EQ(transitions, (std::vector<bool>{false, true, false}));
+}
+
+// Test a disabled controller measures without shedding
+TEST(QueueDelayTest, DisabledOnlyMeasures) {
+    QueueDelayController controller;
+    const auto t = Clock::now();
+    EXPECT_TRUE(controller.admit(t - 1s, t));
+    EXPECT_TRUE(controller.admit(t - 1s, t + 1s));
+    EXPECT_TRUE(controller.admit(Clock::time_point{}, t));
+
+    auto stats = controller.getStats();
+    EXPECT_FALSE(stats.enabled);
+    EXPECT_EQ(stats.admitted, 3u);
+    EXPECT_EQ(stats.maxDelay, 2s);
+
+    controller.configure(enabledConfig());
+    EXPECT_TRUE(controller.admit(Clock::time_point{}, t + 1h));  // Unmeasured
+    EXPECT_EQ(controller.getStats().dropped, 0u);
+}
+
+// Test the injection queue serves the newest task first in LIFO mode
+TEST(QueueDelayTest, WorkerPoolLifoOrder) {
+    WorkerPool pool(1);
+    std::promise<void> started;
+    std::promise<void> release;
+    pool.submit([&started, &release]() {
+        started.set_value();
+        release.get_future().wait();
+    });
+    started.get_future().wait();
+
+    std::mutex mutex;
+    std::vector<int> order;
+    for (int i = 0; i < 3; ++i) {
+        pool.submit([i, &mutex, &order]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(i);
+        });
+    }
+    pool.setLifo(true);
+    EXPECT_TRUE(pool.isLifo());
+    release.set_value();
+    pool.shutdown();
+    EXPECT_EQ(order, (std::vector<int>{2, 1, 0}));
+}
+
+// Test requests that waited too long are answered with a fast 503
+TEST(QueueDelayTest, ServerShedsStaleRequests) {
+    SheddingServer server;
+    server.registerHandler("/work", HttpMethod::GET, makeHandler([](const HttpRequest&) {
+        return HttpResponse::ok("done");
+    }));
+
+    auto schedule = [&server](Clock::time_point receivedAt) {
+        auto request = std::make_shared<HttpRequest>("GET", "/work", "HTTP/2");
+        request->setReceivedAt(receivedAt);
+        std::promise<HttpResponse> response;
+        server.scheduleRequest(request, [&response](HttpResponse result) { response.set_value(result); });
+        return response.get_future().get();
+    };
+
+    EXPECT_EQ(schedule(Clock::now() - 1s).getBody(), "done");
+    std::this_thread::sleep_for(2ms);
+    HttpResponse shed = schedule(Clock::now() - 1s);
+    EXPECT_EQ(shed.getStatus(), HttpResponse::SERVICE_UNAVAILABLE);
+    EXPECT_EQ(shed.getHeader("Retry-After"), "1");
+    EXPECT_NE(shed.getCanned(), nullptr);
+    EXPECT_EQ(schedule(Clock::time_point{}).getBody(), "done");
+
+    auto stats = server.getQueueDelayStats();
+    EXPECT_TRUE(stats.overloaded);
+    EXPECT_EQ(stats.dropped, 1u);
+    EXPECT_GE(stats.maxDelay, std::chrono::microseconds(1s));
+}
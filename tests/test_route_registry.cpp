@@ -232,4 +232,81 @@ TEST_F(RouteRegistryTest, CaseSensitiveRoutes) {
     auto result2 = registry->findRoute(request2);
     // This test assumes case-sensitive matching; adjust if implementation differs
     EXPECT_TRUE(result2.handler == nullptr);
-} 
\ No newline at end of file
+} 
+TEST_F(RouteRegistryTest, MethodNotAllowedReportsAllowedMethods) {
+    registry->registerRoute("/api/users/{id}", HttpMethod::POST, testHandler);
+    registry->registerRoute("/api/users/{id}", HttpMethod::GET, testHandler);
+
+    HttpRequest request("DELETE", "/api/users/7", "HTTP/1.1");
+    auto result = registry->findRoute(request);
+    EXPECT_TRUE(result.handler == nullptr);
+    EXPECT_TRUE(result.pathMatched);
+    EXPECT_EQ(result.allowHeader(), "GET, POST, HEAD, OPTIONS");
+
+    HttpRequest unknown("GET", "/api/orders/7", "HTTP/1.1");
+    auto missing = registry->findRoute(unknown);
+    EXPECT_FALSE(missing.pathMatched);
+    EXPECT_TRUE(missing.allowedMethods.empty());
+}
+
+TEST_F(RouteRegistryTest, HeadFallsBackToGet) {
+    auto getHandler = std::make_shared<TestHandler>("get");
+    auto headHandler = std::make_shared<TestHandler>("head");
+    registry->registerRoute("/files/{name}", HttpMethod::GET, getHandler);
+
+    HttpRequest request("HEAD", "/files/a.txt", "HTTP/1.1");
+    auto result = registry->findRoute(request);
+    EXPECT_EQ(result.handler, getHandler);
+    EXPECT_EQ(result.pathParams.at("name"), "a.txt");
+
+    // An explicit HEAD route takes precedence over the fallback
+    registry->registerRoute("/files/{name}", HttpMethod::HEAD, headHandler);
+    EXPECT_EQ(registry->findRoute(request).handler, headHandler);
+}
+
+TEST_F(RouteRegistryTest, LiteralPathsTakePrecedenceOverPatterns) {
+    auto wildcard = std::make_shared<TestHandler>("wildcard");
+    auto literal = std::make_shared<TestHandler>("literal");
+    registry->registerRoute("/api/*", HttpMethod::GET, wildcard);
+    registry->registerRoute("/api/users", HttpMethod::GET, literal);
+    registry->registerRoute("/api/status", HttpMethod::POST, literal);
+
+    HttpRequest users("GET", "/api/users", "HTTP/1.1");
+    EXPECT_EQ(registry->findRoute(users).handler, literal);
+
+    // A literal path without the requested method still reaches the pattern
+    HttpRequest status("GET", "/api/status", "HTTP/1.1");
+    EXPECT_EQ(registry->findRoute(status).handler, wildcard);
+}
+
+TEST_F(RouteRegistryTest, DotsAreLiteral) {
+    auto favicon = std::make_shared<TestHandler>("favicon");
+    auto health = std::make_shared<TestHandler>("health");
+    registry->registerRoute("/favicon.ico", HttpMethod::GET, favicon);
+    registry->registerRoute("/v1.0/{check}", HttpMethod::GET, health);
+
+    EXPECT_EQ(registry->findRoute(HttpRequest("GET", "/favicon.ico", "HTTP/1.1")).handler, favicon);
+    EXPECT_EQ(registry->findRoute(HttpRequest("GET", "/favicon-ico", "HTTP/1.1")).handler, nullptr);
+    EXPECT_EQ(registry->findRoute(HttpRequest("GET", "/v1.0/health", "HTTP/1.1")).handler, health);
+    EXPECT_EQ(registry->findRoute(HttpRequest("GET", "/v1x0/health", "HTTP/1.1")).handler, nullptr);
+}
+
+TEST_F(RouteRegistryTest, RemoveAndClearRoutes) {
+    registry->registerRoute("/a", HttpMethod::GET, testHandler);
+    registry->registerRoute("/a", HttpMethod::POST, testHandler);
+    registry->registerRoute("/b/{id}", HttpMethod::GET, testHandler);
+    EXPECT_EQ(registry->getAllRoutes().size(), 3u);
+
+    registry->removeRoute("/a", HttpMethod::GET);
+    HttpRequest request("GET", "/a", "HTTP/1.1");
+    auto result = registry->findRoute(request);
+    EXPECT_TRUE(result.handler == nullptr);
+    EXPECT_EQ(result.allowHeader(), "POST, OPTIONS");
+
+    registry->removeRoute("/a", HttpMethod::POST);
+    EXPECT_FALSE(registry->findRoute(request).pathMatched);
+    EXPECT_EQ(registry->getAllRoutes().size(), 1u);
+
+    registry->clear();
+    EXPECT_TRUE(registry->getAllRoutes().empty());
+}
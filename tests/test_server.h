@@ -0,0 +1,37 @@
+/**
+ * @file test_server.h
+ * @brief HttpServer that processes requests without starting listeners
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ */
+
+#pragma once
+
+#include <cppSwitchboard/http_server.h>
+
+namespace cppSwitchboard {
+namespace test {
+
+/**
+ * @brief Exposes request processing without starting listeners
+ *
+ * Suites needing a worker pool or admission control derive from it and set
+ * the protected members in their constructor.
+ */
+class TestServer : public HttpServer {
+public:
+    TestServer() = default;
+    explicit TestServer(const ServerConfig& config) : HttpServer(config) {}
+
+    using HttpServer::processRequest;
+    using HttpServer::executeRequest;
+    using HttpServer::scheduleRequest;
+
+protected:
+    void runHttp1Server() override {}
+    void runHttp2Server() override {}
+};
+
+} // namespace test
+} // namespace cppSwitchboard
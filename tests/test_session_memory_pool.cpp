@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <cppSwitchboard/session_memory_pool.h>
+#include <cppSwitchboard/buffer_pool.h>
+#include <nghttp2/nghttp2.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace cppSwitchboard;
+
+TEST(SessionMemoryPoolTest, BlocksAreAlignedAndWritable) {
+    SessionMemoryPool pool;
+    std::vector<void*> blocks;
+    for (size_t size : {1u, 17u, 100u, 1000u, 2048u, 5000u}) {
+        void* p = pool.allocate(size);
+        ASSERT_NE(p, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % alignof(std::max_align_t), 0u);
+        std::memset(p, 0xAB, size);
+        blocks.push_back(p);
+    }
+    for (void* p : blocks) {
+        pool.deallocate(p);
+    }
+    EXPECT_EQ(pool.getStatistics()["live_blocks"], 0u);
+    EXPECT_EQ(pool.getStatistics()["large_blocks"], 0u);
+}
+
+TEST(SessionMemoryPoolTest, FreedBlocksAreReused) {
+    SessionMemoryPool pool;
+    void* first = pool.allocate(48);
+    pool.deallocate(first);
+
+    void* second = pool.allocate(60);
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(pool.getStatistics()["reused_blocks"], 1u);
+    EXPECT_EQ(pool.getStatistics()["chunks"], 1u);
+    pool.deallocate(second);
+}
+
+TEST(SessionMemoryPoolTest, CallocZeroesMemory) {
+    SessionMemoryPool pool;
+    void* dirty = pool.allocate(256);
+    std::memset(dirty, 0xFF, 256);
+    pool.deallocate(dirty);
+
+    auto* zeroed = static_cast<uint8_t*>(pool.callocate(16, 16));
+    for (size_t i = 0; i < 256; ++i) {
+        ASSERT_EQ(zeroed[i], 0) << "byte " << i;
+    }
+    EXPECT_EQ(pool.callocate(SIZE_MAX, 2), nullptr);
+}
+
+TEST(SessionMemoryPoolTest, ReallocPreservesContents) {
+    SessionMemoryPool pool;
+    auto* p = static_cast<char*>(pool.reallocate(nullptr, 20));
+    std::strcpy(p, "hpack-entry");
+
+    // Fits in the same size class: no move
+    EXPECT_EQ(pool.reallocate(p, 30), p);
+
+    p = static_cast<char*>(pool.reallocate(p, 4000));
+    EXPECT_STREQ(p, "hpack-entry");
+    EXPECT_EQ(pool.getStatistics()["large_blocks"], 1u);
+
+    p = static_cast<char*>(pool.reallocate(p, 64));
+    EXPECT_STREQ(p, "hpack-entry");
+    EXPECT_EQ(pool.getStatistics()["large_blocks"], 0u);
+
+    EXPECT_EQ(pool.reallocate(p, 0), nullptr);
+    EXPECT_EQ(pool.getStatistics()["live_blocks"], 0u);
+}
+
+TEST(SessionMemoryPoolTest, LeftoverBlocksReleasedInBulk) {
+    auto& buffers = BufferPool::getInstance();
+    size_t outstanding = buffers.getStatistics()["outstanding_blocks"];
+    {
+        SessionMemoryPool pool;
+        for (int i = 0; i < 500; ++i) {
+            pool.allocate(static_cast<size_t>(32 + (i % 7) * 300));
+        }
+        EXPECT_GT(buffers.getStatistics()["outstanding_blocks"], outstanding);
+    }
+    EXPECT_EQ(buffers.getStatistics()["outstanding_blocks"], outstanding);
+}
+
+TEST(SessionMemoryPoolTest, DrivesNghttp2Session) {
+    SessionMemoryPool pool;
+    nghttp2_mem mem = {
+        &pool,
+        [](size_t size, void* ud) { return static_cast<SessionMemoryPool*>(ud)->allocate(size); },
+        [](void* ptr, void* ud) { static_cast<SessionMemoryPool*>(ud)->deallocate(ptr); },
+        [](size_t n, size_t size, void* ud) { return static_cast<SessionMemoryPool*>(ud)->callocate(n, size); },
+        [](void* ptr, size_t size, void* ud) { return static_cast<SessionMemoryPool*>(ud)->reallocate(ptr, size); }
+    };
+
+    nghttp2_session_callbacks* callbacks;
+    ASSERT_EQ(nghttp2_session_callbacks_new(&callbacks), 0);
+    nghttp2_session* session = nullptr;
+    ASSERT_EQ(nghttp2_session_server_new3(&session, callbacks, nullptr, nullptr, &mem), 0);
+    nghttp2_session_callbacks_del(callbacks);
+
+    EXPECT_GT(pool.getStatistics()["live_blocks"], 0u);
+
+    // Client preface followed by an empty SETTINGS frame
+    std::string input = NGHTTP2_CLIENT_MAGIC;
+    const uint8_t settings[] = {0, 0, 0, 4, 0, 0, 0, 0, 0};
+    input.append(reinterpret_cast<const char*>(settings), sizeof(settings));
+    EXPECT_EQ(nghttp2_session_mem_recv(session, reinterpret_cast<const uint8_t*>(input.data()), input.size()),
+              static_cast<ssize_t>(input.size()));
+
+    nghttp2_session_del(session);
+    EXPECT_EQ(pool.getStatistics()["live_blocks"], 0u);
+}
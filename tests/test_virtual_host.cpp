@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <cppSwitchboard/virtual_host.h>
+#include <cppSwitchboard/http_server.h>
+#include "test_server.h"
+#include <stdexcept>
+#include <string>
+
+using namespace cppSwitchboard;
+using cppSwitchboard::test::TestServer;
+
+namespace {
+    class TagMiddleware : public Middleware {
+    public:
+        TagMiddleware(std::string tag, int priority) : tag_(std::move(tag)), priority_(priority) {}
+        HttpResponse handle(const HttpRequest& request, Context& context, NextHandler next) override {
+            HttpResponse response = next(request, context);
+            response.setHeader("X-Chain", tag_ + response.getHeader("X-Chain"));
+            return response;
+        }
+        std::string getName() const override { return "TagMiddleware"; }
+        int getPriority() const override { return priority_; }
+    private:
+        std::string tag_;
+        int priority_;
+    };
+
+    HttpRequest requestFor(const std::string& host, const std::string& path) {
+        HttpRequest request("GET", path, "HTTP/1.1");
+        request.setHeader("Host", host);
+        return request;
+    }
+}
+
+TEST(VirtualHostTest, NormalizesHostNames) {
+    EXPECT_EQ(VirtualHostRouter::normalize("API.Example.COM"), "api.example.com");
+    EXPECT_EQ(VirtualHostRouter::normalize("example.com:8443"), "example.com");
+    EXPECT_EQ(VirtualHostRouter::normalize("example.com."), "example.com");
+    EXPECT_EQ(VirtualHostRouter::normalize("[::1]:8080"), "[::1]");
+}
+
+TEST(VirtualHostTest, ExactBeforeMostSpecificWildcard) {
+    VirtualHostRouter router;
+    EXPECT_EQ(router.findHost("example.com"), nullptr);
+
+    auto exact = router.addHost("shop.eu.example.com");
+    auto eu = router.addHost("*.eu.example.com");
+    auto any = router.addHost("*.Example.com");
+    EXPECT_EQ(router.addHost("shop.eu.example.com"), exact);
+    EXPECT_EQ(any->getPattern(), "*.example.com");
+
+    EXPECT_EQ(router.findHost("Shop.EU.example.com:443"), exact);
+    EXPECT_EQ(router.findHost("cart.eu.example.com"), eu);
+    EXPECT_EQ(router.findHost("a.b.us.example.com"), any);
+    EXPECT_EQ(router.findHost("example.com"), nullptr);
+    EXPECT_EQ(router.findHost("example.org"), nullptr);
+    EXPECT_EQ(router.findHost(""), nullptr);
+
+    EXPECT_THROW(router.addHost(""), std::invalid_argument);
+    EXPECT_THROW(router.addHost("api.*.example.com"), std::invalid_argument);
+    EXPECT_THROW(router.addHost("*"), std::invalid_argument);
+}
+
+TEST(VirtualHostTest, ServerRoutesByHostBeforePath) {
+    TestServer server;
+    server.get("/", [](const HttpRequest&) { return HttpResponse::ok("default"); });
+    server.virtualHost("api.example.com")->get("/", [](const HttpRequest&) {
+        return HttpResponse::ok("api");
+    });
+    server.virtualHost("*.tenants.example.com")->get("/users/{id}", [](const HttpRequest& request) {
+        return HttpResponse::ok("tenant " + request.getPathParam("id"));
+    });
+
+    EXPECT_EQ(server.processRequest(requestFor("api.example.com", "/")).getBody(), "api");
+    EXPECT_EQ(server.processRequest(requestFor("other.example.com", "/")).getBody(), "default");
+    EXPECT_EQ(server.processRequest(requestFor("acme.tenants.example.com", "/users/7")).getBody(), "tenant 7");
+
+    // Each host has its own table: no fallback to the default host's paths
+    EXPECT_EQ(server.processRequest(requestFor("acme.tenants.example.com", "/")).getStatus(),
+              HttpResponse::NOT_FOUND);
+}
+
+TEST(VirtualHostTest, GlobalMiddlewareIsPerHost) {
+    TestServer server;
+    server.get("/", [](const HttpRequest&) { return HttpResponse::ok("default"); });
+    server.registerMiddleware(std::make_shared<TagMiddleware>("d", 0));
+
+    auto api = server.virtualHost("api.example.com");
+    api->get("/", [](const HttpRequest&) { return HttpResponse::ok("api"); });
+    api->registerMiddleware(std::make_shared<TagMiddleware>("low", 1));
+    api->registerMiddleware(std::make_shared<TagMiddleware>("high", 10));
+
+    // Higher priority runs first, so its tag ends up outermost
+    EXPECT_EQ(server.processRequest(requestFor("api.example.com", "/")).getHeader("X-Chain"), "highlow");
+    EXPECT_EQ(server.processRequest(requestFor("api.example.com", "/missing")).getHeader("X-Chain"), "highlow");
+    EXPECT_EQ(server.processRequest(requestFor("www.example.com", "/")).getHeader("X-Chain"), "d");
+}
@@ -0,0 +1,195 @@
+/**
+ * @file test_worker_pool.cpp
+ * @brief Tests for the work-stealing worker pool
+ * @author Jordan Vrtanoski <jordan.vrtanoski@gmail.com>
+ * @date 2025-06-27
+ * @version 1.2.0
+ */
+
+#include <gtest/gtest.h>
+#include <cppSwitchboard/worker_pool.h>
+#include <cppSwitchboard/http_server.h>
+#include "test_server.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+using namespace cppSwitchboard;
+
+namespace {
+    uint64_t totalExecuted(const WorkerPool& pool) {
+        uint64_t total = 0;
+        for (const auto& stats : pool.getWorkerStats()) {
+            total += stats.executed;
+        }
+        return total;
+    }
+
+    class PooledServer : public test::TestServer {
+    public:
+        explicit PooledServer(size_t workers) {
+            workerPool_ = std::make_shared<WorkerPool>(workers);
+        }
+        ServerConfig& config() { return config_; }
+    };
+
+    // Answers from a continuation queued on the worker running the handler
+    class ContinuationHandler : public AsyncHttpHandler {
+    public:
+        void handleAsync(const HttpRequest& request, ResponseCallback callback) override {
+            WorkerPool* pool = WorkerPool::current();
+            if (!pool) {
+                callback(HttpResponse::internalServerError("not on a worker"));
+                return;
+            }
+            std::string id = request.getPathParam("id");
+            pool->submit([callback, id]() { callback(HttpResponse::ok("item " + id)); });
+        }
+    };
+
+    class SilentHandler : public AsyncHttpHandler {
+    public:
+        void handleAsync(const HttpRequest&, ResponseCallback) override {}
+    };
+
+    class ThrowingHandler : public AsyncHttpHandler {
+    public:
+        void handleAsync(const HttpRequest&, ResponseCallback) override {
+            throw std::runtime_error("handler failed");
+        }
+    };
+}
+
+// Test tasks from outside the pool all run
+TEST(WorkerPoolTest, RunsInjectedTasks) {
+    WorkerPool pool(4);
+    EXPECT_EQ(pool.getThreadCount(), 4u);
+    EXPECT_EQ(WorkerPool::current(), nullptr);
+
+    std::atomic<int> count{0};
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(pool.submit([&count, &pool]() {
+            EXPECT_EQ(WorkerPool::current(), &pool);
+            count.fetch_add(1);
+        }));
+    }
+    pool.shutdown();
+    EXPECT_EQ(count.load(), 1000);
+    EXPECT_EQ(totalExecuted(pool), 1000u);
+    EXPECT_EQ(pool.getInjectionQueueDepth(), 0u);
+}
+
+// Test continuations go to the submitting worker's deque and idle workers steal them
+TEST(WorkerPoolTest, IdleWorkersStealContinuations) {
+    WorkerPool pool(4);
+    std::atomic<int> count{0};
+    std::promise<void> queued;
+
+    pool.submit([&]() {
+        for (int i = 0; i < 200; ++i) {
+            WorkerPool::current()->submit([&count]() {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                count.fetch_add(1);
+            });
+        }
+        queued.set_value();
+        // Keep this worker busy so the others have to steal
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    });
+    queued.get_future().wait();
+    pool.shutdown();
+
+    EXPECT_EQ(count.load(), 200);
+    auto stats = pool.getWorkerStats();
+    uint64_t steals = 0;
+    for (const auto& worker : stats) {
+        steals += worker.steals;
+        EXPECT_EQ(worker.queueDepth, 0u);
+    }
+    EXPECT_GT(steals, 0u);
+    EXPECT_EQ(totalExecuted(pool), 201u);
+}
+
+// Test shutdown drains queued work and rejects new work
+TEST(WorkerPoolTest, ShutdownDrainsQueue) {
+    WorkerPool pool(1);
+    std::atomic<int> count{0};
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+
+    std::promise<void> started;
+    pool.submit([&started, released]() {
+        started.set_value();
+        released.wait();
+    });
+    started.get_future().wait();
+    for (int i = 0; i < 10; ++i) {
+        pool.submit([&count]() { count.fetch_add(1); });
+    }
+    EXPECT_EQ(pool.getInjectionQueueDepth(), 10u);
+
+    std::promise<bool> rejected;
+    pool.submit([&pool, &rejected]() {
+        try {
+            pool.shutdown();
+            rejected.set_value(false);
+        } catch (const std::logic_error&) {
+            rejected.set_value(true);
+        }
+    });
+    pool.submit([]() { throw std::runtime_error("dropped"); });
+
+    release.set_value();
+    pool.shutdown();
+    EXPECT_EQ(count.load(), 10);
+    EXPECT_TRUE(rejected.get_future().get());
+    EXPECT_FALSE(pool.submit([]() {}));
+    EXPECT_EQ(totalExecuted(pool), 13u);
+}
+
+// Test "auto" resolves to the hardware concurrency
+TEST(WorkerPoolTest, ResolvesThreadCount) {
+    EXPECT_EQ(WorkerPool::resolveThreadCount(3), 3u);
+    EXPECT_EQ(WorkerPool::resolveThreadCount(0),
+              std::max(1u, std::thread::hardware_concurrency()));
+    EXPECT_GE(WorkerPool(0).getThreadCount(), 1u);
+}
+
+// Test asynchronous handlers run on the pool, also from one of its workers
+TEST(WorkerPoolTest, ServerRunsAsyncHandlersOnPool) {
+    PooledServer server(1);
+    server.registerAsyncHandler("/items/{id}", HttpMethod::GET, std::make_shared<ContinuationHandler>());
+    server.registerAsyncHandler("/silent", HttpMethod::GET, std::make_shared<SilentHandler>());
+    server.registerAsyncHandler("/throws", HttpMethod::GET, std::make_shared<ThrowingHandler>());
+
+    HttpResponse response = server.processRequest(HttpRequest("GET", "/items/7", "HTTP/1.1"));
+    EXPECT_EQ(response.getStatus(), 200);
+    EXPECT_EQ(response.getBody(), "item 7");
+
+    // The single worker waits on its own continuation, so it has to run it
+    std::promise<std::string> nested;
+    server.getWorkerPool()->submit([&server, &nested]() {
+        nested.set_value(server.processRequest(HttpRequest("GET", "/items/8", "HTTP/1.1")).getBody());
+    });
+    EXPECT_EQ(nested.get_future().get(), "item 8");
+
+    // Work queued on the worker before the wait is left for later
+    std::promise<bool> leftQueued;
+    server.getWorkerPool()->submit([&server, &leftQueued]() {
+        auto ran = std::make_shared<std::atomic<bool>>(false);
+        WorkerPool::current()->submit([ran]() { *ran = true; });
+        server.processRequest(HttpRequest("GET", "/items/9", "HTTP/1.1"));
+        leftQueued.set_value(!*ran);
+    });
+    EXPECT_TRUE(leftQueued.get_future().get());
+
+    EXPECT_EQ(server.processRequest(HttpRequest("GET", "/throws", "HTTP/1.1")).getStatus(),
+              HttpResponse::INTERNAL_SERVER_ERROR);
+
+    server.config().general.requestTimeout = std::chrono::seconds(0);
+    HttpResponse silent = server.processRequest(HttpRequest("GET", "/silent", "HTTP/1.1"));
+    EXPECT_EQ(silent.getStatus(), HttpResponse::GATEWAY_TIMEOUT);
+    EXPECT_NE(silent.getCanned(), nullptr);
+}